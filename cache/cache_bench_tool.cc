@@ -28,6 +28,7 @@
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/cachable_entry.h"
 #include "util/coding.h"
+#include "util/compression.h"
 #include "util/distributed_mutex.h"
 #include "util/gflags_compat.h"
 #include "util/hash.h"
@@ -119,6 +120,14 @@ DEFINE_string(secondary_cache_uri, "",
 
 DEFINE_string(cache_type, "lru_cache", "Type of block cache.");
 
+DEFINE_double(compressed_secondary_ratio, 0.0,
+              "If > 0, build a tiered cache (NewTieredCache) with this "
+              "fraction of cache_size given to a compressed secondary cache");
+
+DEFINE_string(tiered_adm_policy, "auto",
+              "Admission policy of the tiered cache, one of auto, "
+              "placeholder, allow_cache_hits, allow_all, keep_compressed");
+
 DEFINE_bool(use_jemalloc_no_dump_allocator, false,
             "Whether to use JemallocNoDumpAllocator");
 
@@ -332,6 +341,40 @@ Cache::CacheItemHelper helper3_wos(CacheEntryRole::kFilterBlock, DeleteFn);
 Cache::CacheItemHelper helper3(CacheEntryRole::kFilterBlock, DeleteFn, SizeFn,
                                SaveToFn, CreateFn, &helper3_wos);
 
+bool UseTieredCache() { return FLAGS_compressed_secondary_ratio > 0.0; }
+
+TieredAdmissionPolicy StringToTieredAdmissionPolicy(const std::string& s) {
+  if (s == "auto") {
+    return kAdmPolicyAuto;
+  } else if (s == "placeholder") {
+    return kAdmPolicyPlaceholder;
+  } else if (s == "allow_cache_hits") {
+    return kAdmPolicyAllowCacheHits;
+  } else if (s == "allow_all") {
+    return kAdmPolicyAllowAll;
+  } else if (s == "keep_compressed") {
+    return kAdmPolicyKeepCompressed;
+  }
+  fprintf(stderr, "Unknown tiered admission policy: %s\n", s.c_str());
+  exit(1);
+}
+
+// Inserts a new value for `key`. In keep_compressed mode, the value is also
+// passed as the "on-disk compressed" form of the entry, which the compressed
+// tier saves as is (CreateFn treats saved data as opaque).
+Status InsertValue(Cache* cache, const Slice& key, Random64& rnd,
+                   const Cache::CacheItemHelper* helper,
+                   Cache::Handle** handle = nullptr) {
+  Cache::ObjectPtr value = createValue(rnd, cache->memory_allocator());
+  if (UseTieredCache() && FLAGS_tiered_adm_policy == "keep_compressed") {
+    return cache->Insert(key, value, helper, FLAGS_value_bytes, handle,
+                         Cache::Priority::LOW,
+                         Slice(static_cast<char*>(value), FLAGS_value_bytes),
+                         kLZ4Compression);
+  }
+  return cache->Insert(key, value, helper, FLAGS_value_bytes, handle);
+}
+
 void ConfigureSecondaryCache(ShardedCacheOptions& opts) {
   if (!FLAGS_secondary_cache_uri.empty()) {
     std::shared_ptr<SecondaryCache> secondary_cache;
@@ -348,7 +391,7 @@ void ConfigureSecondaryCache(ShardedCacheOptions& opts) {
 }
 
 ShardedCacheBase* AsShardedCache(Cache* c) {
-  if (!FLAGS_secondary_cache_uri.empty()) {
+  if (!FLAGS_secondary_cache_uri.empty() || UseTieredCache()) {
     c = static_cast_with_check<CacheWrapper>(c)->GetTarget().get();
   }
   return static_cast_with_check<ShardedCacheBase>(c);
@@ -387,6 +430,19 @@ class CacheBench {
       Status s = NewJemallocNodumpAllocator(opts, &allocator);
       assert(s.ok());
     }
+    if (UseTieredCache() && !FLAGS_secondary_cache_uri.empty()) {
+      fprintf(stderr,
+              "compressed_secondary_ratio and secondary_cache_uri are "
+              "mutually exclusive.\n");
+      exit(1);
+    }
+    TieredCacheOptions tiered_opts;
+    tiered_opts.total_capacity = FLAGS_cache_size;
+    tiered_opts.compressed_secondary_ratio = FLAGS_compressed_secondary_ratio;
+    tiered_opts.adm_policy =
+        StringToTieredAdmissionPolicy(FLAGS_tiered_adm_policy);
+    tiered_opts.comp_cache_opts.compression_type =
+        LZ4_Supported() ? kLZ4Compression : kNoCompression;
     if (FLAGS_cache_type == "clock_cache") {
       fprintf(stderr, "Old clock cache implementation has been removed.\n");
       exit(1);
@@ -410,7 +466,13 @@ class CacheBench {
         exit(1);
       }
       ConfigureSecondaryCache(opts);
-      cache_ = opts.MakeSharedCache();
+      if (UseTieredCache()) {
+        tiered_opts.cache_type = PrimaryCacheType::kCacheTypeHCC;
+        tiered_opts.cache_opts = &opts;
+        cache_ = NewTieredCache(tiered_opts);
+      } else {
+        cache_ = opts.MakeSharedCache();
+      }
     } else if (FLAGS_cache_type == "lru_cache") {
       LRUCacheOptions opts(FLAGS_cache_size, FLAGS_num_shard_bits,
                            false /* strict_capacity_limit */,
@@ -418,7 +480,13 @@ class CacheBench {
       opts.hash_seed = BitwiseAnd(FLAGS_seed, INT32_MAX);
       opts.memory_allocator = allocator;
       ConfigureSecondaryCache(opts);
-      cache_ = NewLRUCache(opts);
+      if (UseTieredCache()) {
+        tiered_opts.cache_type = PrimaryCacheType::kCacheTypeLRU;
+        tiered_opts.cache_opts = &opts;
+        cache_ = NewTieredCache(tiered_opts);
+      } else {
+        cache_ = NewLRUCache(opts);
+      }
     } else {
       fprintf(stderr, "Cache type not supported.\n");
       exit(1);
@@ -449,9 +517,7 @@ class CacheBench {
       }
       keys_since_last_not_found = 0;
 
-      Status s =
-          cache_->Insert(key, createValue(rnd, cache_->memory_allocator()),
-                         &helper1, FLAGS_value_bytes);
+      Status s = InsertValue(cache_.get(), key, rnd, &helper1);
       assert(s.ok());
 
       handle = cache_->Lookup(key);
@@ -735,22 +801,18 @@ class CacheBench {
         } else {
           ++lookup_misses;
           // do insert
-          Status s = cache_->Insert(
-              key, createValue(thread->rnd, cache_->memory_allocator()),
-              &helper2, FLAGS_value_bytes, &pinned.emplace_back());
+          Status s = InsertValue(cache_.get(), key, thread->rnd, &helper2,
+                                 &pinned.emplace_back());
           assert(s.ok());
         }
       } else if (random_op < insert_threshold_) {
         // do insert
-        Status s = cache_->Insert(
-            key, createValue(thread->rnd, cache_->memory_allocator()), &helper3,
-            FLAGS_value_bytes, &pinned.emplace_back());
+        Status s = InsertValue(cache_.get(), key, thread->rnd, &helper3,
+                               &pinned.emplace_back());
         assert(s.ok());
       } else if (random_op < blind_insert_threshold_) {
         // insert without keeping a handle
-        Status s = cache_->Insert(
-            key, createValue(thread->rnd, cache_->memory_allocator()), &helper3,
-            FLAGS_value_bytes);
+        Status s = InsertValue(cache_.get(), key, thread->rnd, &helper3);
         assert(s.ok());
       } else if (random_op < lookup_threshold_) {
         // do lookup
@@ -822,6 +884,11 @@ class CacheBench {
     printf("Ops per thread      : %" PRIu64 "\n", FLAGS_ops_per_thread);
     printf("Cache size          : %s\n",
            BytesToHumanString(FLAGS_cache_size).c_str());
+    if (UseTieredCache()) {
+      printf("Tiered cache        : %g compressed, %s\n",
+             FLAGS_compressed_secondary_ratio,
+             FLAGS_tiered_adm_policy.c_str());
+    }
     printf("Num shard bits      : %d\n",
            AsShardedCache(cache_.get())->GetNumShardBits());
     printf("Max key             : %" PRIu64 "\n", max_key_);
@@ -257,7 +257,7 @@ Status CompressedSecondaryCache::InsertSaved(
   }
 
   auto slice_helper = &kSliceCacheItemHelper;
-  if (MaybeInsertDummy(key)) {
+  if (!admit_saved_on_first_insert_ && MaybeInsertDummy(key)) {
     return Status::OK();
   }
 
@@ -104,6 +104,14 @@ class CompressedSecondaryCache : public SecondaryCache {
 
   std::string GetPrintableOptions() const override;
 
+  // Makes InsertSaved() admit the data on the first insertion of a key,
+  // rather than inserting a dummy entry first. Used by TieredCache with
+  // kAdmPolicyKeepCompressed, which inserts each block once, when it is read
+  // from storage. Must be called before the cache is used.
+  void SetAdmitSavedOnFirstInsert(bool admit) {
+    admit_saved_on_first_insert_ = admit;
+  }
+
   size_t TEST_GetUsage() { return cache_->GetUsage(); }
 
  private:
@@ -146,6 +154,7 @@ class CompressedSecondaryCache : public SecondaryCache {
   mutable port::Mutex capacity_mutex_;
   std::shared_ptr<ConcurrentCacheReservationManager> cache_res_mgr_;
   bool disable_cache_;
+  bool admit_saved_on_first_insert_ = false;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
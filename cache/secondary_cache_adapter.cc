@@ -7,6 +7,7 @@
 
 #include <atomic>
 
+#include "cache/compressed_secondary_cache.h"
 #include "cache/tiered_secondary_cache.h"
 #include "monitoring/perf_context_imp.h"
 #include "test_util/sync_point.h"
@@ -130,7 +131,8 @@ bool CacheWithSecondaryAdapter::EvictionHandler(const Slice& key,
                                                 Handle* handle, bool was_hit) {
   auto helper = GetCacheItemHelper(handle);
   if (helper->IsSecondaryCacheCompatible() &&
-      adm_policy_ != TieredAdmissionPolicy::kAdmPolicyThreeQueue) {
+      adm_policy_ != TieredAdmissionPolicy::kAdmPolicyThreeQueue &&
+      adm_policy_ != TieredAdmissionPolicy::kAdmPolicyKeepCompressed) {
     auto obj = target_->Value(handle);
     // Ignore dummy entry
     if (obj != kDummyObj) {
@@ -235,12 +237,48 @@ Cache::Handle* CacheWithSecondaryAdapter::Promote(
   return result;
 }
 
+Status CacheWithSecondaryAdapter::InsertKeepCompressed(
+    const Slice& key, ObjectPtr value, const CacheItemHelper* helper,
+    size_t charge, Handle** handle, Priority priority,
+    const Slice& compressed_value, CompressionType type) {
+  size_t sec_capacity = 0;
+  Status s = secondary_cache_->GetCapacity(sec_capacity);
+  if (s.ok() && sec_capacity > 0) {
+    s = secondary_cache_->InsertSaved(key, compressed_value, type);
+  }
+  if (!s.ok() || sec_capacity == 0) {
+    // Nowhere else to keep the block
+    return target_->Insert(key, value, helper, charge, handle, priority);
+  }
+  // Record the access, so that the block is promoted into the primary cache
+  // if it is looked up again while the dummy entry is still there
+  target_
+      ->Insert(key, kDummyObj, &kNoopCacheItemHelper, /*charge=*/0,
+               /*handle=*/nullptr, priority)
+      .PermitUncheckedError();
+  if (handle) {
+    *handle =
+        CreateStandalone(key, value, helper, charge, /*allow_uncharged*/ true);
+    assert(*handle);
+    PERF_COUNTER_ADD(block_cache_standalone_handle_count, 1);
+  } else {
+    CleanupCacheObject(value, helper);
+  }
+  return Status::OK();
+}
+
 Status CacheWithSecondaryAdapter::Insert(const Slice& key, ObjectPtr value,
                                          const CacheItemHelper* helper,
                                          size_t charge, Handle** handle,
                                          Priority priority,
                                          const Slice& compressed_value,
                                          CompressionType type) {
+  if (adm_policy_ == TieredAdmissionPolicy::kAdmPolicyKeepCompressed &&
+      value != nullptr && !compressed_value.empty() &&
+      type != kNoCompression && helper->IsSecondaryCacheCompatible()) {
+    return InsertKeepCompressed(key, value, helper, charge, handle, priority,
+                                compressed_value, type);
+  }
   Status s = target_->Insert(key, value, helper, charge, handle, priority);
   if (s.ok() && value == nullptr && distribute_cache_res_ && handle) {
     charge = target_->GetCharge(*handle);
@@ -295,9 +333,10 @@ Cache::Handle* CacheWithSecondaryAdapter::Lookup(const Slice& key,
     // Try our secondary cache
     bool kept_in_sec_cache = false;
     std::unique_ptr<SecondaryCacheResultHandle> secondary_handle =
-        secondary_cache_->Lookup(key, helper, create_context, /*wait*/ true,
-                                 found_dummy_entry, stats,
-                                 /*out*/ kept_in_sec_cache);
+        secondary_cache_->Lookup(
+            key, helper, create_context, /*wait*/ true,
+            /*advise_erase*/ found_dummy_entry && AdviseEraseOnDummyHit(),
+            stats, /*out*/ kept_in_sec_cache);
     if (secondary_handle) {
       result = Promote(std::move(secondary_handle), key, helper, priority,
                        stats, found_dummy_entry, kept_in_sec_cache);
@@ -353,7 +392,10 @@ void CacheWithSecondaryAdapter::StartAsyncLookupOnMySecondary(
   std::unique_ptr<SecondaryCacheResultHandle> secondary_handle =
       secondary_cache_->Lookup(
           async_handle.key, async_handle.helper, async_handle.create_context,
-          /*wait*/ false, async_handle.found_dummy_entry, async_handle.stats,
+          /*wait*/ false,
+          /*advise_erase*/ async_handle.found_dummy_entry &&
+              AdviseEraseOnDummyHit(),
+          async_handle.stats,
           /*out*/ async_handle.kept_in_sec_cache);
   if (secondary_handle) {
     // TODO with stacked secondaries: Check & process if already ready?
@@ -637,6 +679,12 @@ Status CacheWithSecondaryAdapter::UpdateCacheReservationRatio(
 
 Status CacheWithSecondaryAdapter::UpdateAdmissionPolicy(
     TieredAdmissionPolicy adm_policy) {
+  if ((adm_policy == TieredAdmissionPolicy::kAdmPolicyKeepCompressed) !=
+      (adm_policy_ == TieredAdmissionPolicy::kAdmPolicyKeepCompressed)) {
+    // The secondary cache admission is configured for it at creation
+    return Status::InvalidArgument(
+        "Cannot switch to or from kAdmPolicyKeepCompressed");
+  }
   adm_policy_ = adm_policy;
   return Status::OK();
 }
@@ -664,6 +712,7 @@ std::shared_ptr<Cache> NewTieredCache(const TieredCacheOptions& _opts) {
       case TieredAdmissionPolicy::kAdmPolicyPlaceholder:
       case TieredAdmissionPolicy::kAdmPolicyAllowCacheHits:
       case TieredAdmissionPolicy::kAdmPolicyAllowAll:
+      case TieredAdmissionPolicy::kAdmPolicyKeepCompressed:
         if (opts.nvm_sec_cache) {
           valid_adm_policy = false;
         }
@@ -703,6 +752,10 @@ std::shared_ptr<Cache> NewTieredCache(const TieredCacheOptions& _opts) {
   opts.comp_cache_opts.capacity = static_cast<size_t>(
       opts.total_capacity * opts.compressed_secondary_ratio);
   sec_cache = NewCompressedSecondaryCache(opts.comp_cache_opts);
+  if (opts.adm_policy == TieredAdmissionPolicy::kAdmPolicyKeepCompressed) {
+    static_cast_with_check<CompressedSecondaryCache>(sec_cache.get())
+        ->SetAdmitSavedOnFirstInsert(true);
+  }
 
   if (opts.nvm_sec_cache) {
     if (opts.adm_policy == TieredAdmissionPolicy::kAdmPolicyThreeQueue) {
@@ -64,6 +64,20 @@ class CacheWithSecondaryAdapter : public CacheWrapper {
 
   bool EvictionHandler(const Slice& key, Handle* handle, bool was_hit);
 
+  // Insert() for kAdmPolicyKeepCompressed: keeps the compressed block only in
+  // the secondary cache, and returns a standalone handle for `value`
+  Status InsertKeepCompressed(const Slice& key, ObjectPtr value,
+                              const CacheItemHelper* helper, size_t charge,
+                              Handle** handle, Priority priority,
+                              const Slice& compressed_value,
+                              CompressionType type);
+
+  // Whether a secondary cache lookup following a primary cache dummy hit
+  // should erase the entry from the secondary cache
+  bool AdviseEraseOnDummyHit() const {
+    return adm_policy_ != TieredAdmissionPolicy::kAdmPolicyKeepCompressed;
+  }
+
   void StartAsyncLookupOnMySecondary(AsyncLookupHandle& async_handle);
 
   Handle* Promote(
@@ -873,6 +873,69 @@ TEST_P(DBTieredAdmPolicyTest, CompressedCacheAdmission) {
   Destroy(options);
 }
 
+TEST_F(DBTieredSecondaryCacheTest, KeepCompressedAdmission) {
+  if (!LZ4_Supported()) {
+    ROCKSDB_GTEST_SKIP("This test requires LZ4 support.");
+    return;
+  }
+
+  BlockBasedTableOptions table_options;
+  // As above, 256KB of the primary capacity is taken by the reservation on
+  // behalf of the compressed cache.
+  table_options.block_cache =
+      NewCache(256 * 1024, 64 * 1024, 0,
+               TieredAdmissionPolicy::kAdmPolicyKeepCompressed);
+  table_options.block_size = 4 * 1024;
+  table_options.cache_index_and_filter_blocks = false;
+  Options options = GetDefaultOptions();
+  options.create_if_missing = true;
+  options.compression = kLZ4Compression;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  size_t comp_cache_usage = compressed_secondary_cache()->TEST_GetUsage();
+  options.paranoid_file_checks = false;
+  DestroyAndReopen(options);
+  Random rnd(301);
+  const int N = 256;
+  for (int i = 0; i < N; i++) {
+    std::string p_v;
+    test::CompressibleString(&rnd, 0.5, 1007, &p_v);
+    ASSERT_OK(Put(Key(i), p_v));
+  }
+
+  ASSERT_OK(Flush());
+
+  get_perf_context()->Reset();
+
+  // The first read of a block admits its on-disk compressed form into the
+  // compressed cache right away, while the primary only gets a placeholder.
+  std::string v = Get(Key(0));
+  ASSERT_EQ(1007, v.size());
+  size_t usage_after_first = compressed_secondary_cache()->TEST_GetUsage();
+  ASSERT_GT(usage_after_first, comp_cache_usage + 128);
+  ASSERT_EQ(get_perf_context()->secondary_cache_hit_count, 0);
+
+  // The second read is served by the compressed cache and promotes the
+  // decompressed block to the primary, keeping the compressed copy.
+  v = Get(Key(0));
+  ASSERT_EQ(1007, v.size());
+  ASSERT_EQ(get_perf_context()->secondary_cache_hit_count, 1);
+  ASSERT_EQ(compressed_secondary_cache()->TEST_GetUsage(), usage_after_first);
+
+  // Now a primary cache hit
+  v = Get(Key(0));
+  ASSERT_EQ(1007, v.size());
+  ASSERT_EQ(get_perf_context()->secondary_cache_hit_count, 1);
+
+  // The policy cannot be switched on a live cache
+  ASSERT_TRUE(UpdateTieredCache(table_options.block_cache, -1,
+                                std::numeric_limits<double>::max(),
+                                TieredAdmissionPolicy::kAdmPolicyAllowAll)
+                  .IsInvalidArgument());
+
+  Destroy(options);
+}
+
 TEST_F(DBTieredSecondaryCacheTest, FSBufferTest) {
   class WrapFS : public FileSystemWrapper {
    public:
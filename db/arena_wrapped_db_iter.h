@@ -69,6 +69,9 @@ class ArenaWrappedDBIter : public Iterator {
   void SeekForPrev(const Slice& target) override {
     db_iter_->SeekForPrev(target);
   }
+  void Prepare(const std::vector<ScanRange>& scan_ranges) override {
+    db_iter_->Prepare(scan_ranges);
+  }
   void Next() override { db_iter_->Next(); }
   void Prev() override { db_iter_->Prev(); }
   Slice key() const override { return db_iter_->key(); }
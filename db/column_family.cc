@@ -256,6 +256,13 @@ ColumnFamilyOptions SanitizeOptions(const ImmutableDBOptions& db_options,
   if (result.max_write_buffer_number < 2) {
     result.max_write_buffer_number = 2;
   }
+  // memtable resident column families serve lookups from flushed memtables,
+  // so retain some by default
+  if (result.memtable_resident &&
+      result.max_write_buffer_size_to_maintain == 0 &&
+      result.max_write_buffer_number_to_maintain == 0) {
+    result.max_write_buffer_size_to_maintain = -1;
+  }
   // fall back max_write_buffer_number_to_maintain if
   // max_write_buffer_size_to_maintain is not set
   if (result.max_write_buffer_size_to_maintain < 0) {
@@ -1542,6 +1549,28 @@ Status ColumnFamilyData::ValidateOptions(
           " runs but is smaller than the compaction trigger "
           "level0_file_num_compaction_trigger.");
     }
+    const unsigned int max_runs_per_tier =
+        cf_options.compaction_options_universal.max_runs_per_tier;
+    if (max_runs_per_tier == 1) {
+      return Status::NotSupported(
+          "CompactionOptionsUniversal::max_runs_per_tier should be 0 or at "
+          "least 2.");
+    } else if (max_runs_per_tier > 0) {
+      if (cf_options.level0_file_num_compaction_trigger >
+          static_cast<int64_t>(max_runs_per_tier)) {
+        return Status::NotSupported(
+            "CompactionOptionsUniversal::max_runs_per_tier is smaller than "
+            "the compaction trigger level0_file_num_compaction_trigger, so a "
+            "full tier may not be compacted.");
+      }
+      // A full tier and the oldest sorted run must not slow down writes.
+      if (cf_options.level0_slowdown_writes_trigger <=
+          static_cast<int64_t>(max_runs_per_tier) + 1) {
+        return Status::NotSupported(
+            "CompactionOptionsUniversal::max_runs_per_tier should be smaller "
+            "than level0_slowdown_writes_trigger - 1.");
+      }
+    }
   }
   return s;
 }
@@ -3595,6 +3595,35 @@ TEST(ColumnFamilyTest, ValidateBlobGCForceThreshold) {
                   .IsInvalidArgument());
 }
 
+TEST(ColumnFamilyTest, ValidateUniversalMaxRunsPerTier) {
+  DBOptions db_options;
+
+  ColumnFamilyOptions cf_options;
+  cf_options.compaction_style = kCompactionStyleUniversal;
+  cf_options.level0_file_num_compaction_trigger = 4;
+  cf_options.level0_slowdown_writes_trigger = 20;
+
+  cf_options.compaction_options_universal.max_runs_per_tier = 1;
+  ASSERT_TRUE(ColumnFamilyData::ValidateOptions(db_options, cf_options)
+                  .IsNotSupported());
+
+  // Smaller than the compaction trigger
+  cf_options.compaction_options_universal.max_runs_per_tier = 3;
+  ASSERT_TRUE(ColumnFamilyData::ValidateOptions(db_options, cf_options)
+                  .IsNotSupported());
+
+  cf_options.compaction_options_universal.max_runs_per_tier = 4;
+  ASSERT_OK(ColumnFamilyData::ValidateOptions(db_options, cf_options));
+
+  cf_options.compaction_options_universal.max_runs_per_tier = 18;
+  ASSERT_OK(ColumnFamilyData::ValidateOptions(db_options, cf_options));
+
+  // A full tier and the oldest run would slow down writes
+  cf_options.compaction_options_universal.max_runs_per_tier = 19;
+  ASSERT_TRUE(ColumnFamilyData::ValidateOptions(db_options, cf_options)
+                  .IsNotSupported());
+}
+
 TEST(ColumnFamilyTest, ValidateMemtableKVChecksumOption) {
   DBOptions db_options;
 
@@ -907,6 +907,22 @@ bool Compaction::DoesInputReferenceBlobFiles() const {
   return false;
 }
 
+bool Compaction::MayInputHaveRangeDeletions() const {
+  size_t num_files = 0;
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    num_files += inputs_[i].size();
+  }
+  if (input_table_properties_.size() != num_files) {
+    return true;
+  }
+  for (const auto& file_and_props : input_table_properties_) {
+    if (file_and_props.second->num_range_deletions > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 uint64_t Compaction::MinInputFileOldestAncesterTime(
     const InternalKey* start, const InternalKey* end) const {
   uint64_t min_oldest_ancester_time = std::numeric_limits<uint64_t>::max();
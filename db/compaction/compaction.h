@@ -327,6 +327,12 @@ class Compaction {
   // PRE: input version has been set.
   bool DoesInputReferenceBlobFiles() const;
 
+  // Returns false iff the table properties of all input files are loaded and
+  // none of the files contains range deletions.
+  //
+  // PRE: input table properties have been initialized.
+  bool MayInputHaveRangeDeletions() const;
+
   // test function to validate the functionality of IsBottommostLevel()
   // function -- determines if compaction with inputs and storage is bottommost
   static bool TEST_IsBottommostLevel(
@@ -10,8 +10,10 @@
 #include "db/compaction/compaction_job.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <set>
 #include <utility>
@@ -23,6 +25,7 @@
 #include "db/builder.h"
 #include "db/compaction/clipping_iterator.h"
 #include "db/compaction/compaction_state.h"
+#include "db/compaction/pipelined_input_iterator.h"
 #include "db/db_impl/db_impl.h"
 #include "db/dbformat.h"
 #include "db/error_handler.h"
@@ -101,6 +104,8 @@ const char* GetCompactionReasonString(CompactionReason compaction_reason) {
       return "RoundRobinTtl";
     case CompactionReason::kRefitLevel:
       return "RefitLevel";
+    case CompactionReason::kUniversalRunsPerTier:
+      return "UniversalRunsPerTier";
     case CompactionReason::kNumOfReasons:
       // fall through
     default:
@@ -577,9 +582,18 @@ void CompactionJob::GenSubcompactionBoundaries() {
     return;
   }
 
+  // With more ranges than threads, Run() balances the ranges across the
+  // threads.
+  uint64_t num_planned_ranges = num_planned_subcompactions;
+  if (!(c->immutable_options()->compaction_pri == kRoundRobin &&
+        c->immutable_options()->compaction_style == kCompactionStyleLevel)) {
+    num_planned_ranges *=
+        std::max(db_options_.subcompaction_ranges_per_thread, 1U);
+  }
+
   // Group the ranges into subcompactions
   uint64_t target_range_size = std::max(
-      total_size / num_planned_subcompactions,
+      total_size / num_planned_ranges,
       MaxFileSizeForLevel(
           *(c->mutable_cf_options()), out_lvl,
           c->immutable_options()->compaction_style, base_level,
@@ -591,6 +605,7 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   uint64_t next_threshold = target_range_size;
   uint64_t cumulative_size = 0;
+  uint64_t range_start_size = 0;
   uint64_t num_actual_subcompactions = 1U;
   for (TableReader::Anchor& anchor : all_anchors) {
     cumulative_size += anchor.range_size;
@@ -598,17 +613,21 @@ void CompactionJob::GenSubcompactionBoundaries() {
       next_threshold += target_range_size;
       num_actual_subcompactions++;
       boundaries_.push_back(anchor.user_key);
+      subcompaction_sizes_.push_back(cumulative_size - range_start_size);
+      range_start_size = cumulative_size;
     }
-    if (num_actual_subcompactions == num_planned_subcompactions) {
+    if (num_actual_subcompactions == num_planned_ranges) {
       break;
     }
   }
+  subcompaction_sizes_.push_back(total_size - range_start_size);
   TEST_SYNC_POINT_CALLBACK("CompactionJob::GenSubcompactionBoundaries:1",
                            &num_actual_subcompactions);
   // Shrink extra subcompactions resources when extra resrouces are acquired
-  ShrinkSubcompactionResources(
-      std::min((int)(num_planned_subcompactions - num_actual_subcompactions),
-               extra_num_subcompaction_threads_reserved_));
+  ShrinkSubcompactionResources(std::min(
+      (int)(num_planned_subcompactions -
+            std::min(num_actual_subcompactions, num_planned_subcompactions)),
+      extra_num_subcompaction_threads_reserved_));
 }
 
 Status CompactionJob::Run() {
@@ -618,21 +637,50 @@ Status CompactionJob::Run() {
   log_buffer_->FlushBufferToLog();
   LogCompaction();
 
-  const size_t num_threads = compact_->sub_compact_states.size();
-  assert(num_threads > 0);
+  const size_t num_subcompactions = compact_->sub_compact_states.size();
+  assert(num_subcompactions > 0);
+  // There are more subcompactions than threads only with
+  // subcompaction_ranges_per_thread > 1.
+  size_t num_threads = num_subcompactions;
+  if (db_options_.subcompaction_ranges_per_thread > 1) {
+    num_threads = std::min(num_threads,
+                           static_cast<size_t>(GetSubcompactionsLimit()));
+  }
   const uint64_t start_micros = db_options_.clock->NowMicros();
 
-  // Launch a thread for each of subcompactions 1...num_threads-1
   std::vector<port::Thread> thread_pool;
   thread_pool.reserve(num_threads - 1);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this,
-                             &compact_->sub_compact_states[i]);
-  }
+  if (num_threads == num_subcompactions) {
+    // Launch a thread for each of subcompactions 1...num_threads-1
+    for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
+      thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction,
+                               this, &compact_->sub_compact_states[i]);
+    }
 
-  // Always schedule the first subcompaction (whether or not there are also
-  // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(compact_->sub_compact_states.data());
+    // Always schedule the first subcompaction (whether or not there are also
+    // others) in the current thread to be efficient with resources
+    ProcessKeyValueCompaction(compact_->sub_compact_states.data());
+  } else {
+    // Every thread, including the current one, takes subcompactions from a
+    // shared queue until it is empty, largest estimated input first.
+    assert(subcompaction_sizes_.size() == num_subcompactions);
+    std::vector<size_t> order(num_subcompactions);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return subcompaction_sizes_[a] > subcompaction_sizes_[b];
+    });
+    std::atomic<size_t> next{0};
+    auto process_subcompactions = [this, &order, &next]() {
+      for (size_t i = next.fetch_add(1); i < order.size();
+           i = next.fetch_add(1)) {
+        ProcessKeyValueCompaction(&compact_->sub_compact_states[order[i]]);
+      }
+    };
+    for (size_t i = 1; i < num_threads; i++) {
+      thread_pool.emplace_back(process_subcompactions);
+    }
+    process_subcompactions();
+  }
 
   // Wait for all other threads (if there are any) to finish execution
   for (auto& thread : thread_pool) {
@@ -978,6 +1026,10 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options,
     stream << "file_fsync_nanos" << compaction_job_stats_->file_fsync_nanos;
     stream << "file_prepare_write_nanos"
            << compaction_job_stats_->file_prepare_write_nanos;
+    stream << "parallel_compression_nanos"
+           << compaction_job_stats_->parallel_compression_nanos;
+    stream << "parallel_compression_wait_nanos"
+           << compaction_job_stats_->parallel_compression_wait_nanos;
   }
 
   stream << "lsm_state";
@@ -1200,6 +1252,18 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     input = clip.get();
   }
 
+  // Files are opened lazily while iterating, which adds their range
+  // tombstones to `range_del_agg`. That cannot happen concurrently with the
+  // compaction iterator using the aggregator.
+  std::unique_ptr<PipelinedInputIterator> pipelined_input;
+  if (db_options_.compaction_pipelined_input_size > 0 &&
+      !sub_compact->compaction->MayInputHaveRangeDeletions()) {
+    pipelined_input = std::make_unique<PipelinedInputIterator>(
+        input, db_options_.compaction_pipelined_input_size,
+        db_options_.clock);
+    input = pipelined_input.get();
+  }
+
   std::unique_ptr<InternalIterator> blob_counter;
 
   if (sub_compact->compaction->DoesInputReferenceBlobFiles()) {
@@ -1408,6 +1472,10 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   }
 
   RecordDroppedKeys(c_iter_stats, &sub_compact->compaction_job_stats);
+  if (pipelined_input) {
+    pipelined_input->Stop();
+    IOSTATS_ADD(bytes_read, pipelined_input->GetBytesRead());
+  }
   RecordCompactionIOStats();
 
   if (status.ok() && cfd->IsDropped()) {
@@ -1451,6 +1519,12 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
       cur_cpu_micros - prev_cpu_micros;
   RecordTick(stats_, COMPACTION_CPU_TOTAL_TIME,
              cur_cpu_micros - last_cpu_micros);
+  if (pipelined_input) {
+    sub_compact->compaction_job_stats.cpu_micros +=
+        pipelined_input->GetCpuMicros();
+    RecordTick(stats_, COMPACTION_CPU_TOTAL_TIME,
+               pipelined_input->GetCpuMicros());
+  }
 
   if (measure_io_stats_) {
     sub_compact->compaction_job_stats.file_write_nanos +=
@@ -1574,6 +1648,16 @@ Status CompactionJob::FinishCompactionOutputFile(
 
   s = outputs.Finish(s, seqno_to_time_mapping_);
 
+  if (measure_io_stats_) {
+    uint64_t compress_nanos = 0;
+    uint64_t wait_nanos = 0;
+    outputs.GetParallelCompressionTimes(&compress_nanos, &wait_nanos);
+    sub_compact->compaction_job_stats.parallel_compression_nanos +=
+        compress_nanos;
+    sub_compact->compaction_job_stats.parallel_compression_wait_nanos +=
+        wait_nanos;
+  }
+
   if (s.ok()) {
     // With accurate smallest and largest key, we can get a slightly more
     // accurate oldest ancester time.
@@ -1852,6 +1936,7 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
     temperature = last_level_temp;
   }
   fo_copy.temperature = temperature;
+  fo_copy.async_write_buffers = db_options_.compaction_async_write_buffers;
 
   Status s;
   IOStatus io_s = NewWritableFile(fs_.get(), fname, &writable_file, fo_copy);
@@ -333,6 +333,9 @@ class CompactionJob {
   bool measure_io_stats_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<std::string> boundaries_;
+  // Estimated input bytes of each subcompaction, when boundaries_ is set by
+  // GenSubcompactionBoundaries()
+  std::vector<uint64_t> subcompaction_sizes_;
   Env::Priority thread_pri_;
   std::string full_history_ts_low_;
   std::string trim_ts_;
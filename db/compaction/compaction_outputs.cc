@@ -746,8 +746,10 @@ Status CompactionOutputs::AddRangeDels(
 void CompactionOutputs::FillFilesToCutForTtl() {
   if (compaction_->immutable_options()->compaction_style !=
           kCompactionStyleLevel ||
-      compaction_->immutable_options()->compaction_pri !=
-          kMinOverlappingRatio ||
+      (compaction_->immutable_options()->compaction_pri !=
+           kMinOverlappingRatio &&
+       compaction_->immutable_options()->compaction_pri !=
+           kReadWeightedOverlappingRatio) ||
       compaction_->mutable_cf_options()->ttl == 0 ||
       compaction_->num_input_levels() < 2 || compaction_->bottommost_level()) {
     return;
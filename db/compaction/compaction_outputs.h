@@ -160,6 +160,11 @@ class CompactionOutputs {
 
   uint64_t NumEntries() const { return builder_->NumEntries(); }
 
+  void GetParallelCompressionTimes(uint64_t* compress_nanos,
+                                   uint64_t* wait_nanos) const {
+    builder_->GetParallelCompressionTimes(compress_nanos, wait_nanos);
+  }
+
   void ResetBuilder() {
     builder_.reset();
     current_output_file_size_ = 0;
@@ -1466,6 +1466,39 @@ TEST_F(CompactionPickerTest, CompactionPriMinOverlapping4) {
   ASSERT_EQ(6U, compaction->input(0, 0)->fd.GetNumber());
 }
 
+TEST_F(CompactionPickerTest, CompactionPriReadWeightedOverlapping) {
+  NewVersionStorage(6, kCompactionStyleLevel);
+  ioptions_.compaction_pri = kReadWeightedOverlappingRatio;
+  mutable_cf_options_.target_file_size_base = 10000000;
+  mutable_cf_options_.target_file_size_multiplier = 10;
+  mutable_cf_options_.max_bytes_for_level_base = 10 * 1024 * 1024;
+
+  Add(2, 6U, "150", "175", 60000000U);  // Overlaps with file 26, 27
+  Add(2, 7U, "176", "200", 60000000U);  // Overlaps with file 27, 28, the
+                                        // smallest overlapping
+  Add(2, 8U, "201", "300", 60000000U);  // Overlaps with file 28, 29
+
+  Add(3, 25U, "100", "110", 261000000U);
+  Add(3, 26U, "150", "170", 261000000U);
+  Add(3, 27U, "171", "179", 260000000U);
+  Add(3, 28U, "191", "220", 260000000U);
+  Add(3, 29U, "221", "300", 261000000U);
+  Add(3, 30U, "321", "400", 261000000U);
+  // File 8 gets most of the reads of level 2.
+  file_map_[6U].first->stats.num_reads_sampled = 1024;
+  file_map_[8U].first->stats.num_reads_sampled = 8 * 1024;
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(level_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, mutable_db_options_, vstorage_.get(),
+      &log_buffer_));
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(1U, compaction->num_input_files(0));
+  // Picking file 8 because its reads outweigh its slightly larger
+  // overlapping ratio.
+  ASSERT_EQ(8U, compaction->input(0, 0)->fd.GetNumber());
+}
+
 TEST_F(CompactionPickerTest, CompactionPriRoundRobin) {
   std::vector<InternalKey> test_cursors = {InternalKey("249", 100, kTypeValue),
                                            InternalKey("600", 100, kTypeValue),
@@ -4442,6 +4475,73 @@ TEST_F(CompactionPickerTest, UniversalMaxReadAmpSmallDB) {
   }
 }
 
+TEST_F(CompactionPickerTest, UniversalLazyLeveling) {
+  ioptions_.compaction_style = kCompactionStyleUniversal;
+  ioptions_.num_levels = 50;
+  mutable_cf_options_.RefreshDerivedOptions(ioptions_);
+  mutable_cf_options_.level0_file_num_compaction_trigger = 4;
+  mutable_cf_options_.write_buffer_size = 1 << 20;
+  mutable_cf_options_.compaction_options_universal.max_runs_per_tier = 4;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, &icmp_);
+
+  // Tier 0 holds the runs smaller than 4MB, tier 1 the runs of [4MB, 16MB).
+  // Three runs of tier 0 and num_tier1_runs runs of tier 1 are above the last
+  // run.
+  for (int num_tier1_runs : {3, 4}) {
+    for (int slowdown_trigger : {20, 8}) {
+      SCOPED_TRACE("num_tier1_runs = " + std::to_string(num_tier1_runs) +
+                   ", slowdown_trigger = " + std::to_string(slowdown_trigger));
+      mutable_cf_options_.level0_slowdown_writes_trigger = slowdown_trigger;
+      NewVersionStorage(/*num_levels=*/50, kCompactionStyleUniversal);
+      const uint64_t kLastRunSize = 1ull << 30;
+      Add(/*level=*/49, /*file_number=*/10, /*smallest=*/"100",
+          /*largest=*/"200", /*file_size=*/kLastRunSize, /*path_id=*/0,
+          /*smallest_seq=*/0, /*largest_seq=*/0,
+          /*compensated_file_size=*/kLastRunSize);
+      int level = 0;
+      for (int i = 0; i < 3 + num_tier1_runs; ++i, ++level) {
+        const uint64_t file_size = i < 3 ? 1 << 20 : 5 << 20;
+        Add(level, /*file_number=*/100 - level, /*smallest=*/"100",
+            /*largest=*/"200", file_size, /*path_id=*/0,
+            /*smallest_seq=*/100 - level, /*largest_seq=*/100 - level,
+            /*compensated_file_size=*/file_size);
+      }
+      UpdateVersionStorageInfo();
+      ASSERT_TRUE(
+          universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+      std::unique_ptr<Compaction> compaction(
+          universal_compaction_picker.PickCompaction(
+              cf_name_, mutable_cf_options_, mutable_db_options_,
+              vstorage_.get(), &log_buffer_));
+      if (num_tier1_runs < 4 && slowdown_trigger == 20) {
+        // No tier is full. Without lazy leveling, the three newest runs would
+        // be merged for size ratio.
+        ASSERT_EQ(nullptr, compaction);
+        continue;
+      }
+      ASSERT_NE(nullptr, compaction);
+      ASSERT_EQ(CompactionReason::kUniversalRunsPerTier,
+                compaction->compaction_reason());
+      size_t num_input_files = 0;
+      for (const auto& input : *compaction->inputs()) {
+        num_input_files += input.size();
+      }
+      if (num_tier1_runs == 4) {
+        // The runs of tier 1 are merged, into the level above the last run.
+        ASSERT_EQ(3, compaction->start_level());
+        ASSERT_EQ(48, compaction->output_level());
+        ASSERT_EQ(4U, num_input_files);
+      } else {
+        // No tier is full, but the 7 sorted runs are one short of slowing
+        // down writes, so the fullest tier is merged early.
+        ASSERT_EQ(0, compaction->start_level());
+        ASSERT_EQ(2, compaction->output_level());
+        ASSERT_EQ(3U, num_input_files);
+      }
+    }
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -88,6 +88,10 @@ class UniversalCompactionBuilder {
   // Pick Universal compaction to limit space amplification.
   Compaction* PickCompactionToReduceSizeAmp();
 
+  // Pick Universal compaction to merge the runs of a full tier, with lazy
+  // leveling (CompactionOptionsUniversal::max_runs_per_tier).
+  Compaction* PickCompactionToReduceRunsPerTier();
+
   // Try to pick incremental compaction to reduce space amplification.
   // It will return null if it cannot find a fanout within the threshold.
   // Fanout is defined as
@@ -528,7 +532,17 @@ Compaction* UniversalCompactionBuilder::PickCompaction() {
       unsigned int ratio =
           mutable_cf_options_.compaction_options_universal.size_ratio;
 
-      if ((c = PickCompactionToReduceSortedRuns(ratio, UINT_MAX)) != nullptr) {
+      if (mutable_cf_options_.compaction_options_universal.max_runs_per_tier >
+          0) {
+        // With lazy leveling, tiers replace the size ratio and the limit on
+        // the number of sorted runs.
+        if ((c = PickCompactionToReduceRunsPerTier()) != nullptr) {
+          ROCKS_LOG_BUFFER(log_buffer_,
+                           "[%s] Universal: compacting for runs per tier\n",
+                           cf_name_.c_str());
+        }
+      } else if ((c = PickCompactionToReduceSortedRuns(ratio, UINT_MAX)) !=
+                 nullptr) {
         TEST_SYNC_POINT("PickCompactionToReduceSortedRunsReturnNonnullptr");
         ROCKS_LOG_BUFFER(log_buffer_,
                          "[%s] Universal: compacting for size ratio\n",
@@ -928,6 +942,92 @@ Compaction* UniversalCompactionBuilder::PickCompactionToReduceSortedRuns(
                         /* l0_files_might_overlap */ true, compaction_reason);
 }
 
+Compaction* UniversalCompactionBuilder::PickCompactionToReduceRunsPerTier() {
+  const unsigned int max_runs =
+      mutable_cf_options_.compaction_options_universal.max_runs_per_tier;
+  assert(max_runs >= 2);
+  const double base_size = static_cast<double>(
+      std::max<size_t>(mutable_cf_options_.write_buffer_size, 1));
+  auto get_tier = [&](uint64_t size) {
+    int tier = 0;
+    for (double limit = base_size * max_runs;
+         static_cast<double>(size) >= limit; limit *= max_runs) {
+      ++tier;
+    }
+    return tier;
+  };
+
+  // The oldest sorted run is leveled, runs are only merged into it for size
+  // amplification.
+  const size_t num_tiered_runs = sorted_runs_.size() - 1;
+  // The longest range of runs of one tier that are not being compacted
+  size_t fullest_start_index = 0;
+  size_t fullest_num_runs = 0;
+  size_t start_index = 0;
+  while (start_index < num_tiered_runs) {
+    if (sorted_runs_[start_index].being_compacted) {
+      ++start_index;
+      continue;
+    }
+    // Runs are ordered from newest to oldest, so the runs of a tier are
+    // next to each other.
+    const int tier = get_tier(sorted_runs_[start_index].size);
+    size_t end_index = start_index;
+    while (end_index + 1 < num_tiered_runs &&
+           !sorted_runs_[end_index + 1].being_compacted &&
+           get_tier(sorted_runs_[end_index + 1].size) == tier) {
+      ++end_index;
+    }
+    const size_t num_runs = end_index - start_index + 1;
+    if (num_runs >= max_runs) {
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] Universal: tier %d has %" ROCKSDB_PRIszt
+                       " runs, at most %u allowed",
+                       cf_name_.c_str(), tier, num_runs, max_runs);
+      return PickCompactionWithSortedRunRange(
+          start_index, end_index, CompactionReason::kUniversalRunsPerTier);
+    }
+    if (num_runs > fullest_num_runs) {
+      fullest_start_index = start_index;
+      fullest_num_runs = num_runs;
+    }
+    start_index = end_index + 1;
+  }
+
+  // No tier is full, but writes are slowed down by the number of sorted runs
+  // alone, which partially filled tiers can also reach. Merge the fullest
+  // tier early once the next flush would slow down writes, or the newest runs
+  // if every tier has a single run.
+  if (sorted_runs_.size() + 1 <
+      static_cast<size_t>(
+          mutable_cf_options_.level0_slowdown_writes_trigger)) {
+    return nullptr;
+  }
+  if (fullest_num_runs < 2) {
+    fullest_num_runs = 0;
+    for (size_t i = 0; i + 1 < sorted_runs_.size(); ++i) {
+      if (!sorted_runs_[i].being_compacted &&
+          !sorted_runs_[i + 1].being_compacted) {
+        fullest_start_index = i;
+        fullest_num_runs = 2;
+        break;
+      }
+    }
+    if (fullest_num_runs == 0) {
+      return nullptr;
+    }
+  }
+  ROCKS_LOG_BUFFER(log_buffer_,
+                   "[%s] Universal: merging %" ROCKSDB_PRIszt
+                   " runs early, %" ROCKSDB_PRIszt
+                   " sorted runs are close to the slowdown trigger %d",
+                   cf_name_.c_str(), fullest_num_runs, sorted_runs_.size(),
+                   mutable_cf_options_.level0_slowdown_writes_trigger);
+  return PickCompactionWithSortedRunRange(
+      fullest_start_index, fullest_start_index + fullest_num_runs - 1,
+      CompactionReason::kUniversalRunsPerTier);
+}
+
 // Look at overall size amplification. If size amplification
 // exceeds the configured value, then do a compaction
 // on longest span of candidate files without conflict with other compactions
@@ -1448,6 +1548,8 @@ Compaction* UniversalCompactionBuilder::PickCompactionWithSortedRunRange(
     } else if (compaction_reason ==
                CompactionReason::kUniversalSizeAmplification) {
       comp_reason_print_string = "size amp";
+    } else if (compaction_reason == CompactionReason::kUniversalRunsPerTier) {
+      comp_reason_print_string = "runs per tier";
     } else {
       assert(false);
       comp_reason_print_string = "unknown: ";
@@ -1465,6 +1567,8 @@ Compaction* UniversalCompactionBuilder::PickCompactionWithSortedRunRange(
   int output_level;
   if (end_index == sorted_runs_.size() - 1) {
     output_level = max_output_level;
+  } else if (sorted_runs_[end_index + 1].level == 0) {
+    output_level = 0;
   } else {
     // if it's not including all sorted_runs, it can only output to the level
     // above the `end_index + 1` sorted_run.
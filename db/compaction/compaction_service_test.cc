@@ -6,6 +6,7 @@
 
 #include "db/db_test_util.h"
 #include "port/stack_trace.h"
+#include "rocksdb/utilities/local_compaction_service.h"
 #include "table/unique_id_impl.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -165,6 +166,14 @@ class CompactionServiceTest : public DBTestBase {
   explicit CompactionServiceTest()
       : DBTestBase("compaction_service_test", true) {}
 
+  ~CompactionServiceTest() override {
+    // LocalCompactionService uses `env_` until it is destroyed, so make sure
+    // it is destroyed before `env_`.
+    Close();
+    last_options_.compaction_service.reset();
+    local_compaction_service_.reset();
+  }
+
  protected:
   void ReopenWithCompactionService(Options* options) {
     options->env = env_;
@@ -180,6 +189,24 @@ class CompactionServiceTest : public DBTestBase {
     CreateAndReopenWithCF({"cf_1", "cf_2", "cf_3"}, *options);
   }
 
+  void ReopenWithLocalCompactionService(
+      Options* options, LocalCompactionServiceOptions cs_options) {
+    options->env = env_;
+    compactor_statistics_ = CreateDBStatistics();
+    cs_options.options_override.env = env_;
+    cs_options.options_override.table_factory = options->table_factory;
+    cs_options.options_override.statistics = compactor_statistics_;
+
+    local_compaction_service_ = NewLocalCompactionService(cs_options);
+    options->compaction_service = local_compaction_service_;
+    DestroyAndReopen(*options);
+    CreateAndReopenWithCF({"cf_1", "cf_2", "cf_3"}, *options);
+  }
+
+  LocalCompactionService* GetLocalCompactionService() {
+    return local_compaction_service_.get();
+  }
+
   Statistics* GetCompactorStatistics() { return compactor_statistics_.get(); }
 
   Statistics* GetPrimaryStatistics() { return primary_statistics_.get(); }
@@ -240,6 +267,7 @@ class CompactionServiceTest : public DBTestBase {
   std::shared_ptr<Statistics> compactor_statistics_;
   std::shared_ptr<Statistics> primary_statistics_;
   std::shared_ptr<CompactionService> compaction_service_;
+  std::shared_ptr<LocalCompactionService> local_compaction_service_;
 };
 
 TEST_F(CompactionServiceTest, BasicCompactions) {
@@ -877,9 +905,164 @@ TEST_F(CompactionServiceTest, TablePropertiesCollector) {
   ASSERT_TRUE(has_user_property);
 }
 
+TEST_F(CompactionServiceTest, LocalCompactionService) {
+  Options options = CurrentOptions();
+  LocalCompactionServiceOptions cs_options;
+  cs_options.num_workers = 2;
+  ReopenWithLocalCompactionService(&options, cs_options);
+
+  GenerateTestData();
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  VerifyTestData();
+
+  LocalCompactionServiceStats stats = GetLocalCompactionService()->GetStats();
+  ASSERT_GE(stats.num_succeeded, 1);
+  ASSERT_EQ(stats.num_failed, 0);
+  ASSERT_EQ(stats.num_canceled, 0);
+  ASSERT_EQ(stats.num_retries, 0);
+  ASSERT_GE(GetCompactorStatistics()->getTickerCount(COMPACT_WRITE_BYTES), 1);
+
+  ReopenWithColumnFamilies({kDefaultColumnFamilyName, "cf_1", "cf_2", "cf_3"},
+                           options);
+  VerifyTestData();
+}
+
+TEST_F(CompactionServiceTest, LocalCompactionServiceRetry) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  LocalCompactionServiceOptions cs_options;
+  cs_options.max_retries = 1;
+  cs_options.fallback_to_local = false;
+  ReopenWithLocalCompactionService(&options, cs_options);
+  GenerateTestData();
+
+  // The first attempt of every job fails.
+  std::atomic_int attempts{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImplSecondary::CompactWithoutInstallation::End", [&](void* status) {
+        if (attempts++ % 2 == 0) {
+          *static_cast<Status*>(status) = Status::Aborted("injected");
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  VerifyTestData();
+  LocalCompactionServiceStats stats = GetLocalCompactionService()->GetStats();
+  ASSERT_GE(stats.num_succeeded, 1);
+  ASSERT_EQ(stats.num_retries, stats.num_succeeded);
+  ASSERT_EQ(stats.num_failed, 0);
+
+  // Every attempt fails, and the DB does not fall back to local compaction.
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImplSecondary::CompactWithoutInstallation::End", [&](void* status) {
+        *static_cast<Status*>(status) = Status::Aborted("injected");
+      });
+  Status s = db_->CompactRange(CompactRangeOptions(), handles_[1], nullptr,
+                               nullptr);
+  ASSERT_TRUE(s.IsAborted());
+  ASSERT_EQ(GetLocalCompactionService()->GetStats().num_failed, 1);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
+TEST_F(CompactionServiceTest, LocalCompactionServiceCancel) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  ReopenWithLocalCompactionService(&options, LocalCompactionServiceOptions());
+  GenerateTestData();
+
+  // Cancel the job while it is running, the DB then compacts locally.
+  SyncPoint::GetInstance()->SetCallBack(
+      "CompactionJob::Run():Inprogress",
+      [&](void* /*arg*/) { GetLocalCompactionService()->CancelAllJobs(); });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  VerifyTestData();
+  LocalCompactionServiceStats stats = GetLocalCompactionService()->GetStats();
+  ASSERT_EQ(stats.num_canceled, 1);
+  ASSERT_EQ(stats.num_succeeded, 0);
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Jobs scheduled after CancelAllJobs() run as usual.
+  ASSERT_OK(
+      db_->CompactRange(CompactRangeOptions(), handles_[1], nullptr, nullptr));
+  VerifyTestData();
+  stats = GetLocalCompactionService()->GetStats();
+  ASSERT_EQ(stats.num_canceled, 1);
+  ASSERT_GE(stats.num_succeeded, 1);
+}
+
+#ifdef OS_LINUX
+// Makes main() run as a worker process of LocalCompactionService.
+constexpr const char* kWorkerProcessFlag = "--local_compaction_service_worker";
+
+TEST_F(CompactionServiceTest, LocalCompactionServiceWorkerProcesses) {
+  if (env_->target() != Env::Default()) {
+    ROCKSDB_GTEST_SKIP("The worker processes use the default Env");
+    return;
+  }
+  Options options = CurrentOptions();
+  LocalCompactionServiceOptions cs_options;
+  cs_options.num_workers = 2;
+  cs_options.worker_command = {"/proc/self/exe", kWorkerProcessFlag};
+  ReopenWithLocalCompactionService(&options, cs_options);
+
+  GenerateTestData();
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  VerifyTestData();
+
+  LocalCompactionServiceStats stats = GetLocalCompactionService()->GetStats();
+  ASSERT_GE(stats.num_succeeded, 1);
+  ASSERT_EQ(stats.num_failed, 0);
+  ASSERT_EQ(stats.num_retries, 0);
+  // The compactions ran in the worker processes.
+  ASSERT_EQ(GetCompactorStatistics()->getTickerCount(COMPACT_WRITE_BYTES), 0);
+}
+
+TEST_F(CompactionServiceTest, LocalCompactionServiceWorkerProcessExits) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  LocalCompactionServiceOptions cs_options;
+  cs_options.max_retries = 1;
+  // Exits right away, like a worker process that crashes.
+  cs_options.worker_command = {"/bin/false"};
+  ReopenWithLocalCompactionService(&options, cs_options);
+  GenerateTestData();
+
+  // Each attempt starts a new process, then the DB compacts locally.
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  VerifyTestData();
+  LocalCompactionServiceStats stats = GetLocalCompactionService()->GetStats();
+  ASSERT_EQ(stats.num_failed, 1);
+  ASSERT_EQ(stats.num_retries, 1);
+  ASSERT_EQ(stats.num_succeeded, 0);
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+}
+#endif  // OS_LINUX
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
+#ifdef OS_LINUX
+  if (argc == 3 &&
+      strcmp(argv[1], ROCKSDB_NAMESPACE::kWorkerProcessFlag) == 0) {
+    ROCKSDB_NAMESPACE::CompactionServiceOptionsOverride options_override;
+    options_override.env = ROCKSDB_NAMESPACE::Env::Default();
+    options_override.table_factory.reset(
+        ROCKSDB_NAMESPACE::NewBlockBasedTableFactory());
+    return ROCKSDB_NAMESPACE::RunLocalCompactionServiceWorker(
+               atoi(argv[2]), options_override)
+                   .ok()
+               ? 0
+               : 1;
+  }
+#endif  // OS_LINUX
   ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
   ::testing::InitGoogleTest(&argc, argv);
   RegisterCustomObjects(argc, argv);
@@ -0,0 +1,219 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/compaction/pipelined_input_iterator.h"
+
+#include <algorithm>
+
+#include "monitoring/iostats_context_imp.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+PipelinedInputIterator::PipelinedInputIterator(InternalIterator* iter,
+                                               size_t max_buffered_bytes,
+                                               SystemClock* clock)
+    : iter_(iter),
+      // Besides the queued batches, one batch is being filled and one is
+      // being used.
+      batch_size_(std::max<size_t>(
+          max_buffered_bytes / (kMaxQueuedBatches + 2), 1)),
+      clock_(clock),
+      cv_(&mu_) {
+  assert(iter_);
+  assert(clock_);
+}
+
+PipelinedInputIterator::~PipelinedInputIterator() { Stop(); }
+
+void PipelinedInputIterator::Stop() {
+  {
+    MutexLock l(&mu_);
+    stop_ = true;
+    cv_.SignalAll();
+  }
+  if (reader_.joinable()) {
+    reader_.join();
+  }
+}
+
+void PipelinedInputIterator::Start(const Slice* target) {
+  batch_.reset();
+  pos_ = 0;
+  status_ = Status::OK();
+  bool start_reader;
+  {
+    MutexLock l(&mu_);
+    while (!queue_.empty()) {
+      queue_.front()->data.clear();
+      queue_.front()->entries.clear();
+      free_batches_.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+    }
+    // The reading thread drops whatever it reads for an earlier seek once it
+    // sees the new seek count.
+    ++seek_count_;
+    seek_target_ = target != nullptr ? target->ToString() : "";
+    seek_to_first_ = target == nullptr;
+    seek_pending_ = true;
+    reader_done_ = false;
+    reader_status_ = Status::OK();
+    start_reader = !reader_.joinable();
+    stop_ = false;
+    cv_.SignalAll();
+  }
+  if (start_reader) {
+    reader_ = port::Thread(&PipelinedInputIterator::ReadInput, this);
+  }
+  NextBatch();
+}
+
+void PipelinedInputIterator::Next() {
+  assert(Valid());
+  ++pos_;
+  if (pos_ == batch_->entries.size()) {
+    NextBatch();
+  }
+}
+
+void PipelinedInputIterator::NextBatch() {
+  std::unique_ptr<Batch> used = std::move(batch_);
+  if (used) {
+    used->data.clear();
+    used->entries.clear();
+  }
+  pos_ = 0;
+  MutexLock l(&mu_);
+  if (used) {
+    free_batches_.push_back(std::move(used));
+  }
+  while (queue_.empty() && !reader_done_) {
+    cv_.Wait();
+  }
+  if (!queue_.empty()) {
+    batch_ = std::move(queue_.front());
+    queue_.pop_front();
+    cv_.SignalAll();
+  } else {
+    status_ = reader_status_;
+  }
+}
+
+std::unique_ptr<PipelinedInputIterator::Batch>
+PipelinedInputIterator::NewBatch() {
+  {
+    MutexLock l(&mu_);
+    if (!free_batches_.empty()) {
+      std::unique_ptr<Batch> batch = std::move(free_batches_.back());
+      free_batches_.pop_back();
+      return batch;
+    }
+  }
+  auto batch = std::make_unique<Batch>();
+  batch->data.reserve(batch_size_);
+  return batch;
+}
+
+bool PipelinedInputIterator::PushBatch(std::unique_ptr<Batch>&& batch,
+                                       uint64_t seek_count) {
+  assert(batch && !batch->entries.empty());
+  MutexLock l(&mu_);
+  while (queue_.size() >= kMaxQueuedBatches && !stop_ &&
+         seek_count == seek_count_) {
+    cv_.Wait();
+  }
+  if (stop_ || seek_count != seek_count_) {
+    batch->data.clear();
+    batch->entries.clear();
+    free_batches_.push_back(std::move(batch));
+    return false;
+  }
+  queue_.push_back(std::move(batch));
+  cv_.SignalAll();
+  return true;
+}
+
+void PipelinedInputIterator::ReadInput() {
+  while (true) {
+    uint64_t seek_count;
+    std::string target;
+    bool seek_to_first;
+    {
+      MutexLock l(&mu_);
+      while (!seek_pending_ && !stop_) {
+        cv_.Wait();
+      }
+      if (stop_) {
+        reader_done_ = true;
+        cv_.SignalAll();
+        return;
+      }
+      seek_pending_ = false;
+      seek_count = seek_count_;
+      target = seek_target_;
+      seek_to_first = seek_to_first_;
+    }
+
+    const uint64_t start_cpu_micros = clock_->CPUMicros();
+    if (seek_to_first) {
+      iter_->SeekToFirst();
+    } else {
+      iter_->Seek(target);
+    }
+    ReadSought(seek_count);
+
+    // Reads and CPU time of this thread are not seen by the compaction's own
+    // accounting, so report them separately.
+    bytes_read_.fetch_add(IOSTATS(bytes_read), std::memory_order_relaxed);
+    IOSTATS_RESET(bytes_read);
+    cpu_micros_.fetch_add(clock_->CPUMicros() - start_cpu_micros,
+                          std::memory_order_relaxed);
+  }
+}
+
+void PipelinedInputIterator::ReadSought(uint64_t seek_count) {
+  std::unique_ptr<Batch> batch = NewBatch();
+  while (iter_->Valid()) {
+    const Slice key = iter_->key();
+    const Slice value = iter_->value();
+    Entry entry;
+    entry.key_offset = batch->data.size();
+    entry.key_size = key.size();
+    batch->data.append(key.data(), key.size());
+    entry.value_offset = batch->data.size();
+    entry.value_size = value.size();
+    batch->data.append(value.data(), value.size());
+    entry.is_delete_range_sentinel = iter_->IsDeleteRangeSentinelKey();
+    batch->entries.push_back(entry);
+    if (batch->data.size() >= batch_size_) {
+      if (!PushBatch(std::move(batch), seek_count)) {
+        return;
+      }
+      batch = NewBatch();
+    }
+    iter_->Next();
+  }
+
+  Status s = iter_->status();
+  if (!batch->entries.empty() && !PushBatch(std::move(batch), seek_count)) {
+    return;
+  }
+  MutexLock l(&mu_);
+  if (seek_count == seek_count_) {
+    reader_status_ = s;
+    reader_done_ = true;
+    cv_.SignalAll();
+  }
+}
+
+void PipelinedInputIterator::NotSupported(const char* op) {
+  Stop();
+  batch_.reset();
+  pos_ = 0;
+  status_ = Status::NotSupported(op, "not supported by PipelinedInputIterator");
+}
+
+}  // namespace ROCKSDB_NAMESPACE
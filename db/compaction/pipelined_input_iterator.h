@@ -0,0 +1,163 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/system_clock.h"
+#include "table/internal_iterator.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// An internal iterator that reads ahead of its user: a dedicated thread
+// iterates the wrapped iterator forward and hands the entries over in
+// batches of copied keys and values, so that reading, decompressing and
+// merging the compaction input overlaps with processing it. At most about
+// `max_buffered_bytes` of entries are buffered.
+//
+// Only forward iteration is supported. Seek() and SeekToFirst() drop the
+// buffered entries and hand the target over to the reading thread, which is
+// started by the first of them and then kept for the iterator's lifetime.
+// The wrapped iterator must outlive this iterator and must
+// not be used by anyone else while this iterator is alive. Anything it
+// touches while iterating (e.g. a range deletion aggregator it adds
+// tombstones to) must be safe to use from another thread.
+class PipelinedInputIterator : public InternalIterator {
+ public:
+  PipelinedInputIterator(InternalIterator* iter, size_t max_buffered_bytes,
+                         SystemClock* clock);
+  ~PipelinedInputIterator() override;
+
+  bool Valid() const override {
+    return batch_ != nullptr && pos_ < batch_->entries.size();
+  }
+
+  void SeekToFirst() override { Start(nullptr); }
+
+  void Seek(const Slice& target) override { Start(&target); }
+
+  void SeekForPrev(const Slice& /* target */) override {
+    NotSupported("SeekForPrev");
+  }
+
+  void SeekToLast() override { NotSupported("SeekToLast"); }
+
+  void Next() override;
+
+  void Prev() override { NotSupported("Prev"); }
+
+  Slice key() const override {
+    assert(Valid());
+    const Entry& entry = batch_->entries[pos_];
+    return Slice(batch_->data.data() + entry.key_offset, entry.key_size);
+  }
+
+  Slice value() const override {
+    assert(Valid());
+    const Entry& entry = batch_->entries[pos_];
+    return Slice(batch_->data.data() + entry.value_offset, entry.value_size);
+  }
+
+  Status status() const override { return status_; }
+
+  bool IsDeleteRangeSentinelKey() const override {
+    assert(Valid());
+    return batch_->entries[pos_].is_delete_range_sentinel;
+  }
+
+  // Stops the reading thread. The current entry, if any, stays valid; the
+  // iterator becomes invalid after the already buffered entries.
+  void Stop();
+
+  // The number of bytes read from files, and the CPU time spent, by the
+  // reading thread so far. Only accurate once the thread is stopped or done
+  // with the last seek.
+  uint64_t GetBytesRead() const {
+    return bytes_read_.load(std::memory_order_relaxed);
+  }
+  uint64_t GetCpuMicros() const {
+    return cpu_micros_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Entry {
+    size_t key_offset;
+    size_t key_size;
+    size_t value_offset;
+    size_t value_size;
+    bool is_delete_range_sentinel;
+  };
+
+  // Keys and values of consecutive entries, stored back to back in `data`.
+  struct Batch {
+    std::string data;
+    std::vector<Entry> entries;
+  };
+
+  void Start(const Slice* target);
+  // Body of the reading thread: waits for a seek, then reads from its target
+  // until the end of the input, the next seek or Stop().
+  void ReadInput();
+  // Reads the input for seek number `seek_count` from the current position of
+  // `iter_`, until its end or until the iterator is sought again or stopped.
+  void ReadSought(uint64_t seek_count);
+  // Hands a non-empty batch over to the user, waiting for room in the queue.
+  // Returns false if the iterator is being stopped or sought again since
+  // seek number `seek_count`; the batch is then dropped.
+  bool PushBatch(std::unique_ptr<Batch>&& batch, uint64_t seek_count);
+  std::unique_ptr<Batch> NewBatch();
+  // Moves to the next batch, waiting for the reading thread to produce it.
+  void NextBatch();
+  void NotSupported(const char* op);
+
+  // The number of full batches the reading thread may get ahead of the user.
+  static constexpr size_t kMaxQueuedBatches = 4;
+
+  InternalIterator* const iter_;
+  const size_t batch_size_;
+  SystemClock* const clock_;
+
+  port::Mutex mu_;
+  port::CondVar cv_;
+  // Batches produced but not yet used. Guarded by `mu_`.
+  std::deque<std::unique_ptr<Batch>> queue_;
+  // Used batches, kept for reuse. Guarded by `mu_`.
+  std::vector<std::unique_ptr<Batch>> free_batches_;
+  // Set by the reading thread once it is done with the latest seek. Guarded
+  // by `mu_`.
+  bool reader_done_ = true;
+  // Status of the wrapped iterator when the reading thread is done. Guarded
+  // by `mu_`.
+  Status reader_status_;
+  // The number of seeks so far, and the target of the latest one (empty for
+  // SeekToFirst()). Guarded by `mu_`.
+  uint64_t seek_count_ = 0;
+  std::string seek_target_;
+  bool seek_to_first_ = false;
+  // The latest seek is not picked up by the reading thread yet. Guarded by
+  // `mu_`.
+  bool seek_pending_ = false;
+  // Asks the reading thread to stop. Guarded by `mu_`.
+  bool stop_ = false;
+  port::Thread reader_;
+
+  std::atomic<uint64_t> bytes_read_{0};
+  std::atomic<uint64_t> cpu_micros_{0};
+
+  // The batch of the current entry, owned by the user's thread.
+  std::unique_ptr<Batch> batch_;
+  size_t pos_ = 0;
+  Status status_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -1149,6 +1149,62 @@ TEST_F(DBBasicTest, MultiGetEmpty) {
   } while (ChangeCompactOptions());
 }
 
+TEST_F(DBBasicTest, MultiGetPrefetchDistance) {
+  for (auto index_type :
+       {BlockBasedTableOptions::kDataBlockBinarySearch,
+        BlockBasedTableOptions::kDataBlockBinaryAndHash}) {
+    Options options = CurrentOptions();
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 256;
+    table_options.data_block_index_type = index_type;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    DestroyAndReopen(options);
+
+    Random rnd(301);
+    std::vector<std::string> expected;
+    for (int i = 0; i < 200; ++i) {
+      expected.push_back(rnd.RandomString(40));
+      ASSERT_OK(Put(Key(i * 2), expected.back()));
+    }
+    ASSERT_OK(Flush());
+
+    // Keys spread over many data blocks, including some absent keys and
+    // several keys per block
+    std::vector<std::string> key_bufs;
+    for (int i = 0; i < 400; i += 3) {
+      key_bufs.push_back(Key(i));
+    }
+    std::vector<Slice> keys(key_bufs.begin(), key_bufs.end());
+
+    for (size_t distance : {0, 1, 4, 64}) {
+      ReadOptions ro;
+      ro.multiget_prefetch_distance = distance;
+      std::vector<PinnableSlice> values(keys.size());
+      std::vector<Status> statuses(keys.size());
+      SetPerfLevel(kEnableTimeExceptForMutex);
+      get_perf_context()->Reset();
+      db_->MultiGet(ro, db_->DefaultColumnFamily(), keys.size(), keys.data(),
+                    values.data(), statuses.data());
+      for (size_t j = 0; j < keys.size(); ++j) {
+        int i = static_cast<int>(j) * 3;
+        if (i % 2 == 0) {
+          ASSERT_OK(statuses[j]);
+          ASSERT_EQ(values[j], expected[i / 2]);
+        } else {
+          ASSERT_TRUE(statuses[j].IsNotFound());
+        }
+      }
+      if (distance == 0) {
+        ASSERT_EQ(get_perf_context()->multiget_prefetch_count, 0);
+      } else {
+        ASSERT_GT(get_perf_context()->multiget_prefetch_count, 0);
+      }
+      ASSERT_GT(get_perf_context()->multiget_block_probe_nanos, 0);
+      SetPerfLevel(kDisable);
+    }
+  }
+}
+
 class DBBlockChecksumTest : public DBBasicTest,
                             public testing::WithParamInterface<uint32_t> {};
 
@@ -10403,6 +10403,57 @@ TEST_F(DBCompactionTest, NumberOfSubcompactions) {
   }
 }
 
+TEST_F(DBCompactionTest, SubcompactionRangesPerThread) {
+  // Tests that a compaction is split into more subcompactions than threads,
+  // which are run by at most max_subcompactions threads.
+  class SubCompactionEventListener : public EventListener {
+   public:
+    void OnSubcompactionBegin(const SubcompactionJobInfo& info) override {
+      std::lock_guard<std::mutex> lock(mutex_);
+      thread_ids_.insert(info.thread_id);
+    }
+    void OnSubcompactionCompleted(const SubcompactionJobInfo&) override {
+      sub_compaction_finished_++;
+    }
+    std::atomic<int> sub_compaction_finished_{0};
+    std::mutex mutex_;
+    std::set<uint64_t> thread_ids_;
+  };
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleLevel;
+  options.compression = kNoCompression;
+  options.target_file_size_base = 100 << 10;  // 100KB
+  options.level0_file_num_compaction_trigger = 2;
+  options.max_subcompactions = 2;
+  options.subcompaction_ranges_per_thread = 4;
+  auto* listener = new SubCompactionEventListener();
+  options.listeners.emplace_back(listener);
+  DestroyAndReopen(options);
+
+  // ~10MB in total, enough for 8 subcompactions of at least one target file
+  // size each
+  const int kValueSize = 500;
+  const int kNumKeyPerFile = 10000;
+  Random rnd(301);
+  std::vector<std::string> values(2 * kNumKeyPerFile);
+  for (int file = 0; file < 2; ++file) {
+    for (int key = file; key < 2 * kNumKeyPerFile; key += 2) {
+      values[key] = rnd.RandomString(kValueSize);
+      ASSERT_OK(Put(Key(key), values[key]));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+
+  ASSERT_GT(listener->sub_compaction_finished_, 2);
+  ASSERT_LE(listener->sub_compaction_finished_, 8);
+  ASSERT_LE(listener->thread_ids_.size(), 2);
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+  for (int key = 0; key < 2 * kNumKeyPerFile; ++key) {
+    ASSERT_EQ(Get(Key(key)), values[key]);
+  }
+}
+
 TEST_F(DBCompactionTest, VerifyRecordCount) {
   Options options = CurrentOptions();
   options.compaction_style = kCompactionStyleLevel;
@@ -10622,6 +10673,76 @@ TEST_F(DBCompactionTest, ReleaseCompactionDuringManifestWrite) {
   SyncPoint::GetInstance()->ClearAllCallBacks();
 }
 
+TEST_F(DBCompactionTest, PipelinedCompactionInput) {
+  // Drops the keys [Key(k), Key(k + 10)) for every multiple k of 100 whose
+  // newest version is a value, through range skips.
+  class SkipRangeFilter : public CompactionFilter {
+   public:
+    Decision FilterV2(int /*level*/, const Slice& key,
+                      ValueType /*value_type*/,
+                      const Slice& /*existing_value*/,
+                      std::string* /*new_value*/,
+                      std::string* skip_until) const override {
+      const int k = std::stoi(key.ToString().substr(3));
+      if (k % 100 == 0) {
+        *skip_until = Key(k + 10);
+        return Decision::kRemoveAndSkipUntil;
+      }
+      return Decision::kKeep;
+    }
+
+    const char* Name() const override { return "SkipRangeFilter"; }
+  };
+  SkipRangeFilter filter;
+
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  // Small enough for the input to be handed over in many batches
+  options.compaction_pipelined_input_size = 4 << 10;
+  options.compaction_filter = &filter;
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+
+  constexpr int kNumKeys = 2000;
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  for (int f = 0; f < 4; ++f) {
+    for (int i = 0; i < 1000; ++i) {
+      const int k = static_cast<int>(rnd.Uniform(kNumKeys));
+      if (rnd.OneIn(5)) {
+        ASSERT_OK(Delete(Key(k)));
+        expected.erase(Key(k));
+      } else {
+        std::string value = rnd.RandomString(50);
+        ASSERT_OK(Put(Key(k), value));
+        expected[Key(k)] = value;
+      }
+    }
+    ASSERT_OK(Flush());
+  }
+  for (int k = 0; k < kNumKeys; k += 100) {
+    if (expected.count(Key(k)) > 0) {
+      expected.erase(expected.lower_bound(Key(k)),
+                     expected.lower_bound(Key(k + 10)));
+    }
+  }
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+  // Reads done by the input thread are accounted to the compaction
+  ASSERT_GT(TestGetTickerCount(options, COMPACT_READ_BYTES), 0);
+
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  auto expected_it = expected.begin();
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected_it) {
+    ASSERT_TRUE(expected_it != expected.end());
+    ASSERT_EQ(iter->key(), expected_it->first);
+    ASSERT_EQ(iter->value(), expected_it->second);
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_TRUE(expected_it == expected.end());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
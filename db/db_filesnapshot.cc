@@ -483,6 +483,22 @@ Status DBImpl::GetLiveFilesStorageInfo(
         info.file_checksum_func_name = kUnknownFileChecksumFuncName;
         info.file_checksum = kUnknownFileChecksum;
       }
+      if (has_wal_streams_) {
+        // The companion stream of the WAL (see wal_per_write_queue) is
+        // always copied, as it may still be open for write.
+        const std::string stream_fname =
+            LogStreamFileName(wal_dir, info.file_number, /*stream=*/1);
+        uint64_t stream_size = 0;
+        if (fs_->GetFileSize(stream_fname, IOOptions(), &stream_size, nullptr)
+                .ok()) {
+          LiveFileStorageInfo stream_info = info;
+          stream_info.relative_filename =
+              stream_fname.substr(stream_fname.rfind('/') + 1);
+          stream_info.size = stream_size;
+          stream_info.trim_to_size = true;
+          results.push_back(std::move(stream_info));
+        }
+      }
     }
   }
 
@@ -35,6 +35,70 @@ class DBFlushTest : public DBTestBase {
   DBFlushTest() : DBTestBase("db_flush_test", /*env_do_fsync=*/true) {}
 };
 
+TEST_F(DBFlushTest, PartitionedFlush) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.max_flush_partitions = 4;
+  DestroyAndReopen(options);
+
+  constexpr int kNumKeys = 2000;
+  Random rnd(301);
+  std::vector<std::string> values(kNumKeys);
+  for (int k = 0; k < kNumKeys; ++k) {
+    values[k] = rnd.RandomString(100);
+    ASSERT_OK(Put(Key(k), values[k]));
+  }
+  ASSERT_OK(Flush());
+
+  // The flush wrote one L0 file per partition, with disjoint key ranges and
+  // the same epoch number
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_GT(files.size(), 1);
+  ASSERT_LE(files.size(), 4);
+  ASSERT_EQ(NumTableFilesAtLevel(0), static_cast<int>(files.size()));
+  std::sort(files.begin(), files.end(),
+            [](const LiveFileMetaData& a, const LiveFileMetaData& b) {
+              return a.smallestkey < b.smallestkey;
+            });
+  ASSERT_EQ(files.front().smallestkey, Key(0));
+  ASSERT_EQ(files.back().largestkey, Key(kNumKeys - 1));
+  for (size_t i = 1; i < files.size(); ++i) {
+    ASSERT_LT(files[i - 1].largestkey, files[i].smallestkey);
+    ASSERT_EQ(files[i - 1].epoch_number, files[i].epoch_number);
+  }
+
+  auto verify = [&]() {
+    for (int k = 0; k < kNumKeys; ++k) {
+      ASSERT_EQ(Get(Key(k)), values[k]);
+    }
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(iter->key(), Key(count));
+      ASSERT_EQ(iter->value(), values[count]);
+      ++count;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, kNumKeys);
+  };
+  verify();
+  Reopen(options);
+  verify();
+
+  // Range deletions disable partitioning
+  for (int k = 0; k < kNumKeys; ++k) {
+    values[k] = rnd.RandomString(100);
+    ASSERT_OK(Put(Key(k), values[k]));
+  }
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(kNumKeys), Key(kNumKeys + 1)));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumTableFilesAtLevel(0), static_cast<int>(files.size()) + 1);
+  verify();
+}
+
 class DBFlushDirectIOTest : public DBFlushTest,
                             public ::testing::WithParamInterface<bool> {
  public:
@@ -1879,6 +1943,139 @@ TEST_F(DBFlushTest, MemPurgeCorrectLogNumberAndSSTFileCreation) {
   Close();
 }
 
+TEST_F(DBFlushTest, MemtableResident) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.statistics = CreateDBStatistics();
+  options.write_buffer_size = 1 << 20;
+  options.memtable_resident = true;
+  options.disable_auto_compactions = true;
+  ASSERT_OK(TryReopen(options));
+
+  std::atomic<uint32_t> mempurge_count{0};
+  std::atomic<uint32_t> sst_count{0};
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::FlushJob:MemPurgeSuccessful",
+      [&](void* /*arg*/) { mempurge_count++; });
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::FlushJob:SSTFileCreated", [&](void* /*arg*/) { sst_count++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // Overwrite a small set of keys many times, filling several write buffers
+  constexpr int kNumKeys = 10;
+  Random rnd(301);
+  std::vector<std::string> values(kNumKeys);
+  for (int i = 0; i < 50; ++i) {
+    for (int k = 0; k < kNumKeys; ++k) {
+      values[k] = rnd.RandomString(10 << 10);
+      ASSERT_OK(Put(Key(k), values[k]));
+    }
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForBackgroundWork());
+
+  // The full write buffers were purged instead of being written to L0
+  ASSERT_GE(mempurge_count.load(), 1);
+  ASSERT_EQ(sst_count.load(), 0);
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+
+  // A manual flush is a checkpoint
+  ASSERT_OK(Flush());
+  ASSERT_EQ(sst_count.load(), 1);
+  ASSERT_EQ(NumTableFilesAtLevel(0), 1);
+
+  // Lookups of existing keys are still served from memory
+  uint64_t hits = TestGetTickerCount(options, MEMTABLE_HIT);
+  uint64_t misses = TestGetTickerCount(options, MEMTABLE_MISS);
+  for (int k = 0; k < kNumKeys; ++k) {
+    ASSERT_EQ(Get(Key(k)), values[k]);
+  }
+  ASSERT_EQ(TestGetTickerCount(options, MEMTABLE_HIT), hits + kNumKeys);
+  ASSERT_EQ(TestGetTickerCount(options, MEMTABLE_MISS), misses);
+  ASSERT_EQ(Get(Key(kNumKeys)), "NOT_FOUND");
+  ASSERT_EQ(TestGetTickerCount(options, MEMTABLE_MISS), misses + 1);
+
+  // Newer checkpoints shadow the older retained memtables
+  ASSERT_OK(Delete(Key(0)));
+  ASSERT_OK(Put(Key(1), "new"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(NumTableFilesAtLevel(0), 2);
+  ASSERT_EQ(Get(Key(0)), "NOT_FOUND");
+  ASSERT_EQ(Get(Key(1)), "new");
+  ASSERT_EQ(Get(Key(2)), values[2]);
+
+  // Ingested files could be shadowed by the retained memtables
+  std::string ext_file = dbname_ + "/ext.sst";
+  SstFileWriter writer(EnvOptions(), options);
+  ASSERT_OK(writer.Open(ext_file));
+  ASSERT_OK(writer.Put(Key(2), "ingested"));
+  ASSERT_OK(writer.Finish());
+  ASSERT_TRUE(db_->IngestExternalFile({ext_file}, IngestExternalFileOptions())
+                  .IsNotSupported());
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  Reopen(options);
+  ASSERT_EQ(Get(Key(0)), "NOT_FOUND");
+  ASSERT_EQ(Get(Key(1)), "new");
+  for (int k = 2; k < kNumKeys; ++k) {
+    ASSERT_EQ(Get(Key(k)), values[k]);
+  }
+  Close();
+}
+
+TEST_F(DBFlushTest, MemtableResidentDropsStaleHistory) {
+  class DropKeyFilter : public CompactionFilter {
+   public:
+    bool Filter(int /*level*/, const Slice& key, const Slice& /*value*/,
+                std::string* /*new_value*/,
+                bool* /*value_changed*/) const override {
+      return key == "filtered";
+    }
+    const char* Name() const override { return "DropKeyFilter"; }
+  };
+  DropKeyFilter filter;
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.memtable_resident = true;
+  options.disable_auto_compactions = true;
+  options.compaction_filter = &filter;
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("filtered", "v"));
+  ASSERT_OK(Put("kept", "v"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(Get("filtered"), "v");
+
+  // The compaction filter drops the key from the SST file, so the retained
+  // memtable must not return it anymore.
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(Get("filtered"), "NOT_FOUND");
+  ASSERT_EQ(Get("kept"), "v");
+
+  options.compaction_filter = nullptr;
+  Reopen(options);
+
+  // Range deletions are writes, so the retained memtables see them.
+  ASSERT_OK(Put("ranged", "v"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             "range", "rangez"));
+  ASSERT_OK(Flush());
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  ASSERT_EQ(Get("ranged"), "NOT_FOUND");
+
+  // Files deleted by DeleteFilesInRange() take the retained memtables along.
+  ASSERT_OK(Put("deleted", "v"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  ASSERT_EQ(Get("deleted"), "v");
+  ASSERT_OK(DeleteFilesInRange(db_, db_->DefaultColumnFamily(), nullptr,
+                               nullptr));
+  ASSERT_EQ(Get("deleted"), "NOT_FOUND");
+  Close();
+}
+
 TEST_P(DBFlushDirectIOTest, DirectIO) {
   Options options;
   options.create_if_missing = true;
@@ -13,10 +13,12 @@
 #include <alloca.h>
 #endif
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -196,6 +198,7 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       shutting_down_(false),
       reject_new_background_jobs_(false),
       db_lock_(nullptr),
+      has_wal_streams_(immutable_db_options_.wal_per_write_queue),
       manual_compaction_paused_(false),
       bg_cv_(&mutex_),
       logfile_number_(0),
@@ -1586,6 +1589,7 @@ IOStatus DBImpl::SyncWalImpl(bool include_current_wal,
                              bool error_recovery_in_prog) {
   autovector<log::Writer*, 1> wals_to_sync;
   bool need_wal_dir_sync;
+  bool wait_for_wal_stream;
   // Number of a WAL that was active at the start of call and maybe is by
   // the end of the call.
   uint64_t maybe_active_number;
@@ -1623,9 +1627,24 @@ IOStatus DBImpl::SyncWalImpl(bool include_current_wal,
       if (log.writer->file()) {
         wals_to_sync.push_back(log.writer);
       }
+      if (log.stream_writer != nullptr && log.stream_writer->file()) {
+        wals_to_sync.push_back(log.stream_writer);
+      }
     }
 
     need_wal_dir_sync = !log_dir_synced_;
+    wait_for_wal_stream =
+        include_current_wal && logs_.back().stream_writer != nullptr;
+  }
+
+  if (wait_for_wal_stream) {
+    // A write of the nonmem queue may have allocated its sequence number
+    // before the writes synced here, but not appended its record to the
+    // stream yet. Wait for it, so that the sync covers every sequence number
+    // up to the last one synced in either stream, and a crash cannot leave a
+    // hole in the writes recovered from the synced data.
+    TEST_SYNC_POINT("DBImpl::SyncWalImpl:BeforeWaitForWALStream");
+    InstrumentedMutexLock l(&wal_stream_mutex_);
   }
 
   if (include_current_wal) {
@@ -1840,6 +1859,9 @@ void DBImpl::MarkLogsSynced(uint64_t up_to, bool synced_dir,
            wal.GetPreSyncSize() == wal.writer->file()->GetFlushedSize())) {
         // Fully synced
         logs_to_free_.push_back(wal.ReleaseWriter());
+        if (wal.stream_writer != nullptr) {
+          logs_to_free_.push_back(wal.ReleaseStreamWriter());
+        }
         it = logs_.erase(it);
       } else {
         wal.FinishSync();
@@ -2456,6 +2478,35 @@ Status DBImpl::GetImpl(const ReadOptions& read_options, const Slice& key,
         }
 
         RecordTick(stats_, MEMTABLE_HIT);
+      } else if (s.ok() && cfd->ioptions()->memtable_resident &&
+                 get_impl_options.callback == nullptr) {
+        // Flushed memtables retained by memtable resident column families
+        // hold the latest version of any key they contain, as they are
+        // dropped whenever SST files lose or change data other than through
+        // newer writes (see DropMemtableResidentHistory()). Only a final
+        // result is used from them, as the operands of a merge in progress
+        // are also present in the SST files.
+        Status history_s;
+        MergeContext history_merge_context;
+        SequenceNumber history_max_covering_tombstone_seq =
+            max_covering_tombstone_seq;
+        if (sv->imm->GetFromHistory(
+                lkey,
+                get_impl_options.value ? get_impl_options.value->GetSelf()
+                                       : nullptr,
+                get_impl_options.columns, timestamp, &history_s,
+                &history_merge_context, &history_max_covering_tombstone_seq,
+                read_options, get_impl_options.is_blob_index)) {
+          done = true;
+          s = history_s;
+          merge_context = std::move(history_merge_context);
+
+          if (get_impl_options.value) {
+            get_impl_options.value->PinSelf();
+          }
+
+          RecordTick(stats_, MEMTABLE_HIT);
+        }
       }
     } else {
       // Get Merge Operands associated with key, Merge Operands should not be
@@ -3002,6 +3053,53 @@ void DB::MultiGet(const ReadOptions& options, ColumnFamilyHandle* column_family,
   }
 }
 
+Status DB::MultiScan(
+    const ReadOptions& options, ColumnFamilyHandle* column_family,
+    const std::vector<ScanRange>& ranges,
+    const std::function<bool(size_t, const Slice&, const Slice&)>& callback) {
+  if (options.iter_start_ts != nullptr) {
+    return Status::NotSupported("MultiScan does not support iter_start_ts");
+  }
+  if (ranges.empty()) {
+    return Status::OK();
+  }
+  assert(column_family);
+  const Comparator* ucmp = column_family->GetComparator();
+  assert(ucmp);
+
+  std::vector<size_t> order(ranges.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return ucmp->CompareWithoutTimestamp(ranges[a].start, /*a_has_ts=*/false,
+                                         ranges[b].start,
+                                         /*b_has_ts=*/false) < 0;
+  });
+  std::vector<ScanRange> sorted_ranges;
+  sorted_ranges.reserve(ranges.size());
+  for (size_t idx : order) {
+    sorted_ranges.push_back(ranges[idx]);
+  }
+
+  std::unique_ptr<Iterator> iter(NewIterator(options, column_family));
+  iter->Prepare(sorted_ranges);
+  for (size_t i = 0; i < sorted_ranges.size(); ++i) {
+    const ScanRange& range = sorted_ranges[i];
+    for (iter->Seek(range.start); iter->Valid(); iter->Next()) {
+      if (ucmp->CompareWithoutTimestamp(iter->key(), /*a_has_ts=*/false,
+                                        range.limit, /*b_has_ts=*/false) >= 0) {
+        break;
+      }
+      if (!callback(order[i], iter->key(), iter->value())) {
+        break;
+      }
+    }
+    if (!iter->status().ok()) {
+      break;
+    }
+  }
+  return iter->status();
+}
+
 void DBImpl::MultiGetCommon(const ReadOptions& read_options,
                             ColumnFamilyHandle* column_family,
                             const size_t num_keys, const Slice* keys,
@@ -4762,6 +4860,10 @@ Status DBImpl::GetUpdatesSince(
         "This API is not yet compatible with write-prepared/write-unprepared "
         "transactions");
   }
+  if (has_wal_streams_) {
+    return Status::NotSupported(
+        "This API is not yet compatible with wal_per_write_queue");
+  }
   if (seq > versions_->LastSequence()) {
     return Status::NotFound("Requested sequence not yet written in the db");
   }
@@ -4855,6 +4957,7 @@ Status DBImpl::DeleteFile(std::string name) {
                                     read_options, write_options, &edit, &mutex_,
                                     directories_.GetDbDir());
     if (status.ok()) {
+      DropMemtableResidentHistory(cfd, &job_context);
       InstallSuperVersionAndScheduleWork(
           cfd, job_context.superversion_contexts.data(),
           *cfd->GetLatestMutableCFOptions());
@@ -4968,6 +5071,7 @@ Status DBImpl::DeleteFilesInRanges(ColumnFamilyHandle* column_family,
                                     read_options, write_options, &edit, &mutex_,
                                     directories_.GetDbDir());
     if (status.ok()) {
+      DropMemtableResidentHistory(cfd, &job_context);
       InstallSuperVersionAndScheduleWork(
           cfd, job_context.superversion_contexts.data(),
           *cfd->GetLatestMutableCFOptions());
@@ -5263,14 +5367,13 @@ Status DestroyDB(const std::string& dbname, const Options& options,
           type != kDBLockFile) {  // Lock file will be deleted at end
         Status del;
         std::string path_to_delete = dbname + "/" + fname;
+        const bool is_wal = type == kWalFile || type == kWalStreamFile;
         if (type == kMetaDatabase) {
           del = DestroyDB(path_to_delete, options);
-        } else if (type == kTableFile || type == kWalFile ||
-                   type == kBlobFile) {
-          del = DeleteDBFile(
-              &soptions, path_to_delete, dbname,
-              /*force_bg=*/false,
-              /*force_fg=*/(type == kWalFile) ? !wal_in_db_path : false);
+        } else if (type == kTableFile || is_wal || type == kBlobFile) {
+          del = DeleteDBFile(&soptions, path_to_delete, dbname,
+                             /*force_bg=*/false,
+                             /*force_fg=*/is_wal ? !wal_in_db_path : false);
         } else {
           del = env->DeleteFile(path_to_delete);
         }
@@ -5350,11 +5453,11 @@ Status DestroyDB(const std::string& dbname, const Options& options,
     // Delete log files in the WAL dir
     if (wal_dir_exists) {
       for (const auto& file : walDirFiles) {
-        if (ParseFileName(file, &number, &type) && type == kWalFile) {
-          Status del =
-              DeleteDBFile(&soptions, LogFileName(soptions.wal_dir, number),
-                           soptions.wal_dir, /*force_bg=*/false,
-                           /*force_fg=*/!wal_in_db_path);
+        if (ParseFileName(file, &number, &type) &&
+            (type == kWalFile || type == kWalStreamFile)) {
+          Status del = DeleteDBFile(&soptions, soptions.wal_dir + "/" + file,
+                                    soptions.wal_dir, /*force_bg=*/false,
+                                    /*force_fg=*/!wal_in_db_path);
           if (!del.ok() && result.ok()) {
             result = del;
           }
@@ -5801,6 +5904,14 @@ Status DBImpl::IngestExternalFiles(
   }
   for (const auto& arg : args) {
     const IngestExternalFileOptions& ingest_opts = arg.options;
+    auto* cfh = static_cast<ColumnFamilyHandleImpl*>(arg.column_family);
+    if (cfh->cfd()->ioptions()->memtable_resident &&
+        !ingest_opts.ingest_behind) {
+      // Lookups could be served stale data by retained flushed memtables
+      return Status::NotSupported(
+          "Column family with memtable_resident enabled only supports "
+          "ingest behind.");
+    }
     if (ingest_opts.ingest_behind) {
       if (!immutable_db_options_.allow_ingest_behind) {
         return Status::InvalidArgument(
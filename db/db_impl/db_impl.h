@@ -1670,6 +1670,8 @@ class DBImpl : public DB {
   friend class DBImplFollower;
 #ifndef NDEBUG
   friend class DBTest_ConcurrentFlushWAL_Test;
+  friend class DBWALTest_WalPerWriteQueue_Test;
+  friend class DBWALTest_WalPerWriteQueueSyncCoversEarlierStreamWrites_Test;
   friend class DBTest_MixedSlowdownOptionsStop_Test;
   friend class DBCompactionTest_CompactBottomLevelFilesWithDeletions_Test;
   friend class DBCompactionTest_CompactionDuringShutdown_Test;
@@ -1712,15 +1714,21 @@ class DBImpl : public DB {
   };
 
   struct LogWriterNumber {
-    // pass ownership of _writer
-    LogWriterNumber(uint64_t _number, log::Writer* _writer)
-        : number(_number), writer(_writer) {}
+    // pass ownership of _writer and _stream_writer
+    LogWriterNumber(uint64_t _number, log::Writer* _writer,
+                    log::Writer* _stream_writer = nullptr)
+        : number(_number), writer(_writer), stream_writer(_stream_writer) {}
 
     log::Writer* ReleaseWriter() {
       auto* w = writer;
       writer = nullptr;
       return w;
     }
+    log::Writer* ReleaseStreamWriter() {
+      auto* w = stream_writer;
+      stream_writer = nullptr;
+      return w;
+    }
     Status ClearWriter() {
       Status s;
       if (writer->file()) {
@@ -1729,6 +1737,16 @@ class DBImpl : public DB {
       }
       delete writer;
       writer = nullptr;
+      if (stream_writer != nullptr) {
+        if (stream_writer->file()) {
+          Status ss = stream_writer->WriteBuffer(WriteOptions());
+          if (s.ok()) {
+            s = ss;
+          }
+        }
+        delete stream_writer;
+        stream_writer = nullptr;
+      }
       return s;
     }
 
@@ -1762,6 +1780,9 @@ class DBImpl : public DB {
     // Visual Studio doesn't support deque's member to be noncopyable because
     // of a std::unique_ptr as a member.
     log::Writer* writer;  // own
+    // Writer of the WAL stream of the nonmem write queue, only set with
+    // wal_per_write_queue.
+    log::Writer* stream_writer;  // own
 
    private:
     // true for some prefix of logs_
@@ -1975,8 +1996,11 @@ class DBImpl : public DB {
       JobContext* job_context, LogBuffer* log_buffer, Env::Priority thread_pri);
 
   // REQUIRES: log_numbers are sorted in ascending order
+  // log_stream_numbers are the log numbers that also have a stream file, see
+  // DBOptions::wal_per_write_queue.
   // corrupted_log_found is set to true if we recover from a corrupted log file.
   Status RecoverLogFiles(const std::vector<uint64_t>& log_numbers,
+                         const std::unordered_set<uint64_t>& log_stream_numbers,
                          SequenceNumber* next_sequence, bool read_only,
                          bool is_retry, bool* corrupted_log_found,
                          RecoveryContext* recovery_ctx);
@@ -2146,15 +2170,41 @@ class DBImpl : public DB {
                       uint64_t* log_size,
                       LogFileNumberSize& log_file_number_size);
 
-  IOStatus WriteToWAL(const WriteThread::WriteGroup& write_group,
+  IOStatus WriteToWAL(WriteThread::WriteGroup& write_group,
                       log::Writer* log_writer, uint64_t* log_used,
                       bool need_log_sync, bool need_log_dir_sync,
                       SequenceNumber sequence,
                       LogFileNumberSize& log_file_number_size);
 
+  // Returns true if the batches of write_group should be written to the WAL
+  // as separate records encoded by their writers in parallel, see
+  // DBOptions::parallel_wal_writes.
+  bool ShouldWriteToWALInParallel(const WriteThread::WriteGroup& write_group);
+
+  // Writes each batch of write_group as its own WAL record. The leader
+  // reserves the records in order and the followers encode them in parallel.
+  IOStatus ParallelWriteToWAL(WriteThread::WriteGroup& write_group,
+                              const WriteOptions& write_options,
+                              log::Writer* log_writer, uint64_t* log_used,
+                              SequenceNumber sequence, uint64_t* log_size,
+                              size_t* write_with_wal,
+                              WriteBatch** to_be_cached_state,
+                              LogFileNumberSize& log_file_number_size);
+
+  // With wal_per_write_queue, writes of the nonmem queue go to the WAL
+  // stream of that queue instead of the main one.
   IOStatus ConcurrentWriteToWAL(const WriteThread::WriteGroup& write_group,
                                 uint64_t* log_used,
-                                SequenceNumber* last_sequence, size_t seq_inc);
+                                SequenceNumber* last_sequence, size_t seq_inc,
+                                bool nonmem_queue = false);
+
+  // Allocates the sequence number of merged_batch and appends it to
+  // stream_writer, under wal_stream_mutex_ instead of log_write_mutex_.
+  IOStatus WriteToWALStream(WriteBatch* merged_batch,
+                            const WriteOptions& write_options,
+                            log::Writer* stream_writer,
+                            SequenceNumber* last_sequence, size_t seq_inc,
+                            uint64_t* log_size);
 
   // Used by WriteImpl to update bg_error_ if paranoid check is enabled.
   // Caller must hold mutex_.
@@ -2333,6 +2383,17 @@ class DBImpl : public DB {
       ColumnFamilyData* cfd, SuperVersionContext* sv_context,
       const MutableCFOptions& mutable_cf_options);
 
+  // Memtable resident column families serve point lookups from flushed
+  // memtables before the SST files. Drops those memtables once SST files lost
+  // or changed data without a newer write, e.g. through DeleteFilesInRanges(),
+  // so that lookups do not return that data anymore.
+  // REQUIRES: mutex_ held. A new SuperVersion is installed afterwards.
+  void DropMemtableResidentHistory(ColumnFamilyData* cfd,
+                                   JobContext* job_context);
+  // Same, if `c` is a FIFO deletion or may run a compaction filter.
+  void DropMemtableResidentHistory(const Compaction& c,
+                                   JobContext* job_context);
+
   bool GetIntPropertyInternal(ColumnFamilyData* cfd,
                               const DBPropertyInfo& property_info,
                               bool is_locked, uint64_t* value);
@@ -2369,6 +2430,25 @@ class DBImpl : public DB {
                      uint64_t recycle_log_number, size_t preallocate_block_size,
                      log::Writer** new_log);
 
+  // Creates the companion file of WAL log_file_num written by the nonmem
+  // write queue when wal_per_write_queue is set. *new_stream is left null
+  // otherwise.
+  IOStatus CreateWALStream(const WriteOptions& write_options,
+                           uint64_t log_file_num,
+                           size_t preallocate_block_size,
+                           log::Writer** new_stream);
+
+  // Deletes the WAL stream files of WAL `number`, if the DB may have any.
+  void DeleteWALStreamFiles(uint64_t number);
+
+  // Wraps file, the newly created file of WAL log_file_num, in a log writer.
+  IOStatus NewWALWriter(const WriteOptions& write_options,
+                        const std::string& fname, uint64_t log_file_num,
+                        const FileOptions& file_options,
+                        size_t preallocate_block_size,
+                        std::unique_ptr<FSWritableFile>&& file,
+                        log::Writer** new_log);
+
   // Validate self-consistency of DB options
   static Status ValidateOptions(const DBOptions& db_options);
   // Validate self-consistency of DB options and its consistency with cf options
@@ -2514,6 +2594,16 @@ class DBImpl : public DB {
   // mutex_, the order should be first mutex_ and then log_write_mutex_.
   InstrumentedMutex log_write_mutex_;
 
+  // With wal_per_write_queue, serializes sequence number allocation and
+  // appends to the WAL stream of the nonmem write queue, so that the records
+  // of that stream are in sequence number order. The stream writer itself is
+  // read from logs_ under log_write_mutex_.
+  InstrumentedMutex wal_stream_mutex_;
+
+  // True if WAL stream files may exist, because wal_per_write_queue is set
+  // or recovery found some.
+  bool has_wal_streams_;
+
   // If zero, manual compactions are allowed to proceed. If non-zero, manual
   // compactions may still be running, but will quickly fail with
   // `Status::Incomplete`. The value indicates how many threads have paused
@@ -374,6 +374,12 @@ Status DBImpl::FlushMemTableToOutputFile(
       // exists. Otherwise, some tests may fail.  Ignore the error in the
       // interim.
       sfm->OnAddFile(file_path).PermitUncheckedError();
+      for (const FileMetaData& partition_meta :
+           flush_job.GetPartitionOutputs()) {
+        sfm->OnAddFile(MakeTableFileName(cfd->ioptions()->cf_paths[0].path,
+                                         partition_meta.fd.GetNumber()))
+            .PermitUncheckedError();
+      }
       if (sfm->IsMaxAllowedSpaceReached()) {
         Status new_bg_error =
             Status::SpaceLimit("Max allowed space was reached");
@@ -839,6 +845,13 @@ Status DBImpl::AtomicFlushMemTablesToOutputFiles(
         // exists. Otherwise, some tests may fail.  Ignore the error in the
         // interim.
         sfm->OnAddFile(file_path).PermitUncheckedError();
+        for (const FileMetaData& partition_meta :
+             jobs[i]->GetPartitionOutputs()) {
+          sfm->OnAddFile(
+                 MakeTableFileName(cfds[i]->ioptions()->cf_paths[0].path,
+                                   partition_meta.fd.GetNumber()))
+              .PermitUncheckedError();
+        }
         if (sfm->IsMaxAllowedSpaceReached() &&
             error_handler_.GetBGError().ok()) {
           Status new_bg_error =
@@ -1578,6 +1591,7 @@ Status DBImpl::CompactFilesImpl(
   }
   if (status.ok()) {
     assert(compaction_job.io_status().ok());
+    DropMemtableResidentHistory(*c, job_context);
     InstallSuperVersionAndScheduleWork(
         c->column_family_data(), job_context->superversion_contexts.data(),
         *c->mutable_cf_options());
@@ -2670,8 +2684,13 @@ Status DBImpl::WaitUntilFlushWouldNotStallWrites(ColumnFamilyData* cfd,
       // triggers. If it stalled in these conditions, that'd mean the stall
       // triggers are so low that stalling is needed for any background work. In
       // that case we shouldn't wait since background work won't be scheduled.
-      if (cfd->imm()->NumNotFlushed() <
-              cfd->ioptions()->min_write_buffer_number_to_merge &&
+      // The same holds for the memtables that MemPurge keeps in memory for
+      // memtable resident column families: unless a flush is already queued
+      // or running, they are only flushed by checkpoints like this one.
+      if ((cfd->imm()->NumNotFlushed() <
+               cfd->ioptions()->min_write_buffer_number_to_merge ||
+           (cfd->ioptions()->memtable_resident && !cfd->queued_for_flush() &&
+            num_running_flushes_ == 0)) &&
           vstorage->l0_delay_trigger_count() <
               mutable_cf_options.level0_file_num_compaction_trigger) {
         break;
@@ -3741,6 +3760,9 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
           compaction_released = true;
         });
     io_s = versions_->io_status();
+    if (status.ok()) {
+      DropMemtableResidentHistory(*c, job_context);
+    }
     InstallSuperVersionAndScheduleWork(
         c->column_family_data(), job_context->superversion_contexts.data(),
         *c->mutable_cf_options());
@@ -3911,6 +3933,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
         compaction_job.Install(*c->mutable_cf_options(), &compaction_released);
     io_s = compaction_job.io_status();
     if (status.ok()) {
+      DropMemtableResidentHistory(*c, job_context);
       InstallSuperVersionAndScheduleWork(
           c->column_family_data(), job_context->superversion_contexts.data(),
           *c->mutable_cf_options());
@@ -4230,6 +4253,23 @@ void DBImpl::BuildCompactionJobInfo(
 // new SuperVersion() inside of the mutex. We do similar thing
 // for superversion_to_free
 
+void DBImpl::DropMemtableResidentHistory(ColumnFamilyData* cfd,
+                                         JobContext* job_context) {
+  mutex_.AssertHeld();
+  if (cfd->ioptions()->memtable_resident && cfd->imm()->HasHistory()) {
+    cfd->imm()->DropHistory(&job_context->memtables_to_free);
+  }
+}
+
+void DBImpl::DropMemtableResidentHistory(const Compaction& c,
+                                         JobContext* job_context) {
+  ColumnFamilyData* cfd = c.column_family_data();
+  if (c.deletion_compaction() || cfd->ioptions()->compaction_filter ||
+      cfd->ioptions()->compaction_filter_factory) {
+    DropMemtableResidentHistory(cfd, job_context);
+  }
+}
+
 void DBImpl::InstallSuperVersionAndScheduleWork(
     ColumnFamilyData* cfd, SuperVersionContext* sv_context,
     const MutableCFOptions& mutable_cf_options) {
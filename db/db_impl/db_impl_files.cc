@@ -326,13 +326,23 @@ void DBImpl::FindObsoleteFiles(JobContext* job_context, bool force,
         // TODO: plumb Env::IOActivity, Env::IOPriority
         auto s = log.writer->file()->Close({});
         s.PermitUncheckedError();
+        if (log.stream_writer != nullptr && log.stream_writer->file()) {
+          s = log.stream_writer->file()->Close({});
+          s.PermitUncheckedError();
+        }
         log_write_mutex_.Lock();
         log.writer->PublishIfClosed();
+        if (log.stream_writer != nullptr) {
+          log.stream_writer->PublishIfClosed();
+        }
         assert(&log == &logs_.front());
         log.FinishSync();
         log_sync_cv_.SignalAll();
       }
       logs_to_free_.push_back(log.ReleaseWriter());
+      if (log.stream_writer != nullptr) {
+        logs_to_free_.push_back(log.ReleaseStreamWriter());
+      }
       logs_.pop_front();
     }
     // Current log cannot be obsolete.
@@ -353,19 +363,41 @@ void DBImpl::FindObsoleteFiles(JobContext* job_context, bool force,
 }
 
 // Delete obsolete files and log status and information of file deletion
+void DBImpl::DeleteWALStreamFiles(uint64_t number) {
+  if (!has_wal_streams_) {
+    return;
+  }
+  const std::string& wal_dir = immutable_db_options_.GetWalDir();
+  const std::string fname = LogStreamFileName(wal_dir, number, /*stream=*/1);
+  Status s = DeleteDBFile(&immutable_db_options_, fname, wal_dir,
+                          /*force_bg=*/false, /*force_fg=*/!wal_in_db_path_);
+  if (!s.ok() && !env_->FileExists(fname).IsNotFound()) {
+    ROCKS_LOG_ERROR(immutable_db_options_.info_log,
+                    "Failed to delete WAL stream %s -- %s\n", fname.c_str(),
+                    s.ToString().c_str());
+  }
+}
+
 void DBImpl::DeleteObsoleteFileImpl(int job_id, const std::string& fname,
                                     const std::string& path_to_sync,
                                     FileType type, uint64_t number) {
   TEST_SYNC_POINT_CALLBACK("DBImpl::DeleteObsoleteFileImpl::BeforeDeletion",
                            const_cast<std::string*>(&fname));
 
+  if (type == kWalFile) {
+    // Delete the streams first, so that a crash in between cannot leave
+    // streams behind whose WAL is gone.
+    DeleteWALStreamFiles(number);
+  }
   Status file_deletion_status;
-  if (type == kTableFile || type == kBlobFile || type == kWalFile) {
+  if (type == kTableFile || type == kBlobFile || type == kWalFile ||
+      type == kWalStreamFile) {
     // Rate limit WAL deletion only if its in the DB dir
+    const bool is_wal = type == kWalFile || type == kWalStreamFile;
     file_deletion_status = DeleteDBFile(
         &immutable_db_options_, fname, path_to_sync,
         /*force_bg=*/false,
-        /*force_fg=*/(type == kWalFile) ? !wal_in_db_path_ : false);
+        /*force_fg=*/is_wal ? !wal_in_db_path_ : false);
   } else {
     file_deletion_status = env_->DeleteFile(fname);
   }
@@ -550,6 +582,13 @@ void DBImpl::PurgeObsoleteFiles(JobContext& state, bool schedule_only) {
                 (log_recycle_files_set.find(number) !=
                  log_recycle_files_set.end()));
         break;
+      case kWalStreamFile:
+        // Lives as long as its WAL. Streams are not recycled, and those
+        // left behind by a crash or by disabling wal_per_write_queue are
+        // deleted here.
+        keep = ((number >= state.log_number) ||
+                (number == state.prev_log_number));
+        break;
       case kDescriptorFile:
         // Keep my manifest file, and any newer incarnations'
         // (can happen during manifest roll)
@@ -615,7 +654,8 @@ void DBImpl::PurgeObsoleteFiles(JobContext& state, bool schedule_only) {
       fname = BlobFileName(candidate_file.file_path, number);
       dir_to_sync = candidate_file.file_path;
     } else {
-      dir_to_sync = (type == kWalFile) ? wal_dir : dbname_;
+      dir_to_sync =
+          (type == kWalFile || type == kWalStreamFile) ? wal_dir : dbname_;
       fname = dir_to_sync +
               ((!dir_to_sync.empty() && dir_to_sync.back() == '/') ||
                        (!to_delete.empty() && to_delete.front() == '/')
@@ -626,6 +666,8 @@ void DBImpl::PurgeObsoleteFiles(JobContext& state, bool schedule_only) {
 
     if (type == kWalFile && (immutable_db_options_.WAL_ttl_seconds > 0 ||
                              immutable_db_options_.WAL_size_limit_MB > 0)) {
+      // WAL streams are not archived, see wal_per_write_queue
+      DeleteWALStreamFiles(number);
       wal_manager_.ArchiveWALFile(fname, number);
       continue;
     }
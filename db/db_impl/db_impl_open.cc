@@ -25,6 +25,7 @@
 #include "rocksdb/table.h"
 #include "rocksdb/wal_filter.h"
 #include "test_util/sync_point.h"
+#include "util/coding.h"
 #include "util/rate_limiter_impl.h"
 #include "util/string_util.h"
 #include "util/udt_util.h"
@@ -97,7 +98,8 @@ DBOptions SanitizeOptions(const std::string& dbname, const DBOptions& src,
     }
   }
 
-  if (result.WAL_ttl_seconds > 0 || result.WAL_size_limit_MB > 0) {
+  if (result.WAL_ttl_seconds > 0 || result.WAL_size_limit_MB > 0 ||
+      result.wal_per_write_queue) {
     result.recycle_log_file_num = false;
   }
 
@@ -266,6 +268,19 @@ Status DBImpl::ValidateOptions(const DBOptions& db_options) {
         "unordered_write is incompatible with enable_pipelined_write");
   }
 
+  if (db_options.wal_per_write_queue) {
+    if (!db_options.two_write_queues) {
+      return Status::InvalidArgument(
+          "wal_per_write_queue requires two_write_queues");
+    }
+    if (db_options.manual_wal_flush || db_options.WAL_ttl_seconds > 0 ||
+        db_options.WAL_size_limit_MB > 0) {
+      return Status::NotSupported(
+          "wal_per_write_queue is incompatible with manual_wal_flush and WAL "
+          "archival");
+    }
+  }
+
   if (db_options.atomic_flush && db_options.enable_pipelined_write) {
     return Status::InvalidArgument(
         "atomic_flush is incompatible with enable_pipelined_write");
@@ -717,17 +732,21 @@ Status DBImpl::Recover(
     }
 
     std::unordered_map<uint64_t, std::string> wal_files;
+    std::unordered_set<uint64_t> wal_stream_numbers;
     for (const auto& file : files_in_wal_dir) {
       uint64_t number;
       FileType type;
-      if (ParseFileName(file, &number, &type) && type == kWalFile) {
+      if (ParseFileName(file, &number, &type) &&
+          (type == kWalFile || type == kWalStreamFile)) {
         if (is_new_db) {
           return Status::Corruption(
               "While creating a new Db, wal_dir contains "
               "existing log file: ",
               file);
-        } else {
+        } else if (type == kWalFile) {
           wal_files[number] = LogFileName(wal_dir, number);
+        } else {
+          wal_stream_numbers.insert(number);
         }
       }
     }
@@ -786,8 +805,8 @@ Status DBImpl::Recover(
       std::sort(wals.begin(), wals.end());
 
       bool corrupted_wal_found = false;
-      s = RecoverLogFiles(wals, &next_sequence, read_only, is_retry,
-                          &corrupted_wal_found, recovery_ctx);
+      s = RecoverLogFiles(wals, wal_stream_numbers, &next_sequence, read_only,
+                          is_retry, &corrupted_wal_found, recovery_ctx);
       if (corrupted_wal_found && recovered_seq != nullptr) {
         *recovered_seq = next_sequence;
       }
@@ -1082,10 +1101,11 @@ bool DBImpl::InvokeWalFilterIfNeededOnWalRecord(uint64_t wal_number,
 }
 
 // REQUIRES: wal_numbers are sorted in ascending order
-Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
-                               SequenceNumber* next_sequence, bool read_only,
-                               bool is_retry, bool* corrupted_wal_found,
-                               RecoveryContext* recovery_ctx) {
+Status DBImpl::RecoverLogFiles(
+    const std::vector<uint64_t>& wal_numbers,
+    const std::unordered_set<uint64_t>& wal_stream_numbers,
+    SequenceNumber* next_sequence, bool read_only, bool is_retry,
+    bool* corrupted_wal_found, RecoveryContext* recovery_ctx) {
   struct LogReporter : public log::Reader::Reporter {
     Env* env;
     Logger* info_log;
@@ -1218,25 +1238,100 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
     log::Reader reader(immutable_db_options_.info_log, std::move(file_reader),
                        &reporter, true /*checksum*/, wal_number);
 
+    // The WAL may have been written as two streams, see wal_per_write_queue.
+    // Each stream is in sequence number order, so their records are merged
+    // back into sequence number order.
+    const std::string stream_fname = LogStreamFileName(
+        immutable_db_options_.GetWalDir(), wal_number, /*stream=*/1);
+    LogReporter stream_reporter = reporter;
+    stream_reporter.fname = stream_fname.c_str();
+    std::unique_ptr<log::Reader> stream_reader;
+    if (wal_stream_numbers.count(wal_number) > 0) {
+      has_wal_streams_ = true;
+      std::unique_ptr<FSSequentialFile> file;
+      status = fs_->NewSequentialFile(
+          stream_fname, fs_->OptimizeForLogRead(file_options_), &file, nullptr);
+      if (!status.ok()) {
+        MaybeIgnoreError(&status);
+        if (!status.ok()) {
+          return status;
+        }
+      } else {
+        stream_reader.reset(new log::Reader(
+            immutable_db_options_.info_log,
+            std::unique_ptr<SequentialFileReader>(new SequentialFileReader(
+                std::move(file), stream_fname,
+                immutable_db_options_.log_readahead_size, io_tracer_,
+                /*listeners=*/{}, /*rate_limiter=*/nullptr, is_retry)),
+            &stream_reporter, true /*checksum*/, wal_number));
+      }
+    }
+    log::Reader* const stream_readers[2] = {&reader, stream_reader.get()};
+    LogReporter* const stream_reporters[2] = {&reporter, &stream_reporter};
+    std::string pending_records[2];
+    uint64_t pending_checksums[2] = {0, 0};
+    bool pending[2] = {false, false};
+    bool exhausted[2] = {false, stream_reader == nullptr};
+    // Stream of the last record returned by read_record
+    size_t cur_stream = 0;
+
     // Determine if we should tolerate incomplete records at the tail end of the
     // Read all the records and add to a memtable
     std::string scratch;
     Slice record;
+    uint64_t record_checksum;
+
+    auto read_record = [&]() {
+      if (stream_reader == nullptr) {
+        return reader.ReadRecord(&record, &scratch,
+                                 immutable_db_options_.wal_recovery_mode,
+                                 &record_checksum);
+      }
+      SequenceNumber seqs[2] = {0, 0};
+      for (size_t i = 0; i < 2; ++i) {
+        if (!pending[i] && !exhausted[i]) {
+          Slice r;
+          if (stream_readers[i]->ReadRecord(
+                  &r, &scratch, immutable_db_options_.wal_recovery_mode,
+                  &pending_checksums[i])) {
+            pending_records[i].assign(r.data(), r.size());
+            pending[i] = true;
+          } else {
+            exhausted[i] = true;
+          }
+        }
+        // Undersized records sort first and are reported by the caller
+        if (pending[i] &&
+            pending_records[i].size() >= WriteBatchInternal::kHeader) {
+          seqs[i] = DecodeFixed64(pending_records[i].data());
+        }
+      }
+      if (!pending[0] && !pending[1]) {
+        return false;
+      }
+      // Both queues allocate sequence numbers from the same counter, so two
+      // records only tie when one of them consumed none, leaving its number
+      // to the next write. The nonmem queue is picked on a tie: a record of it
+      // that consumes none (a write that does not assign order) was allocated
+      // before the main queue write sharing its number, while such a record
+      // of the main queue is an empty batch, whose replay order is irrelevant.
+      cur_stream = (pending[1] && (!pending[0] || seqs[1] <= seqs[0])) ? 1 : 0;
+      pending[cur_stream] = false;
+      record = pending_records[cur_stream];
+      record_checksum = pending_checksums[cur_stream];
+      return true;
+    };
 
     const UnorderedMap<uint32_t, size_t>& running_ts_sz =
         versions_->GetRunningColumnFamiliesTimestampSize();
 
     TEST_SYNC_POINT_CALLBACK("DBImpl::RecoverLogFiles:BeforeReadWal",
                              /*arg=*/nullptr);
-    uint64_t record_checksum;
-    while (!stop_replay_by_wal_filter &&
-           reader.ReadRecord(&record, &scratch,
-                             immutable_db_options_.wal_recovery_mode,
-                             &record_checksum) &&
-           status.ok()) {
+    while (!stop_replay_by_wal_filter && read_record() && status.ok()) {
+      LogReporter& cur_reporter = *stream_reporters[cur_stream];
       if (record.size() < WriteBatchInternal::kHeader) {
-        reporter.Corruption(record.size(),
-                            Status::Corruption("log record too small"));
+        cur_reporter.Corruption(record.size(),
+                                Status::Corruption("log record too small"));
         continue;
       }
       // We create a new batch and initialize with a valid prot_info_ to store
@@ -1250,7 +1345,7 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
       }
 
       const UnorderedMap<uint32_t, size_t>& record_ts_sz =
-          reader.GetRecordedTimestampSize();
+          stream_readers[cur_stream]->GetRecordedTimestampSize();
       status = HandleWriteBatchTimestampSizeDifference(
           &batch, running_ts_sz, record_ts_sz,
           TimestampSizeConsistencyMode::kReconcileInconsistency, &new_batch);
@@ -1275,7 +1370,7 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
 
       SequenceNumber sequence = WriteBatchInternal::Sequence(batch_to_use);
       if (sequence > kMaxSequenceNumber) {
-        reporter.Corruption(
+        cur_reporter.Corruption(
             record.size(),
             Status::Corruption("sequence " + std::to_string(sequence) +
                                " is too large"));
@@ -1299,9 +1394,9 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
 
       // For the default case of wal_filter == nullptr, always performs no-op
       // and returns true.
-      if (!InvokeWalFilterIfNeededOnWalRecord(wal_number, fname, reporter,
-                                              status, stop_replay_by_wal_filter,
-                                              *batch_to_use)) {
+      if (!InvokeWalFilterIfNeededOnWalRecord(
+              wal_number, fname, cur_reporter, status,
+              stop_replay_by_wal_filter, *batch_to_use)) {
         continue;
       }
 
@@ -1320,7 +1415,7 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
       if (!status.ok()) {
         // We are treating this as a failure while reading since we read valid
         // blocks that do not form coherent data
-        reporter.Corruption(record.size(), status);
+        cur_reporter.Corruption(record.size(), status);
         continue;
       }
 
@@ -1947,26 +2042,66 @@ IOStatus DBImpl::CreateWAL(const WriteOptions& write_options,
   }
 
   if (io_s.ok()) {
-    lfile->SetWriteLifeTimeHint(CalculateWALWriteHint());
-    lfile->SetPreallocationBlockSize(preallocate_block_size);
+    io_s = NewWALWriter(write_options, log_fname, log_file_num,
+                        opt_file_options, preallocate_block_size,
+                        std::move(lfile), new_log);
+  }
+  return io_s;
+}
 
-    const auto& listeners = immutable_db_options_.listeners;
-    FileTypeSet tmp_set = immutable_db_options_.checksum_handoff_file_types;
-    std::unique_ptr<WritableFileWriter> file_writer(new WritableFileWriter(
-        std::move(lfile), log_fname, opt_file_options,
-        immutable_db_options_.clock, io_tracer_, nullptr /* stats */,
-        Histograms::HISTOGRAM_ENUM_MAX /* hist_type */, listeners, nullptr,
-        tmp_set.Contains(FileType::kWalFile),
-        tmp_set.Contains(FileType::kWalFile)));
-    *new_log = new log::Writer(std::move(file_writer), log_file_num,
-                               immutable_db_options_.recycle_log_file_num > 0,
-                               immutable_db_options_.manual_wal_flush,
-                               immutable_db_options_.wal_compression);
-    io_s = (*new_log)->AddCompressionTypeRecord(write_options);
+IOStatus DBImpl::CreateWALStream(const WriteOptions& write_options,
+                                 uint64_t log_file_num,
+                                 size_t preallocate_block_size,
+                                 log::Writer** new_stream) {
+  *new_stream = nullptr;
+  if (!immutable_db_options_.wal_per_write_queue) {
+    return IOStatus::OK();
+  }
+  DBOptions db_options =
+      BuildDBOptions(immutable_db_options_, mutable_db_options_);
+  FileOptions opt_file_options =
+      fs_->OptimizeForLogWrite(file_options_, db_options);
+  std::string stream_fname = LogStreamFileName(
+      immutable_db_options_.GetWalDir(), log_file_num, /*stream=*/1);
+  std::unique_ptr<FSWritableFile> lfile;
+  IOStatus io_s =
+      NewWritableFile(fs_.get(), stream_fname, &lfile, opt_file_options);
+  if (io_s.ok()) {
+    io_s = NewWALWriter(write_options, stream_fname, log_file_num,
+                        opt_file_options, preallocate_block_size,
+                        std::move(lfile), new_stream);
+  }
+  if (!io_s.ok()) {
+    delete *new_stream;
+    *new_stream = nullptr;
   }
   return io_s;
 }
 
+IOStatus DBImpl::NewWALWriter(const WriteOptions& write_options,
+                              const std::string& fname, uint64_t log_file_num,
+                              const FileOptions& file_options,
+                              size_t preallocate_block_size,
+                              std::unique_ptr<FSWritableFile>&& file,
+                              log::Writer** new_log) {
+  file->SetWriteLifeTimeHint(CalculateWALWriteHint());
+  file->SetPreallocationBlockSize(preallocate_block_size);
+
+  const auto& listeners = immutable_db_options_.listeners;
+  FileTypeSet tmp_set = immutable_db_options_.checksum_handoff_file_types;
+  std::unique_ptr<WritableFileWriter> file_writer(new WritableFileWriter(
+      std::move(file), fname, file_options, immutable_db_options_.clock,
+      io_tracer_, nullptr /* stats */,
+      Histograms::HISTOGRAM_ENUM_MAX /* hist_type */, listeners, nullptr,
+      tmp_set.Contains(FileType::kWalFile),
+      tmp_set.Contains(FileType::kWalFile)));
+  *new_log = new log::Writer(std::move(file_writer), log_file_num,
+                             immutable_db_options_.recycle_log_file_num > 0,
+                             immutable_db_options_.manual_wal_flush,
+                             immutable_db_options_.wal_compression);
+  return (*new_log)->AddCompressionTypeRecord(write_options);
+}
+
 void DBImpl::TrackExistingDataFiles(
     const std::vector<std::string>& existing_data_files) {
   auto sfm = static_cast<SstFileManagerImpl*>(
@@ -2097,6 +2232,15 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
         impl->GetWalPreallocateBlockSize(max_write_buffer_size);
     s = impl->CreateWAL(write_options, new_log_number, 0 /*recycle_log_number*/,
                         preallocate_block_size, &new_log);
+    log::Writer* new_stream = nullptr;
+    if (s.ok()) {
+      s = impl->CreateWALStream(write_options, new_log_number,
+                                preallocate_block_size, &new_stream);
+      if (!s.ok()) {
+        delete new_log;
+        new_log = nullptr;
+      }
+    }
     if (s.ok()) {
       // Prevent log files created by previous instance from being recycled.
       // They might be in alive_log_file_, and might get recycled otherwise.
@@ -2107,7 +2251,7 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
       impl->logfile_number_ = new_log_number;
       assert(new_log != nullptr);
       assert(impl->logs_.empty());
-      impl->logs_.emplace_back(new_log_number, new_log);
+      impl->logs_.emplace_back(new_log_number, new_log, new_stream);
     }
 
     if (s.ok()) {
@@ -18,6 +18,108 @@
 #include "util/cast_util.h"
 
 namespace ROCKSDB_NAMESPACE {
+namespace {
+// Auto-scoped timer of a write path stage. The latency is always kept in the
+// per write queue histograms of InternalStats, and also reported to
+// Statistics, if any, into the histogram and the ticker of the stage.
+//
+// The write path already reads the clock around most stages, so a stage can
+// reuse the start time of the DB_WRITE StopWatch or take the place of the
+// PERF_TIMER of the stage instead of reading the clock twice more.
+class WriteStageStopWatch {
+ public:
+  // `start_micros` is a NowMicros() taken right before, if any.
+  WriteStageStopWatch(SystemClock* clock, Statistics* stats,
+                      InternalStats* internal_stats,
+                      InternalStats::WriteQueue queue,
+                      InternalStats::WriteStage stage,
+                      uint64_t start_micros = 0)
+      : clock_(clock),
+        stats_(stats),
+        internal_stats_(internal_stats),
+        queue_(queue),
+        stage_(stage),
+        perf_metric_(nullptr),
+        use_nanos_(false),
+        start_time_(start_micros != 0 ? start_micros : clock->NowMicros()) {}
+
+  // Also adds the time to the perf context `perf_metric` if `perf_level` is
+  // at least `perf_enable_level`, like PerfStepTimer.
+  WriteStageStopWatch(SystemClock* clock, Statistics* stats,
+                      InternalStats* internal_stats,
+                      InternalStats::WriteQueue queue,
+                      InternalStats::WriteStage stage, uint64_t* perf_metric,
+                      PerfLevel perf_enable_level)
+      : clock_(clock),
+        stats_(stats),
+        internal_stats_(internal_stats),
+        queue_(queue),
+        stage_(stage),
+#if defined(NPERF_CONTEXT)
+        perf_metric_(nullptr),
+#else
+        perf_metric_(perf_level >= perf_enable_level ? perf_metric : nullptr),
+#endif
+        use_nanos_(true),
+        start_time_(clock->NowNanos()) {
+#if defined(NPERF_CONTEXT)
+    (void)perf_metric;
+    (void)perf_enable_level;
+#endif
+  }
+
+  ~WriteStageStopWatch() {
+    uint64_t micros;
+    if (use_nanos_) {
+      const uint64_t nanos = clock_->NowNanos() - start_time_;
+      if (perf_metric_ != nullptr) {
+        *perf_metric_ += nanos;
+      }
+      micros = nanos / 1000;
+    } else {
+      micros = clock_->NowMicros() - start_time_;
+    }
+    internal_stats_->AddWriteStageLatency(queue_, stage_, micros);
+    if (stats_ == nullptr ||
+        stats_->get_stats_level() <= StatsLevel::kExceptTimers) {
+      return;
+    }
+    switch (stage_) {
+      case InternalStats::kWriteStageThreadWait:
+        stats_->reportTimeToHistogram(DB_WRITE_THREAD_WAIT_MICROS, micros);
+        stats_->recordTick(WRITE_THREAD_WAIT_MICROS, micros);
+        break;
+      case InternalStats::kWriteStageWal:
+        stats_->reportTimeToHistogram(DB_WRITE_WAL_MICROS, micros);
+        stats_->recordTick(WRITE_WAL_MICROS, micros);
+        break;
+      case InternalStats::kWriteStageWalSync:
+        stats_->reportTimeToHistogram(WAL_FILE_SYNC_MICROS, micros);
+        break;
+      case InternalStats::kWriteStageMemtable:
+        stats_->reportTimeToHistogram(DB_WRITE_MEMTABLE_MICROS, micros);
+        stats_->recordTick(WRITE_MEMTABLE_MICROS, micros);
+        break;
+      default:
+        // The delay stage is reported by DelayWrite() itself.
+        assert(false);
+        break;
+    }
+  }
+
+ private:
+  SystemClock* clock_;
+  Statistics* stats_;
+  InternalStats* internal_stats_;
+  const InternalStats::WriteQueue queue_;
+  const InternalStats::WriteStage stage_;
+  uint64_t* const perf_metric_;
+  // Whether start_time_ is from NowNanos() rather than NowMicros()
+  const bool use_nanos_;
+  const uint64_t start_time_;
+};
+}  // namespace
+
 // Convenience methods
 Status DBImpl::Put(const WriteOptions& o, ColumnFamilyHandle* column_family,
                    const Slice& key, const Slice& val) {
@@ -347,7 +449,28 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
                         pre_release_callback, post_memtable_callback);
   StopWatch write_sw(immutable_db_options_.clock, stats_, DB_WRITE);
 
-  write_thread_.JoinBatchGroup(&w);
+  {
+    WriteStageStopWatch wait_sw(
+        immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+        InternalStats::kWriteQueueMain, InternalStats::kWriteStageThreadWait,
+        write_sw.start_time());
+    write_thread_.JoinBatchGroup(&w);
+  }
+  if (w.state == WriteThread::STATE_PARALLEL_WAL_WRITER) {
+    // we are a non-leader in a parallel WAL write group. Encode our own
+    // record unless the leader already did it for us.
+    if (write_thread_.ClaimParallelWalRecord(&w)) {
+      PERF_TIMER_STOP(write_pre_and_post_process_time);
+      {
+        PERF_TIMER_GUARD(write_wal_time);
+        w.write_group->wal_writer->FillRecord(
+            w.wal_reservation, WriteBatchInternal::Contents(w.batch));
+      }
+      write_thread_.CompleteParallelWalRecord(w.write_group);
+      PERF_TIMER_START(write_pre_and_post_process_time);
+    }
+    write_thread_.ExitParallelWalWriter(&w);
+  }
   if (w.state == WriteThread::STATE_PARALLEL_MEMTABLE_CALLER) {
     write_thread_.SetMemWritersEachStride(&w);
   }
@@ -356,7 +479,10 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
 
     if (w.ShouldWriteToMemtable()) {
       PERF_TIMER_STOP(write_pre_and_post_process_time);
-      PERF_TIMER_FOR_WAIT_GUARD(write_memtable_time);
+      WriteStageStopWatch memtable_sw(
+          immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+          InternalStats::kWriteQueueMain, InternalStats::kWriteStageMemtable,
+          &perf_context.write_memtable_time, PerfLevel::kEnableWait);
 
       ColumnFamilyMemTablesImpl column_family_memtables(
           versions_->GetColumnFamilySet());
@@ -533,7 +659,11 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         assert(log_context.log_file_number_size);
         LogFileNumberSize& log_file_number_size =
             *(log_context.log_file_number_size);
-        PERF_TIMER_GUARD(write_wal_time);
+        WriteStageStopWatch wal_sw(
+            immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+            InternalStats::kWriteQueueMain, InternalStats::kWriteStageWal,
+            &perf_context.write_wal_time,
+            PerfLevel::kEnableTimeExceptForMutex);
         io_s =
             WriteToWAL(write_group, log_context.writer, log_used,
                        log_context.need_log_sync, log_context.need_log_dir_sync,
@@ -541,7 +671,11 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
       }
     } else {
       if (status.ok() && !write_options.disableWAL) {
-        PERF_TIMER_GUARD(write_wal_time);
+        WriteStageStopWatch wal_sw(
+            immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+            InternalStats::kWriteQueueMain, InternalStats::kWriteStageWal,
+            &perf_context.write_wal_time,
+            PerfLevel::kEnableTimeExceptForMutex);
         // LastAllocatedSequence is increased inside WriteToWAL under
         // wal_write_mutex_ to ensure ordered events in WAL
         io_s = ConcurrentWriteToWAL(write_group, log_used, &last_sequence,
@@ -588,7 +722,10 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     }
 
     if (status.ok()) {
-      PERF_TIMER_FOR_WAIT_GUARD(write_memtable_time);
+      WriteStageStopWatch memtable_sw(
+          immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+          InternalStats::kWriteQueueMain, InternalStats::kWriteStageMemtable,
+          &perf_context.write_memtable_time, PerfLevel::kEnableWait);
 
       if (!parallel) {
         // w.sequence will be set inside InsertInto
@@ -712,7 +849,13 @@ Status DBImpl::PipelinedWriteImpl(const WriteOptions& write_options,
   WriteThread::Writer w(write_options, my_batch, callback, user_write_cb,
                         log_ref, disable_memtable, /*_batch_cnt=*/0,
                         /*_pre_release_callback=*/nullptr);
-  write_thread_.JoinBatchGroup(&w);
+  {
+    WriteStageStopWatch wait_sw(
+        immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+        InternalStats::kWriteQueueMain, InternalStats::kWriteStageThreadWait,
+        write_sw.start_time());
+    write_thread_.JoinBatchGroup(&w);
+  }
   TEST_SYNC_POINT("DBImplWrite::PipelinedWriteImpl:AfterJoinBatchGroup");
   if (w.state == WriteThread::STATE_GROUP_LEADER) {
     WriteThread::WriteGroup wal_write_group;
@@ -778,7 +921,10 @@ Status DBImpl::PipelinedWriteImpl(const WriteOptions& write_options,
     io_s.PermitUncheckedError();  // Allow io_s to be uninitialized
 
     if (w.status.ok() && !write_options.disableWAL) {
-      PERF_TIMER_GUARD(write_wal_time);
+      WriteStageStopWatch wal_sw(
+          immutable_db_options_.clock, stats_, stats,
+          InternalStats::kWriteQueueMain, InternalStats::kWriteStageWal,
+          &perf_context.write_wal_time, PerfLevel::kEnableTimeExceptForMutex);
       stats->AddDBStats(InternalStats::kIntStatsWriteDoneBySelf, 1);
       RecordTick(stats_, WRITE_DONE_BY_SELF, 1);
       if (wal_write_group.size > 1) {
@@ -829,7 +975,10 @@ Status DBImpl::PipelinedWriteImpl(const WriteOptions& write_options,
   WriteThread::WriteGroup memtable_write_group;
 
   if (w.state == WriteThread::STATE_MEMTABLE_WRITER_LEADER) {
-    PERF_TIMER_FOR_WAIT_GUARD(write_memtable_time);
+    WriteStageStopWatch memtable_sw(
+        immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+        InternalStats::kWriteQueueMain, InternalStats::kWriteStageMemtable,
+        &perf_context.write_memtable_time, PerfLevel::kEnableWait);
     assert(w.ShouldWriteToMemtable());
     write_thread_.EnterAsMemTableWriter(&w, &memtable_write_group);
     if (memtable_write_group.size > 1 &&
@@ -854,19 +1003,24 @@ Status DBImpl::PipelinedWriteImpl(const WriteOptions& write_options,
   }
   if (w.state == WriteThread::STATE_PARALLEL_MEMTABLE_WRITER) {
     PERF_TIMER_STOP(write_pre_and_post_process_time);
-    PERF_TIMER_FOR_WAIT_GUARD(write_memtable_time);
 
     assert(w.ShouldWriteToMemtable());
-    ColumnFamilyMemTablesImpl column_family_memtables(
-        versions_->GetColumnFamilySet());
-    w.status = WriteBatchInternal::InsertInto(
-        &w, w.sequence, &column_family_memtables, &flush_scheduler_,
-        &trim_history_scheduler_, write_options.ignore_missing_column_families,
-        0 /*log_number*/, this, true /*concurrent_memtable_writes*/,
-        false /*seq_per_batch*/, 0 /*batch_cnt*/, true /*batch_per_txn*/,
-        write_options.memtable_insert_hint_per_batch);
-
-    PERF_TIMER_STOP(write_memtable_time);
+    {
+      WriteStageStopWatch memtable_sw(
+          immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+          InternalStats::kWriteQueueMain, InternalStats::kWriteStageMemtable,
+          &perf_context.write_memtable_time, PerfLevel::kEnableWait);
+      ColumnFamilyMemTablesImpl column_family_memtables(
+          versions_->GetColumnFamilySet());
+      w.status = WriteBatchInternal::InsertInto(
+          &w, w.sequence, &column_family_memtables, &flush_scheduler_,
+          &trim_history_scheduler_,
+          write_options.ignore_missing_column_families, 0 /*log_number*/, this,
+          true /*concurrent_memtable_writes*/, false /*seq_per_batch*/,
+          0 /*batch_cnt*/, true /*batch_per_txn*/,
+          write_options.memtable_insert_hint_per_batch);
+    }
+
     PERF_TIMER_START(write_pre_and_post_process_time);
 
     if (write_thread_.CompleteParallelMemTableWriter(&w)) {
@@ -903,16 +1057,22 @@ Status DBImpl::UnorderedWriteMemtable(const WriteOptions& write_options,
     RecordTick(stats_, NUMBER_KEYS_WRITTEN, total_count);
 
     PERF_TIMER_STOP(write_pre_and_post_process_time);
-    PERF_TIMER_FOR_WAIT_GUARD(write_memtable_time);
-
-    ColumnFamilyMemTablesImpl column_family_memtables(
-        versions_->GetColumnFamilySet());
-    w.status = WriteBatchInternal::InsertInto(
-        &w, w.sequence, &column_family_memtables, &flush_scheduler_,
-        &trim_history_scheduler_, write_options.ignore_missing_column_families,
-        0 /*log_number*/, this, true /*concurrent_memtable_writes*/,
-        seq_per_batch_, sub_batch_cnt, true /*batch_per_txn*/,
-        write_options.memtable_insert_hint_per_batch);
+
+    {
+      WriteStageStopWatch memtable_sw(
+          immutable_db_options_.clock, stats_, stats,
+          InternalStats::kWriteQueueMain, InternalStats::kWriteStageMemtable,
+          &perf_context.write_memtable_time, PerfLevel::kEnableWait);
+      ColumnFamilyMemTablesImpl column_family_memtables(
+          versions_->GetColumnFamilySet());
+      w.status = WriteBatchInternal::InsertInto(
+          &w, w.sequence, &column_family_memtables, &flush_scheduler_,
+          &trim_history_scheduler_,
+          write_options.ignore_missing_column_families, 0 /*log_number*/, this,
+          true /*concurrent_memtable_writes*/, seq_per_batch_, sub_batch_cnt,
+          true /*batch_per_txn*/,
+          write_options.memtable_insert_hint_per_batch);
+    }
     if (write_options.disableWAL) {
       has_unpersisted_data_.store(true, std::memory_order_relaxed);
     }
@@ -952,8 +1112,17 @@ Status DBImpl::WriteImplWALOnly(
                         log_ref, disable_memtable, sub_batch_cnt,
                         pre_release_callback);
   StopWatch write_sw(immutable_db_options_.clock, stats_, DB_WRITE);
+  const InternalStats::WriteQueue write_queue =
+      write_thread == &nonmem_write_thread_ ? InternalStats::kWriteQueueWalOnly
+                                            : InternalStats::kWriteQueueMain;
 
-  write_thread->JoinBatchGroup(&w);
+  {
+    WriteStageStopWatch wait_sw(
+        immutable_db_options_.clock, stats_, default_cf_internal_stats_,
+        write_queue, InternalStats::kWriteStageThreadWait,
+        write_sw.start_time());
+    write_thread->JoinBatchGroup(&w);
+  }
   assert(w.state != WriteThread::STATE_PARALLEL_MEMTABLE_WRITER);
   if (w.state == WriteThread::STATE_COMPLETED) {
     if (log_used != nullptr) {
@@ -1057,7 +1226,6 @@ Status DBImpl::WriteImplWALOnly(
 
   PERF_TIMER_STOP(write_pre_and_post_process_time);
 
-  PERF_TIMER_GUARD(write_wal_time);
   // LastAllocatedSequence is increased inside WriteToWAL under
   // wal_write_mutex_ to ensure ordered events in WAL
   size_t seq_inc = 0 /* total_count */;
@@ -1073,8 +1241,16 @@ Status DBImpl::WriteImplWALOnly(
   }
   Status status;
   if (!write_options.disableWAL) {
-    IOStatus io_s =
-        ConcurrentWriteToWAL(write_group, log_used, &last_sequence, seq_inc);
+    IOStatus io_s;
+    {
+      WriteStageStopWatch wal_sw(
+          immutable_db_options_.clock, stats_, stats, write_queue,
+          InternalStats::kWriteStageWal, &perf_context.write_wal_time,
+          PerfLevel::kEnableTimeExceptForMutex);
+      io_s = ConcurrentWriteToWAL(write_group, log_used, &last_sequence,
+                                  seq_inc,
+                                  write_thread == &nonmem_write_thread_);
+    }
     status = io_s;
     // last_sequence may not be set if there is an error
     // This error checking and return is moved up to avoid using uninitialized
@@ -1089,6 +1265,9 @@ Status DBImpl::WriteImplWALOnly(
     last_sequence = versions_->FetchAddLastAllocatedSequence(seq_inc);
   }
 
+  // The rest of the WAL work, such as a requested sync, is not part of the
+  // WAL stage.
+  PERF_TIMER_GUARD(write_wal_time);
   size_t memtable_write_cnt = 0;
   auto curr_seq = last_sequence + 1;
   for (auto* writer : write_group) {
@@ -1413,7 +1592,133 @@ IOStatus DBImpl::WriteToWAL(const WriteBatch& merged_batch,
   return io_s;
 }
 
-IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
+IOStatus DBImpl::WriteToWALStream(WriteBatch* merged_batch,
+                                  const WriteOptions& write_options,
+                                  log::Writer* stream_writer,
+                                  SequenceNumber* last_sequence,
+                                  size_t seq_inc, uint64_t* log_size) {
+  *log_size = 0;
+  // Allocating the sequence number under the same mutex as the append keeps
+  // the records of the stream in sequence number order, which is what
+  // recovery relies on to merge the streams.
+  InstrumentedMutexLock l(&wal_stream_mutex_);
+  *last_sequence = versions_->FetchAddLastAllocatedSequence(seq_inc);
+  WriteBatchInternal::SetSequence(merged_batch, *last_sequence + 1);
+
+  Slice log_entry = WriteBatchInternal::Contents(merged_batch);
+  TEST_SYNC_POINT_CALLBACK("DBImpl::WriteToWALStream:log_entry", &log_entry);
+  IOStatus io_s = status_to_io_status(merged_batch->VerifyChecksum());
+  if (io_s.ok()) {
+    io_s = stream_writer->MaybeAddUserDefinedTimestampSizeRecord(
+        write_options, versions_->GetColumnFamiliesTimestampSizeForRecord());
+  }
+  if (io_s.ok()) {
+    io_s = stream_writer->AddRecord(write_options, log_entry);
+  }
+  *log_size = log_entry.size();
+  total_log_size_ += log_entry.size();
+  return io_s;
+}
+
+bool DBImpl::ShouldWriteToWALInParallel(
+    const WriteThread::WriteGroup& write_group) {
+  if (!immutable_db_options_.parallel_wal_writes || write_group.size < 2 ||
+      immutable_db_options_.enable_pipelined_write || seq_per_batch_ ||
+      immutable_db_options_.wal_compression != kNoCompression) {
+    return false;
+  }
+  for (auto* writer : write_group) {
+    if (writer->CallbackFailed()) {
+      continue;
+    }
+    // The sequence numbers of the records must follow from the number of
+    // keys of the previous ones, as for a merged batch
+    if (!writer->ShouldWriteToMemtable() ||
+        !writer->batch->GetWalTerminationPoint().is_cleared()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+IOStatus DBImpl::ParallelWriteToWAL(WriteThread::WriteGroup& write_group,
+                                    const WriteOptions& write_options,
+                                    log::Writer* log_writer, uint64_t* log_used,
+                                    SequenceNumber sequence, uint64_t* log_size,
+                                    size_t* write_with_wal,
+                                    WriteBatch** to_be_cached_state,
+                                    LogFileNumberSize& log_file_number_size) {
+  size_t total_size = 0;
+  for (auto* writer : write_group) {
+    writer->log_used = logfile_number_;
+    if (writer->CallbackFailed()) {
+      // Nothing to encode
+      writer->wal_record_claimed.store(true, std::memory_order_relaxed);
+      continue;
+    }
+    WriteBatchInternal::SetSequence(writer->batch, sequence);
+    sequence += WriteBatchInternal::Count(writer->batch);
+    Slice log_entry = WriteBatchInternal::Contents(writer->batch);
+    TEST_SYNC_POINT_CALLBACK("DBImpl::WriteToWAL:log_entry", &log_entry);
+    IOStatus io_s = status_to_io_status(writer->batch->VerifyChecksum());
+    if (!io_s.ok()) {
+      return io_s;
+    }
+    if (WriteBatchInternal::IsLatestPersistentState(writer->batch)) {
+      *to_be_cached_state = writer->batch;
+    }
+    total_size += log_entry.size();
+    (*write_with_wal)++;
+  }
+  *log_size = total_size;
+
+  // See WriteToWAL(merged_batch) for the locking
+  const bool needs_locking = manual_wal_flush_ && !two_write_queues_;
+  if (UNLIKELY(needs_locking)) {
+    log_write_mutex_.Lock();
+  }
+  IOStatus io_s = log_writer->MaybeAddUserDefinedTimestampSizeRecord(
+      write_options, versions_->GetColumnFamiliesTimestampSizeForRecord());
+  if (io_s.ok()) {
+    io_s = log_writer->BeginConcurrentAppend(*write_with_wal, total_size);
+  }
+  if (io_s.ok()) {
+    for (auto* writer : write_group) {
+      if (!writer->CallbackFailed()) {
+        bool reserved = log_writer->ReserveRecord(
+            WriteBatchInternal::ByteSize(writer->batch),
+            &writer->wal_reservation);
+        assert(reserved);
+        (void)reserved;
+      }
+    }
+    write_group.wal_writer = log_writer;
+    write_thread_.LaunchParallelWalWriters(&write_group);
+    // Encode our own record, and those of the followers that have not woken
+    // up yet
+    for (auto* writer : write_group) {
+      if (write_thread_.ClaimParallelWalRecord(writer)) {
+        log_writer->FillRecord(writer->wal_reservation,
+                               WriteBatchInternal::Contents(writer->batch));
+        write_thread_.CompleteParallelWalRecord(&write_group);
+      }
+    }
+    write_thread_.WaitForParallelWalWriters(&write_group);
+    io_s = log_writer->EndConcurrentAppend(write_options);
+  }
+  if (UNLIKELY(needs_locking)) {
+    log_write_mutex_.Unlock();
+  }
+  if (log_used != nullptr) {
+    *log_used = logfile_number_;
+  }
+  total_log_size_ += total_size;
+  log_file_number_size.AddSize(total_size);
+  log_empty_ = false;
+  return io_s;
+}
+
+IOStatus DBImpl::WriteToWAL(WriteThread::WriteGroup& write_group,
                             log::Writer* log_writer, uint64_t* log_used,
                             bool need_log_sync, bool need_log_dir_sync,
                             SequenceNumber sequence,
@@ -1424,38 +1729,48 @@ IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
   // Same holds for all in the batch group
   size_t write_with_wal = 0;
   WriteBatch* to_be_cached_state = nullptr;
-  WriteBatch* merged_batch;
-  io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch_, &merged_batch,
-                                        &write_with_wal, &to_be_cached_state));
-  if (UNLIKELY(!io_s.ok())) {
-    return io_s;
-  }
-
-  if (merged_batch == write_group.leader->batch) {
-    write_group.leader->log_used = logfile_number_;
-  } else if (write_with_wal > 1) {
-    for (auto writer : write_group) {
-      writer->log_used = logfile_number_;
-    }
-  }
-
-  WriteBatchInternal::SetSequence(merged_batch, sequence);
-
+  WriteBatch* merged_batch = nullptr;
   uint64_t log_size;
 
   // TODO: plumb Env::IOActivity, Env::IOPriority
   WriteOptions write_options;
   write_options.rate_limiter_priority =
       write_group.leader->rate_limiter_priority;
-  io_s = WriteToWAL(*merged_batch, write_options, log_writer, log_used,
-                    &log_size, log_file_number_size);
+  if (ShouldWriteToWALInParallel(write_group)) {
+    io_s = ParallelWriteToWAL(write_group, write_options, log_writer, log_used,
+                              sequence, &log_size, &write_with_wal,
+                              &to_be_cached_state, log_file_number_size);
+  } else {
+    io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch_,
+                                          &merged_batch, &write_with_wal,
+                                          &to_be_cached_state));
+    if (UNLIKELY(!io_s.ok())) {
+      return io_s;
+    }
+
+    if (merged_batch == write_group.leader->batch) {
+      write_group.leader->log_used = logfile_number_;
+    } else if (write_with_wal > 1) {
+      for (auto writer : write_group) {
+        writer->log_used = logfile_number_;
+      }
+    }
+
+    WriteBatchInternal::SetSequence(merged_batch, sequence);
+
+    io_s = WriteToWAL(*merged_batch, write_options, log_writer, log_used,
+                      &log_size, log_file_number_size);
+  }
   if (to_be_cached_state) {
     cached_recoverable_state_ = *to_be_cached_state;
     cached_recoverable_state_empty_ = false;
   }
 
   if (io_s.ok() && need_log_sync) {
-    StopWatch sw(immutable_db_options_.clock, stats_, WAL_FILE_SYNC_MICROS);
+    WriteStageStopWatch sw(immutable_db_options_.clock, stats_,
+                           default_cf_internal_stats_,
+                           InternalStats::kWriteQueueMain,
+                           InternalStats::kWriteStageWalSync);
     // It's safe to access logs_ with unlocked mutex_ here because:
     //  - we've set getting_synced=true for all logs,
     //    so other threads won't pop from logs_ while we're here,
@@ -1527,7 +1842,7 @@ IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
 
 IOStatus DBImpl::ConcurrentWriteToWAL(
     const WriteThread::WriteGroup& write_group, uint64_t* log_used,
-    SequenceNumber* last_sequence, size_t seq_inc) {
+    SequenceNumber* last_sequence, size_t seq_inc, bool nonmem_queue) {
   IOStatus io_s;
 
   assert(two_write_queues_ || immutable_db_options_.unordered_write);
@@ -1553,23 +1868,48 @@ IOStatus DBImpl::ConcurrentWriteToWAL(
       writer->log_used = logfile_number_;
     }
   }
-  *last_sequence = versions_->FetchAddLastAllocatedSequence(seq_inc);
-  auto sequence = *last_sequence + 1;
-  WriteBatchInternal::SetSequence(merged_batch, sequence);
-
-  log::Writer* log_writer = logs_.back().writer;
-  LogFileNumberSize& log_file_number_size = alive_log_files_.back();
-
-  assert(log_writer->get_log_number() == log_file_number_size.number);
-
-  uint64_t log_size;
-
   // TODO: plumb Env::IOActivity, Env::IOPriority
   WriteOptions write_options;
   write_options.rate_limiter_priority =
       write_group.leader->rate_limiter_priority;
-  io_s = WriteToWAL(*merged_batch, write_options, log_writer, log_used,
-                    &log_size, log_file_number_size);
+  uint64_t log_size;
+  log::Writer* stream_writer = nullptr;
+  if (nonmem_queue) {
+    stream_writer = logs_.back().stream_writer;
+  }
+  if (stream_writer == nullptr) {
+    *last_sequence = versions_->FetchAddLastAllocatedSequence(seq_inc);
+    auto sequence = *last_sequence + 1;
+    WriteBatchInternal::SetSequence(merged_batch, sequence);
+
+    log::Writer* log_writer = logs_.back().writer;
+    LogFileNumberSize& log_file_number_size = alive_log_files_.back();
+
+    assert(log_writer->get_log_number() == log_file_number_size.number);
+
+    io_s = WriteToWAL(*merged_batch, write_options, log_writer, log_used,
+                      &log_size, log_file_number_size);
+  } else {
+    // The WAL cannot be switched while this group is being written, since
+    // SwitchMemtable() waits for the nonmem queue to be empty. So the write
+    // to the stream can happen without holding log_write_mutex_.
+    log_write_mutex_.Unlock();
+    // Recovery orders the records of the two streams by sequence number only,
+    // so unlike in the main WAL, a record that is replayed into the memtable
+    // needs sequence numbers of its own even if the write does not assign
+    // order.
+    if (!seq_per_batch_) {
+      seq_inc = WriteBatchInternal::Count(merged_batch);
+    }
+    io_s = WriteToWALStream(merged_batch, write_options, stream_writer,
+                            last_sequence, seq_inc, &log_size);
+    log_write_mutex_.Lock();
+    if (log_used != nullptr) {
+      *log_used = logfile_number_;
+    }
+    alive_log_files_.back().AddSize(log_size);
+    log_empty_ = false;
+  }
   if (to_be_cached_state) {
     cached_recoverable_state_ = *to_be_cached_state;
     cached_recoverable_state_empty_ = false;
@@ -1981,6 +2321,11 @@ Status DBImpl::DelayWrite(uint64_t num_bytes, WriteThread& write_thread,
         InternalStats::kIntStatsWriteStallMicros, time_delayed);
     RecordTick(stats_, STALL_MICROS, time_delayed);
     RecordInHistogram(stats_, WRITE_STALL, time_delayed);
+    default_cf_internal_stats_->AddWriteStageLatency(
+        &write_thread == &nonmem_write_thread_
+            ? InternalStats::kWriteQueueWalOnly
+            : InternalStats::kWriteQueueMain,
+        InternalStats::kWriteStageDelay, time_delayed);
   }
 
   // If DB is not in read-only mode and write_controller is not stopping
@@ -2200,6 +2545,7 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context) {
   const WriteOptions write_options;
 
   log::Writer* new_log = nullptr;
+  log::Writer* new_stream = nullptr;
   MemTable* new_mem = nullptr;
   IOStatus io_s;
 
@@ -2254,6 +2600,10 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context) {
     // of mutable_cf_options.write_buffer_size.
     io_s = CreateWAL(write_options, new_log_number, recycle_log_number,
                      preallocate_block_size, &new_log);
+    if (io_s.ok()) {
+      io_s = CreateWALStream(write_options, new_log_number,
+                             preallocate_block_size, &new_stream);
+    }
     if (s.ok()) {
       s = io_s;
     }
@@ -2307,7 +2657,7 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context) {
       logfile_number_ = new_log_number;
       log_empty_ = true;
       log_dir_synced_ = false;
-      logs_.emplace_back(logfile_number_, new_log);
+      logs_.emplace_back(logfile_number_, new_log, new_stream);
       alive_log_files_.emplace_back(logfile_number_);
     }
   }
@@ -2317,6 +2667,7 @@ Status DBImpl::SwitchMemtable(ColumnFamilyData* cfd, WriteContext* context) {
     assert(creating_new_log);
     delete new_mem;
     delete new_log;
+    delete new_stream;
     context->superversion_context.new_superversion.reset();
     // We may have lost data from the WritableFileBuffer in-memory buffer for
     // the current log, so treat it as a fatal error and set bg_error
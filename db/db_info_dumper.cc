@@ -73,6 +73,7 @@ void DumpDBFileSummary(const ImmutableDBOptions& options,
         }
         break;
       case kWalFile:
+      case kWalStreamFile:
         s = env->GetFileSize(dbname + "/" + file, &file_size);
         if (s.ok()) {
           wal_info.append(file)
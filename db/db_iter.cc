@@ -1755,6 +1755,38 @@ void DBIter::SeekToLast() {
   }
 }
 
+void DBIter::Prepare(const std::vector<ScanRange>& scan_ranges) {
+  ReleaseTempPinnedData();
+  ResetBlobValue();
+  ResetValueAndColumns();
+  valid_ = false;
+  status_ = Status::OK();
+
+  scan_range_keys_.clear();
+  internal_scan_ranges_.clear();
+  // Reserve up front so that the slices below stay valid.
+  scan_range_keys_.reserve(scan_ranges.size() * 2);
+  for (const ScanRange& range : scan_ranges) {
+    for (const Slice* user_key : {&range.start, &range.limit}) {
+      scan_range_keys_.emplace_back();
+      std::string& ikey = scan_range_keys_.back();
+      // The smallest internal key with this user key
+      if (timestamp_size_ > 0) {
+        AppendKeyWithMaxTimestamp(&ikey, *user_key, timestamp_size_);
+      } else {
+        ikey.append(user_key->data(), user_key->size());
+      }
+      AppendInternalKeyFooter(&ikey, kMaxSequenceNumber, kValueTypeForSeek);
+    }
+  }
+  internal_scan_ranges_.reserve(scan_ranges.size());
+  for (size_t i = 0; i < scan_range_keys_.size(); i += 2) {
+    internal_scan_ranges_.emplace_back(scan_range_keys_[i],
+                                       scan_range_keys_[i + 1]);
+  }
+  iter_.Prepare(internal_scan_ranges_);
+}
+
 Iterator* NewDBIterator(Env* env, const ReadOptions& read_options,
                         const ImmutableOptions& ioptions,
                         const MutableCFOptions& mutable_cf_options,
@@ -208,6 +208,9 @@ class DBIter final : public Iterator {
   void SeekForPrev(const Slice& target) final override;
   void SeekToFirst() final override;
   void SeekToLast() final override;
+  // Converts the user key ranges to internal key ranges and passes them down
+  // to the internal iterator. `scan_ranges` do not contain timestamps.
+  void Prepare(const std::vector<ScanRange>& scan_ranges) final override;
   Env* env() const { return env_; }
   void set_sequence(uint64_t s) {
     sequence_ = s;
@@ -428,6 +431,10 @@ class DBIter final : public Iterator {
   const Slice* const timestamp_lb_;
   const size_t timestamp_size_;
   std::string saved_timestamp_;
+  // Internal key ranges passed to the internal iterator by Prepare(), and the
+  // memory backing them.
+  std::vector<std::string> scan_range_keys_;
+  std::vector<ScanRange> internal_scan_ranges_;
 };
 
 // Return a new iterator that converts internal keys (yielded by
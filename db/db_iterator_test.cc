@@ -118,6 +118,104 @@ class DBIteratorTest : public DBIteratorBaseTest,
   std::vector<std::unique_ptr<DummyReadCallback>> read_callbacks_;
 };
 
+TEST_F(DBIteratorBaseTest, MultiScan) {
+  for (bool use_block_cache : {true, false}) {
+    Options options = CurrentOptions();
+    options.compression = kNoCompression;
+    options.disable_auto_compactions = true;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 256;
+    table_options.no_block_cache = !use_block_cache;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    DestroyAndReopen(options);
+
+    // Keys spread over L1, L0 and the memtable
+    Random rnd(301);
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_OK(Put(Key(i), rnd.RandomString(50)));
+    }
+    ASSERT_OK(Flush());
+    MoveFilesToLevel(1);
+    for (int i = 0; i < 1000; i += 3) {
+      ASSERT_OK(Put(Key(i), rnd.RandomString(50)));
+    }
+    ASSERT_OK(Delete(Key(20)));
+    ASSERT_OK(Flush());
+    for (int i = 0; i < 1000; i += 7) {
+      ASSERT_OK(Put(Key(i), rnd.RandomString(50)));
+    }
+
+    // Unsorted, overlapping, empty and out of range
+    const std::vector<std::pair<std::string, std::string>> bounds = {
+        {Key(500), Key(520)}, {Key(10), Key(40)},     {Key(30), Key(60)},
+        {Key(700), Key(700)}, {Key(990), Key(2000)}, {Key(3000), Key(4000)}};
+    std::vector<ScanRange> ranges;
+    for (const auto& b : bounds) {
+      ranges.emplace_back(b.first, b.second);
+    }
+
+    using KVs = std::vector<std::pair<std::string, std::string>>;
+    std::vector<KVs> expected(ranges.size());
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+      for (size_t i = 0; i < ranges.size(); ++i) {
+        for (iter->Seek(ranges[i].start);
+             iter->Valid() && iter->key().compare(ranges[i].limit) < 0;
+             iter->Next()) {
+          expected[i].emplace_back(iter->key().ToString(),
+                                   iter->value().ToString());
+        }
+        ASSERT_OK(iter->status());
+      }
+    }
+    ASSERT_EQ(expected[0].size(), 20);
+    ASSERT_EQ(expected[1].size(), 29);
+    ASSERT_TRUE(expected[3].empty());
+    ASSERT_TRUE(expected[5].empty());
+
+    // Blocks of the same file are read with one MultiRead() per batch, in
+    // which adjacent blocks share a request. Blocks the iterator above loaded
+    // into the block cache are not read again.
+    size_t blocks_read = 0;
+    size_t read_requests = 0;
+    SyncPoint::GetInstance()->SetCallBack(
+        "BlockBasedTable::MultiReadDataBlocks:MultiRead", [&](void* arg) {
+          auto* blocks_and_requests =
+              static_cast<std::pair<size_t, size_t>*>(arg);
+          ASSERT_GT(blocks_and_requests->second, 0);
+          ASSERT_LE(blocks_and_requests->second, blocks_and_requests->first);
+          blocks_read += blocks_and_requests->first;
+          read_requests += blocks_and_requests->second;
+        });
+    SyncPoint::GetInstance()->EnableProcessing();
+    std::vector<KVs> actual(ranges.size());
+    ASSERT_OK(db_->MultiScan(
+        ReadOptions(), db_->DefaultColumnFamily(), ranges,
+        [&](size_t idx, const Slice& key, const Slice& value) {
+          actual[idx].emplace_back(key.ToString(), value.ToString());
+          return true;
+        }));
+    SyncPoint::GetInstance()->DisableProcessing();
+    SyncPoint::GetInstance()->ClearAllCallBacks();
+    ASSERT_EQ(expected, actual);
+    if (use_block_cache) {
+      ASSERT_EQ(blocks_read, 0);
+    } else {
+      ASSERT_LT(read_requests, blocks_read);
+    }
+
+    // The callback can stop the scan of a range early
+    std::vector<size_t> counts(ranges.size());
+    ASSERT_OK(db_->MultiScan(ReadOptions(), db_->DefaultColumnFamily(), ranges,
+                             [&](size_t idx, const Slice&, const Slice&) {
+                               return ++counts[idx] < 2;
+                             }));
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      ASSERT_EQ(counts[i], std::min<size_t>(expected[i].size(), 2));
+    }
+  }
+}
+
 TEST_P(DBIteratorTest, IteratorProperty) {
   // The test needs to be changed if kPersistedTier is supported in iterator.
   Options options = CurrentOptions();
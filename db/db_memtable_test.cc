@@ -4,6 +4,7 @@
 //  (found in the LICENSE.Apache file in the root directory).
 
 #include <memory>
+#include <set>
 #include <string>
 
 #include "db/db_test_util.h"
@@ -320,6 +321,231 @@ TEST_F(DBMemTableTest, InsertWithHint) {
   ASSERT_EQ("vvv", Get("NotInPrefixDomain"));
 }
 
+TEST_F(DBMemTableTest, BTreeRep) {
+  Options options;
+  InternalKeyComparator cmp(BytewiseComparator());
+  options.memtable_factory = std::make_shared<BTreeRepFactory>();
+  WriteBufferManager wb(options.db_write_buffer_size);
+  Random rnd(301);
+
+  for (bool with_hint : {false, true}) {
+    if (with_hint) {
+      options.memtable_insert_with_hint_prefix_extractor.reset(
+          new TestPrefixExtractor());
+    }
+    ImmutableOptions ioptions(options);
+    std::unique_ptr<MemTable> mem(
+        new MemTable(cmp, ioptions, MutableCFOptions(options), &wb,
+                     kMaxSequenceNumber, 0 /* column_family_id */));
+
+    // A few prefixes, each of which is mostly appended to
+    std::set<std::string> expected;
+    SequenceNumber seq = 1;
+    for (int i = 0; i < 10000; i++) {
+      std::string key = "p" + std::to_string(rnd.Uniform(4)) + "_" +
+                        Key(rnd.OneIn(4) ? rnd.Uniform(100000) : i * 10);
+      if (!expected.insert(key).second) {
+        continue;
+      }
+      ASSERT_OK(mem->Add(seq, kTypeValue, key, "value",
+                         nullptr /* kv_prot_info */));
+      ASSERT_TRUE(mem->Add(seq, kTypeValue, key, "value",
+                           nullptr /* kv_prot_info */)
+                      .IsTryAgain());
+      seq++;
+    }
+
+    Arena arena;
+    ScopedArenaPtr<InternalIterator> iter(
+        mem->NewIterator(ReadOptions(), /*seqno_to_time_mapping=*/nullptr,
+                         &arena));
+    auto it = expected.begin();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++it) {
+      ASSERT_TRUE(it != expected.end());
+      ASSERT_EQ(*it, ExtractUserKey(iter->key()).ToString());
+    }
+    ASSERT_TRUE(it == expected.end());
+    auto rit = expected.rbegin();
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev(), ++rit) {
+      ASSERT_TRUE(rit != expected.rend());
+      ASSERT_EQ(*rit, ExtractUserKey(iter->key()).ToString());
+    }
+    ASSERT_TRUE(rit == expected.rend());
+
+    for (int i = 0; i < 1000; i++) {
+      std::string target = "p" + std::to_string(rnd.Uniform(5)) + "_" +
+                           Key(rnd.Uniform(110000));
+      InternalKey seek_key(target, kMaxSequenceNumber, kValueTypeForSeek);
+      iter->Seek(seek_key.Encode());
+      auto lower = expected.lower_bound(target);
+      if (lower == expected.end()) {
+        ASSERT_FALSE(iter->Valid());
+      } else {
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(*lower, ExtractUserKey(iter->key()).ToString());
+      }
+
+      InternalKey seek_for_prev_key(target, 0, kTypeValue);
+      iter->SeekForPrev(seek_for_prev_key.Encode());
+      auto upper = expected.upper_bound(target);
+      if (upper == expected.begin()) {
+        ASSERT_FALSE(iter->Valid());
+      } else {
+        ASSERT_TRUE(iter->Valid());
+        ASSERT_EQ(*std::prev(upper), ExtractUserKey(iter->key()).ToString());
+      }
+    }
+  }
+}
+
+TEST_F(DBMemTableTest, BTreeRepConcurrentWrite) {
+  const int kNumThreads = 4;
+  const int kNumKeysPerThread = 5000;
+  Options options;
+  InternalKeyComparator cmp(BytewiseComparator());
+  options.memtable_factory = std::make_shared<BTreeRepFactory>();
+  options.allow_concurrent_memtable_write = true;
+  ImmutableOptions ioptions(options);
+  WriteBufferManager wb(options.db_write_buffer_size);
+  std::unique_ptr<MemTable> mem(
+      new MemTable(cmp, ioptions, MutableCFOptions(options), &wb,
+                   kMaxSequenceNumber, 0 /* column_family_id */));
+
+  std::atomic<int> writers_done{0};
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&, t]() {
+      MemTablePostProcessInfo post_process_info;
+      for (int i = 0; i < kNumKeysPerThread; i++) {
+        int k = i * kNumThreads + t;
+        ASSERT_OK(mem->Add(k + 1, kTypeValue, Key(k), "value",
+                           nullptr /* kv_prot_info */,
+                           true /* allow_concurrent */, &post_process_info));
+      }
+      writers_done.fetch_add(1);
+    });
+  }
+  // Iterators stay sorted while leaves are split under them
+  threads.emplace_back([&]() {
+    while (writers_done.load() < kNumThreads) {
+      Arena arena;
+      ScopedArenaPtr<InternalIterator> iter(mem->NewIterator(
+          ReadOptions(), /*seqno_to_time_mapping=*/nullptr, &arena));
+      std::string prev;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+        std::string user_key = ExtractUserKey(iter->key()).ToString();
+        ASSERT_LT(prev, user_key);
+        prev = user_key;
+      }
+    }
+  });
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  Arena arena;
+  ScopedArenaPtr<InternalIterator> iter(mem->NewIterator(
+      ReadOptions(), /*seqno_to_time_mapping=*/nullptr, &arena));
+  int k = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), k++) {
+    ASSERT_EQ(Key(k), ExtractUserKey(iter->key()).ToString());
+  }
+  ASSERT_EQ(kNumThreads * kNumKeysPerThread, k);
+}
+
+TEST_F(DBMemTableTest, BTreeRepWithDB) {
+  Options options = CurrentOptions();
+  options.memtable_factory = std::make_shared<BTreeRepFactory>();
+  options.allow_concurrent_memtable_write = true;
+  DestroyAndReopen(options);
+
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = t; i < 2000; i += 4) {
+        ASSERT_OK(Put(Key(i), "v1_" + std::to_string(i)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const Snapshot* snapshot = db_->GetSnapshot();
+  for (int i = 0; i < 2000; i += 2) {
+    ASSERT_OK(Put(Key(i), "v2_" + std::to_string(i)));
+  }
+
+  for (int i = 0; i < 2000; i++) {
+    ASSERT_EQ("v1_" + std::to_string(i), Get(Key(i), snapshot));
+    ASSERT_EQ((i % 2 == 0 ? "v2_" : "v1_") + std::to_string(i), Get(Key(i)));
+  }
+  ReadOptions ro;
+  ro.snapshot = snapshot;
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ro));
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), count++) {
+    ASSERT_EQ(Key(count), iter->key().ToString());
+    ASSERT_EQ("v1_" + std::to_string(count), iter->value().ToString());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(2000, count);
+  iter.reset();
+  db_->ReleaseSnapshot(snapshot);
+
+  ASSERT_OK(Flush());
+  for (int i = 0; i < 2000; i++) {
+    ASSERT_EQ((i % 2 == 0 ? "v2_" : "v1_") + std::to_string(i), Get(Key(i)));
+  }
+}
+
+TEST_F(DBMemTableTest, ValueSeparation) {
+  Options options = CurrentOptions();
+  options.memtable_value_separation_min_size = 100;
+  options.memtable_protection_bytes_per_key = 8;
+  options.merge_operator = MergeOperators::CreateStringAppendOperator();
+  options.enable_blob_files = true;
+  options.min_blob_size = 100;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int i = 0; i < 100; i++) {
+    // Alternate between values stored inline and separated values.
+    values.push_back(rnd.RandomString(i % 2 == 0 ? 10 : 100 + i * 50));
+    ASSERT_OK(Put(Key(i), values.back()));
+  }
+  std::string large_operand = rnd.RandomString(1000);
+  ASSERT_OK(Merge(Key(1), large_operand));
+  values[1] += "," + large_operand;
+  // A range tombstone whose end key is large enough to be separated.
+  std::string end_key = Key(90) + std::string(200, 'x');
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(80), end_key));
+
+  auto verify = [&]() {
+    for (int i = 0; i < 100; i++) {
+      ASSERT_EQ(i >= 80 && i <= 90 ? "NOT_FOUND" : values[i], Get(Key(i)));
+    }
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int i = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), i++) {
+      if (i == 80) {
+        i = 91;
+      }
+      ASSERT_EQ(Key(i), iter->key());
+      ASSERT_EQ(values[i], iter->value());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(100, i);
+  };
+  verify();
+
+  // Separated values are written to blob files by flush.
+  ASSERT_OK(Flush());
+  ASSERT_FALSE(GetBlobFileNumbers().empty());
+  verify();
+}
+
 TEST_F(DBMemTableTest, ColumnFamilyId) {
   // Verifies MemTableRepFactory is told the right column family id.
   Options options;
@@ -2114,6 +2114,62 @@ TEST_F(DBPropertiesTest, GetMapPropertyDbStats) {
   Close();
 }
 
+TEST_F(DBPropertiesTest, GetMapPropertyWriteStageStats) {
+  Options options = CurrentOptions();
+  options.statistics = CreateDBStatistics();
+  CreateAndReopenWithCF({"pikachu"}, options);
+
+  std::map<std::string, std::string> stage_stats;
+  ASSERT_TRUE(db_->GetMapProperty(DB::Properties::kDBWriteStageStats,
+                                  &stage_stats));
+  ASSERT_EQ("0", stage_stats["main.thread-wait.count"]);
+  ASSERT_EQ("0", stage_stats["wal-only.wal.count"]);
+
+  WriteOptions write_opts;
+  ASSERT_OK(Put("key1", "val", write_opts));
+  write_opts.sync = true;
+  ASSERT_OK(Put("key2", "val", write_opts));
+  write_opts.sync = false;
+  write_opts.disableWAL = true;
+  ASSERT_OK(Put(1, "key3", "val", write_opts));
+
+  stage_stats.clear();
+  ASSERT_TRUE(db_->GetMapProperty(DB::Properties::kDBWriteStageStats,
+                                  &stage_stats));
+  ASSERT_EQ("3", stage_stats["main.thread-wait.count"]);
+  ASSERT_EQ("2", stage_stats["main.wal.count"]);
+  ASSERT_EQ("1", stage_stats["main.wal-sync.count"]);
+  ASSERT_EQ("3", stage_stats["main.memtable.count"]);
+  ASSERT_EQ("0", stage_stats["main.delay.count"]);
+  ASSERT_EQ("0", stage_stats["wal-only.thread-wait.count"]);
+
+  std::string str;
+  ASSERT_TRUE(db_->GetProperty(DB::Properties::kDBWriteStageStats, &str));
+  ASSERT_NE(std::string::npos, str.find("main memtable: count 3 "));
+  ASSERT_EQ(std::string::npos, str.find("wal-only"));
+
+  HistogramData data;
+  options.statistics->histogramData(DB_WRITE_THREAD_WAIT_MICROS, &data);
+  ASSERT_EQ(3, data.count);
+  options.statistics->histogramData(DB_WRITE_WAL_MICROS, &data);
+  ASSERT_EQ(2, data.count);
+  options.statistics->histogramData(WAL_FILE_SYNC_MICROS, &data);
+  ASSERT_EQ(1, data.count);
+  options.statistics->histogramData(DB_WRITE_MEMTABLE_MICROS, &data);
+  ASSERT_EQ(3, data.count);
+
+  // DB-scope, so not reported for other column families
+  stage_stats.clear();
+  ASSERT_TRUE(db_->GetMapProperty(
+      handles_[1], DB::Properties::kDBWriteStageStats, &stage_stats));
+  ASSERT_TRUE(stage_stats.empty());
+
+  ASSERT_OK(db_->ResetStats());
+  ASSERT_TRUE(db_->GetMapProperty(DB::Properties::kDBWriteStageStats,
+                                  &stage_stats));
+  ASSERT_EQ("0", stage_stats["main.memtable.count"]);
+}
+
 TEST_F(DBPropertiesTest, GetMapPropertyBlockCacheEntryStats) {
   // Currently only verifies the expected properties are present
   std::map<std::string, std::string> values;
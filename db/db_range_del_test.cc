@@ -711,6 +711,53 @@ TEST_F(DBRangeDelTest, GetCoveredKeyFromMutableMemtable) {
   } while (ChangeOptions(kRangeDelSkipConfigs));
 }
 
+TEST_F(DBRangeDelTest, InterleavedDeleteRangeAndReadsInMutableMemtable) {
+  // Reads after each DeleteRange build the memtable's fragmented range
+  // tombstones from those of the previous read, unless too many DeleteRanges
+  // happened in between.
+  Options options = CurrentOptions();
+  options.write_buffer_size = 64 << 20;
+  DestroyAndReopen(options);
+  const int kNumKeys = 100;
+  std::vector<bool> live(kNumKeys, true);
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), "val"));
+  }
+  Random rnd(301);
+  for (int round = 0; round < 300; ++round) {
+    int num_range_dels = round % 50 == 49 ? 100 : 1;
+    for (int i = 0; i < num_range_dels; ++i) {
+      int start = rnd.Uniform(kNumKeys);
+      int end = start + 1 + rnd.Uniform(10);
+      ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                                 Key(start), Key(end)));
+      std::fill(live.begin() + start, live.begin() + std::min(end, kNumKeys),
+                false);
+      int k = rnd.Uniform(kNumKeys);
+      ASSERT_OK(Put(Key(k), "val"));
+      live[k] = true;
+    }
+    int k = rnd.Uniform(kNumKeys);
+    ASSERT_EQ(live[k] ? "val" : "NOT_FOUND", Get(Key(k)));
+    if (round % 10 == 0) {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+      int i = 0;
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+        while (i < kNumKeys && !live[i]) {
+          ++i;
+        }
+        ASSERT_LT(i, kNumKeys);
+        ASSERT_EQ(Key(i), iter->key());
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(kNumKeys, std::find(live.begin() + i, live.end(), true) -
+                              live.begin());
+    }
+  }
+  // All of the above was served by the mutable memtable.
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+}
+
 TEST_F(DBRangeDelTest, GetCoveredKeyFromImmutableMemtable) {
   do {
     Options opts = CurrentOptions();
@@ -1898,6 +1898,63 @@ TEST_F(DBTest2, CompressionOptions) {
   }
 }
 
+TEST_F(DBTest2, ParallelCompressionStats) {
+  class StatsListener : public EventListener {
+   public:
+    void OnCompactionCompleted(DB* /*db*/,
+                               const CompactionJobInfo& ci) override {
+      std::lock_guard<std::mutex> lock(mutex_);
+      compress_nanos_ += ci.stats.parallel_compression_nanos;
+      ++num_compactions_;
+    }
+    std::mutex mutex_;
+    uint64_t compress_nanos_ = 0;
+    int num_compactions_ = 0;
+  };
+  auto listener = std::make_shared<StatsListener>();
+
+  Options options = CurrentOptions();
+  options.compression = GetSupportedCompressions().back();
+  options.compression_opts.parallel_threads = 4;
+  options.report_bg_io_stats = true;
+  options.listeners.emplace_back(listener);
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 256;
+  table_options.index_type = BlockBasedTableOptions::kTwoLevelIndexSearch;
+  table_options.partition_filters = true;
+  table_options.filter_policy.reset(NewBloomFilterPolicy(10));
+  table_options.metadata_block_size = 256;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 500; j++) {
+      std::string key = Key(rnd.Uniform(2000));
+      expected[key] = rnd.RandomString(50);
+      ASSERT_OK(Put(key, expected[key]));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  ASSERT_GT(listener->num_compactions_, 0);
+  ASSERT_GT(listener->compress_nanos_, 0);
+
+  for (const auto& kv : expected) {
+    ASSERT_EQ(kv.second, Get(kv.first));
+  }
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  size_t count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_EQ(expected[iter->key().ToString()], iter->value().ToString());
+    ++count;
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(expected.size(), count);
+}
+
 class CompactionStallTestListener : public EventListener {
  public:
   CompactionStallTestListener()
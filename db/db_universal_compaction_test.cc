@@ -2086,6 +2086,52 @@ TEST_F(DBTestUniversalCompaction2, OverlappingL0) {
   ASSERT_GT(NumTableFilesAtLevel(6), 0);
 }
 
+TEST_F(DBTestUniversalCompaction2, LazyLevelingDoesNotSlowDownWrites) {
+  Options opts = CurrentOptions();
+  opts.compaction_style = kCompactionStyleUniversal;
+  opts.num_levels = 20;
+  opts.compression = kNoCompression;
+  opts.write_buffer_size = 100 << 10;  // 100KB
+  opts.level0_file_num_compaction_trigger = 2;
+  opts.level0_slowdown_writes_trigger = 4;
+  opts.level0_stop_writes_trigger = 8;
+  opts.compaction_options_universal.max_runs_per_tier = 2;
+  // Keep the tiered runs apart from the oldest run
+  opts.compaction_options_universal.max_size_amplification_percent = 10000;
+  Reopen(opts);
+
+  int runs_per_tier_compactions = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "UniversalCompactionBuilder::PickCompaction:Return", [&](void* arg) {
+        auto c = static_cast<Compaction*>(arg);
+        if (c != nullptr && c->compaction_reason() ==
+                                CompactionReason::kUniversalRunsPerTier) {
+          runs_per_tier_compactions++;
+        }
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  // Each flush writes a run of tier 0, and merging two runs of a tier moves
+  // them up a tier. Runs of more tiers than the slowdown trigger allows then
+  // pile up unless partially filled tiers are merged early.
+  Random rnd(301);
+  int key_idx = 0;
+  for (int num = 0; num < 64; num++) {
+    // 80KB, so that the memtable is not flushed before Flush()
+    for (int i = 0; i < 8; i++) {
+      ASSERT_OK(Put(Key(key_idx++), rnd.RandomString(10 << 10)));
+    }
+    ASSERT_OK(Flush());
+    ASSERT_FALSE(dbfull()->TEST_write_controler().NeedsDelay());
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+    ASSERT_LT(NumSortedRuns(), opts.level0_slowdown_writes_trigger - 1);
+  }
+  ASSERT_GT(runs_per_tier_compactions, 0);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBTestUniversalCompaction2, IngestBehind) {
   const int kNumKeys = 3000;
   const int kWindowSize = 100;
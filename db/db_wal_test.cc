@@ -228,6 +228,110 @@ TEST_F(DBWALTest, RollLog) {
   } while (ChangeWalOptions());
 }
 
+TEST_F(DBWALTest, WalPerWriteQueue) {
+  Options options = CurrentOptions();
+  options.wal_per_write_queue = true;
+  ASSERT_TRUE(TryReopen(options).IsInvalidArgument());
+
+  options.two_write_queues = true;
+  DestroyAndReopen(options);
+  const std::string wal_dir =
+      options.wal_dir.empty() ? dbname_ : options.wal_dir;
+  const std::string stream_fname = LogStreamFileName(
+      wal_dir, dbfull()->TEST_LogfileNumber(), /*stream=*/1);
+  ASSERT_OK(env_->FileExists(stream_fname));
+
+  // Interleave writes of the WAL-only queue, which go to the WAL stream, with
+  // writes of the main queue overwriting the same keys.
+  for (int i = 0; i < 10; ++i) {
+    const std::string key = "key" + std::to_string(i % 3);
+    WriteBatch batch;
+    ASSERT_OK(batch.Put(key, "stream" + std::to_string(i)));
+    ASSERT_OK(batch.Put("stream_only" + std::to_string(i), "v"));
+    ASSERT_OK(dbfull()->WriteImpl(WriteOptions(), &batch, nullptr, nullptr,
+                                  nullptr, 0, /*disable_memtable=*/true,
+                                  nullptr, /*batch_cnt=*/2));
+    ASSERT_OK(Put(key, "main" + std::to_string(i)));
+  }
+  uint64_t stream_size = 0;
+  ASSERT_OK(env_->GetFileSize(stream_fname, &stream_size));
+  ASSERT_GT(stream_size, 0);
+  ASSERT_OK(dbfull()->SyncWAL());
+
+  // Recovery replays the records of both streams in sequence number order
+  Reopen(options);
+  ASSERT_EQ("main9", Get("key0"));
+  ASSERT_EQ("main7", Get("key1"));
+  ASSERT_EQ("main8", Get("key2"));
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ("v", Get("stream_only" + std::to_string(i)));
+  }
+
+  std::unique_ptr<TransactionLogIterator> iter;
+  ASSERT_TRUE(db_->GetUpdatesSince(0, &iter).IsNotSupported());
+
+  // The stream is deleted along with its WAL once the WAL is obsolete
+  ASSERT_OK(Flush());
+  ASSERT_TRUE(env_->FileExists(stream_fname).IsNotFound());
+
+  const std::string cur_stream_fname = LogStreamFileName(
+      wal_dir, dbfull()->TEST_LogfileNumber(), /*stream=*/1);
+  ASSERT_OK(env_->FileExists(cur_stream_fname));
+  Close();
+  ASSERT_OK(DestroyDB(dbname_, options));
+  ASSERT_TRUE(env_->FileExists(cur_stream_fname).IsNotFound());
+}
+
+TEST_F(DBWALTest, WalPerWriteQueueSyncCoversEarlierStreamWrites) {
+  std::unique_ptr<FaultInjectionTestEnv> fault_env(
+      new FaultInjectionTestEnv(env_));
+  Options options = CurrentOptions();
+  options.env = fault_env.get();
+  options.two_write_queues = true;
+  options.wal_per_write_queue = true;
+  DestroyAndReopen(options);
+
+  // The write to the WAL stream gets the smaller sequence number, but only
+  // appends its record while the synced write of the main queue is syncing.
+  SyncPoint::GetInstance()->LoadDependency(
+      {{"DBWALTest::WalPerWriteQueueSync:StreamSeqAllocated",
+        "DBWALTest::WalPerWriteQueueSync:BeforeSyncedWrite"},
+       {"DBImpl::SyncWalImpl:BeforeWaitForWALStream",
+        "DBWALTest::WalPerWriteQueueSync:AppendStreamRecord"}});
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::WriteToWALStream:log_entry", [](void* /*arg*/) {
+        TEST_SYNC_POINT("DBWALTest::WalPerWriteQueueSync:StreamSeqAllocated");
+        TEST_SYNC_POINT("DBWALTest::WalPerWriteQueueSync:AppendStreamRecord");
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  port::Thread stream_writer([&]() {
+    WriteBatch batch;
+    ASSERT_OK(batch.Put("stream", "v"));
+    ASSERT_OK(dbfull()->WriteImpl(WriteOptions(), &batch, nullptr, nullptr,
+                                  nullptr, 0, /*disable_memtable=*/true,
+                                  nullptr, /*batch_cnt=*/1));
+  });
+  TEST_SYNC_POINT("DBWALTest::WalPerWriteQueueSync:BeforeSyncedWrite");
+  WriteOptions sync_write_options;
+  sync_write_options.sync = true;
+  ASSERT_OK(Put("main", "v", sync_write_options));
+  stream_writer.join();
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  Close();
+
+  // The sync covered the stream record, so no hole is left before the synced
+  // write once the unsynced data is lost.
+  ASSERT_OK(fault_env->DropUnsyncedFileData());
+  Reopen(options);
+  ASSERT_EQ("v", Get("stream"));
+  ASSERT_EQ("v", Get("main"));
+
+  // Need to close before `fault_env` goes out of scope.
+  Close();
+}
+
 TEST_F(DBWALTest, SyncWALNotBlockWrite) {
   Options options = CurrentOptions();
   options.max_write_buffer_number = 4;
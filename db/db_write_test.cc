@@ -6,6 +6,7 @@
 #include <atomic>
 #include <cstdint>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -1000,6 +1001,135 @@ TEST_P(DBWriteTest, RecycleLogToggleTest) {
   ASSERT_EQ(Get(Key(1)), "val2");
 }
 
+TEST_P(DBWriteTest, MemtableSortedBatchInsert) {
+  for (bool concurrent_memtable_write : {false, true}) {
+    Options options = GetOptions();
+    options.memtable_sorted_batch_insert = true;
+    options.allow_concurrent_memtable_write = concurrent_memtable_write;
+    options.merge_operator = MergeOperators::CreateStringAppendOperator();
+    DestroyAndReopen(options);
+
+    constexpr int kNumThreads = 4;
+    constexpr int kNumBatches = 20;
+    constexpr int kKeysPerBatch = 50;
+    // Expected contents, per thread (threads write disjoint key ranges)
+    std::vector<std::map<std::string, std::string>> expected(kNumThreads);
+    std::vector<port::Thread> threads;
+    for (int t = 0; t < kNumThreads; t++) {
+      threads.emplace_back([&, t] {
+        Random rnd(301 + t);
+        auto& exp = expected[t];
+        auto key = [t](int k) {
+          return "t" + std::to_string(t) + "_" + Key(k);
+        };
+        for (int b = 0; b < kNumBatches; b++) {
+          WriteBatch batch;
+          for (int i = 0; i < kKeysPerBatch; i++) {
+            int k = static_cast<int>(rnd.Uniform(200));
+            switch (rnd.Uniform(4)) {
+              case 0: {
+                ASSERT_OK(batch.Delete(key(k)));
+                exp.erase(key(k));
+                break;
+              }
+              case 1: {
+                ASSERT_OK(batch.Merge(key(k), "m"));
+                auto& v = exp[key(k)];
+                v = v.empty() ? "m" : v + ",m";
+                break;
+              }
+              default: {
+                std::string value = rnd.RandomString(10);
+                ASSERT_OK(batch.Put(key(k), value));
+                exp[key(k)] = value;
+                break;
+              }
+            }
+          }
+          if (b % 5 == 4) {
+            int begin = static_cast<int>(rnd.Uniform(190));
+            ASSERT_OK(batch.DeleteRange(key(begin), key(begin + 10)));
+            exp.erase(exp.lower_bound(key(begin)),
+                      exp.lower_bound(key(begin + 10)));
+          }
+          ASSERT_OK(db_->Write(WriteOptions(), &batch));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    auto verify = [&]() {
+      std::map<std::string, std::string> all;
+      for (auto& exp : expected) {
+        all.insert(exp.begin(), exp.end());
+      }
+      std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+      auto exp_iter = all.begin();
+      for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++exp_iter) {
+        ASSERT_TRUE(exp_iter != all.end());
+        ASSERT_EQ(exp_iter->first, iter->key().ToString());
+        ASSERT_EQ(exp_iter->second, iter->value().ToString());
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_TRUE(exp_iter == all.end());
+    };
+    verify();
+    // Recovery inserts the WAL batches in sorted order too
+    Reopen(options);
+    verify();
+  }
+}
+
+TEST_P(DBWriteTest, ParallelWalWrites) {
+  Options options = GetOptions();
+  options.parallel_wal_writes = true;
+  options.avoid_flush_during_recovery = true;
+  DestroyAndReopen(options);
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumBatches = 50;
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&, t] {
+      Random rnd(301 + t);
+      for (int b = 0; b < kNumBatches; b++) {
+        WriteBatch batch;
+        // Some batches span several log blocks
+        int value_size = b % 10 == 0 ? 40000 : 100;
+        for (int i = 0; i < 3; i++) {
+          ASSERT_OK(batch.Put("t" + std::to_string(t) + "_" + Key(b * 3 + i),
+                              rnd.RandomString(value_size)));
+        }
+        ASSERT_OK(db_->Write(WriteOptions(), &batch));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto verify = [&]() {
+    for (int t = 0; t < kNumThreads; t++) {
+      Random rnd(301 + t);
+      for (int b = 0; b < kNumBatches; b++) {
+        int value_size = b % 10 == 0 ? 40000 : 100;
+        for (int i = 0; i < 3; i++) {
+          ASSERT_EQ(rnd.RandomString(value_size),
+                    Get("t" + std::to_string(t) + "_" + Key(b * 3 + i)));
+        }
+      }
+    }
+  };
+  verify();
+  // Recover the records from the WAL
+  Reopen(options);
+  verify();
+  ASSERT_EQ(static_cast<SequenceNumber>(kNumThreads * kNumBatches * 3),
+            dbfull()->GetLatestSequenceNumber());
+}
+
 INSTANTIATE_TEST_CASE_P(DBWriteTestInstance, DBWriteTest,
                         testing::Values(DBTestBase::kDefault,
                                         DBTestBase::kConcurrentWALWrites,
@@ -36,6 +36,7 @@ TEST_F(FileNameTest, Parse) {
   } cases[] = {
       {"100.log", 100, kWalFile, kAllMode},
       {"0.log", 0, kWalFile, kAllMode},
+      {"100.log.1", 100, kWalStreamFile, kAllMode},
       {"0.sst", 0, kTableFile, kAllMode},
       {"CURRENT", 0, kCurrentFile, kAllMode},
       {"LOCK", 0, kDBLockFile, kAllMode},
@@ -95,7 +96,11 @@ TEST_F(FileNameTest, Parse) {
                                  "184467440737095516150.log",
                                  "100",
                                  "100.",
-                                 "100.lop"};
+                                 "100.lop",
+                                 "100.log.",
+                                 "100.log.0",
+                                 "100.log.1x",
+                                 "archive/100.log.1"};
   for (unsigned int i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
     std::string f = errors[i];
     ASSERT_TRUE(!ParseFileName(f, &number, &type)) << f;
@@ -141,6 +146,19 @@ TEST_F(FileNameTest, Construction) {
   ASSERT_EQ(192U, number);
   ASSERT_EQ(kWalFile, type);
 
+  uint32_t stream;
+  fname = LogStreamFileName("foo", 192, 1);
+  ASSERT_EQ("foo/", std::string(fname.data(), 4));
+  ASSERT_TRUE(ParseFileName(fname.c_str() + 4, &number, &type));
+  ASSERT_EQ(192U, number);
+  ASSERT_EQ(kWalStreamFile, type);
+  ASSERT_TRUE(ParseLogStreamFileName(fname.c_str() + 4, &number, &stream));
+  ASSERT_EQ(192U, number);
+  ASSERT_EQ(1U, stream);
+  ASSERT_FALSE(ParseLogStreamFileName("000192.log", &number, &stream));
+  ASSERT_FALSE(ParseLogStreamFileName("000192.log.0", &number, &stream));
+  ASSERT_FALSE(ParseLogStreamFileName("000192.log.1x", &number, &stream));
+
   fname = TableFileName({DbPath("bar", 0)}, 200, 0);
   std::string fname1 =
       TableFileName({DbPath("foo", 0), DbPath("bar", 0)}, 200, 1);
@@ -11,9 +11,11 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <unordered_set>
 #include <vector>
 
 #include "db/builder.h"
+#include "db/compaction/clipping_iterator.h"
 #include "db/db_iter.h"
 #include "db/dbformat.h"
 #include "db/event_helpers.h"
@@ -258,10 +260,14 @@ Status FlushJob::Run(LogsWithPrepTracker* prep_tracker, FileMetaData* file_meta,
     prev_cpu_write_nanos = IOSTATS(cpu_write_nanos);
     prev_cpu_read_nanos = IOSTATS(cpu_read_nanos);
   }
+  // Memtable resident column families always purge full write buffers, so
+  // that their data stays in memory; other flushes act as checkpoints.
+  const bool memtable_resident = cfd_->ioptions()->memtable_resident;
   Status mempurge_s = Status::NotFound("No MemPurge.");
-  if ((mempurge_threshold > 0.0) &&
+  if ((mempurge_threshold > 0.0 || memtable_resident) &&
       (flush_reason_ == FlushReason::kWriteBufferFull) && (!mems_.empty()) &&
-      MemPurgeDecider(mempurge_threshold) && !(db_options_.atomic_flush)) {
+      (memtable_resident || MemPurgeDecider(mempurge_threshold)) &&
+      !(db_options_.atomic_flush)) {
     cfd_->SetMempurgeUsed();
     mempurge_s = MemPurge();
     if (!mempurge_s.ok()) {
@@ -847,6 +853,68 @@ bool FlushJob::MemPurgeDecider(double threshold) {
           threshold);
 }
 
+void FlushJob::GetFlushPartitionBoundaries(
+    std::vector<std::string>* boundaries) {
+  assert(boundaries);
+  boundaries->clear();
+  const uint32_t max_partitions = mutable_cf_options_.max_flush_partitions;
+  if (max_partitions <= 1 ||
+      cfd_->ioptions()->compaction_style != kCompactionStyleLevel ||
+      cfd_->user_comparator()->timestamp_size() > 0) {
+    return;
+  }
+  uint64_t total_num_entries = 0;
+  for (MemTable* m : mems_) {
+    if (!m->IsRandomSampleSupported()) {
+      return;
+    }
+    total_num_entries += m->num_entries();
+  }
+  // Take a fixed number of samples per partition, spread over the memtables
+  // proportionally to their number of entries, so that the boundaries split
+  // the entries roughly evenly.
+  constexpr uint64_t kSamplesPerPartition = 64;
+  const uint64_t target_num_samples = kSamplesPerPartition * max_partitions;
+  if (total_num_entries < target_num_samples) {
+    return;
+  }
+  const Comparator* ucmp = cfd_->user_comparator();
+  std::vector<std::string> samples;
+  samples.reserve(target_num_samples);
+  for (MemTable* m : mems_) {
+    const uint64_t num_entries = m->num_entries();
+    if (num_entries == 0) {
+      continue;
+    }
+    const uint64_t target_sample_size = std::max<uint64_t>(
+        1, target_num_samples * num_entries / total_num_entries);
+    std::unordered_set<const char*> entries;
+    m->UniqueRandomSample(target_sample_size, &entries);
+    for (const char* entry : entries) {
+      samples.push_back(
+          ExtractUserKey(GetLengthPrefixedSlice(entry)).ToString());
+    }
+  }
+  if (samples.empty()) {
+    return;
+  }
+  std::sort(samples.begin(), samples.end(),
+            [ucmp](const std::string& a, const std::string& b) {
+              return ucmp->Compare(a, b) < 0;
+            });
+  // A boundary is the first key of the next partition, so it must be greater
+  // than the smallest sample and than the previous boundary for no partition
+  // to be empty.
+  for (uint32_t i = 1; i < max_partitions; ++i) {
+    const std::string& key = samples[i * samples.size() / max_partitions];
+    const std::string& prev =
+        boundaries->empty() ? samples.front() : boundaries->back();
+    if (ucmp->Compare(key, prev) > 0) {
+      boundaries->push_back(key);
+    }
+  }
+}
+
 Status FlushJob::WriteLevel0Table() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_FLUSH_WRITE_L0);
@@ -965,31 +1033,159 @@ Status FlushJob::WriteLevel0Table() {
       ReadOptions read_options(Env::IOActivity::kFlush);
       read_options.rate_limiter_priority = io_priority;
       const WriteOptions write_options(io_priority, Env::IOActivity::kFlush);
-      TableBuilderOptions tboptions(
-          *cfd_->ioptions(), mutable_cf_options_, read_options, write_options,
-          cfd_->internal_comparator(), cfd_->internal_tbl_prop_coll_factories(),
-          output_compression_, mutable_cf_options_.compression_opts,
-          cfd_->GetID(), cfd_->GetName(), 0 /* level */,
-          false /* is_bottommost */, TableFileCreationReason::kFlush,
-          oldest_key_time, current_time, db_id_, db_session_id_,
-          0 /* target_file_size */, meta_.fd.GetNumber(),
-          preclude_last_level_min_seqno_ == kMaxSequenceNumber
-              ? preclude_last_level_min_seqno_
-              : std::min(earliest_snapshot_, preclude_last_level_min_seqno_));
+      auto new_table_builder_options = [&](uint64_t file_number) {
+        return TableBuilderOptions(
+            *cfd_->ioptions(), mutable_cf_options_, read_options,
+            write_options, cfd_->internal_comparator(),
+            cfd_->internal_tbl_prop_coll_factories(), output_compression_,
+            mutable_cf_options_.compression_opts, cfd_->GetID(),
+            cfd_->GetName(), 0 /* level */, false /* is_bottommost */,
+            TableFileCreationReason::kFlush, oldest_key_time, current_time,
+            db_id_, db_session_id_, 0 /* target_file_size */, file_number,
+            preclude_last_level_min_seqno_ == kMaxSequenceNumber
+                ? preclude_last_level_min_seqno_
+                : std::min(earliest_snapshot_, preclude_last_level_min_seqno_));
+      };
+      TableBuilderOptions tboptions =
+          new_table_builder_options(meta_.fd.GetNumber());
       const SequenceNumber job_snapshot_seq =
           job_context_->GetJobSnapshotSequence();
 
-      s = BuildTable(
-          dbname_, versions_, db_options_, tboptions, file_options_,
-          cfd_->table_cache(), iter.get(), std::move(range_del_iters), &meta_,
-          &blob_file_additions, existing_snapshots_, earliest_snapshot_,
-          earliest_write_conflict_snapshot_, job_snapshot_seq,
-          snapshot_checker_, mutable_cf_options_.paranoid_file_checks,
-          cfd_->internal_stats(), &io_s, io_tracer_,
-          BlobFileCreationReason::kFlush, seqno_to_time_mapping_.get(),
-          event_logger_, job_context_->job_id, &table_properties_, write_hint,
-          full_history_ts_low, blob_callback_, base_, &num_input_entries,
-          &memtable_payload_bytes, &memtable_garbage_bytes);
+      std::vector<std::string> partition_boundaries;
+      if (range_del_iters.empty()) {
+        GetFlushPartitionBoundaries(&partition_boundaries);
+      }
+
+      if (partition_boundaries.empty()) {
+        s = BuildTable(
+            dbname_, versions_, db_options_, tboptions, file_options_,
+            cfd_->table_cache(), iter.get(), std::move(range_del_iters),
+            &meta_, &blob_file_additions, existing_snapshots_,
+            earliest_snapshot_, earliest_write_conflict_snapshot_,
+            job_snapshot_seq, snapshot_checker_,
+            mutable_cf_options_.paranoid_file_checks, cfd_->internal_stats(),
+            &io_s, io_tracer_, BlobFileCreationReason::kFlush,
+            seqno_to_time_mapping_.get(), event_logger_, job_context_->job_id,
+            &table_properties_, write_hint, full_history_ts_low,
+            blob_callback_, base_, &num_input_entries, &memtable_payload_bytes,
+            &memtable_garbage_bytes);
+      } else {
+        // Each partition is written from its own iterator over the
+        // memtables, clipped to the partition's key range, into its own file.
+        // The first partition is written by this thread, into the file
+        // allocated for the flush, and the others by extra threads.
+        struct FlushPartition {
+          // Unset for the first partition.
+          InternalKey start;
+          // Unset for the last partition.
+          InternalKey end;
+          FileMetaData meta;
+          std::vector<BlobFileAddition> blob_file_additions;
+          TableProperties table_properties;
+          uint64_t num_input_entries = 0;
+          uint64_t memtable_payload_bytes = 0;
+          uint64_t memtable_garbage_bytes = 0;
+          Status status;
+        };
+        std::vector<FlushPartition> partitions(partition_boundaries.size() +
+                                               1);
+        for (size_t i = 0; i < partitions.size(); ++i) {
+          FlushPartition& partition = partitions[i];
+          partition.meta = meta_;
+          if (i > 0) {
+            partition.meta.fd =
+                FileDescriptor(versions_->NewFileNumber(), 0, 0);
+            partition.start.Set(partition_boundaries[i - 1],
+                                kMaxSequenceNumber, kValueTypeForSeek);
+          }
+          if (i + 1 < partitions.size()) {
+            partition.end.Set(partition_boundaries[i], kMaxSequenceNumber,
+                              kValueTypeForSeek);
+          }
+        }
+        ROCKS_LOG_INFO(db_options_.info_log,
+                       "[%s] [JOB %d] Level-0 flush split into %" ROCKSDB_PRIszt
+                       " partitions",
+                       cfd_->GetName().c_str(), job_context_->job_id,
+                       partitions.size());
+
+        auto write_partition = [&](FlushPartition* partition) {
+          Arena partition_arena;
+          std::vector<InternalIterator*> partition_memtables;
+          for (MemTable* m : mems_) {
+            partition_memtables.push_back(m->NewIterator(
+                ro, /*seqno_to_time_mapping=*/nullptr, &partition_arena));
+          }
+          ScopedArenaPtr<InternalIterator> partition_iter(NewMergingIterator(
+              &cfd_->internal_comparator(), partition_memtables.data(),
+              static_cast<int>(partition_memtables.size()),
+              &partition_arena));
+          Slice start, end;
+          if (partition->start.size() > 0) {
+            start = partition->start.Encode();
+          }
+          if (partition->end.size() > 0) {
+            end = partition->end.Encode();
+          }
+          ClippingIterator clipped_iter(
+              partition_iter.get(),
+              partition->start.size() > 0 ? &start : nullptr,
+              partition->end.size() > 0 ? &end : nullptr,
+              &cfd_->internal_comparator());
+          TableBuilderOptions partition_tboptions =
+              new_table_builder_options(partition->meta.fd.GetNumber());
+          IOStatus partition_io_s;
+          partition->status = BuildTable(
+              dbname_, versions_, db_options_, partition_tboptions,
+              file_options_, cfd_->table_cache(), &clipped_iter,
+              {} /* range_del_iters */, &partition->meta,
+              &partition->blob_file_additions, existing_snapshots_,
+              earliest_snapshot_, earliest_write_conflict_snapshot_,
+              job_snapshot_seq, snapshot_checker_,
+              mutable_cf_options_.paranoid_file_checks, cfd_->internal_stats(),
+              &partition_io_s, io_tracer_, BlobFileCreationReason::kFlush,
+              seqno_to_time_mapping_.get(), event_logger_, job_context_->job_id,
+              &partition->table_properties, write_hint, full_history_ts_low,
+              blob_callback_, base_, &partition->num_input_entries,
+              &partition->memtable_payload_bytes,
+              &partition->memtable_garbage_bytes);
+          assert(!partition->status.ok() || partition_io_s.ok());
+          partition_io_s.PermitUncheckedError();
+          if (partition != &partitions.front()) {
+            // RecordFlushIOStats() only covers the flush thread.
+            RecordTick(stats_, FLUSH_WRITE_BYTES, IOSTATS(bytes_written));
+          }
+        };
+        std::vector<port::Thread> thread_pool;
+        thread_pool.reserve(partitions.size() - 1);
+        for (size_t i = 1; i < partitions.size(); ++i) {
+          thread_pool.emplace_back(write_partition, &partitions[i]);
+        }
+        write_partition(&partitions.front());
+        for (auto& thread : thread_pool) {
+          thread.join();
+        }
+
+        for (FlushPartition& partition : partitions) {
+          if (s.ok()) {
+            s = partition.status;
+          } else {
+            partition.status.PermitUncheckedError();
+          }
+          num_input_entries += partition.num_input_entries;
+          memtable_payload_bytes += partition.memtable_payload_bytes;
+          memtable_garbage_bytes += partition.memtable_garbage_bytes;
+          blob_file_additions.insert(
+              blob_file_additions.end(),
+              std::make_move_iterator(partition.blob_file_additions.begin()),
+              std::make_move_iterator(partition.blob_file_additions.end()));
+        }
+        meta_ = partitions.front().meta;
+        table_properties_ = partitions.front().table_properties;
+        for (size_t i = 1; i < partitions.size(); ++i) {
+          partition_metas_.push_back(std::move(partitions[i].meta));
+        }
+      }
       TEST_SYNC_POINT_CALLBACK("FlushJob::WriteLevel0Table:s", &s);
       // TODO: Cleanup io_status in BuildTable and table builders
       assert(!s.ok() || io_s.ok());
@@ -1022,6 +1218,17 @@ Status FlushJob::WriteLevel0Table() {
                      meta_.fd.GetNumber(), meta_.fd.GetFileSize(),
                      s.ToString().c_str(),
                      meta_.marked_for_compaction ? " (needs compaction)" : "");
+    for (const FileMetaData& partition_meta : partition_metas_) {
+      ROCKS_LOG_BUFFER(
+          log_buffer_,
+          "[%s] [JOB %d] Level-0 flush table #%" PRIu64 ": %" PRIu64
+          " bytes %s"
+          "%s",
+          cfd_->GetName().c_str(), job_context_->job_id,
+          partition_meta.fd.GetNumber(), partition_meta.fd.GetFileSize(),
+          s.ToString().c_str(),
+          partition_meta.marked_for_compaction ? " (needs compaction)" : "");
+    }
 
     if (s.ok() && output_file_directory_ != nullptr && sync_output_directory_) {
       s = output_file_directory_->FsyncWithDirOptions(
@@ -1035,7 +1242,16 @@ Status FlushJob::WriteLevel0Table() {
 
   // Note that if file_size is zero, the file has been deleted and
   // should not be added to the manifest.
-  const bool has_output = meta_.fd.GetFileSize() > 0;
+  std::vector<const FileMetaData*> outputs;
+  if (meta_.fd.GetFileSize() > 0) {
+    outputs.push_back(&meta_);
+  }
+  for (const FileMetaData& partition_meta : partition_metas_) {
+    if (partition_meta.fd.GetFileSize() > 0) {
+      outputs.push_back(&partition_meta);
+    }
+  }
+  const bool has_output = !outputs.empty();
 
   if (s.ok() && has_output) {
     TEST_SYNC_POINT("DBImpl::FlushJob:SSTFileCreated");
@@ -1044,15 +1260,17 @@ Status FlushJob::WriteLevel0Table() {
     // threads could be concurrently producing compacted files for
     // that key range.
     // Add file to L0
-    edit_->AddFile(0 /* level */, meta_.fd.GetNumber(), meta_.fd.GetPathId(),
-                   meta_.fd.GetFileSize(), meta_.smallest, meta_.largest,
-                   meta_.fd.smallest_seqno, meta_.fd.largest_seqno,
-                   meta_.marked_for_compaction, meta_.temperature,
-                   meta_.oldest_blob_file_number, meta_.oldest_ancester_time,
-                   meta_.file_creation_time, meta_.epoch_number,
-                   meta_.file_checksum, meta_.file_checksum_func_name,
-                   meta_.unique_id, meta_.compensated_range_deletion_size,
-                   meta_.tail_size, meta_.user_defined_timestamps_persisted);
+    for (const FileMetaData* f : outputs) {
+      edit_->AddFile(0 /* level */, f->fd.GetNumber(), f->fd.GetPathId(),
+                     f->fd.GetFileSize(), f->smallest, f->largest,
+                     f->fd.smallest_seqno, f->fd.largest_seqno,
+                     f->marked_for_compaction, f->temperature,
+                     f->oldest_blob_file_number, f->oldest_ancester_time,
+                     f->file_creation_time, f->epoch_number, f->file_checksum,
+                     f->file_checksum_func_name, f->unique_id,
+                     f->compensated_range_deletion_size, f->tail_size,
+                     f->user_defined_timestamps_persisted);
+    }
     edit_->SetBlobFileAdditions(std::move(blob_file_additions));
   }
   // Piggyback FlushJobInfo on the first first flushed memtable.
@@ -1071,9 +1289,9 @@ Status FlushJob::WriteLevel0Table() {
                  cfd_->GetName().c_str(), job_context_->job_id, micros,
                  cpu_micros);
 
-  if (has_output) {
-    stats.bytes_written = meta_.fd.GetFileSize();
-    stats.num_output_files = 1;
+  for (const FileMetaData* f : outputs) {
+    stats.bytes_written += f->fd.GetFileSize();
+    stats.num_output_files++;
   }
 
   const auto& blobs = edit_->GetBlobFileAdditions();
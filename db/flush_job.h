@@ -97,6 +97,12 @@ class FlushJob {
     return &committed_flush_jobs_info_;
   }
 
+  // When the flush was partitioned (see `max_flush_partitions`), the output
+  // files other than the one returned through Run()'s `file_meta`.
+  const std::vector<FileMetaData>& GetPartitionOutputs() const {
+    return partition_metas_;
+  }
+
  private:
   friend class FlushJobTest_GetRateLimiterPriorityForWrite_Test;
 
@@ -104,6 +110,10 @@ class FlushJob {
   void ReportFlushInputSize(const autovector<MemTable*>& mems);
   void RecordFlushIOStats();
   Status WriteLevel0Table();
+  // Picks the user keys at which the flush is split into
+  // `max_flush_partitions` output files, by sampling the memtables. Leaves
+  // `boundaries` empty if the flush should not be partitioned.
+  void GetFlushPartitionBoundaries(std::vector<std::string>* boundaries);
 
   // Memtable Garbage Collection algorithm: a MemPurge takes the list
   // of immutable memtables and filters out (or "purge") the outdated bytes
@@ -205,6 +215,8 @@ class FlushJob {
 
   // Variables below are set by PickMemTable():
   FileMetaData meta_;
+  // Output files of a partitioned flush after the one described by `meta_`.
+  std::vector<FileMetaData> partition_metas_;
   autovector<MemTable*> mems_;
   VersionEdit* edit_;
   Version* base_;
@@ -251,6 +251,7 @@ static const std::string cf_file_histogram = "cf-file-histogram";
 static const std::string cf_write_stall_stats = "cf-write-stall-stats";
 static const std::string dbstats = "dbstats";
 static const std::string db_write_stall_stats = "db-write-stall-stats";
+static const std::string db_write_stage_stats = "db-write-stage-stats";
 static const std::string levelstats = "levelstats";
 static const std::string block_cache_entry_stats = "block-cache-entry-stats";
 static const std::string fast_block_cache_entry_stats =
@@ -335,6 +336,8 @@ const std::string DB::Properties::kCFWriteStallStats =
     rocksdb_prefix + cf_write_stall_stats;
 const std::string DB::Properties::kDBWriteStallStats =
     rocksdb_prefix + db_write_stall_stats;
+const std::string DB::Properties::kDBWriteStageStats =
+    rocksdb_prefix + db_write_stage_stats;
 const std::string DB::Properties::kDBStats = rocksdb_prefix + dbstats;
 const std::string DB::Properties::kLevelStats = rocksdb_prefix + levelstats;
 const std::string DB::Properties::kBlockCacheEntryStats =
@@ -473,6 +476,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kDBWriteStallStats,
          {false, &InternalStats::HandleDBWriteStallStats, nullptr,
           &InternalStats::HandleDBWriteStallStatsMap, nullptr}},
+        {DB::Properties::kDBWriteStageStats,
+         {false, &InternalStats::HandleDBWriteStageStats, nullptr,
+          &InternalStats::HandleDBWriteStageStatsMap, nullptr}},
         {DB::Properties::kBlockCacheEntryStats,
          {true, &InternalStats::HandleBlockCacheEntryStats, nullptr,
           &InternalStats::HandleBlockCacheEntryStatsMap, nullptr}},
@@ -640,6 +646,9 @@ InternalStats::InternalStats(int num_levels, SystemClock* clock,
       clock_(clock),
       cfd_(cfd),
       started_at_(clock->NowMicros()) {
+  if (cfd_ == nullptr || cfd_->GetID() == 0) {
+    write_stage_latency_.reset(new CoreLocalArray<WriteStageHistograms>());
+  }
   Cache* block_cache = GetBlockCacheForStats();
   if (block_cache) {
     // Extract or create stats collector. Could fail in rare cases.
@@ -1146,6 +1155,18 @@ bool InternalStats::HandleDBWriteStallStatsMap(
   return true;
 }
 
+bool InternalStats::HandleDBWriteStageStats(std::string* value,
+                                            Slice /*suffix*/) {
+  DumpDBStatsWriteStage(value);
+  return true;
+}
+
+bool InternalStats::HandleDBWriteStageStatsMap(
+    std::map<std::string, std::string>* value, Slice /*suffix*/) {
+  DumpDBMapStatsWriteStage(value);
+  return true;
+}
+
 bool InternalStats::HandleSsTables(std::string* value, Slice /*suffix*/) {
   auto* current = cfd_->current();
   *value = current->DebugString(true, true);
@@ -1714,6 +1735,78 @@ void InternalStats::DumpDBStatsWriteStall(std::string* value) {
   *value = str.str();
 }
 
+namespace {
+const char* const kWriteQueueNames[InternalStats::kNumWriteQueues] = {
+    "main", "wal-only"};
+const char* const kWriteStageNames[InternalStats::kNumWriteStages] = {
+    "thread-wait", "wal", "wal-sync", "memtable", "delay"};
+}  // namespace
+
+void InternalStats::GetWriteStageLatency(WriteQueue queue, WriteStage stage,
+                                         HistogramImpl* hist) const {
+  assert(write_stage_latency_);
+  for (size_t core_idx = 0; core_idx < write_stage_latency_->Size();
+       ++core_idx) {
+    hist->Merge(write_stage_latency_->AccessAtCore(core_idx)->hists_[queue]
+                                                                    [stage]);
+  }
+}
+
+void InternalStats::DumpDBMapStatsWriteStage(
+    std::map<std::string, std::string>* value) {
+  if (!write_stage_latency_) {
+    return;
+  }
+  for (int q = 0; q < kNumWriteQueues; ++q) {
+    for (int stage = 0; stage < kNumWriteStages; ++stage) {
+      HistogramImpl hist;
+      GetWriteStageLatency(static_cast<WriteQueue>(q),
+                           static_cast<WriteStage>(stage), &hist);
+      const std::string prefix = std::string(kWriteQueueNames[q]) + "." +
+                                 kWriteStageNames[stage] + ".";
+      HistogramData data;
+      hist.Data(&data);
+      (*value)[prefix + "count"] = std::to_string(data.count);
+      (*value)[prefix + "sum"] = std::to_string(data.sum);
+      (*value)[prefix + "p50"] = std::to_string(data.median);
+      (*value)[prefix + "p99"] = std::to_string(data.percentile99);
+      (*value)[prefix + "p99.9"] = std::to_string(hist.Percentile(99.9));
+      (*value)[prefix + "max"] = std::to_string(data.max);
+    }
+  }
+}
+
+void InternalStats::DumpDBStatsWriteStage(std::string* value) {
+  assert(value);
+  if (!write_stage_latency_) {
+    return;
+  }
+
+  std::ostringstream str;
+  str << "\n** Write Stage Latency (micros) **\n";
+  for (int q = 0; q < kNumWriteQueues; ++q) {
+    for (int stage = 0; stage < kNumWriteStages; ++stage) {
+      HistogramImpl hist;
+      GetWriteStageLatency(static_cast<WriteQueue>(q),
+                           static_cast<WriteStage>(stage), &hist);
+      if (hist.Empty()) {
+        continue;
+      }
+      HistogramData data;
+      hist.Data(&data);
+      char buf[256];
+      snprintf(buf, sizeof(buf),
+               "%s %s: count %" PRIu64 " avg %.1f P50 %.1f P99 %.1f "
+               "P99.9 %.1f max %" PRIu64 "\n",
+               kWriteQueueNames[q], kWriteStageNames[stage], data.count,
+               data.average, data.median, data.percentile99,
+               hist.Percentile(99.9), static_cast<uint64_t>(data.max));
+      str << buf;
+    }
+  }
+  value->append(str.str());
+}
+
 /**
  * Dump Compaction Level stats to a map of stat name with "compaction." prefix
  * to value in double as string. The level in stat name is represented with
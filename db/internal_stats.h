@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
@@ -17,7 +18,9 @@
 
 #include "cache/cache_entry_roles.h"
 #include "db/version_set.h"
+#include "monitoring/statistics_impl.h"
 #include "rocksdb/system_clock.h"
+#include "util/core_local.h"
 #include "util/hash_containers.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -151,6 +154,28 @@ class InternalStats {
 
   static const std::map<InternalDBStatsType, DBStatInfo> db_stats_type_to_info;
 
+  // Stages of the write path whose latencies are kept per write queue in the
+  // InternalStats of the default column family.
+  enum WriteStage : int {
+    // Waiting to become a write group leader or for the write to be done by
+    // another writer
+    kWriteStageThreadWait,
+    // Writing a write group to the WAL, including the sync
+    kWriteStageWal,
+    kWriteStageWalSync,
+    kWriteStageMemtable,
+    // Delayed or stopped by the WriteController
+    kWriteStageDelay,
+    kNumWriteStages,
+  };
+
+  enum WriteQueue : int {
+    kWriteQueueMain,
+    // The second write queue of two_write_queues, for WAL-only writes
+    kWriteQueueWalOnly,
+    kNumWriteQueues,
+  };
+
   InternalStats(int num_levels, SystemClock* clock, ColumnFamilyData* cfd);
 
   // Per level compaction stats
@@ -518,6 +543,17 @@ class InternalStats {
       h.Clear();
     }
     blob_file_read_latency_.Clear();
+    if (write_stage_latency_) {
+      for (size_t core_idx = 0; core_idx < write_stage_latency_->Size();
+           ++core_idx) {
+        for (auto& queue_hists :
+             write_stage_latency_->AccessAtCore(core_idx)->hists_) {
+          for (auto& h : queue_hists) {
+            h.Clear();
+          }
+        }
+      }
+    }
     cf_stats_snapshot_.Clear();
     db_stats_snapshot_.Clear();
     bg_error_count_ = 0;
@@ -571,6 +607,17 @@ class InternalStats {
 
   HistogramImpl* GetBlobFileReadHist() { return &blob_file_read_latency_; }
 
+  // Only valid on the InternalStats of the default column family.
+  void AddWriteStageLatency(WriteQueue queue, WriteStage stage,
+                            uint64_t micros) {
+    assert(write_stage_latency_);
+    write_stage_latency_->Access()->hists_[queue][stage].Add(micros);
+  }
+
+  // Merges the per core histograms of a write stage into `hist`.
+  void GetWriteStageLatency(WriteQueue queue, WriteStage stage,
+                            HistogramImpl* hist) const;
+
   uint64_t GetBackgroundErrorCount() const { return bg_error_count_; }
 
   uint64_t BumpAndGetBackgroundErrorCount() { return ++bg_error_count_; }
@@ -620,6 +667,9 @@ class InternalStats {
   void DumpDBMapStatsWriteStall(std::map<std::string, std::string>* value);
   void DumpDBStatsWriteStall(std::string* value);
 
+  void DumpDBMapStatsWriteStage(std::map<std::string, std::string>* value);
+  void DumpDBStatsWriteStage(std::string* value);
+
   void DumpCFMapStats(std::map<std::string, std::string>* cf_stats);
   void DumpCFMapStats(
       const VersionStorageInfo* vstorage,
@@ -660,6 +710,28 @@ class InternalStats {
   CompactionStats per_key_placement_comp_stats_;
   std::vector<HistogramImpl> file_read_latency_;
   HistogramImpl blob_file_read_latency_;
+  // Per write queue write path stage latencies, one copy per core since
+  // every write adds to them. DB-scope, so only allocated for the default
+  // column family.
+  struct ALIGN_AS(CACHE_LINE_SIZE) WriteStageHistograms {
+    HistogramImpl hists_[kNumWriteQueues][kNumWriteStages];
+#ifndef HAVE_ALIGNED_NEW
+    char padding[(CACHE_LINE_SIZE -
+                  (kNumWriteQueues * kNumWriteStages * sizeof(HistogramImpl)) %
+                      CACHE_LINE_SIZE)] ROCKSDB_FIELD_UNUSED;
+#endif
+    void* operator new(size_t s) { return port::cacheline_aligned_alloc(s); }
+    void* operator new[](size_t s) { return port::cacheline_aligned_alloc(s); }
+    void operator delete(void* p) { port::cacheline_aligned_free(p); }
+    void operator delete[](void* p) { port::cacheline_aligned_free(p); }
+  };
+
+#ifndef TEST_CACHE_LINE_SIZE
+  static_assert(sizeof(WriteStageHistograms) % CACHE_LINE_SIZE == 0,
+                "Expected " TOSTRING(CACHE_LINE_SIZE) "-byte aligned");
+#endif
+
+  std::unique_ptr<CoreLocalArray<WriteStageHistograms>> write_stage_latency_;
   bool has_cf_change_since_dump_;
   // How many periods of no change since the last time stats are dumped for
   // a periodic dump.
@@ -776,6 +848,9 @@ class InternalStats {
   bool HandleDBWriteStallStats(std::string* value, Slice suffix);
   bool HandleDBWriteStallStatsMap(std::map<std::string, std::string>* values,
                                   Slice suffix);
+  bool HandleDBWriteStageStats(std::string* value, Slice suffix);
+  bool HandleDBWriteStageStatsMap(std::map<std::string, std::string>* values,
+                                  Slice suffix);
   bool HandleSsTables(std::string* value, Slice suffix);
   bool HandleAggregatedTableProperties(std::string* value, Slice suffix);
   bool HandleAggregatedTablePropertiesAtLevel(std::string* value, Slice suffix);
@@ -7,6 +7,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <thread>
+
 #include "db/log_reader.h"
 #include "db/log_writer.h"
 #include "file/sequence_file_reader.h"
@@ -800,6 +802,75 @@ TEST_P(LogTest, TimestampSizeRecordPadding) {
   CheckRecordAndTimestampSize(second_str, ts_sz);
 }
 
+TEST_P(LogTest, ConcurrentAppend) {
+  const bool recyclable_log = (std::get<0>(GetParam()) != 0);
+  Random rnd(301);
+  std::vector<std::string> records;
+  records.emplace_back("small");
+  for (int i = 0; i < 200; i++) {
+    records.push_back(rnd.RandomString(
+        static_cast<int>(i % 20 == 0 ? rnd.Uniform(3 * kBlockSize)
+                                     : rnd.Uniform(1000))));
+  }
+  records.emplace_back("");
+
+  // Same records written one at a time, for comparison
+  std::string expected;
+  {
+    std::unique_ptr<FSWritableFile> sink(new test::StringSink(nullptr));
+    auto* string_sink = static_cast<test::StringSink*>(sink.get());
+    std::unique_ptr<WritableFileWriter> dest(new WritableFileWriter(
+        std::move(sink), "" /* don't care */, FileOptions()));
+    Writer writer(std::move(dest), 123, recyclable_log);
+    for (const auto& record : records) {
+      ASSERT_OK(writer.AddRecord(WriteOptions(), Slice(record)));
+    }
+    expected = string_sink->contents_;
+  }
+
+  // The first record is added normally, the others in two concurrent appends
+  Write(records[0]);
+  constexpr size_t kNumThreads = 4;
+  const size_t mid = records.size() / 2;
+  for (auto range : {std::make_pair(size_t{1}, mid),
+                     std::make_pair(mid, records.size())}) {
+    size_t total_size = 0;
+    for (size_t i = range.first; i < range.second; i++) {
+      total_size += records[i].size();
+    }
+    ASSERT_OK(writer_->BeginConcurrentAppend(range.second - range.first,
+                                             total_size));
+    std::vector<uint64_t> reservations;
+    for (size_t i = range.first; i < range.second; i++) {
+      uint64_t reservation;
+      ASSERT_TRUE(writer_->ReserveRecord(records[i].size(), &reservation));
+      reservations.push_back(reservation);
+    }
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kNumThreads; t++) {
+      threads.emplace_back([&, t]() {
+        for (size_t i = t; i < reservations.size(); i += kNumThreads) {
+          writer_->FillRecord(reservations[i],
+                              Slice(records[range.first + i]));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_OK(writer_->EndConcurrentAppend(WriteOptions()));
+  }
+  Write("last");
+
+  ASSERT_EQ(expected,
+            get_reader_contents()->ToString().substr(0, expected.size()));
+  for (const auto& record : records) {
+    ASSERT_EQ(record, Read());
+  }
+  ASSERT_EQ("last", Read());
+  ASSERT_EQ("EOF", Read());
+}
+
 // Do NOT enable compression for this instantiation.
 INSTANTIATE_TEST_CASE_P(
     Log, LogTest,
@@ -9,7 +9,9 @@
 
 #include "db/log_writer.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 #include "file/writable_file_writer.h"
 #include "rocksdb/env.h"
@@ -166,19 +168,9 @@ IOStatus Writer::AddRecord(const WriteOptions& write_options,
 
       const size_t fragment_length = (left < avail) ? left : avail;
 
-      RecordType type;
       const bool end = (left == fragment_length && compress_remaining == 0);
-      if (begin && end) {
-        type = recycle_log_files_ ? kRecyclableFullType : kFullType;
-      } else if (begin) {
-        type = recycle_log_files_ ? kRecyclableFirstType : kFirstType;
-      } else if (end) {
-        type = recycle_log_files_ ? kRecyclableLastType : kLastType;
-      } else {
-        type = recycle_log_files_ ? kRecyclableMiddleType : kMiddleType;
-      }
-
-      s = EmitPhysicalRecord(write_options, type, ptr, fragment_length);
+      s = EmitPhysicalRecord(write_options, GetFragmentType(begin, end), ptr,
+                             fragment_length);
       ptr += fragment_length;
       left -= fragment_length;
       begin = false;
@@ -193,6 +185,125 @@ IOStatus Writer::AddRecord(const WriteOptions& write_options,
   return s;
 }
 
+template <typename Fn>
+size_t Writer::ForEachFragment(size_t block_offset, size_t length,
+                               Fn&& fn) const {
+  const size_t header_size = static_cast<size_t>(header_size_);
+  size_t pos = 0;
+  size_t left = length;
+  bool begin = true;
+  // Same as AddRecord(): emit at least one (possibly empty) fragment, and
+  // never leave less than a header in a block.
+  do {
+    size_t padding = 0;
+    if (kBlockSize - block_offset < header_size) {
+      padding = kBlockSize - block_offset;
+      block_offset = 0;
+    }
+    const size_t avail = kBlockSize - block_offset - header_size;
+    const size_t fragment_length = (left < avail) ? left : avail;
+    fn(pos, padding, length - left, fragment_length, begin,
+       left == fragment_length);
+    pos += padding + header_size + fragment_length;
+    block_offset += header_size + fragment_length;
+    left -= fragment_length;
+    begin = false;
+  } while (left > 0);
+  return pos;
+}
+
+IOStatus Writer::BeginConcurrentAppend(size_t num_records,
+                                       size_t total_payload) {
+  assert(compression_type_ == kNoCompression);
+  if (dest_->seen_error()) {
+#ifndef NDEBUG
+    if (dest_->seen_injected_error()) {
+      return IOStatus::IOError("Seen injected error. Skip writing buffer.");
+    }
+#endif  // NDEBUG
+    return IOStatus::IOError("Seen error. Skip writing buffer.");
+  }
+  // A record has at most one fragment more than the full blocks its payload
+  // needs (the first one may be empty), and each fragment adds a header and
+  // possibly a block trailer shorter than a header.
+  const size_t max_fragments =
+      total_payload / (kBlockSize - header_size_) + 2 * num_records;
+  const size_t size = total_payload + max_fragments * 2 * header_size_;
+  // Reuse the buffer, unless it was sized for a much larger group than the
+  // current one, so that a burst of large groups does not pin memory.
+  if (concurrent_buffer_size_ < size ||
+      concurrent_buffer_size_ > std::max(4 * size, size_t{kBlockSize})) {
+    concurrent_buffer_.reset(new char[size]);
+    concurrent_buffer_size_ = size;
+  }
+  concurrent_block_offset_ = block_offset_ % kBlockSize;
+  concurrent_reserved_.store(0, std::memory_order_relaxed);
+  concurrent_filled_.store(0, std::memory_order_relaxed);
+  return IOStatus::OK();
+}
+
+bool Writer::ReserveRecord(size_t length, uint64_t* reservation) {
+  uint64_t start = concurrent_reserved_.load(std::memory_order_relaxed);
+  uint64_t end;
+  do {
+    // The layout of the record depends on where it starts in its block
+    const size_t block_offset =
+        static_cast<size_t>((concurrent_block_offset_ + start) % kBlockSize);
+    end = start + ForEachFragment(block_offset, length,
+                                  [](size_t, size_t, size_t, size_t, bool,
+                                     bool) {});
+    if (end > concurrent_buffer_size_) {
+      return false;
+    }
+  } while (!concurrent_reserved_.compare_exchange_weak(
+      start, end, std::memory_order_relaxed));
+  *reservation = start;
+  return true;
+}
+
+void Writer::FillRecord(uint64_t reservation, const Slice& slice) {
+  char* const record = concurrent_buffer_.get() + reservation;
+  const size_t block_offset = static_cast<size_t>(
+      (concurrent_block_offset_ + reservation) % kBlockSize);
+  const size_t size = ForEachFragment(
+      block_offset, slice.size(),
+      [&](size_t pos, size_t padding, size_t payload_offset,
+          size_t fragment_length, bool begin, bool end) {
+        char* dst = record + pos;
+        memset(dst, 0, padding);
+        dst += padding;
+        const char* ptr = slice.data() + payload_offset;
+        uint32_t payload_crc;
+        const size_t header_size =
+            EncodeHeader(GetFragmentType(begin, end), ptr, fragment_length,
+                         dst, &payload_crc);
+        memcpy(dst + header_size, ptr, fragment_length);
+      });
+  // Publishes the record to EndConcurrentAppend()
+  concurrent_filled_.fetch_add(size, std::memory_order_release);
+}
+
+IOStatus Writer::EndConcurrentAppend(const WriteOptions& write_options) {
+  const uint64_t size = concurrent_reserved_.load(std::memory_order_relaxed);
+  if (size == 0) {
+    return IOStatus::OK();
+  }
+  assert(concurrent_filled_.load(std::memory_order_acquire) == size);
+  IOOptions opts;
+  IOStatus s = WritableFileWriter::PrepareIOOptions(write_options, opts);
+  if (s.ok()) {
+    s = dest_->Append(
+        opts, Slice(concurrent_buffer_.get(), static_cast<size_t>(size)),
+        0 /* crc32c_checksum */);
+  }
+  block_offset_ =
+      static_cast<size_t>((concurrent_block_offset_ + size) % kBlockSize);
+  if (s.ok() && !manual_flush_) {
+    s = dest_->Flush(opts);
+  }
+  return s;
+}
+
 IOStatus Writer::AddCompressionTypeRecord(const WriteOptions& write_options) {
   // Should be the first record
   assert(block_offset_ == 0);
@@ -290,12 +401,23 @@ IOStatus Writer::MaybeAddUserDefinedTimestampSizeRecord(
 
 bool Writer::BufferIsEmpty() { return dest_->BufferIsEmpty(); }
 
-IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
-                                    RecordType t, const char* ptr, size_t n) {
+RecordType Writer::GetFragmentType(bool begin, bool end) const {
+  if (begin && end) {
+    return recycle_log_files_ ? kRecyclableFullType : kFullType;
+  } else if (begin) {
+    return recycle_log_files_ ? kRecyclableFirstType : kFirstType;
+  } else if (end) {
+    return recycle_log_files_ ? kRecyclableLastType : kLastType;
+  } else {
+    return recycle_log_files_ ? kRecyclableMiddleType : kMiddleType;
+  }
+}
+
+size_t Writer::EncodeHeader(RecordType t, const char* ptr, size_t n, char* buf,
+                            uint32_t* payload_crc) const {
   assert(n <= 0xffff);  // Must fit in two bytes
 
   size_t header_size;
-  char buf[kRecyclableHeaderSize];
 
   // Format the header
   buf[4] = static_cast<char>(n & 0xff);
@@ -306,11 +428,9 @@ IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
   if (t < kRecyclableFullType || t == kSetCompressionType ||
       t == kUserDefinedTimestampSizeType) {
     // Legacy record format
-    assert(block_offset_ + kHeaderSize + n <= kBlockSize);
     header_size = kHeaderSize;
   } else {
     // Recyclable record format
-    assert(block_offset_ + kRecyclableHeaderSize + n <= kBlockSize);
     header_size = kRecyclableHeaderSize;
 
     // Only encode low 32-bits of the 64-bit log number.  This means
@@ -323,12 +443,21 @@ IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
   }
 
   // Compute the crc of the record type and the payload.
-  uint32_t payload_crc = crc32c::Value(ptr, n);
-  crc = crc32c::Crc32cCombine(crc, payload_crc, n);
+  *payload_crc = crc32c::Value(ptr, n);
+  crc = crc32c::Crc32cCombine(crc, *payload_crc, n);
   crc = crc32c::Mask(crc);  // Adjust for storage
   TEST_SYNC_POINT_CALLBACK("LogWriter::EmitPhysicalRecord:BeforeEncodeChecksum",
                            &crc);
   EncodeFixed32(buf, crc);
+  return header_size;
+}
+
+IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
+                                    RecordType t, const char* ptr, size_t n) {
+  char buf[kRecyclableHeaderSize];
+  uint32_t payload_crc;
+  const size_t header_size = EncodeHeader(t, ptr, n, buf, &payload_crc);
+  assert(block_offset_ + header_size + n <= kBlockSize);
 
   // Write the header and the payload
   IOOptions opts;
@@ -8,6 +8,7 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
@@ -89,6 +90,27 @@ class Writer {
   IOStatus AddRecord(const WriteOptions& write_options, const Slice& slice);
   IOStatus AddCompressionTypeRecord(const WriteOptions& write_options);
 
+  // Multi-producer record appends. Between BeginConcurrentAppend() and
+  // EndConcurrentAppend(), records are added by reserving their byte range in
+  // a shared buffer with ReserveRecord() and encoding them into it with
+  // FillRecord(). Both are thread-safe and lock-free, so many threads can
+  // encode (checksum and copy) their records in parallel. The records are
+  // laid out exactly as AddRecord() would, in reservation order, so that
+  // Reader can read them back. AddRecord() and the other record types must not
+  // be added in the meantime. Not supported with WAL compression.
+  //
+  // Prepares the buffer for up to `num_records` records with a total of
+  // `total_payload` bytes.
+  IOStatus BeginConcurrentAppend(size_t num_records, size_t total_payload);
+  // Reserves the byte range of a record with `length` bytes of payload and
+  // returns its offset in the buffer in `*reservation`. Returns false if the
+  // buffer does not have enough room left.
+  bool ReserveRecord(size_t length, uint64_t* reservation);
+  // Encodes `slice` into the range returned by ReserveRecord().
+  void FillRecord(uint64_t reservation, const Slice& slice);
+  // Appends the buffer to the file. All reserved records must be filled.
+  IOStatus EndConcurrentAppend(const WriteOptions& write_options);
+
   // If there are column families in `cf_to_ts_sz` not included in
   // `recorded_cf_to_ts_sz_` and its user-defined timestamp size is non-zero,
   // adds a record of type kUserDefinedTimestampSizeType or
@@ -131,6 +153,23 @@ class Writer {
   IOStatus EmitPhysicalRecord(const WriteOptions& write_options,
                               RecordType type, const char* ptr, size_t length);
 
+  // Returns the type of a physical record (fragment) of a logical record
+  RecordType GetFragmentType(bool begin, bool end) const;
+
+  // Encodes the header of a physical record into `buf` and returns its size.
+  // The checksum of the payload alone is returned in `*payload_crc`.
+  size_t EncodeHeader(RecordType t, const char* ptr, size_t n, char* buf,
+                      uint32_t* payload_crc) const;
+
+  // Visits the physical records of a logical record of `length` bytes
+  // starting at block offset `block_offset`, as laid out by AddRecord().
+  // `fn(pos, padding, payload_offset, fragment_length, begin, end)` is called
+  // for each fragment, where `pos` is the offset of the fragment from the
+  // start of the record and `padding` the size of the block trailer written
+  // before its header. Returns the total size of the record.
+  template <typename Fn>
+  size_t ForEachFragment(size_t block_offset, size_t length, Fn&& fn) const;
+
   // If true, it does not flush after each write. Instead it relies on the upper
   // layer to manually does the flush by calling ::WriteBuffer()
   bool manual_flush_;
@@ -141,6 +180,15 @@ class Writer {
   // Reusable compressed output buffer
   std::unique_ptr<char[]> compressed_buffer_;
 
+  // State of the concurrent append, see BeginConcurrentAppend()
+  std::unique_ptr<char[]> concurrent_buffer_;
+  size_t concurrent_buffer_size_ = 0;
+  // Block offset at the start of the buffer
+  size_t concurrent_block_offset_ = 0;
+  // Bytes of the buffer reserved and filled so far
+  std::atomic<uint64_t> concurrent_reserved_{0};
+  std::atomic<uint64_t> concurrent_filled_{0};
+
   // The recorded user-defined timestamp size that have been written so far.
   // Since the user-defined timestamp size cannot be changed while the DB is
   // running, existing entry in this map cannot be updated.
@@ -69,7 +69,12 @@ ImmutableMemTableOptions::ImmutableMemTableOptions(
       info_log(ioptions.logger),
       allow_data_in_errors(ioptions.allow_data_in_errors),
       protection_bytes_per_key(
-          mutable_cf_options.memtable_protection_bytes_per_key) {}
+          mutable_cf_options.memtable_protection_bytes_per_key),
+      // Values updated in place must stay inside their entries.
+      value_separation_min_size(
+          ioptions.inplace_update_support
+              ? 0
+              : mutable_cf_options.memtable_value_separation_min_size) {}
 
 MemTable::MemTable(const InternalKeyComparator& cmp,
                    const ImmutableOptions& ioptions,
@@ -87,7 +92,20 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
                write_buffer_manager->cost_to_cache()))
                  ? &mem_tracker_
                  : nullptr,
-             mutable_cf_options.memtable_huge_page_size),
+             mutable_cf_options.memtable_huge_page_size,
+             mutable_cf_options.memtable_numa_aware),
+      value_arena_(
+          moptions_.value_separation_min_size > 0
+              ? std::make_unique<ConcurrentArena>(
+                    moptions_.arena_block_size,
+                    (write_buffer_manager != nullptr &&
+                     (write_buffer_manager->enabled() ||
+                      write_buffer_manager->cost_to_cache()))
+                        ? &mem_tracker_
+                        : nullptr,
+                    mutable_cf_options.memtable_huge_page_size,
+                    mutable_cf_options.memtable_numa_aware)
+              : nullptr),
       table_(ioptions.memtable_factory->CreateMemTableRep(
           comparator_, &arena_, mutable_cf_options.prefix_extractor.get(),
           ioptions.logger, column_family_id)),
@@ -162,7 +180,9 @@ MemTable::~MemTable() {
 
 size_t MemTable::ApproximateMemoryUsage() {
   autovector<size_t> usages = {
-      arena_.ApproximateMemoryUsage(), table_->ApproximateMemoryUsage(),
+      arena_.ApproximateMemoryUsage(),
+      value_arena_ ? value_arena_->ApproximateMemoryUsage() : 0,
+      table_->ApproximateMemoryUsage(),
       range_del_table_->ApproximateMemoryUsage(),
       ROCKSDB_NAMESPACE::ApproximateMemoryUsage(insert_hints_)};
   size_t total_usage = 0;
@@ -201,7 +221,9 @@ bool MemTable::ShouldFlushNow() {
   // shouldn't flush.
   auto allocated_memory = table_->ApproximateMemoryUsage() +
                           range_del_table_->ApproximateMemoryUsage() +
-                          arena_.MemoryAllocatedBytes();
+                          arena_.MemoryAllocatedBytes() +
+                          (value_arena_ ? value_arena_->MemoryAllocatedBytes()
+                                        : 0);
 
   approximate_memory_usage_.store(allocated_memory, std::memory_order_relaxed);
 
@@ -273,8 +295,27 @@ void MemTable::UpdateOldestKeyTime() {
   }
 }
 
+const char* MemTable::DecodeEntryValue(const char* p,
+                                      uint32_t value_separation_min_size,
+                                      Slice* value) {
+  uint32_t value_length = 0;
+  p = GetVarint32Ptr(p, p + 5, &value_length);
+  if (p == nullptr) {
+    return nullptr;
+  }
+  if (IsSeparatedValue(value_length, value_separation_min_size)) {
+    const char* value_data;
+    memcpy(&value_data, p, sizeof(value_data));
+    *value = Slice(value_data, value_length);
+    return p + sizeof(value_data);
+  }
+  *value = Slice(p, value_length);
+  return p + value_length;
+}
+
 Status MemTable::VerifyEntryChecksum(const char* entry,
                                      uint32_t protection_bytes_per_key,
+                                     uint32_t value_separation_min_size,
                                      bool allow_data_in_errors) {
   if (protection_bytes_per_key == 0) {
     return Status::OK();
@@ -294,15 +335,12 @@ Status MemTable::VerifyEntryChecksum(const char* entry,
   SequenceNumber seq;
   UnPackSequenceAndType(tag, &seq, &type);
 
-  uint32_t value_length = 0;
-  const char* value_ptr = GetVarint32Ptr(
-      key_ptr + key_length, key_ptr + key_length + 5, &value_length);
-  if (value_ptr == nullptr) {
+  Slice value;
+  const char* checksum_ptr = DecodeEntryValue(
+      key_ptr + key_length, value_separation_min_size, &value);
+  if (checksum_ptr == nullptr) {
     return Status::Corruption("Unable to parse internal key value");
   }
-  Slice value = Slice(value_ptr, value_length);
-
-  const char* checksum_ptr = value_ptr + value_length;
   bool match =
       ProtectionInfo64()
           .ProtectKVO(user_key, value, type)
@@ -376,6 +414,7 @@ class MemTableIterator : public InternalIterator {
         value_pinned_(
             !mem.GetImmutableMemTableOptions()->inplace_update_support),
         protection_bytes_per_key_(mem.moptions_.protection_bytes_per_key),
+        value_separation_min_size_(mem.moptions_.value_separation_min_size),
         status_(Status::OK()),
         logger_(mem.moptions_.info_log),
         ts_sz_(mem.ts_sz_) {
@@ -520,7 +559,10 @@ class MemTableIterator : public InternalIterator {
   Slice value() const override {
     assert(Valid());
     Slice key_slice = GetLengthPrefixedSlice(iter_->key());
-    return GetLengthPrefixedSlice(key_slice.data() + key_slice.size());
+    Slice v;
+    MemTable::DecodeEntryValue(key_slice.data() + key_slice.size(),
+                               value_separation_min_size_, &v);
+    return v;
   }
 
   Status status() const override { return status_; }
@@ -546,14 +588,15 @@ class MemTableIterator : public InternalIterator {
   bool arena_mode_;
   bool value_pinned_;
   uint32_t protection_bytes_per_key_;
+  uint32_t value_separation_min_size_;
   Status status_;
   Logger* logger_;
   size_t ts_sz_;
 
   void VerifyEntryChecksum() {
     if (protection_bytes_per_key_ > 0 && Valid()) {
-      status_ = MemTable::VerifyEntryChecksum(iter_->key(),
-                                              protection_bytes_per_key_);
+      status_ = MemTable::VerifyEntryChecksum(
+          iter_->key(), protection_bytes_per_key_, value_separation_min_size_);
       if (!status_.ok()) {
         ROCKS_LOG_ERROR(logger_, "In MemtableIterator: %s", status_.getState());
       }
@@ -601,13 +644,24 @@ FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIteratorInternal(
   if (!cache->initialized.load(std::memory_order_acquire)) {
     cache->reader_mutex.lock();
     if (!cache->tombstones) {
-      auto* unfragmented_iter = new MemTableIterator(
-          *this, read_options, nullptr /* seqno_to_time_mapping= */,
-          nullptr /* arena */, true /* use_range_del_table */);
-      cache->tombstones.reset(new FragmentedRangeTombstoneList(
-          std::unique_ptr<InternalIterator>(unfragmented_iter),
-          comparator_.comparator));
+      std::shared_ptr<FragmentedRangeTombstoneList> base =
+          std::atomic_load_explicit(&cache->base, std::memory_order_relaxed);
+      if (base != nullptr) {
+        // Only the tombstones added since `base` need to be fragmented.
+        cache->tombstones = std::make_shared<FragmentedRangeTombstoneList>(
+            *base, cache->new_tombstones, comparator_.comparator);
+      } else {
+        auto* unfragmented_iter = new MemTableIterator(
+            *this, read_options, nullptr /* seqno_to_time_mapping= */,
+            nullptr /* arena */, true /* use_range_del_table */);
+        cache->tombstones.reset(new FragmentedRangeTombstoneList(
+            std::unique_ptr<InternalIterator>(unfragmented_iter),
+            comparator_.comparator));
+      }
       cache->initialized.store(true, std::memory_order_release);
+      std::atomic_store_explicit(
+          &cache->base, std::shared_ptr<FragmentedRangeTombstoneList>(),
+          std::memory_order_relaxed);
     }
     cache->reader_mutex.unlock();
   }
@@ -617,6 +671,37 @@ FragmentedRangeTombstoneIterator* MemTable::NewRangeTombstoneIteratorInternal(
   return fragmented_iter;
 }
 
+void MemTable::InheritRangeTombstones(
+    const std::shared_ptr<FragmentedRangeTombstoneListCache>& prev_cache,
+    const Slice& tombstone_key, const Slice& tombstone_end,
+    FragmentedRangeTombstoneListCache* new_cache) {
+  // Bounds the tombstones copied on each DeleteRange when no reader builds the
+  // fragmented list in between. Past that, the next reader fragments all
+  // tombstones from range_del_table_ again.
+  static constexpr size_t kMaxNewRangeTombstones = 64;
+
+  std::shared_ptr<FragmentedRangeTombstoneList> base;
+  if (prev_cache->initialized.load(std::memory_order_acquire)) {
+    base = prev_cache->tombstones;
+  } else {
+    base = std::atomic_load_explicit(&prev_cache->base,
+                                     std::memory_order_relaxed);
+    if (base != nullptr) {
+      new_cache->new_tombstones = prev_cache->new_tombstones;
+    } else if (prev_cache->initialized.load(std::memory_order_acquire)) {
+      // A reader built the list and released its base in the meantime.
+      base = prev_cache->tombstones;
+    }
+  }
+  if (base == nullptr ||
+      new_cache->new_tombstones.size() >= kMaxNewRangeTombstones) {
+    new_cache->new_tombstones.clear();
+    return;
+  }
+  new_cache->new_tombstones.emplace_back(tombstone_key, tombstone_end);
+  new_cache->base = std::move(base);
+}
+
 void MemTable::ConstructFragmentedRangeTombstones() {
   // There should be no concurrent Construction.
   // We could also check fragmented_range_tombstone_list_ to avoid repeate
@@ -685,13 +770,22 @@ Status MemTable::VerifyEncodedEntry(Slice encoded,
   if (!GetVarint32(&encoded, &value_len)) {
     return Status::Corruption("Unable to parse value length");
   }
-  if (value_len < encoded.size()) {
+  const bool separated =
+      IsSeparatedValue(value_len, moptions_.value_separation_min_size);
+  const size_t encoded_value_len =
+      separated ? sizeof(const char*) : size_t{value_len};
+  if (encoded_value_len < encoded.size()) {
     return Status::Corruption("Value length too short");
   }
-  if (value_len > encoded.size()) {
+  if (encoded_value_len > encoded.size()) {
     return Status::Corruption("Value length too long");
   }
   Slice value(encoded.data(), value_len);
+  if (separated) {
+    const char* value_data;
+    memcpy(&value_data, encoded.data(), sizeof(value_data));
+    value = Slice(value_data, value_len);
+  }
 
   return kv_prot_info.StripS(sequence_number)
       .StripKVO(key, value, value_type)
@@ -723,19 +817,30 @@ Status MemTable::Add(SequenceNumber s, ValueType type,
                      const Slice& value,
                      const ProtectionInfoKVOS64* kv_prot_info,
                      bool allow_concurrent,
-                     MemTablePostProcessInfo* post_process_info, void** hint) {
+                     MemTablePostProcessInfo* post_process_info, void** hint,
+                     std::vector<KeyHandle>* deferred_inserts) {
   // Format of an entry is concatenation of:
   //  key_size     : varint32 of internal_key.size()
   //  key bytes    : char[internal_key.size()]
   //  value_size   : varint32 of value.size()
   //  value bytes  : char[value.size()]
   //  checksum     : char[moptions_.protection_bytes_per_key]
+  // Values of at least moptions_.value_separation_min_size bytes are copied
+  // to value_arena_ instead, and value bytes hold a pointer to the copy.
   uint32_t key_size = static_cast<uint32_t>(key.size());
   uint32_t val_size = static_cast<uint32_t>(value.size());
   uint32_t internal_key_size = key_size + 8;
-  const uint32_t encoded_len = VarintLength(internal_key_size) +
-                               internal_key_size + VarintLength(val_size) +
-                               val_size + moptions_.protection_bytes_per_key;
+  const bool separate_value =
+      IsSeparatedValue(val_size, moptions_.value_separation_min_size);
+  const uint32_t encoded_val_size =
+      separate_value ? static_cast<uint32_t>(sizeof(const char*)) : val_size;
+  const uint32_t encoded_len =
+      VarintLength(internal_key_size) + internal_key_size +
+      VarintLength(val_size) + encoded_val_size +
+      moptions_.protection_bytes_per_key;
+  // Counts separated values as memtable data as well.
+  const uint64_t entry_size =
+      encoded_len + (separate_value ? uint64_t{val_size} : 0);
   char* buf = nullptr;
   std::unique_ptr<MemTableRep>& table =
       type == kTypeRangeDeletion ? range_del_table_ : table_;
@@ -749,8 +854,18 @@ Status MemTable::Add(SequenceNumber s, ValueType type,
   EncodeFixed64(p, packed);
   p += 8;
   p = EncodeVarint32(p, val_size);
-  memcpy(p, value.data(), val_size);
-  assert((unsigned)(p + val_size - buf + moptions_.protection_bytes_per_key) ==
+  const char* value_data = p;
+  if (separate_value) {
+    assert(value_arena_);
+    char* separated_value = value_arena_->Allocate(val_size);
+    memcpy(separated_value, value.data(), val_size);
+    memcpy(p, &separated_value, sizeof(separated_value));
+    value_data = separated_value;
+  } else {
+    memcpy(p, value.data(), val_size);
+  }
+  assert((unsigned)(p + encoded_val_size - buf +
+                    moptions_.protection_bytes_per_key) ==
          (unsigned)encoded_len);
 
   UpdateEntryChecksum(kv_prot_info, key, value, type, s,
@@ -765,12 +880,19 @@ Status MemTable::Add(SequenceNumber s, ValueType type,
   }
 
   Slice key_without_ts = StripTimestampFromUserKey(key, ts_sz_);
+  // Range deletions are never deferred
+  if (table != table_) {
+    deferred_inserts = nullptr;
+  }
 
   if (!allow_concurrent) {
-    // Extract prefix for insert with hint. Hints are for point key table
-    // (`table_`) only, not `range_del_table_`.
-    if (table == table_ && insert_with_hint_prefix_extractor_ != nullptr &&
-        insert_with_hint_prefix_extractor_->InDomain(key_slice)) {
+    if (deferred_inserts != nullptr) {
+      deferred_inserts->push_back(handle);
+    } else if (table == table_ &&
+               insert_with_hint_prefix_extractor_ != nullptr &&
+               insert_with_hint_prefix_extractor_->InDomain(key_slice)) {
+      // Extract prefix for insert with hint. Hints are for point key table
+      // (`table_`) only, not `range_del_table_`.
       Slice prefix = insert_with_hint_prefix_extractor_->Transform(key_slice);
       bool res = table->InsertKeyWithHint(handle, &insert_hints_[prefix]);
       if (UNLIKELY(!res)) {
@@ -787,7 +909,7 @@ Status MemTable::Add(SequenceNumber s, ValueType type,
     // when incrementing an atomic
     num_entries_.store(num_entries_.load(std::memory_order_relaxed) + 1,
                        std::memory_order_relaxed);
-    data_size_.store(data_size_.load(std::memory_order_relaxed) + encoded_len,
+    data_size_.store(data_size_.load(std::memory_order_relaxed) + entry_size,
                      std::memory_order_relaxed);
     if (type == kTypeDeletion || type == kTypeSingleDeletion ||
         type == kTypeDeletionWithTimestamp) {
@@ -823,16 +945,20 @@ Status MemTable::Add(SequenceNumber s, ValueType type,
     MaybeUpdateNewestUDT(key_slice);
     UpdateFlushState();
   } else {
-    bool res = (hint == nullptr)
-                   ? table->InsertKeyConcurrently(handle)
-                   : table->InsertKeyWithHintConcurrently(handle, hint);
-    if (UNLIKELY(!res)) {
-      return Status::TryAgain("key+seq exists");
+    if (deferred_inserts != nullptr) {
+      deferred_inserts->push_back(handle);
+    } else {
+      bool res = (hint == nullptr)
+                     ? table->InsertKeyConcurrently(handle)
+                     : table->InsertKeyWithHintConcurrently(handle, hint);
+      if (UNLIKELY(!res)) {
+        return Status::TryAgain("key+seq exists");
+      }
     }
 
     assert(post_process_info != nullptr);
     post_process_info->num_entries++;
-    post_process_info->data_size += encoded_len;
+    post_process_info->data_size += entry_size;
     if (type == kTypeDeletion) {
       post_process_info->num_deletes++;
     }
@@ -865,6 +991,17 @@ Status MemTable::Add(SequenceNumber s, ValueType type,
       post_process_info->num_range_deletes++;
       range_del_mutex_.lock();
     }
+    if (ts_sz_ == 0 && !moptions_.inplace_update_support) {
+      // Both this tombstone and the keys of fragmented tombstone lists built
+      // from range_del_table_ live in the arena, so later lists can be merged
+      // from earlier ones instead of re-fragmenting every tombstone.
+      InheritRangeTombstones(
+          std::atomic_load_explicit(cached_range_tombstone_.AccessAtCore(0),
+                                    std::memory_order_relaxed),
+          Slice(key_slice.data(), internal_key_size),
+          Slice(value_data, val_size),
+          new_cache.get());
+    }
     for (size_t i = 0; i < size; ++i) {
       std::shared_ptr<FragmentedRangeTombstoneListCache>* local_cache_ref_ptr =
           cached_range_tombstone_.AccessAtCore(i);
@@ -893,6 +1030,33 @@ Status MemTable::Add(SequenceNumber s, ValueType type,
   return Status::OK();
 }
 
+Status MemTable::InsertSorted(std::vector<KeyHandle>* handles,
+                              bool allow_concurrent) {
+  std::sort(handles->begin(), handles->end(),
+            [this](KeyHandle a, KeyHandle b) {
+              return comparator_(static_cast<const char*>(a),
+                                 static_cast<const char*>(b)) < 0;
+            });
+  bool duplicate = false;
+  if (!allow_concurrent) {
+    for (KeyHandle handle : *handles) {
+      duplicate |= !table_->InsertKeyWithHint(handle, &sorted_insert_hint_);
+    }
+  } else {
+    void* hint = nullptr;
+    for (KeyHandle handle : *handles) {
+      duplicate |= !table_->InsertKeyWithHintConcurrently(handle, &hint);
+    }
+    // Hints of concurrent inserts are heap allocated
+    delete[] reinterpret_cast<char*>(hint);
+  }
+  handles->clear();
+  if (UNLIKELY(duplicate)) {
+    return Status::Corruption("key+seq exists");
+  }
+  return Status::OK();
+}
+
 // Callback from MemTable::Get()
 namespace {
 
@@ -920,6 +1084,7 @@ struct Saver {
   bool* is_blob_index;
   bool allow_data_in_errors;
   uint32_t protection_bytes_per_key;
+  uint32_t value_separation_min_size;
   bool CheckCallback(SequenceNumber _seq) {
     if (callback_) {
       return callback_->IsVisible(_seq);
@@ -964,7 +1129,8 @@ static bool SaveValue(void* arg, const char* entry) {
 
     if (s->protection_bytes_per_key > 0) {
       *(s->status) = MemTable::VerifyEntryChecksum(
-          entry, s->protection_bytes_per_key, s->allow_data_in_errors);
+          entry, s->protection_bytes_per_key, s->value_separation_min_size,
+          s->allow_data_in_errors);
       if (!s->status->ok()) {
         ROCKS_LOG_ERROR(s->logger, "In SaveValue: %s", s->status->getState());
         // Memtable entry corrupted
@@ -1042,7 +1208,9 @@ static bool SaveValue(void* arg, const char* entry) {
           return false;
         }
 
-        Slice v = GetLengthPrefixedSlice(key_ptr + key_length);
+        Slice v;
+        MemTable::DecodeEntryValue(key_ptr + key_length,
+                                   s->value_separation_min_size, &v);
 
         *(s->status) = Status::OK();
 
@@ -1059,7 +1227,9 @@ static bool SaveValue(void* arg, const char* entry) {
       }
       case kTypeValue:
       case kTypeValuePreferredSeqno: {
-        Slice v = GetLengthPrefixedSlice(key_ptr + key_length);
+        Slice v;
+        MemTable::DecodeEntryValue(key_ptr + key_length,
+                                   s->value_separation_min_size, &v);
 
         if (type == kTypeValuePreferredSeqno) {
           v = ParsePackedValueForValue(v);
@@ -1104,7 +1274,9 @@ static bool SaveValue(void* arg, const char* entry) {
         return false;
       }
       case kTypeWideColumnEntity: {
-        Slice v = GetLengthPrefixedSlice(key_ptr + key_length);
+        Slice v;
+        MemTable::DecodeEntryValue(key_ptr + key_length,
+                                   s->value_separation_min_size, &v);
 
         *(s->status) = Status::OK();
 
@@ -1190,7 +1362,9 @@ static bool SaveValue(void* arg, const char* entry) {
           *(s->found_final_value) = true;
           return false;
         }
-        Slice v = GetLengthPrefixedSlice(key_ptr + key_length);
+        Slice v;
+        MemTable::DecodeEntryValue(key_ptr + key_length,
+                                   s->value_separation_min_size, &v);
         *(s->merge_in_progress) = true;
         merge_context->PushOperand(
             v, s->inplace_update_support == false /* operand_pinned */);
@@ -1347,6 +1521,7 @@ void MemTable::GetFromTable(const LookupKey& key,
   saver.do_merge = do_merge;
   saver.allow_data_in_errors = moptions_.allow_data_in_errors;
   saver.protection_bytes_per_key = moptions_.protection_bytes_per_key;
+  saver.value_separation_min_size = moptions_.value_separation_min_size;
   table_->Get(key, &saver, SaveValue);
   *seq = saver.seq;
 }
@@ -1452,6 +1627,8 @@ void MemTable::MultiGet(const ReadOptions& read_options, MultiGetRange* range,
 Status MemTable::Update(SequenceNumber seq, ValueType value_type,
                         const Slice& key, const Slice& value,
                         const ProtectionInfoKVOS64* kv_prot_info) {
+  // Values are never separated with inplace_update_support.
+  assert(moptions_.value_separation_min_size == 0);
   LookupKey lkey(key, seq);
   Slice mem_key = lkey.memtable_key();
 
@@ -1515,6 +1692,8 @@ Status MemTable::Update(SequenceNumber seq, ValueType value_type,
 Status MemTable::UpdateCallback(SequenceNumber seq, const Slice& key,
                                 const Slice& delta,
                                 const ProtectionInfoKVOS64* kv_prot_info) {
+  // Values are never separated with inplace_update_support.
+  assert(moptions_.value_separation_min_size == 0);
   LookupKey lkey(key, seq);
   Slice memkey = lkey.memtable_key();
 
@@ -62,6 +62,7 @@ struct ImmutableMemTableOptions {
   Logger* info_log;
   bool allow_data_in_errors;
   uint32_t protection_bytes_per_key;
+  uint32_t value_separation_min_size;
 };
 
 // Batched counters to updated when inserting keys in one write batch.
@@ -238,11 +239,28 @@ class MemTable {
   // Returns `Status::TryAgain` if the `seq`, `key` combination already exists
   // in the memtable and `MemTableRepFactory::CanHandleDuplicatedKey()` is true.
   // The next attempt should try a larger value for `seq`.
+  //
+  // If `deferred_inserts` is not null, a point entry is encoded and accounted
+  // for, but only inserted into the memtable representation by a later
+  // InsertSorted() call, to which its handle is appended. Duplicates are not
+  // detected until then.
   Status Add(SequenceNumber seq, ValueType type, const Slice& key,
              const Slice& value, const ProtectionInfoKVOS64* kv_prot_info,
              bool allow_concurrent = false,
              MemTablePostProcessInfo* post_process_info = nullptr,
-             void** hint = nullptr);
+             void** hint = nullptr,
+             std::vector<KeyHandle>* deferred_inserts = nullptr);
+
+  // Inserts the entries deferred by Add() into the memtable representation.
+  // They are sorted first, so that each insert can resume the search from the
+  // position of the previous one (see MemTableRep::InsertKeyWithHint())
+  // instead of searching from the top. Clears `handles`.
+  //
+  // Returns `Status::Corruption` if a `seq`, `key` combination already
+  // existed in the memtable.
+  //
+  // REQUIRES: the same `allow_concurrent` as passed to Add().
+  Status InsertSorted(std::vector<KeyHandle>* handles, bool allow_concurrent);
 
   // Used to Get value associated with key or Get Merge Operands associated
   // with key.
@@ -485,6 +503,11 @@ class MemTable {
     return table_->IsSnapshotSupported() && !moptions_.inplace_update_support;
   }
 
+  // return true if the current MemTableRep supports UniqueRandomSample().
+  bool IsRandomSampleSupported() const {
+    return table_->IsRandomSampleSupported();
+  }
+
   struct MemTableStats {
     uint64_t size;
     uint64_t count;
@@ -562,8 +585,24 @@ class MemTable {
   // Returns Corruption status if verification fails.
   static Status VerifyEntryChecksum(const char* entry,
                                     uint32_t protection_bytes_per_key,
+                                    uint32_t value_separation_min_size,
                                     bool allow_data_in_errors = false);
 
+  // Whether a value of `value_size` bytes is stored outside of its entry,
+  // in the value arena of the memtable.
+  static bool IsSeparatedValue(uint32_t value_size,
+                               uint32_t value_separation_min_size) {
+    return value_separation_min_size > 0 &&
+           value_size >= value_separation_min_size;
+  }
+
+  // Decodes the length-prefixed value of a memtable entry at `p` into
+  // `value`, following the pointer stored in the entry for separated values.
+  // Returns the end of the value in the entry, or nullptr on corruption.
+  static const char* DecodeEntryValue(const char* p,
+                                      uint32_t value_separation_min_size,
+                                      Slice* value);
+
  private:
   enum FlushStateEnum { FLUSH_NOT_REQUESTED, FLUSH_REQUESTED, FLUSH_SCHEDULED };
 
@@ -577,6 +616,10 @@ class MemTable {
   const size_t kArenaBlockSize;
   AllocTracker mem_tracker_;
   ConcurrentArena arena_;
+  // Holds values of at least moptions_.value_separation_min_size bytes, so
+  // that they do not spread out the entries of table_. Only created if value
+  // separation is enabled, so that it costs nothing otherwise.
+  std::unique_ptr<ConcurrentArena> value_arena_;
   std::unique_ptr<MemTableRep> table_;
   std::unique_ptr<MemTableRep> range_del_table_;
   std::atomic_bool is_range_del_table_empty_;
@@ -631,6 +674,9 @@ class MemTable {
   // Insert hints for each prefix.
   UnorderedMapH<Slice, void*, SliceHasher32> insert_hints_;
 
+  // Insert hint for non-concurrent InsertSorted()
+  void* sorted_insert_hint_ = nullptr;
+
   // Timestamp of oldest key
   std::atomic<uint64_t> oldest_key_time_;
 
@@ -695,6 +741,14 @@ class MemTable {
   std::unique_ptr<FragmentedRangeTombstoneList>
       fragmented_range_tombstone_list_;
 
+  // Sets up `new_cache`, which replaces `prev_cache` after the range
+  // tombstone (`tombstone_key`, `tombstone_end`) is added, to be built from
+  // the fragmented tombstones of `prev_cache` where possible.
+  void InheritRangeTombstones(
+      const std::shared_ptr<FragmentedRangeTombstoneListCache>& prev_cache,
+      const Slice& tombstone_key, const Slice& tombstone_end,
+      FragmentedRangeTombstoneListCache* new_cache);
+
   // makes sure there is a single range tombstone writer to invalidate cache
   std::mutex range_del_mutex_;
   CoreLocalArray<std::shared_ptr<FragmentedRangeTombstoneListCache>>
@@ -369,6 +369,14 @@ bool MemTableListVersion::TrimHistory(autovector<MemTable*>* to_delete,
   return ret;
 }
 
+void MemTableListVersion::DropHistory(autovector<MemTable*>* to_delete) {
+  while (!memlist_history_.empty()) {
+    MemTable* x = memlist_history_.back();
+    memlist_history_.pop_back();
+    UnrefMemTable(to_delete, x);
+  }
+}
+
 // Returns true if there is at least one memtable on which flush has
 // not yet started.
 bool MemTableList::IsFlushPending() const {
@@ -672,6 +680,13 @@ bool MemTableList::TrimHistory(autovector<MemTable*>* to_delete, size_t usage) {
   return ret;
 }
 
+void MemTableList::DropHistory(autovector<MemTable*>* to_delete) {
+  InstallNewVersion();
+  current_->DropHistory(to_delete);
+  UpdateCachedValuesFromMemTableListVersion();
+  ResetTrimHistoryNeeded();
+}
+
 // Returns an estimate of the number of bytes of data in use.
 size_t MemTableList::ApproximateUnflushedMemTablesMemoryUsage() {
   size_t total_size = 0;
@@ -162,6 +162,8 @@ class MemTableListVersion {
   // Return true if memtable is trimmed
   bool TrimHistory(autovector<MemTable*>* to_delete, size_t usage);
 
+  void DropHistory(autovector<MemTable*>* to_delete);
+
   bool GetFromList(std::list<MemTable*>* list, const LookupKey& key,
                    std::string* value, PinnableWideColumns* columns,
                    std::string* timestamp, Status* s,
@@ -328,6 +330,10 @@ class MemTableList {
   // Return true if memtable is trimmed
   bool TrimHistory(autovector<MemTable*>* to_delete, size_t usage);
 
+  // Drops all flushed memtables kept in the history, regardless of
+  // max_write_buffer_size_to_maintain.
+  void DropHistory(autovector<MemTable*>* to_delete);
+
   // Returns an estimate of the number of bytes of data used by
   // the unflushed mem-tables.
   size_t ApproximateUnflushedMemTablesMemoryUsage();
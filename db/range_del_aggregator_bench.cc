@@ -11,12 +11,14 @@ int main() {
 }
 #else
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "db/dbformat.h"
@@ -54,6 +56,11 @@ DEFINE_int32(should_deletes_per_run, 1, "number of ShouldDelete calls per run");
 DEFINE_int32(add_tombstones_per_run, 1,
              "number of AddTombstones calls per run");
 
+DEFINE_int32(incremental_tombstones_per_run, 0,
+             "number of range tombstones of each AddTombstones call that are "
+             "merged one at a time into the fragmented list of the others, as "
+             "a mutable memtable does, instead of being fragmented with them");
+
 DEFINE_bool(use_compaction_range_del_aggregator, false,
             "Whether to use CompactionRangeDelAggregator. Default is to use "
             "ReadRangeDelAggregator.");
@@ -65,6 +72,7 @@ struct Stats {
   uint64_t time_first_should_delete = 0;
   uint64_t time_rest_should_delete = 0;
   uint64_t time_fragment_tombstones = 0;
+  uint64_t time_merge_tombstones = 0;
 };
 
 std::ostream& operator<<(std::ostream& os, const Stats& s) {
@@ -76,6 +84,13 @@ std::ostream& operator<<(std::ostream& os, const Stats& s) {
      << s.time_fragment_tombstones /
             (FLAGS_add_tombstones_per_run * FLAGS_num_runs * 1.0e3)
      << " us\n";
+  if (FLAGS_incremental_tombstones_per_run > 0) {
+    os << std::setw(25) << "Merge Tombstone: "
+       << s.time_merge_tombstones /
+              (FLAGS_incremental_tombstones_per_run *
+               FLAGS_add_tombstones_per_run * FLAGS_num_runs * 1.0e3)
+       << " us\n";
+  }
   os << std::setw(25) << "AddTombstones: "
      << s.time_add_tombstones /
             (FLAGS_add_tombstones_per_run * FLAGS_num_runs * 1.0e3)
@@ -194,6 +209,10 @@ int main(int argc, char** argv) {
         std::vector<ROCKSDB_NAMESPACE::PersistentRangeTombstone>(
             FLAGS_num_range_tombstones);
   }
+  // At least one tombstone of each call is fragmented from scratch.
+  FLAGS_incremental_tombstones_per_run =
+      std::max(0, std::min(FLAGS_incremental_tombstones_per_run,
+                           FLAGS_num_range_tombstones - 1));
   auto mode = ROCKSDB_NAMESPACE::RangeDelPositioningMode::kForwardTraversal;
   std::vector<ROCKSDB_NAMESPACE::SequenceNumber> snapshots{0};
   for (int i = 0; i < FLAGS_num_runs; i++) {
@@ -210,6 +229,11 @@ int main(int argc, char** argv) {
     std::vector<
         std::unique_ptr<ROCKSDB_NAMESPACE::FragmentedRangeTombstoneList> >
         fragmented_range_tombstone_lists(FLAGS_add_tombstones_per_run);
+    std::vector<std::pair<ROCKSDB_NAMESPACE::InternalKey,
+                          ROCKSDB_NAMESPACE::Slice> >
+        serialized_tombstones;
+    serialized_tombstones.reserve(FLAGS_add_tombstones_per_run *
+                                  FLAGS_incremental_tombstones_per_run);
 
     for (auto& persistent_range_tombstones : all_persistent_range_tombstones) {
       // TODO(abhimadan): consider whether creating the range tombstones right
@@ -223,8 +247,14 @@ int main(int argc, char** argv) {
             ROCKSDB_NAMESPACE::PersistentRangeTombstone(
                 ROCKSDB_NAMESPACE::Key(start), ROCKSDB_NAMESPACE::Key(end), j);
       }
-      auto iter =
-          ROCKSDB_NAMESPACE::MakeRangeDelIterator(persistent_range_tombstones);
+      // The last incremental_tombstones_per_run tombstones are merged into
+      // the fragmented list of the others one at a time.
+      auto incremental_begin =
+          persistent_range_tombstones.end() -
+          FLAGS_incremental_tombstones_per_run;
+      auto iter = ROCKSDB_NAMESPACE::MakeRangeDelIterator(
+          std::vector<ROCKSDB_NAMESPACE::PersistentRangeTombstone>(
+              persistent_range_tombstones.begin(), incremental_begin));
       ROCKSDB_NAMESPACE::StopWatchNano stop_watch_fragment_tombstones(
           clock, true /* auto_start */);
       fragmented_range_tombstone_lists.emplace_back(
@@ -233,6 +263,31 @@ int main(int argc, char** argv) {
               snapshots));
       stats.time_fragment_tombstones +=
           stop_watch_fragment_tombstones.ElapsedNanos();
+
+      // A merged list references the keys of the list it is merged from, so
+      // the first list is kept alive along with the last one.
+      std::unique_ptr<ROCKSDB_NAMESPACE::FragmentedRangeTombstoneList>
+          merged_list;
+      for (auto it = incremental_begin; it != persistent_range_tombstones.end();
+           ++it) {
+        serialized_tombstones.push_back(it->tombstone.Serialize());
+        std::vector<
+            std::pair<ROCKSDB_NAMESPACE::Slice, ROCKSDB_NAMESPACE::Slice> >
+            new_tombstones{{serialized_tombstones.back().first.Encode(),
+                            serialized_tombstones.back().second}};
+        const auto& base = merged_list != nullptr
+                               ? *merged_list
+                               : *fragmented_range_tombstone_lists.back();
+        ROCKSDB_NAMESPACE::StopWatchNano stop_watch_merge_tombstones(
+            clock, true /* auto_start */);
+        merged_list.reset(new ROCKSDB_NAMESPACE::FragmentedRangeTombstoneList(
+            base, new_tombstones, icmp));
+        stats.time_merge_tombstones +=
+            stop_watch_merge_tombstones.ElapsedNanos();
+      }
+      if (merged_list != nullptr) {
+        fragmented_range_tombstone_lists.emplace_back(std::move(merged_list));
+      }
       std::unique_ptr<ROCKSDB_NAMESPACE::FragmentedRangeTombstoneIterator>
           fragmented_range_del_iter(
               new ROCKSDB_NAMESPACE::FragmentedRangeTombstoneIterator(
@@ -85,6 +85,180 @@ FragmentedRangeTombstoneList::FragmentedRangeTombstoneList(
   FragmentTombstones(std::move(iter), icmp, for_compaction, snapshots);
 }
 
+namespace {
+// Iterates over range tombstones whose keys are pinned by the caller, sorted
+// by start key.
+class PinnedRangeTombstoneIterator : public InternalIterator {
+ public:
+  PinnedRangeTombstoneIterator(std::vector<std::pair<Slice, Slice>> tombstones,
+                               const InternalKeyComparator* icmp)
+      : tombstones_(std::move(tombstones)),
+        icmp_(icmp),
+        current_(tombstones_.size()) {
+    std::sort(tombstones_.begin(), tombstones_.end(),
+              [icmp](const std::pair<Slice, Slice>& a,
+                     const std::pair<Slice, Slice>& b) {
+                return icmp->Compare(a.first, b.first) < 0;
+              });
+  }
+
+  bool Valid() const override { return current_ < tombstones_.size(); }
+  void SeekToFirst() override { current_ = 0; }
+  void SeekToLast() override {
+    current_ = tombstones_.empty() ? 0 : tombstones_.size() - 1;
+  }
+  void Seek(const Slice& target) override {
+    current_ = std::lower_bound(tombstones_.begin(), tombstones_.end(), target,
+                                [this](const std::pair<Slice, Slice>& t,
+                                       const Slice& k) {
+                                  return icmp_->Compare(t.first, k) < 0;
+                                }) -
+               tombstones_.begin();
+  }
+  void SeekForPrev(const Slice& target) override {
+    current_ = std::upper_bound(tombstones_.begin(), tombstones_.end(), target,
+                                [this](const Slice& k,
+                                       const std::pair<Slice, Slice>& t) {
+                                  return icmp_->Compare(k, t.first) < 0;
+                                }) -
+               tombstones_.begin();
+    // Wraps around to an invalid position before the first tombstone.
+    current_--;
+  }
+  void Next() override { current_++; }
+  void Prev() override { current_--; }
+  Slice key() const override { return tombstones_[current_].first; }
+  Slice value() const override { return tombstones_[current_].second; }
+  Status status() const override { return Status::OK(); }
+  bool IsKeyPinned() const override { return true; }
+  bool IsValuePinned() const override { return true; }
+
+ private:
+  std::vector<std::pair<Slice, Slice>> tombstones_;
+  const InternalKeyComparator* icmp_;
+  size_t current_;
+};
+}  // anonymous namespace
+
+FragmentedRangeTombstoneList::FragmentedRangeTombstoneList(
+    const FragmentedRangeTombstoneList& base,
+    const std::vector<std::pair<Slice, Slice>>& new_tombstones,
+    const InternalKeyComparator& icmp) {
+  const Comparator* ucmp = icmp.user_comparator();
+  assert(ucmp->timestamp_size() == 0);
+  // A new tombstone may already have been in the memtable when `base` was
+  // built. Then its start key is covered in `base` at its sequence number,
+  // and it is only counted once.
+  num_unfragmented_tombstones_ = base.num_unfragmented_tombstones_;
+  total_tombstone_payload_bytes_ = base.total_tombstone_payload_bytes_;
+  for (const auto& tombstone : new_tombstones) {
+    const Slice start_key = ExtractUserKey(tombstone.first);
+    const SequenceNumber seq = GetInternalKeySeqno(tombstone.first);
+    auto frag = std::upper_bound(
+        base.tombstones_.begin(), base.tombstones_.end(), start_key,
+        [ucmp](const Slice& k, const RangeTombstoneStack& t) {
+          return ucmp->Compare(k, t.end_key) < 0;
+        });
+    if (frag != base.tombstones_.end() &&
+        ucmp->Compare(frag->start_key, start_key) <= 0 &&
+        std::binary_search(base.seq_iter(frag->seq_start_idx),
+                           base.seq_iter(frag->seq_end_idx), seq,
+                           std::greater<SequenceNumber>())) {
+      continue;
+    }
+    num_unfragmented_tombstones_++;
+    total_tombstone_payload_bytes_ +=
+        tombstone.first.size() + tombstone.second.size();
+  }
+
+  // Fragment the new tombstones on their own, then move their fragments out
+  // of the way to merge them with the fragments of `base`.
+  FragmentTombstones(
+      std::make_unique<PinnedRangeTombstoneIterator>(new_tombstones, &icmp),
+      icmp, false /* for_compaction */, {} /* snapshots */);
+  std::vector<RangeTombstoneStack> new_fragments;
+  std::vector<SequenceNumber> new_seqs;
+  new_fragments.swap(tombstones_);
+  new_seqs.swap(tombstone_seqs_);
+  tombstones_.reserve(base.tombstones_.size() + 2 * new_fragments.size());
+  tombstone_seqs_.reserve(base.tombstone_seqs_.size() + new_seqs.size());
+
+  // Sweep over both sets of non-overlapping fragments, cutting a new fragment
+  // at every start or end key of either. `b` and `n` are the first fragments
+  // of each set that end after cur_start_key.
+  auto b = base.tombstones_.begin();
+  auto n = new_fragments.begin();
+  Slice cur_start_key;
+  bool positioned = false;
+  while (true) {
+    if (positioned) {
+      while (b != base.tombstones_.end() &&
+             ucmp->Compare(b->end_key, cur_start_key) <= 0) {
+        ++b;
+      }
+      while (n != new_fragments.end() &&
+             ucmp->Compare(n->end_key, cur_start_key) <= 0) {
+        ++n;
+      }
+    }
+    const bool b_valid = b != base.tombstones_.end();
+    const bool n_valid = n != new_fragments.end();
+    if (!b_valid && !n_valid) {
+      break;
+    }
+    const bool in_b = positioned && b_valid &&
+                      ucmp->Compare(b->start_key, cur_start_key) <= 0;
+    const bool in_n = positioned && n_valid &&
+                      ucmp->Compare(n->start_key, cur_start_key) <= 0;
+    if (!in_b && !in_n) {
+      // Skip the gap up to the next fragment.
+      if (!n_valid ||
+          (b_valid && ucmp->Compare(b->start_key, n->start_key) < 0)) {
+        cur_start_key = b->start_key;
+      } else {
+        cur_start_key = n->start_key;
+      }
+      positioned = true;
+      continue;
+    }
+
+    Slice cur_end_key;
+    if (b_valid) {
+      cur_end_key = in_b ? b->end_key : b->start_key;
+    }
+    if (n_valid) {
+      const Slice& n_key = in_n ? n->end_key : n->start_key;
+      if (!b_valid || ucmp->Compare(n_key, cur_end_key) < 0) {
+        cur_end_key = n_key;
+      }
+    }
+
+    // Both sequence number lists are in descending order.
+    auto b_seq = in_b ? base.seq_iter(b->seq_start_idx) : base.seq_end();
+    auto b_seq_end = in_b ? base.seq_iter(b->seq_end_idx) : base.seq_end();
+    auto n_seq = new_seqs.cend();
+    auto n_seq_end = new_seqs.cend();
+    if (in_n) {
+      n_seq = new_seqs.cbegin() + n->seq_start_idx;
+      n_seq_end = new_seqs.cbegin() + n->seq_end_idx;
+    }
+    size_t start_idx = tombstone_seqs_.size();
+    while (b_seq != b_seq_end || n_seq != n_seq_end) {
+      if (n_seq == n_seq_end || (b_seq != b_seq_end && *b_seq >= *n_seq)) {
+        if (n_seq != n_seq_end && *n_seq == *b_seq) {
+          ++n_seq;
+        }
+        tombstone_seqs_.push_back(*b_seq++);
+      } else {
+        tombstone_seqs_.push_back(*n_seq++);
+      }
+    }
+    tombstones_.emplace_back(cur_start_key, cur_end_key, start_idx,
+                             tombstone_seqs_.size());
+    cur_start_key = cur_end_key;
+  }
+}
+
 void FragmentedRangeTombstoneList::FragmentTombstones(
     std::unique_ptr<InternalIterator> unfragmented_tombstones,
     const InternalKeyComparator& icmp, bool for_compaction,
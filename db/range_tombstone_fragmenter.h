@@ -9,6 +9,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "db/dbformat.h"
@@ -47,6 +48,19 @@ struct FragmentedRangeTombstoneList {
       const std::vector<SequenceNumber>& snapshots = {},
       const bool tombstone_end_include_ts = true);
 
+  // Fragments the union of the tombstones in `base` and `new_tombstones`
+  // (pairs of internal start key and user end key). Only `new_tombstones` is
+  // fragmented; the result is then merged with the fragments of `base` in a
+  // single pass, which is much cheaper than fragmenting every tombstone again
+  // when `new_tombstones` is small. A tombstone in both inputs is kept once.
+  // Keys are referenced rather than copied, so the memory backing the keys of
+  // `base` and `new_tombstones` must outlive this list. User-defined
+  // timestamps are not supported.
+  FragmentedRangeTombstoneList(
+      const FragmentedRangeTombstoneList& base,
+      const std::vector<std::pair<Slice, Slice>>& new_tombstones,
+      const InternalKeyComparator& icmp);
+
   std::vector<RangeTombstoneStack>::const_iterator begin() const {
     return tombstones_.begin();
   }
@@ -117,9 +131,16 @@ struct FragmentedRangeTombstoneList {
 struct FragmentedRangeTombstoneListCache {
   // ensure only the first reader needs to initialize l
   std::mutex reader_mutex;
-  std::unique_ptr<FragmentedRangeTombstoneList> tombstones = nullptr;
+  std::shared_ptr<FragmentedRangeTombstoneList> tombstones = nullptr;
   // readers will first check this bool to avoid
   std::atomic<bool> initialized = false;
+  // If set, the fragmented tombstones of an earlier cache. `tombstones` is
+  // then built by merging `base` with `new_tombstones`, the tombstones added
+  // since, instead of fragmenting all tombstones again. Only accessed through
+  // std::atomic_load/store as the first reader releases it once `tombstones`
+  // is built. `new_tombstones` is immutable once the cache is published.
+  std::shared_ptr<FragmentedRangeTombstoneList> base = nullptr;
+  std::vector<std::pair<Slice, Slice>> new_tombstones;
 };
 
 // FragmentedRangeTombstoneIterator converts an InternalIterator of a range-del
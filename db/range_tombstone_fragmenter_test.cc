@@ -546,6 +546,93 @@ TEST_F(RangeTombstoneFragmenterTest, SeekOutOfBounds) {
                     {{"", {}, true /* out of range */}, {"z", {"l", "n", 4}}});
 }
 
+TEST_F(RangeTombstoneFragmenterTest, MergeNewTombstones) {
+  auto range_del_iter = MakeRangeDelIter({{"a", "e", 10}, {"g", "i", 5}});
+  FragmentedRangeTombstoneList base(std::move(range_del_iter), bytewise_icmp);
+
+  // "c"@12 splits an existing fragment, "e"@3 fills the gap, and "a"@10 is
+  // already part of `base`.
+  std::vector<RangeTombstone> new_tombstones{
+      {"c", "h", 12}, {"e", "g", 3}, {"a", "e", 10}};
+  std::vector<std::pair<InternalKey, Slice>> serialized;
+  std::vector<std::pair<Slice, Slice>> new_tombstone_slices;
+  for (const auto& t : new_tombstones) {
+    serialized.push_back(t.Serialize());
+  }
+  for (const auto& t : serialized) {
+    new_tombstone_slices.emplace_back(t.first.Encode(), t.second);
+  }
+  FragmentedRangeTombstoneList fragment_list(base, new_tombstone_slices,
+                                             bytewise_icmp);
+  ASSERT_EQ(4, fragment_list.num_unfragmented_tombstones());
+  FragmentedRangeTombstoneIterator iter(&fragment_list, bytewise_icmp,
+                                        kMaxSequenceNumber);
+  VerifyFragmentedRangeDels(&iter, {{"a", "c", 10},
+                                    {"c", "e", 12},
+                                    {"c", "e", 10},
+                                    {"e", "g", 12},
+                                    {"e", "g", 3},
+                                    {"g", "h", 12},
+                                    {"g", "h", 5},
+                                    {"h", "i", 5}});
+  VerifyMaxCoveringTombstoneSeqnum(
+      &iter, {{"a", 10}, {"d", 12}, {"f", 12}, {"h", 5}, {"i", 0}});
+}
+
+TEST_F(RangeTombstoneFragmenterTest, MergeNewTombstonesRandomized) {
+  Random rnd(301);
+  std::vector<std::string> keys;
+  for (int i = 0; i < 120; i++) {
+    char buf[8];
+    snprintf(buf, sizeof(buf), "%03d", i);
+    keys.emplace_back(buf);
+  }
+  std::vector<RangeTombstone> tombstones;
+  for (SequenceNumber seq = 1; seq <= 1000; seq++) {
+    uint32_t start = rnd.Uniform(100);
+    uint32_t end = start + 1 + rnd.Uniform(20);
+    tombstones.emplace_back(keys[start], keys[end], seq);
+  }
+
+  // Merge the tombstones into the fragmented list in batches of random size,
+  // and check the result against fragmenting them all at once.
+  std::vector<std::unique_ptr<FragmentedRangeTombstoneList>> lists;
+  std::vector<std::pair<InternalKey, Slice>> serialized;
+  serialized.reserve(tombstones.size());
+  std::vector<std::pair<Slice, Slice>> new_tombstones;
+  lists.emplace_back(new FragmentedRangeTombstoneList(
+      MakeRangeDelIter({tombstones[0]}), bytewise_icmp));
+  for (size_t i = 1; i < tombstones.size(); i++) {
+    serialized.push_back(tombstones[i].Serialize());
+    new_tombstones.emplace_back(serialized.back().first.Encode(),
+                                serialized.back().second);
+    if (!rnd.OneIn(3) && i + 1 < tombstones.size()) {
+      continue;
+    }
+    lists.emplace_back(new FragmentedRangeTombstoneList(
+        *lists.back(), new_tombstones, bytewise_icmp));
+    new_tombstones.clear();
+
+    const FragmentedRangeTombstoneList& merged = *lists.back();
+    FragmentedRangeTombstoneList expected(
+        MakeRangeDelIter(std::vector<RangeTombstone>(
+            tombstones.begin(), tombstones.begin() + i + 1)),
+        bytewise_icmp);
+    ASSERT_EQ(i + 1, merged.num_unfragmented_tombstones());
+    ASSERT_EQ(expected.end() - expected.begin(),
+              merged.end() - merged.begin());
+    for (auto e = expected.begin(), m = merged.begin(); e != expected.end();
+         ++e, ++m) {
+      ASSERT_EQ(e->start_key, m->start_key);
+      ASSERT_EQ(e->end_key, m->end_key);
+      ASSERT_TRUE(std::equal(expected.seq_iter(e->seq_start_idx),
+                             expected.seq_iter(e->seq_end_idx),
+                             merged.seq_iter(m->seq_start_idx),
+                             merged.seq_iter(m->seq_end_idx)));
+    }
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
@@ -1088,6 +1088,15 @@ class LevelIterator final : public InternalIterator {
 
   bool IsDeleteRangeSentinelKey() const override { return to_return_sentinel_; }
 
+  void Prepare(const std::vector<ScanRange>& scan_ranges) override {
+    // Files are only opened when the iterator gets to them, so just remember
+    // the ranges and pass the overlapping ones down in NewFileIterator().
+    scan_ranges_ = scan_ranges;
+    SetFileIterator(nullptr);
+    file_index_ = flevel_->num_files;
+    ClearRangeTombstoneIter();
+  }
+
   void SetRangeDelReadSeqno(SequenceNumber read_seq) override {
     read_seq_ = read_seq;
   }
@@ -1140,7 +1149,7 @@ class LevelIterator final : public InternalIterator {
     }
     CheckMayBeOutOfLowerBound();
     ClearRangeTombstoneIter();
-    return table_cache_->NewIterator(
+    InternalIterator* iter = table_cache_->NewIterator(
         read_options_, file_options_, icomparator_, *file_meta.file_metadata,
         range_del_agg_, prefix_extractor_,
         nullptr /* don't need reference to table */, file_read_hist_, caller_,
@@ -1148,6 +1157,21 @@ class LevelIterator final : public InternalIterator {
         /*max_file_size_for_l0_meta_pin=*/0, smallest_compaction_key,
         largest_compaction_key, allow_unprepared_value_,
         block_protection_bytes_per_key_, &read_seq_, range_tombstone_iter_);
+    if (!scan_ranges_.empty()) {
+      std::vector<ScanRange> file_scan_ranges;
+      for (const ScanRange& range : scan_ranges_) {
+        if (icomparator_.Compare(range.start, file_largest_key(file_index_)) <=
+                0 &&
+            icomparator_.Compare(range.limit, file_smallest_key(file_index_)) >
+                0) {
+          file_scan_ranges.push_back(range);
+        }
+      }
+      if (!file_scan_ranges.empty()) {
+        iter->Prepare(file_scan_ranges);
+      }
+    }
+    return iter;
   }
 
   // Check if current file being fully within iterate_lower_bound.
@@ -1207,6 +1231,9 @@ class LevelIterator final : public InternalIterator {
   Slice sentinel_;
   SequenceNumber read_seq_;
 
+  // Set by Prepare(). The slices point to memory owned by the caller.
+  std::vector<ScanRange> scan_ranges_;
+
   int level_;
   uint8_t block_protection_bytes_per_key_;
   bool should_sample_;
@@ -3954,15 +3981,25 @@ void VersionStorageInfo::UpdateNumNonEmptyLevels() {
 }
 
 namespace {
-// Sort `temp` based on ratio of overlapping size over file size
+// Sort `temp` based on ratio of overlapping size over file size. With
+// `weight_by_reads`, the ratio is divided by one plus the sampled reads of
+// the file relative to the average file of the level.
 void SortFileByOverlappingRatio(
     const InternalKeyComparator& icmp, const std::vector<FileMetaData*>& files,
     const std::vector<FileMetaData*>& next_level_files, SystemClock* clock,
-    int level, int num_non_empty_levels, uint64_t ttl,
+    int level, int num_non_empty_levels, uint64_t ttl, bool weight_by_reads,
     std::vector<Fsize>* temp) {
   std::unordered_map<uint64_t, uint64_t> file_to_order;
   auto next_level_it = next_level_files.begin();
 
+  uint64_t level_reads = 0;
+  if (weight_by_reads) {
+    for (auto& file : files) {
+      level_reads +=
+          file->stats.num_reads_sampled.load(std::memory_order_relaxed);
+    }
+  }
+
   int64_t curr_time;
   Status status = clock->GetCurrentTime(&curr_time);
   if (!status.ok()) {
@@ -3995,9 +4032,17 @@ void SortFileByOverlappingRatio(
     uint64_t ttl_boost_score = (ttl > 0) ? ttl_booster.GetBoostScore(file) : 1;
     assert(ttl_boost_score > 0);
     assert(file->compensated_file_size != 0);
-    file_to_order[file->fd.GetNumber()] = overlapping_bytes * 1024U /
-                                          file->compensated_file_size /
-                                          ttl_boost_score;
+    uint64_t order = overlapping_bytes * 1024U /
+                     file->compensated_file_size / ttl_boost_score;
+    if (level_reads > 0) {
+      const double relative_reads =
+          static_cast<double>(
+              file->stats.num_reads_sampled.load(std::memory_order_relaxed)) *
+          static_cast<double>(files.size()) / static_cast<double>(level_reads);
+      order = static_cast<uint64_t>(static_cast<double>(order) /
+                                    (1.0 + relative_reads));
+    }
+    file_to_order[file->fd.GetNumber()] = order;
   }
 
   size_t num_to_sort = temp->size() > VersionStorageInfo::kNumberFilesToSort
@@ -4128,9 +4173,11 @@ void VersionStorageInfo::UpdateFilesByCompactionPri(
                   });
         break;
       case kMinOverlappingRatio:
-        SortFileByOverlappingRatio(*internal_comparator_, files_[level],
-                                   files_[level + 1], ioptions.clock, level,
-                                   num_non_empty_levels_, options.ttl, &temp);
+      case kReadWeightedOverlappingRatio:
+        SortFileByOverlappingRatio(
+            *internal_comparator_, files_[level], files_[level + 1],
+            ioptions.clock, level, num_non_empty_levels_, options.ttl,
+            ioptions.compaction_pri == kReadWeightedOverlappingRatio, &temp);
         break;
       case kRoundRobin:
         SortFileByRoundRobin(*internal_comparator_, &compact_cursor_,
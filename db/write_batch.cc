@@ -1926,6 +1926,26 @@ class MemTableInserter : public WriteBatch::Handler {
   using HintMapType = aligned_storage<HintMap>::type;
   HintMapType hint_;
 
+  // Whether point entries are inserted into memtables in sorted order once
+  // the whole batch (group) is processed. See
+  // DBOptions::memtable_sorted_batch_insert.
+  const bool sorted_insert_;
+  bool deferred_inserts_created_;
+  // Point entries whose insertion into each memtable is deferred
+  using DeferredInsertMap =
+      std::unordered_map<MemTable*, std::vector<KeyHandle>>;
+  using DeferredInsertMapType = aligned_storage<DeferredInsertMap>::type;
+  DeferredInsertMapType deferred_inserts_;
+
+  DeferredInsertMap& GetDeferredInsertMap() {
+    assert(sorted_insert_);
+    if (!deferred_inserts_created_) {
+      new (&deferred_inserts_) DeferredInsertMap();
+      deferred_inserts_created_ = true;
+    }
+    return *reinterpret_cast<DeferredInsertMap*>(&deferred_inserts_);
+  }
+
   HintMap& GetHintMap() {
     assert(hint_per_batch_);
     if (!hint_created_) {
@@ -2024,7 +2044,14 @@ class MemTableInserter : public WriteBatch::Handler {
         duplicate_detector_(),
         dup_dectector_on_(false),
         hint_per_batch_(hint_per_batch),
-        hint_created_(false) {
+        hint_created_(false),
+        // Duplicate key+seq are only detected when inserting into the memtable
+        // representation, which is too late for seq_per_batch to retry with a
+        // new sequence number.
+        sorted_insert_(
+            !seq_per_batch && db_ != nullptr &&
+            db_->immutable_db_options().memtable_sorted_batch_insert),
+        deferred_inserts_created_(false) {
     assert(cf_mems_);
   }
 
@@ -2042,6 +2069,16 @@ class MemTableInserter : public WriteBatch::Handler {
       }
       reinterpret_cast<HintMap*>(&hint_)->~HintMap();
     }
+    if (deferred_inserts_created_) {
+      // All deferred entries must have been inserted
+      assert(std::all_of(
+          GetDeferredInsertMap().begin(), GetDeferredInsertMap().end(),
+          [](const DeferredInsertMap::value_type& p) {
+            return p.second.empty();
+          }));
+      reinterpret_cast<DeferredInsertMap*>(&deferred_inserts_)
+          ->~DeferredInsertMap();
+    }
     delete rebuilding_trx_;
   }
 
@@ -2072,6 +2109,22 @@ class MemTableInserter : public WriteBatch::Handler {
 
   SequenceNumber sequence() const { return sequence_; }
 
+  // Inserts the point entries deferred by sorted memtable inserts. Must be
+  // called before the sequence numbers of the batch (group) are published.
+  Status InsertDeferred() {
+    Status s;
+    if (deferred_inserts_created_) {
+      for (auto& pair : GetDeferredInsertMap()) {
+        Status insert_status = pair.first->InsertSorted(
+            &pair.second, concurrent_memtable_writes_);
+        if (s.ok()) {
+          s = insert_status;
+        }
+      }
+    }
+    return s;
+  }
+
   void PostProcess() {
     assert(concurrent_memtable_writes_);
     // If post info was not created there is nothing
@@ -2162,7 +2215,8 @@ class MemTableInserter : public WriteBatch::Handler {
       ret_status =
           mem->Add(sequence_, value_type, key, value, kv_prot_info,
                    concurrent_memtable_writes_, get_post_process_info(mem),
-                   hint_per_batch_ ? &GetHintMap()[mem] : nullptr);
+                   hint_per_batch_ ? &GetHintMap()[mem] : nullptr,
+                   get_deferred_inserts(mem));
     } else if (moptions->inplace_callback == nullptr ||
                value_type != kTypeValue) {
       assert(!concurrent_memtable_writes_);
@@ -2382,7 +2436,8 @@ class MemTableInserter : public WriteBatch::Handler {
     ret_status =
         mem->Add(sequence_, delete_type, key, value, kv_prot_info,
                  concurrent_memtable_writes_, get_post_process_info(mem),
-                 hint_per_batch_ ? &GetHintMap()[mem] : nullptr);
+                 hint_per_batch_ ? &GetHintMap()[mem] : nullptr,
+                 get_deferred_inserts(mem));
     if (UNLIKELY(ret_status.IsTryAgain())) {
       assert(seq_per_batch_);
       const bool kBatchBoundary = true;
@@ -2765,11 +2820,13 @@ class MemTableInserter : public WriteBatch::Handler {
             kv_prot_info->StripC(column_family_id).ProtectS(sequence_);
         ret_status =
             mem->Add(sequence_, kTypeMerge, key, value, &mem_kv_prot_info,
-                     concurrent_memtable_writes_, get_post_process_info(mem));
+                     concurrent_memtable_writes_, get_post_process_info(mem),
+                     nullptr /* hint */, get_deferred_inserts(mem));
       } else {
         ret_status = mem->Add(
             sequence_, kTypeMerge, key, value, nullptr /* kv_prot_info */,
-            concurrent_memtable_writes_, get_post_process_info(mem));
+            concurrent_memtable_writes_, get_post_process_info(mem),
+            nullptr /* hint */, get_deferred_inserts(mem));
       }
     }
 
@@ -3096,6 +3153,20 @@ class MemTableInserter : public WriteBatch::Handler {
     }
     return &GetPostMap()[mem];
   }
+
+  std::vector<KeyHandle>* get_deferred_inserts(MemTable* mem) {
+    if (!sorted_insert_) {
+      return nullptr;
+    }
+    // Successive merges and in-place updates read the memtable while the
+    // batch is being inserted, so they need to see the previous entries.
+    auto* moptions = mem->GetImmutableMemTableOptions();
+    if (moptions->max_successive_merges > 0 ||
+        moptions->inplace_update_support) {
+      return nullptr;
+    }
+    return &GetDeferredInsertMap()[mem];
+  }
 };
 
 }  // anonymous namespace
@@ -3131,12 +3202,14 @@ Status WriteBatchInternal::InsertInto(
     inserter.set_prot_info(w->batch->prot_info_.get());
     w->status = w->batch->Iterate(&inserter);
     if (!w->status.ok()) {
+      // Entries of the previous batches are still inserted
+      inserter.InsertDeferred().PermitUncheckedError();
       return w->status;
     }
     assert(!seq_per_batch || w->batch_cnt != 0);
     assert(!seq_per_batch || inserter.sequence() - w->sequence == w->batch_cnt);
   }
-  return Status::OK();
+  return inserter.InsertDeferred();
 }
 
 Status WriteBatchInternal::InsertInto(
@@ -3160,6 +3233,10 @@ Status WriteBatchInternal::InsertInto(
   inserter.set_log_number_ref(writer->log_ref);
   inserter.set_prot_info(writer->batch->prot_info_.get());
   Status s = writer->batch->Iterate(&inserter);
+  Status insert_status = inserter.InsertDeferred();
+  if (s.ok()) {
+    s = insert_status;
+  }
   assert(!seq_per_batch || batch_cnt != 0);
   assert(!seq_per_batch || inserter.sequence() - sequence == batch_cnt);
   if (concurrent_memtable_writes) {
@@ -3181,6 +3258,10 @@ Status WriteBatchInternal::InsertInto(
                             concurrent_memtable_writes, batch->prot_info_.get(),
                             has_valid_writes, seq_per_batch, batch_per_txn);
   Status s = batch->Iterate(&inserter);
+  Status insert_status = inserter.InsertDeferred();
+  if (s.ok()) {
+    s = insert_status;
+  }
   if (next_seq != nullptr) {
     *next_seq = inserter.sequence();
   }
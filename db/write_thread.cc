@@ -431,7 +431,8 @@ void WriteThread::JoinBatchGroup(Writer* w) {
     AwaitState(w,
                STATE_GROUP_LEADER | STATE_MEMTABLE_WRITER_LEADER |
                    STATE_PARALLEL_MEMTABLE_CALLER |
-                   STATE_PARALLEL_MEMTABLE_WRITER | STATE_COMPLETED,
+                   STATE_PARALLEL_MEMTABLE_WRITER |
+                   STATE_PARALLEL_WAL_WRITER | STATE_COMPLETED,
                &jbg_ctx);
     TEST_SYNC_POINT_CALLBACK("WriteThread::JoinBatchGroup:DoneWaiting", w);
   }
@@ -734,6 +735,54 @@ bool WriteThread::CompleteParallelMemTableWriter(Writer* w) {
   return true;
 }
 
+void WriteThread::LaunchParallelWalWriters(WriteGroup* write_group) {
+  assert(write_group != nullptr);
+  assert(write_group->wal_writer != nullptr);
+  // One for each record to encode, and one for the leader
+  size_t running = 1;
+  for (auto w : *write_group) {
+    if (!w->wal_record_claimed.load(std::memory_order_relaxed)) {
+      running++;
+    }
+  }
+  write_group->running_wal_writers.store(running, std::memory_order_relaxed);
+  for (auto w : *write_group) {
+    if (w != write_group->leader &&
+        !w->wal_record_claimed.load(std::memory_order_relaxed)) {
+      SetState(w, STATE_PARALLEL_WAL_WRITER);
+    }
+  }
+}
+
+void WriteThread::CompleteParallelWalRecord(WriteGroup* write_group) {
+  if (write_group->running_wal_writers.fetch_sub(
+          1, std::memory_order_acq_rel) == 1) {
+    // The leader is waiting in WaitForParallelWalWriters()
+    SetState(write_group->leader, STATE_PARALLEL_WAL_WRITER);
+  }
+}
+
+static WriteThread::AdaptationContext fpww_ctx("WaitForParallelWalWriters");
+void WriteThread::WaitForParallelWalWriters(WriteGroup* write_group) {
+  // The leader encodes the records that no follower has claimed, so this
+  // only waits for the followers that are already copying theirs.
+  Writer* leader = write_group->leader;
+  if (write_group->running_wal_writers.fetch_sub(
+          1, std::memory_order_acq_rel) > 1) {
+    AwaitState(leader, STATE_PARALLEL_WAL_WRITER, &fpww_ctx);
+    // Woken by the last follower, which no longer accesses the leader
+    leader->state.store(STATE_GROUP_LEADER, std::memory_order_relaxed);
+  }
+}
+
+static WriteThread::AdaptationContext epww_ctx("ExitParallelWalWriter");
+void WriteThread::ExitParallelWalWriter(Writer* w) {
+  AwaitState(w,
+             STATE_PARALLEL_MEMTABLE_CALLER | STATE_PARALLEL_MEMTABLE_WRITER |
+                 STATE_COMPLETED,
+             &epww_ctx);
+}
+
 void WriteThread::ExitAsBatchGroupFollower(Writer* w) {
   auto* write_group = w->write_group;
 
@@ -29,6 +29,10 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+namespace log {
+class Writer;
+}  // namespace log
+
 class WriteThread {
  public:
   enum State : uint8_t {
@@ -79,6 +83,14 @@ class WriteThread {
     // by calling SetMemWritersEachStride. After doing
     // this, it will also write to memtable.
     STATE_PARALLEL_MEMTABLE_CALLER = 64,
+
+    // The state used to inform a waiting follower that the leader has
+    // reserved room for its batch in the WAL buffer, and that it should
+    // encode its record in parallel with the rest of the group (see
+    // DBOptions::parallel_wal_writes). The follower then waits for one of
+    // the parallel memtable writer states or STATE_COMPLETED. Also used to
+    // wake the leader once the last of these records has been encoded.
+    STATE_PARALLEL_WAL_WRITER = 128,
   };
 
   struct Writer;
@@ -91,6 +103,10 @@ class WriteThread {
     Status status;
     std::atomic<size_t> running;
     size_t size = 0;
+    // Parallel WAL write state, see LaunchParallelWalWriters(). The count
+    // includes the leader until it calls WaitForParallelWalWriters().
+    log::Writer* wal_writer = nullptr;
+    std::atomic<size_t> running_wal_writers{0};
 
     struct Iterator {
       Writer* writer;
@@ -136,6 +152,10 @@ class WriteThread {
     uint64_t log_ref;   // log number that memtable insert should reference
     WriteCallback* callback;
     UserWriteCallback* user_write_cb;
+    // Offset of the batch's record in the WAL buffer, and whether a thread
+    // has taken responsibility for encoding it, in a parallel WAL write group
+    uint64_t wal_reservation;
+    std::atomic<bool> wal_record_claimed;
     bool made_waitable;          // records lazy construction of mutex and cv
     std::atomic<uint8_t> state;  // write under StateMutex() or pre-link
     WriteGroup* write_group;
@@ -163,6 +183,8 @@ class WriteThread {
           log_ref(0),
           callback(nullptr),
           user_write_cb(nullptr),
+          wal_reservation(0),
+          wal_record_claimed(false),
           made_waitable(false),
           state(STATE_INIT),
           write_group(nullptr),
@@ -191,6 +213,8 @@ class WriteThread {
           log_ref(_log_ref),
           callback(_callback),
           user_write_cb(_user_write_cb),
+          wal_reservation(0),
+          wal_record_claimed(false),
           made_waitable(false),
           state(STATE_INIT),
           write_group(nullptr),
@@ -366,6 +390,34 @@ class WriteThread {
   // someone else has already taken responsibility for that.
   bool CompleteParallelMemTableWriter(Writer* w);
 
+  // Wakes the followers of write_group whose WAL record has been reserved in
+  // write_group->wal_writer (and not claimed yet) as
+  // STATE_PARALLEL_WAL_WRITER, so that they encode it in parallel. The leader
+  // should encode its own record and the records no follower has claimed yet,
+  // then call WaitForParallelWalWriters.
+  //
+  // WriteGroup* write_group: Extra state used to coordinate the parallel write
+  void LaunchParallelWalWriters(WriteGroup* write_group);
+
+  // Returns true if the calling thread should encode w's WAL record, false if
+  // another thread has already taken responsibility for that.
+  bool ClaimParallelWalRecord(Writer* w) {
+    return !w->wal_record_claimed.exchange(true, std::memory_order_acq_rel);
+  }
+
+  // Reports that a claimed WAL record has been encoded, and wakes the leader
+  // if it was the last one. write_group must not be accessed by a follower
+  // afterwards.
+  void CompleteParallelWalRecord(WriteGroup* write_group);
+
+  // Called by the leader once it has encoded the records it claimed. Waits
+  // until all the claimed WAL records of write_group are encoded.
+  void WaitForParallelWalWriters(WriteGroup* write_group);
+
+  // Waits for a follower woken as STATE_PARALLEL_WAL_WRITER to be moved to
+  // the next state by the leader.
+  void ExitParallelWalWriter(Writer* w);
+
   // Waits for all preceding writers (unlocking mu while waiting), then
   // registers w as the currently proceeding writer.
   //
@@ -96,6 +96,8 @@ DECLARE_int32(threads);
 DECLARE_int32(ttl);
 DECLARE_int32(value_size_mult);
 DECLARE_int32(compaction_readahead_size);
+DECLARE_uint64(compaction_async_write_buffers);
+DECLARE_uint64(compaction_pipelined_input_size);
 DECLARE_bool(enable_pipelined_write);
 DECLARE_bool(verify_before_write);
 DECLARE_bool(histogram);
@@ -125,6 +127,7 @@ DECLARE_int32(level0_stop_writes_trigger);
 DECLARE_int32(block_size);
 DECLARE_int32(format_version);
 DECLARE_int32(index_block_restart_interval);
+DECLARE_bool(adaptive_block_restart_interval);
 DECLARE_bool(disable_auto_compactions);
 DECLARE_int32(max_background_compactions);
 DECLARE_int32(num_bottom_pri_threads);
@@ -136,6 +139,7 @@ DECLARE_int32(universal_min_merge_width);
 DECLARE_int32(universal_max_merge_width);
 DECLARE_int32(universal_max_size_amplification_percent);
 DECLARE_int32(universal_max_read_amp);
+DECLARE_uint32(universal_max_runs_per_tier);
 DECLARE_int32(clear_column_family_one_in);
 DECLARE_int32(get_live_files_apis_one_in);
 DECLARE_int32(get_all_column_family_metadata_one_in);
@@ -156,12 +160,17 @@ DECLARE_int32(partition_pinning);
 DECLARE_int32(unpartitioned_pinning);
 DECLARE_string(cache_type);
 DECLARE_uint64(subcompactions);
+DECLARE_uint32(subcompaction_ranges_per_thread);
 DECLARE_uint64(periodic_compaction_seconds);
 DECLARE_string(daily_offpeak_time_utc);
 DECLARE_uint64(compaction_ttl);
 DECLARE_bool(fifo_allow_compaction);
 DECLARE_bool(allow_concurrent_memtable_write);
+DECLARE_bool(memtable_sorted_batch_insert);
+DECLARE_bool(parallel_wal_writes);
+DECLARE_bool(wal_per_write_queue);
 DECLARE_double(experimental_mempurge_threshold);
+DECLARE_bool(memtable_resident);
 DECLARE_bool(enable_write_thread_adaptive_yield);
 DECLARE_int32(reopen);
 DECLARE_double(bloom_bits);
@@ -174,6 +183,7 @@ DECLARE_uint32(sqfc_version);
 DECLARE_bool(use_sqfc_for_range_queries);
 DECLARE_int32(index_type);
 DECLARE_int32(data_block_index_type);
+DECLARE_bool(data_block_restart_key_prefix);
 DECLARE_string(db);
 DECLARE_string(secondaries_base);
 DECLARE_bool(test_secondary);
@@ -351,6 +361,12 @@ DECLARE_bool(enable_thread_tracking);
 
 DECLARE_uint32(memtable_max_range_deletions);
 
+DECLARE_uint32(memtable_value_separation_min_size);
+
+DECLARE_bool(memtable_numa_aware);
+
+DECLARE_uint32(max_flush_partitions);
+
 DECLARE_uint32(bottommost_file_compaction_delay);
 
 // Tiered storage
@@ -382,6 +398,7 @@ DECLARE_bool(strict_bytes_per_sync);
 DECLARE_bool(avoid_flush_during_shutdown);
 DECLARE_bool(fill_cache);
 DECLARE_bool(optimize_multiget_for_io);
+DECLARE_uint64(multiget_prefetch_distance);
 DECLARE_bool(memtable_insert_hint_per_batch);
 DECLARE_bool(dump_malloc_stats);
 DECLARE_uint64(stats_history_buffer_size);
@@ -435,7 +452,7 @@ extern enum ROCKSDB_NAMESPACE::CompressionType compression_type_e;
 extern enum ROCKSDB_NAMESPACE::CompressionType bottommost_compression_type_e;
 extern enum ROCKSDB_NAMESPACE::ChecksumType checksum_type_e;
 
-enum RepFactory { kSkipList, kHashSkipList, kVectorRep };
+enum RepFactory { kSkipList, kHashSkipList, kVectorRep, kBTree };
 
 inline enum RepFactory StringToRepFactory(const char* ctype) {
   assert(ctype);
@@ -446,6 +463,8 @@ inline enum RepFactory StringToRepFactory(const char* ctype) {
     return kHashSkipList;
   else if (!strcasecmp(ctype, "vector"))
     return kVectorRep;
+  else if (!strcasecmp(ctype, "btree"))
+    return kBTree;
 
   fprintf(stdout, "Cannot parse memreptable %s\n", ctype);
   return kSkipList;
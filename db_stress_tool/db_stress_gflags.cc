@@ -126,6 +126,14 @@ DEFINE_int32(value_size_mult, 8,
 
 DEFINE_int32(compaction_readahead_size, 0, "Compaction readahead size");
 
+DEFINE_uint64(compaction_async_write_buffers,
+              ROCKSDB_NAMESPACE::Options().compaction_async_write_buffers,
+              "Options.compaction_async_write_buffers");
+
+DEFINE_uint64(compaction_pipelined_input_size,
+              ROCKSDB_NAMESPACE::Options().compaction_pipelined_input_size,
+              "Options.compaction_pipelined_input_size");
+
 DEFINE_bool(enable_pipelined_write, false, "Pipeline WAL/memtable writes");
 
 DEFINE_bool(verify_before_write, false, "Verify before write");
@@ -265,6 +273,11 @@ DEFINE_int32(
     "Number of keys between restart points "
     "for delta encoding of keys in index block.");
 
+DEFINE_bool(adaptive_block_restart_interval,
+            ROCKSDB_NAMESPACE::BlockBasedTableOptions()
+                .adaptive_block_restart_interval,
+            "BlockBasedTableOptions.adaptive_block_restart_interval");
+
 DEFINE_bool(disable_auto_compactions,
             ROCKSDB_NAMESPACE::Options().disable_auto_compactions,
             "If true, RocksDB internally will not trigger compactions.");
@@ -309,6 +322,11 @@ DEFINE_int32(universal_max_size_amplification_percent, 0,
 DEFINE_int32(universal_max_read_amp, -1,
              "The limit on the number of sorted runs");
 
+DEFINE_uint32(universal_max_runs_per_tier,
+              ROCKSDB_NAMESPACE::CompactionOptionsUniversal().max_runs_per_tier,
+              "If at least 2, universal compaction does lazy leveling with "
+              "this many sorted runs per tier.");
+
 DEFINE_int32(clear_column_family_one_in, 1000000,
              "With a chance of 1/N, delete a column family and then recreate "
              "it again. If N == 0, never drop/create column families. "
@@ -404,6 +422,10 @@ DEFINE_uint64(subcompactions, 1,
               "Maximum number of subcompactions to divide L0-L1 compactions "
               "into.");
 
+DEFINE_uint32(subcompaction_ranges_per_thread,
+              ROCKSDB_NAMESPACE::Options().subcompaction_ranges_per_thread,
+              "Options.subcompaction_ranges_per_thread");
+
 DEFINE_uint64(periodic_compaction_seconds, 1000,
               "Files older than this value will be picked up for compaction.");
 DEFINE_string(daily_offpeak_time_utc, "",
@@ -419,10 +441,30 @@ DEFINE_bool(fifo_allow_compaction, false,
 DEFINE_bool(allow_concurrent_memtable_write, false,
             "Allow multi-writers to update mem tables in parallel.");
 
+DEFINE_bool(memtable_sorted_batch_insert,
+            ROCKSDB_NAMESPACE::Options().memtable_sorted_batch_insert,
+            "Insert the entries of a write group into the memtable in sorted "
+            "order.");
+
+DEFINE_bool(parallel_wal_writes,
+            ROCKSDB_NAMESPACE::Options().parallel_wal_writes,
+            "Let the writers of a write group encode their own WAL records "
+            "in parallel.");
+
+DEFINE_bool(wal_per_write_queue,
+            ROCKSDB_NAMESPACE::Options().wal_per_write_queue,
+            "Give each write queue its own WAL stream (requires "
+            "two_write_queues).");
+
 DEFINE_double(experimental_mempurge_threshold, 0.0,
               "Maximum estimated useful payload that triggers a "
               "mempurge process to collect memtable garbage bytes.");
 
+DEFINE_bool(memtable_resident, ROCKSDB_NAMESPACE::Options().memtable_resident,
+            "Keep the data of column families in memory (mempurge instead of "
+            "flush on full write buffers, serve lookups from flushed "
+            "memtables).");
+
 DEFINE_bool(enable_write_thread_adaptive_yield,
             ROCKSDB_NAMESPACE::Options().enable_write_thread_adaptive_yield,
             "Use a yielding spin loop for brief writer thread waits.");
@@ -604,6 +646,11 @@ DEFINE_int32(
         ROCKSDB_NAMESPACE::BlockBasedTableOptions().data_block_index_type),
     "Index type for data blocks (see `enum DataBlockIndexType` in table.h)");
 
+DEFINE_bool(data_block_restart_key_prefix,
+            ROCKSDB_NAMESPACE::BlockBasedTableOptions()
+                .data_block_restart_key_prefix,
+            "BlockBasedTableOptions.data_block_restart_key_prefix");
+
 DEFINE_string(db, "", "Use the db with the following name.");
 
 DEFINE_string(secondaries_base, "",
@@ -1223,6 +1270,22 @@ DEFINE_uint32(memtable_max_range_deletions, 0,
               "If nonzero, RocksDB will try to flush the current memtable"
               "after the number of range deletions is >= this limit");
 
+DEFINE_uint32(memtable_value_separation_min_size,
+              ROCKSDB_NAMESPACE::Options().memtable_value_separation_min_size,
+              "If non-zero, memtables store values of at least this many "
+              "bytes out of line, in a separate arena.");
+
+DEFINE_bool(memtable_numa_aware,
+            ROCKSDB_NAMESPACE::Options().memtable_numa_aware,
+            "If true, memtable arenas allocate per-core blocks from memory "
+            "local to the NUMA node of each core.");
+
+DEFINE_uint32(max_flush_partitions,
+              ROCKSDB_NAMESPACE::Options().max_flush_partitions,
+              "If greater than 1, a flush splits the memtables into up to "
+              "this many key ranges and writes one L0 file per range in "
+              "parallel.");
+
 DEFINE_uint32(bottommost_file_compaction_delay, 0,
               "Delay kBottommostFiles compaction by this amount of seconds."
               "See more in option comment.");
@@ -1284,6 +1347,10 @@ DEFINE_bool(optimize_multiget_for_io,
             ROCKSDB_NAMESPACE::ReadOptions().optimize_multiget_for_io,
             "ReadOptions.optimize_multiget_for_io");
 
+DEFINE_uint64(multiget_prefetch_distance,
+              ROCKSDB_NAMESPACE::ReadOptions().multiget_prefetch_distance,
+              "ReadOptions.multiget_prefetch_distance");
+
 DEFINE_bool(memtable_insert_hint_per_batch,
             ROCKSDB_NAMESPACE::WriteOptions().memtable_insert_hint_per_batch,
             "WriteOptions.memtable_insert_hint_per_batch");
@@ -286,6 +286,7 @@ bool StressTest::BuildOptionsTable() {
            std::to_string(options_.write_buffer_size / 8),
        }},
       {"memtable_huge_page_size", {"0", std::to_string(2 * 1024 * 1024)}},
+      {"memtable_numa_aware", {"false", "true"}},
       {"strict_max_successive_merges", {"false", "true"}},
       {"inplace_update_num_locks", {"100", "200", "300"}},
       // TODO: re-enable once internal task T124324915 is fixed.
@@ -341,6 +342,7 @@ bool StressTest::BuildOptionsTable() {
            "2",
        }},
       {"max_sequential_skip_in_iterations", {"4", "8", "12"}},
+      {"max_flush_partitions", {"1", "2", "4"}},
   };
   if (FLAGS_unordered_write) {
     options_tbl.emplace("max_successive_merges", std::vector<std::string>{"0"});
@@ -885,6 +887,8 @@ void StressTest::OperateDb(ThreadState* thread) {
   read_opts.auto_readahead_size = FLAGS_auto_readahead_size;
   read_opts.fill_cache = FLAGS_fill_cache;
   read_opts.optimize_multiget_for_io = FLAGS_optimize_multiget_for_io;
+  read_opts.multiget_prefetch_distance =
+      static_cast<size_t>(FLAGS_multiget_prefetch_distance);
   WriteOptions write_opts;
   if (FLAGS_rate_limit_auto_wal_flush) {
     write_opts.rate_limiter_priority = Env::IO_USER;
@@ -3294,6 +3298,9 @@ void StressTest::PrintEnv() const {
     case kVectorRep:
       memtablerep = "vector";
       break;
+    case kBTree:
+      memtablerep = "btree";
+      break;
   }
 
   fprintf(stdout, "Memtablerep               : %s\n", memtablerep);
@@ -3331,6 +3338,9 @@ void StressTest::PrintEnv() const {
     case kRoundRobin:
       compaction_pri = "kRoundRobin";
       break;
+    case kReadWeightedOverlappingRatio:
+      compaction_pri = "kReadWeightedOverlappingRatio";
+      break;
   }
   fprintf(stdout, "Compaction Pri            : %s\n", compaction_pri);
   fprintf(stdout, "Background Purge          : %d\n",
@@ -3999,6 +4009,8 @@ void InitializeOptionsFromFlags(
       static_cast<uint32_t>(FLAGS_format_version);
   block_based_options.index_block_restart_interval =
       static_cast<int32_t>(FLAGS_index_block_restart_interval);
+  block_based_options.adaptive_block_restart_interval =
+      FLAGS_adaptive_block_restart_interval;
   block_based_options.filter_policy = filter_policy;
   block_based_options.partition_filters = FLAGS_partition_filters;
   block_based_options.optimize_filters_for_memory =
@@ -4010,6 +4022,8 @@ void InitializeOptionsFromFlags(
   block_based_options.data_block_index_type =
       static_cast<BlockBasedTableOptions::DataBlockIndexType>(
           FLAGS_data_block_index_type);
+  block_based_options.data_block_restart_key_prefix =
+      FLAGS_data_block_restart_key_prefix;
   block_based_options.prepopulate_block_cache =
       static_cast<BlockBasedTableOptions::PrepopulateBlockCache>(
           FLAGS_prepopulate_block_cache);
@@ -4070,6 +4084,10 @@ void InitializeOptionsFromFlags(
   options.env = db_stress_env;
   options.use_fsync = FLAGS_use_fsync;
   options.compaction_readahead_size = FLAGS_compaction_readahead_size;
+  options.compaction_async_write_buffers =
+      static_cast<size_t>(FLAGS_compaction_async_write_buffers);
+  options.compaction_pipelined_input_size =
+      static_cast<size_t>(FLAGS_compaction_pipelined_input_size);
   options.allow_mmap_reads = FLAGS_mmap_read;
   options.allow_mmap_writes = FLAGS_mmap_write;
   options.use_direct_reads = FLAGS_use_direct_reads;
@@ -4109,10 +4127,16 @@ void InitializeOptionsFromFlags(
   }
   options.max_manifest_file_size = FLAGS_max_manifest_file_size;
   options.max_subcompactions = static_cast<uint32_t>(FLAGS_subcompactions);
+  options.subcompaction_ranges_per_thread =
+      FLAGS_subcompaction_ranges_per_thread;
   options.allow_concurrent_memtable_write =
       FLAGS_allow_concurrent_memtable_write;
+  options.memtable_sorted_batch_insert = FLAGS_memtable_sorted_batch_insert;
+  options.parallel_wal_writes = FLAGS_parallel_wal_writes;
+  options.wal_per_write_queue = FLAGS_wal_per_write_queue;
   options.experimental_mempurge_threshold =
       FLAGS_experimental_mempurge_threshold;
+  options.memtable_resident = FLAGS_memtable_resident;
   options.periodic_compaction_seconds = FLAGS_periodic_compaction_seconds;
   options.daily_offpeak_time_utc = FLAGS_daily_offpeak_time_utc;
   options.stats_dump_period_sec =
@@ -4130,6 +4154,8 @@ void InitializeOptionsFromFlags(
       FLAGS_universal_max_size_amplification_percent;
   options.compaction_options_universal.max_read_amp =
       FLAGS_universal_max_read_amp;
+  options.compaction_options_universal.max_runs_per_tier =
+      FLAGS_universal_max_runs_per_tier;
   options.atomic_flush = FLAGS_atomic_flush;
   options.manual_wal_flush = FLAGS_manual_wal_flush_one_in > 0 ? true : false;
   options.avoid_unnecessary_blocking_io = FLAGS_avoid_unnecessary_blocking_io;
@@ -4213,6 +4239,9 @@ void InitializeOptionsFromFlags(
     case kVectorRep:
       options.memtable_factory.reset(new VectorRepFactory());
       break;
+    case kBTree:
+      options.memtable_factory.reset(new BTreeRepFactory());
+      break;
   }
 
   InitializeMergeOperator(options);
@@ -4235,6 +4264,10 @@ void InitializeOptionsFromFlags(
   options.enable_thread_tracking = FLAGS_enable_thread_tracking;
 
   options.memtable_max_range_deletions = FLAGS_memtable_max_range_deletions;
+  options.memtable_value_separation_min_size =
+      FLAGS_memtable_value_separation_min_size;
+  options.memtable_numa_aware = FLAGS_memtable_numa_aware;
+  options.max_flush_partitions = FLAGS_max_flush_partitions;
 
   options.bottommost_file_compaction_delay =
       FLAGS_bottommost_file_compaction_delay;
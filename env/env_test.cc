@@ -88,6 +88,7 @@ struct Deleter {
 };
 
 extern "C" bool RocksDbIOUringEnable() { return true; }
+extern "C" bool RocksDbIOUringWritesEnable() { return true; }
 
 std::unique_ptr<char, Deleter> NewAligned(const size_t size, const char ch) {
   char* ptr = nullptr;
@@ -1140,6 +1141,86 @@ TEST_F(EnvPosixTest, PositionedAppend) {
   ASSERT_EQ('b', result[kBlockSize]);
 }
 
+TEST_F(EnvPosixTest, AppendFlushAndSync) {
+  // Exercises the io_uring write path where available, which only table and
+  // blob files take
+  bool io_uring_writes = false;
+  uint64_t num_io_uring_requests = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "IOUringWriteQueue::Create",
+      [&](void* /*arg*/) { io_uring_writes = true; });
+  SyncPoint::GetInstance()->SetCallBack(
+      "IOUringWriteQueue::Submit", [&](void* arg) {
+        num_io_uring_requests += *static_cast<unsigned int*>(arg);
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::unique_ptr<WritableFile> writable_file;
+  EnvOptions options;
+  options.use_direct_writes = false;
+  options.use_mmap_writes = false;
+  ASSERT_OK(env_->NewWritableFile(
+      test::PerThreadDBPath(env_, "append_flush_and_sync.log"), &writable_file,
+      options));
+  ASSERT_FALSE(io_uring_writes);
+  ASSERT_OK(writable_file->Close());
+
+  std::string fname = test::PerThreadDBPath(env_, "append_flush_and_sync.sst");
+  ASSERT_OK(env_->NewWritableFile(fname, &writable_file, options));
+
+  // Spans several io_uring write buffers, with appends crossing buffer
+  // boundaries
+  Random rnd(301);
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    std::string chunk = rnd.RandomString(rnd.Uniform(40 << 10));
+    ASSERT_OK(writable_file->Append(chunk));
+    expected += chunk;
+    ASSERT_EQ(expected.size(), writable_file->GetFileSize());
+    switch (rnd.Uniform(8)) {
+      case 0:
+        ASSERT_OK(writable_file->Flush());
+        break;
+      case 1:
+        ASSERT_OK(writable_file->Sync());
+        break;
+      case 2:
+        ASSERT_OK(writable_file->Fsync());
+        break;
+      case 3:
+        ASSERT_OK(writable_file->RangeSync(0, expected.size()));
+        break;
+      default:
+        break;
+    }
+  }
+  ASSERT_OK(writable_file->Flush());
+  std::string contents;
+  ASSERT_OK(ReadFileToString(env_, fname, &contents));
+  ASSERT_EQ(expected, contents);
+
+  // Overwrite and truncate with data still queued
+  ASSERT_OK(writable_file->Append("tail"));
+  ASSERT_OK(writable_file->PositionedAppend("head", 0));
+  expected.replace(0, 4, "head");
+  ASSERT_OK(writable_file->Truncate(expected.size()));
+  ASSERT_OK(writable_file->Sync());
+  ASSERT_OK(writable_file->Close());
+  ASSERT_OK(ReadFileToString(env_, fname, &contents));
+  ASSERT_EQ(expected, contents);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // Without io_uring support in the kernel, plain writes are used
+  if (io_uring_writes) {
+    ASSERT_GT(num_io_uring_requests, 0);
+  }
+#else
+  ASSERT_FALSE(io_uring_writes);
+#endif
+}
+
 // `GetUniqueId()` temporarily returns zero on Windows. `BlockBasedTable` can
 // handle a return value of zero but this test case cannot.
 #ifndef OS_WIN
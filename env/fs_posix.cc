@@ -75,6 +75,9 @@
 #endif
 
 extern "C" bool RocksDbIOUringEnable() __attribute__((__weak__));
+// Writes to table and blob files opened without direct I/O are issued through
+// io_uring only if this function is defined and returns true.
+extern "C" bool RocksDbIOUringWritesEnable() __attribute__((__weak__));
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -347,11 +350,13 @@ class PosixFileSystem : public FileSystem {
       // disable mmap writes
       EnvOptions no_mmap_writes_options = options;
       no_mmap_writes_options.use_mmap_writes = false;
-      result->reset(
-          new PosixWritableFile(fname, fd,
-                                GetLogicalBlockSizeForWriteIfNeeded(
-                                    no_mmap_writes_options, fname, fd),
-                                no_mmap_writes_options));
+      result->reset(new PosixWritableFile(
+          fname, fd,
+          GetLogicalBlockSizeForWriteIfNeeded(no_mmap_writes_options, fname,
+                                              fd),
+          no_mmap_writes_options,
+          !no_mmap_writes_options.use_direct_writes &&
+              IsIOUringWritesEnabled(fname)));
     }
     return s;
   }
@@ -442,11 +447,13 @@ class PosixFileSystem : public FileSystem {
       // disable mmap writes
       FileOptions no_mmap_writes_options = options;
       no_mmap_writes_options.use_mmap_writes = false;
-      result->reset(
-          new PosixWritableFile(fname, fd,
-                                GetLogicalBlockSizeForWriteIfNeeded(
-                                    no_mmap_writes_options, fname, fd),
-                                no_mmap_writes_options));
+      result->reset(new PosixWritableFile(
+          fname, fd,
+          GetLogicalBlockSizeForWriteIfNeeded(no_mmap_writes_options, fname,
+                                              fd),
+          no_mmap_writes_options,
+          !no_mmap_writes_options.use_direct_writes &&
+              IsIOUringWritesEnabled(fname)));
     }
     return s;
   }
@@ -998,6 +1005,20 @@ class PosixFileSystem : public FileSystem {
   }
 #endif  // ROCKSDB_IOURING_PRESENT
 
+  // Every file written through io_uring has a ring and pinned buffers of its
+  // own, which only pay off for the large sequential writes of table and blob
+  // files. WALs, MANIFEST, info LOG, OPTIONS and temporary files are written
+  // in small pieces that are flushed right away.
+  bool IsIOUringWritesEnabled(const std::string& fname) {
+#ifdef ROCKSDB_IOURING_PRESENT
+    return RocksDbIOUringWritesEnable && RocksDbIOUringWritesEnable() &&
+           (EndsWith(fname, ".sst") || EndsWith(fname, ".blob"));
+#else
+    (void)fname;
+    return false;
+#endif  // ROCKSDB_IOURING_PRESENT
+  }
+
   // TODO:
   // 1. Update Poll API to take into account min_completions
   // and returns if number of handles in io_handles (any order) completed is
@@ -1270,9 +1270,221 @@ IOStatus PosixMmapFile::Allocate(uint64_t offset, uint64_t len,
  *
  * Use posix write to write data to a file.
  */
+#if defined(ROCKSDB_IOURING_PRESENT)
+std::unique_ptr<IOUringWriteQueue> IOUringWriteQueue::Create(
+    int fd, const std::string& fname) {
+  std::unique_ptr<IOUringWriteQueue> queue(new IOUringWriteQueue(fd, fname));
+  // A write request per buffer, plus a linked sync request
+  if (io_uring_queue_init(kNumBuffers + 1, &queue->ring_, 0) != 0) {
+    return nullptr;
+  }
+  queue->ring_initialized_ = true;
+
+  struct iovec iovecs[kNumBuffers];
+  for (size_t i = 0; i < kNumBuffers; ++i) {
+    queue->buffers_[i].data = new char[kBufferSize];
+    iovecs[i].iov_base = queue->buffers_[i].data;
+    iovecs[i].iov_len = kBufferSize;
+  }
+  // Registering the buffers saves mapping them for every request, but pins
+  // them in memory and can fail with a low RLIMIT_MEMLOCK. Fall back to
+  // regular write requests in that case.
+  queue->fixed_buffers_ =
+      io_uring_register_buffers(&queue->ring_, iovecs, kNumBuffers) == 0;
+  TEST_SYNC_POINT_CALLBACK("IOUringWriteQueue::Create", queue.get());
+  return queue;
+}
+
+IOUringWriteQueue::~IOUringWriteQueue() {
+  if (ring_initialized_) {
+    {
+      MutexLock lock(&mutex_);
+      ReapAll();
+    }
+    if (fixed_buffers_) {
+      io_uring_unregister_buffers(&ring_);
+    }
+    io_uring_queue_exit(&ring_);
+  }
+  if (!abandoned_) {
+    for (Buffer& buffer : buffers_) {
+      delete[] buffer.data;
+    }
+  }
+}
+
+IOStatus IOUringWriteQueue::Append(const Slice& data, uint64_t offset) {
+  MutexLock lock(&mutex_);
+  const char* src = data.data();
+  size_t left = data.size();
+  while (left > 0 && error_.ok()) {
+    Buffer* buffer = &buffers_[current_];
+    while (buffer->in_flight && !abandoned_) {
+      ReapOne();
+    }
+    if (abandoned_) {
+      break;
+    }
+    if (buffer->len == 0) {
+      buffer->offset = offset;
+    }
+    assert(buffer->offset + buffer->len == offset);
+    size_t n = std::min(left, kBufferSize - buffer->len);
+    memcpy(buffer->data + buffer->len, src, n);
+    buffer->len += n;
+    src += n;
+    left -= n;
+    offset += n;
+    if (buffer->len == kBufferSize) {
+      SetError(Submit(buffer, SyncMode::kNone));
+      current_ = (current_ + 1) % kNumBuffers;
+    }
+  }
+  return error_;
+}
+
+IOStatus IOUringWriteQueue::Drain(SyncMode sync_mode) {
+  MutexLock lock(&mutex_);
+  // Requests are only ordered when linked, so the writes submitted before
+  // need to complete before the sync request is submitted.
+  ReapAll();
+  Buffer* buffer = &buffers_[current_];
+  if (buffer->len == 0) {
+    buffer = nullptr;
+  }
+  if (error_.ok() && (buffer != nullptr || sync_mode != SyncMode::kNone)) {
+    sync_cancelled_ = false;
+    SetError(Submit(buffer, sync_mode));
+    ReapAll();
+    if (sync_cancelled_ && error_.ok()) {
+      // The linked write was completed synchronously, see ReapOne(), or the
+      // kernel does not support the sync request.
+      if (sync_mode == SyncMode::kFdatasync) {
+        if (fdatasync(fd_) < 0) {
+          SetError(IOError("While fdatasync", filename_, errno));
+        }
+      } else if (fsync(fd_) < 0) {
+        SetError(IOError("While fsync", filename_, errno));
+      }
+    }
+  }
+  return error_;
+}
+
+IOStatus IOUringWriteQueue::Submit(Buffer* buffer, SyncMode sync_mode) {
+  unsigned int num_requests = 0;
+  if (buffer != nullptr) {
+    assert(!buffer->in_flight);
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    assert(sqe != nullptr);
+    if (fixed_buffers_) {
+      io_uring_prep_write_fixed(sqe, fd_, buffer->data,
+                                static_cast<unsigned int>(buffer->len),
+                                buffer->offset,
+                                static_cast<int>(buffer - buffers_));
+    } else {
+      io_uring_prep_write(sqe, fd_, buffer->data,
+                          static_cast<unsigned int>(buffer->len),
+                          buffer->offset);
+    }
+    if (sync_mode != SyncMode::kNone) {
+      sqe->flags |= IOSQE_IO_LINK;
+    }
+    io_uring_sqe_set_data(sqe, buffer);
+    buffer->in_flight = true;
+    ++num_requests;
+  }
+  if (sync_mode != SyncMode::kNone) {
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    assert(sqe != nullptr);
+    io_uring_prep_fsync(
+        sqe, fd_,
+        sync_mode == SyncMode::kFdatasync ? IORING_FSYNC_DATASYNC : 0);
+    io_uring_sqe_set_data(sqe, nullptr);
+    ++num_requests;
+  }
+
+  TEST_SYNC_POINT_CALLBACK("IOUringWriteQueue::Submit", &num_requests);
+  // The kernel may consume fewer requests than queued, e.g. if allocating
+  // one fails. Submit the rest again, until it makes no progress anymore.
+  IOStatus s;
+  unsigned int num_submitted = 0;
+  while (num_submitted < num_requests) {
+    int ret = io_uring_submit(&ring_);
+    if (ret == -EINTR || ret == -EAGAIN) {
+      continue;
+    }
+    if (ret < 0) {
+      s = IOError("While submitting requests via io_uring", filename_, -ret);
+      break;
+    }
+    if (ret == 0) {
+      s = IOStatus::IOError("io_uring_submit submitted " +
+                                std::to_string(num_submitted) + " of " +
+                                std::to_string(num_requests) + " requests",
+                            filename_);
+      break;
+    }
+    num_submitted += static_cast<unsigned int>(ret);
+  }
+  // Requests are submitted in order, so the ones not submitted are the last
+  // ones. They are left in the submission queue, and nothing is submitted
+  // once error_ is set. The ones submitted are reaped as usual.
+  num_in_flight_ += num_submitted;
+  if (buffer != nullptr && num_submitted == 0) {
+    buffer->in_flight = false;
+  }
+  return s;
+}
+
+void IOUringWriteQueue::ReapOne() {
+  assert(num_in_flight_ > 0);
+  struct io_uring_cqe* cqe = nullptr;
+  int ret;
+  do {
+    ret = io_uring_wait_cqe(&ring_, &cqe);
+  } while (ret == -EINTR);
+  if (ret) {
+    // The state of the requests in flight is unknown, so fail the file.
+    SetError(IOError("While waiting for io_uring completion", filename_, -ret));
+    abandoned_ = true;
+    return;
+  }
+  Buffer* buffer = static_cast<Buffer*>(io_uring_cqe_get_data(cqe));
+  const int res = cqe->res;
+  io_uring_cqe_seen(&ring_, cqe);
+  --num_in_flight_;
+
+  if (buffer == nullptr) {
+    // Sync request. Cancelled if the linked write failed or was short. Don't
+    // retry on other errors, as a failed fsync may have cleared the error
+    // state of the dirty pages.
+    if (res == -ECANCELED || res == -EINVAL || res == -EOPNOTSUPP) {
+      sync_cancelled_ = true;
+    } else if (res < 0) {
+      SetError(IOError("While syncing file via io_uring", filename_, -res));
+    }
+    return;
+  }
+
+  // Finish short or failed writes synchronously, which also reports the
+  // error, if any, with the errno of pwrite().
+  const size_t written = res > 0 ? static_cast<size_t>(res) : 0;
+  if (written < buffer->len &&
+      !PosixPositionedWrite(fd_, buffer->data + written,
+                            buffer->len - written,
+                            static_cast<off_t>(buffer->offset + written))) {
+    SetError(IOError("While appending to file", filename_, errno));
+  }
+  buffer->len = 0;
+  buffer->in_flight = false;
+}
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
+
 PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
                                      size_t logical_block_size,
-                                     const EnvOptions& options)
+                                     const EnvOptions& options,
+                                     bool use_io_uring)
     : FSWritableFile(options),
       filename_(fname),
       use_direct_io_(options.use_direct_writes),
@@ -1286,9 +1498,25 @@ PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
 #ifdef ROCKSDB_RANGESYNC_PRESENT
   sync_file_range_supported_ = IsSyncFileRangeSupported(fd_);
 #endif  // ROCKSDB_RANGESYNC_PRESENT
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (use_io_uring && !use_direct_io_) {
+    io_uring_writes_ = IOUringWriteQueue::Create(fd_, filename_);
+  }
+#else
+  (void)use_io_uring;
+#endif
   assert(!options.use_mmap_writes);
 }
 
+IOStatus PosixWritableFile::DrainIOUringWrites() {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (io_uring_writes_) {
+    return io_uring_writes_->Drain(IOUringWriteQueue::SyncMode::kNone);
+  }
+#endif
+  return IOStatus::OK();
+}
+
 PosixWritableFile::~PosixWritableFile() {
   if (fd_ >= 0) {
     IOStatus s = PosixWritableFile::Close(IOOptions(), nullptr);
@@ -1305,6 +1533,16 @@ IOStatus PosixWritableFile::Append(const Slice& data, const IOOptions& /*opts*/,
   const char* src = data.data();
   size_t nbytes = data.size();
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (io_uring_writes_) {
+    IOStatus s = io_uring_writes_->Append(data, filesize_);
+    if (s.ok()) {
+      filesize_ += nbytes;
+    }
+    return s;
+  }
+#endif
+
   if (!PosixWrite(fd_, src, nbytes)) {
     return IOError("While appending to file", filename_, errno);
   }
@@ -1322,6 +1560,10 @@ IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
     assert(IsSectorAligned(data.data(), GetRequiredBufferAlignment()));
   }
   assert(offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
+  IOStatus s = DrainIOUringWrites();
+  if (!s.ok()) {
+    return s;
+  }
   const char* src = data.data();
   size_t nbytes = data.size();
   if (!PosixPositionedWrite(fd_, src, nbytes, static_cast<off_t>(offset))) {
@@ -1334,7 +1576,10 @@ IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
 
 IOStatus PosixWritableFile::Truncate(uint64_t size, const IOOptions& /*opts*/,
                                      IODebugContext* /*dbg*/) {
-  IOStatus s;
+  IOStatus s = DrainIOUringWrites();
+  if (!s.ok()) {
+    return s;
+  }
   int r = ftruncate(fd_, size);
   if (r < 0) {
     s = IOError("While ftruncate file to size " + std::to_string(size),
@@ -1347,7 +1592,10 @@ IOStatus PosixWritableFile::Truncate(uint64_t size, const IOOptions& /*opts*/,
 
 IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
-  IOStatus s;
+  IOStatus s = DrainIOUringWrites();
+#if defined(ROCKSDB_IOURING_PRESENT)
+  io_uring_writes_.reset();
+#endif
 
   size_t block_size;
   size_t last_allocated_block;
@@ -1388,7 +1636,7 @@ IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
 #endif
   }
 
-  if (close(fd_) < 0) {
+  if (close(fd_) < 0 && s.ok()) {
     s = IOError("While closing file after writing", filename_, errno);
   }
   fd_ = -1;
@@ -1398,11 +1646,16 @@ IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
 // write out the cached data to the OS cache
 IOStatus PosixWritableFile::Flush(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
-  return IOStatus::OK();
+  return DrainIOUringWrites();
 }
 
 IOStatus PosixWritableFile::Sync(const IOOptions& /*opts*/,
                                  IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (io_uring_writes_) {
+    return io_uring_writes_->Drain(IOUringWriteQueue::SyncMode::kFdatasync);
+  }
+#endif
 #ifdef HAVE_FULLFSYNC
   if (::fcntl(fd_, F_FULLFSYNC) < 0) {
     return IOError("while fcntl(F_FULLFSYNC)", filename_, errno);
@@ -1417,6 +1670,11 @@ IOStatus PosixWritableFile::Sync(const IOOptions& /*opts*/,
 
 IOStatus PosixWritableFile::Fsync(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (io_uring_writes_) {
+    return io_uring_writes_->Drain(IOUringWriteQueue::SyncMode::kFsync);
+  }
+#endif
 #ifdef HAVE_FULLFSYNC
   if (::fcntl(fd_, F_FULLFSYNC) < 0) {
     return IOError("while fcntl(F_FULLFSYNC)", filename_, errno);
@@ -1501,6 +1759,11 @@ IOStatus PosixWritableFile::Allocate(uint64_t offset, uint64_t len,
 IOStatus PosixWritableFile::RangeSync(uint64_t offset, uint64_t nbytes,
                                       const IOOptions& opts,
                                       IODebugContext* dbg) {
+  // The range may still be queued for writing through io_uring
+  IOStatus s = DrainIOUringWrites();
+  if (!s.ok()) {
+    return s;
+  }
 #ifdef ROCKSDB_RANGESYNC_PRESENT
   assert(offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
   assert(nbytes <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
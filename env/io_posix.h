@@ -17,6 +17,7 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "port/port.h"
@@ -325,6 +326,82 @@ class PosixRandomAccessFile : public FSRandomAccessFile {
                              IODebugContext* dbg) override;
 };
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+// Writes the data appended to a file through an io_uring instance owned by
+// the file. Appended data is copied to a ring of buffers registered with the
+// io_uring, and each buffer is submitted as soon as it is full, so the caller
+// does not block on the write unless all the buffers are in flight.
+// Drain() submits the partially filled buffer, linked to an fsync or
+// fdatasync request if asked for, so that they are issued with a single
+// io_uring_enter() call, and waits for all the requests to complete.
+//
+// Thread-safe. Requests are reaped by the thread issuing them.
+class IOUringWriteQueue {
+ public:
+  // Returns nullptr if io_uring cannot be set up for the file.
+  static std::unique_ptr<IOUringWriteQueue> Create(int fd,
+                                                   const std::string& fname);
+  ~IOUringWriteQueue();
+
+  // Queues `data` to be written at `offset`.
+  IOStatus Append(const Slice& data, uint64_t offset);
+
+  enum class SyncMode { kNone, kFdatasync, kFsync };
+  // Submits the queued data and waits until it and everything submitted
+  // before has been written, then synced according to `sync_mode`.
+  IOStatus Drain(SyncMode sync_mode);
+
+ private:
+  static constexpr size_t kNumBuffers = 4;
+  static constexpr size_t kBufferSize = 256 << 10;
+
+  struct Buffer {
+    char* data = nullptr;
+    size_t len = 0;
+    uint64_t offset = 0;
+    bool in_flight = false;
+  };
+
+  IOUringWriteQueue(int fd, const std::string& fname)
+      : fd_(fd), filename_(fname) {}
+
+  // REQUIRES: mutex_ held
+  IOStatus Submit(Buffer* buffer, SyncMode sync_mode);
+  // Waits for one request to complete. If waiting fails, sets error_ and
+  // abandoned_, and the requests in flight are not waited for anymore.
+  // REQUIRES: mutex_ held, num_in_flight_ > 0
+  void ReapOne();
+  // REQUIRES: mutex_ held
+  void ReapAll() {
+    while (num_in_flight_ > 0 && !abandoned_) {
+      ReapOne();
+    }
+  }
+  void SetError(const IOStatus& s) {
+    if (error_.ok()) {
+      error_ = s;
+    }
+  }
+
+  port::Mutex mutex_;
+  struct io_uring ring_;
+  const int fd_;
+  const std::string filename_;
+  Buffer buffers_[kNumBuffers];
+  bool ring_initialized_ = false;
+  bool fixed_buffers_ = false;
+  size_t current_ = 0;
+  size_t num_in_flight_ = 0;
+  // Set if a linked sync request was cancelled because the preceding write
+  // was short or failed, to sync again after the write is completed.
+  bool sync_cancelled_ = false;
+  // Set if the completions of the requests in flight cannot be reaped. The
+  // kernel may still access the buffers then, so they are not freed.
+  bool abandoned_ = false;
+  IOStatus error_;
+};
+#endif  // defined(ROCKSDB_IOURING_PRESENT)
+
 class PosixWritableFile : public FSWritableFile {
  protected:
   const std::string filename_;
@@ -341,11 +418,21 @@ class PosixWritableFile : public FSWritableFile {
   // support it, so we need to do a dynamic check too.
   bool sync_file_range_supported_;
 #endif  // ROCKSDB_RANGESYNC_PRESENT
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // Set if writes are issued through io_uring
+  std::unique_ptr<IOUringWriteQueue> io_uring_writes_;
+#endif
+
+  // Waits for the writes queued through io_uring, if any, to complete.
+  IOStatus DrainIOUringWrites();
 
  public:
+  // If `use_io_uring` is true and io_uring is available, buffered (non
+  // direct I/O) writes are issued through io_uring, see IOUringWriteQueue.
   explicit PosixWritableFile(const std::string& fname, int fd,
                              size_t logical_block_size,
-                             const EnvOptions& options);
+                             const EnvOptions& options,
+                             bool use_io_uring = false);
   virtual ~PosixWritableFile();
 
   // Need to implement this so the file is truncated correctly
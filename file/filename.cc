@@ -11,6 +11,7 @@
 #include <cctype>
 #include <cinttypes>
 #include <cstdio>
+#include <limits>
 #include <vector>
 
 #include "file/file_util.h"
@@ -84,6 +85,30 @@ std::string LogFileName(uint64_t number) {
   return MakeFileName(number, "log");
 }
 
+std::string LogStreamFileName(const std::string& name, uint64_t number,
+                              uint32_t stream) {
+  assert(stream > 0);
+  return LogFileName(name, number) + "." + std::to_string(stream);
+}
+
+bool ParseLogStreamFileName(const std::string& filename, uint64_t* number,
+                            uint32_t* stream) {
+  Slice rest(filename);
+  uint64_t num;
+  if (!ConsumeDecimalNumber(&rest, &num) || !rest.starts_with(".log.")) {
+    return false;
+  }
+  rest.remove_prefix(5);
+  uint64_t stream_num;
+  if (!ConsumeDecimalNumber(&rest, &stream_num) || !rest.empty() ||
+      stream_num == 0 || stream_num > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+  *number = num;
+  *stream = static_cast<uint32_t>(stream_num);
+  return true;
+}
+
 std::string BlobFileName(uint64_t number) {
   assert(number > 0);
   return MakeFileName(number, kRocksDBBlobFileExt.c_str());
@@ -371,6 +396,15 @@ bool ParseFileName(const std::string& fname, uint64_t* number,
       }
     } else if (archive_dir_found) {
       return false;  // Archive dir can contain only log files
+    } else if (suffix.starts_with("log.")) {
+      // See LogStreamFileName()
+      suffix.remove_prefix(strlen("log."));
+      uint64_t stream;
+      if (!ConsumeDecimalNumber(&suffix, &stream) || !suffix.empty() ||
+          stream == 0 || stream > std::numeric_limits<uint32_t>::max()) {
+        return false;
+      }
+      *type = kWalStreamFile;
     } else if (suffix == Slice(kRocksDbTFileExt) ||
                suffix == Slice(kLevelDbTFileExt)) {
       *type = kTableFile;
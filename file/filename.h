@@ -44,6 +44,18 @@ std::string LogFileName(const std::string& dbname, uint64_t number);
 
 std::string LogFileName(uint64_t number);
 
+// Return the name of the file holding stream `stream` (> 0) of the log file
+// with the specified number, when the WAL is split across write queues (see
+// DBOptions::wal_per_write_queue). Stream 0 is the file named LogFileName().
+std::string LogStreamFileName(const std::string& dbname, uint64_t number,
+                              uint32_t stream);
+
+// If filename is a name returned by LogStreamFileName(), store the log number
+// and the stream in *number and *stream and return true. ParseFileName()
+// returns such files as kWalStreamFile.
+bool ParseLogStreamFileName(const std::string& filename, uint64_t* number,
+                            uint32_t* stream);
+
 std::string BlobFileName(uint64_t number);
 
 std::string BlobFileName(const std::string& bdirname, uint64_t number);
@@ -10,6 +10,7 @@
 #include "file/writable_file_writer.h"
 
 #include <algorithm>
+#include <deque>
 #include <mutex>
 
 #include "db/version_edit.h"
@@ -43,6 +44,278 @@ inline Histograms GetFileWriteHistograms(Histograms file_writer_hist,
   return Histograms::HISTOGRAM_ENUM_MAX;
 }
 
+class WritableFileWriter::AsyncWriter {
+ public:
+  AsyncWriter(WritableFileWriter* writer, size_t num_buffers)
+      : writer_(writer), max_in_flight_(num_buffers - 1), cv_(&mu_) {
+    assert(max_in_flight_ > 0);
+  }
+
+  ~AsyncWriter() {
+    {
+      MutexLock l(&mu_);
+      shutdown_ = true;
+      cv_.SignalAll();
+    }
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // Queues the data in `*buf` to be written after all previously submitted
+  // buffers, and replaces it with an empty buffer of at least the same
+  // capacity. `crc32c_checksum` is the checksum of the buffered data if the
+  // writer maintains one. Blocks while all other buffers are in flight.
+  IOStatus Submit(const IOOptions& opts, AlignedBuffer* buf,
+                  uint32_t crc32c_checksum) {
+    MutexLock l(&mu_);
+    while (status_.ok() &&
+           pending_.size() + (writing_ ? 1 : 0) >= max_in_flight_) {
+      cv_.Wait();
+    }
+    if (!status_.ok()) {
+      return status_;
+    }
+    AlignedBuffer next;
+    if (free_buffers_.empty()) {
+      next.Alignment(buf->Alignment());
+    } else {
+      next = std::move(free_buffers_.back());
+      free_buffers_.pop_back();
+    }
+    if (next.Capacity() < buf->Capacity()) {
+      next.AllocateNewBuffer(buf->Capacity());
+    }
+    next.Size(0);
+    pending_.emplace_back(opts, std::move(*buf), crc32c_checksum,
+                          GetPerfLevel());
+    *buf = std::move(next);
+    if (!thread_.joinable()) {
+      thread_ = port::Thread(&AsyncWriter::BackgroundWrite, this);
+    }
+    cv_.SignalAll();
+    AddIOStatsToCaller();
+    return IOStatus::OK();
+  }
+
+  // Returns the first error hit by the background writes, if any.
+  IOStatus WaitForPendingWrites() {
+    MutexLock l(&mu_);
+    while (!pending_.empty() || writing_) {
+      cv_.Wait();
+    }
+    AddIOStatsToCaller();
+    return status_;
+  }
+
+ private:
+  struct PendingWrite {
+    PendingWrite(const IOOptions& _opts, AlignedBuffer&& _buf, uint32_t _crc,
+                 PerfLevel _perf_level)
+        : opts(_opts),
+          buf(std::move(_buf)),
+          crc32c_checksum(_crc),
+          perf_level(_perf_level) {}
+    IOOptions opts;
+    AlignedBuffer buf;
+    uint32_t crc32c_checksum;
+    // Perf level of the submitting thread, for the background write to be
+    // timed the same way as a synchronous one.
+    PerfLevel perf_level;
+  };
+
+  // The IOStatsContext counters updated by a write
+  struct WriteIOStats {
+    uint64_t bytes_written = 0;
+    uint64_t write_nanos = 0;
+    uint64_t cpu_write_nanos = 0;
+    uint64_t range_sync_nanos = 0;
+  };
+
+  static WriteIOStats CurrentThreadIOStats() {
+    WriteIOStats stats;
+    stats.bytes_written = IOSTATS(bytes_written);
+    stats.write_nanos = IOSTATS(write_nanos);
+    stats.cpu_write_nanos = IOSTATS(cpu_write_nanos);
+    stats.range_sync_nanos = IOSTATS(range_sync_nanos);
+    return stats;
+  }
+
+  // The IOStatsContext is thread local, so the background writes are
+  // accounted in unreported_iostats_, and added to the context of the thread
+  // using the writer, e.g. for compaction stats, when it submits or waits.
+  // REQUIRES: mu_ held
+  void AddIOStatsToCaller() {
+    IOSTATS_ADD(bytes_written, unreported_iostats_.bytes_written);
+    IOSTATS_ADD(write_nanos, unreported_iostats_.write_nanos);
+    IOSTATS_ADD(cpu_write_nanos, unreported_iostats_.cpu_write_nanos);
+    IOSTATS_ADD(range_sync_nanos, unreported_iostats_.range_sync_nanos);
+    unreported_iostats_ = WriteIOStats();
+  }
+
+  void BackgroundWrite() {
+    MutexLock l(&mu_);
+    while (true) {
+      while (pending_.empty() && !shutdown_) {
+        cv_.Wait();
+      }
+      if (pending_.empty()) {
+        break;
+      }
+      PendingWrite w = std::move(pending_.front());
+      pending_.pop_front();
+      writing_ = true;
+      // Once a write failed, the following data can no longer be written
+      // without leaving a hole in the file.
+      if (status_.ok() && writer_->seen_error()) {
+        status_ = writer_->GetWriterHasPreviousErrorStatus();
+      }
+      if (status_.ok()) {
+        mu_.Unlock();
+        TEST_SYNC_POINT("WritableFileWriter::AsyncWriter::BeforeWrite");
+        SetPerfLevel(w.perf_level);
+        const WriteIOStats before = CurrentThreadIOStats();
+        IOStatus s;
+        if (writer_->perform_data_verification_ &&
+            writer_->buffered_data_with_checksum_) {
+          s = writer_->WriteBufferedDataWithChecksum(
+              w.opts, w.buf.BufferStart(), w.buf.CurrentSize(),
+              w.crc32c_checksum);
+        } else {
+          s = writer_->WriteBufferedData(w.opts, w.buf.BufferStart(),
+                                         w.buf.CurrentSize());
+        }
+        if (s.ok()) {
+          s = writer_->MaybeRangeSync(w.opts);
+        }
+        const WriteIOStats after = CurrentThreadIOStats();
+        mu_.Lock();
+        unreported_iostats_.bytes_written +=
+            after.bytes_written - before.bytes_written;
+        unreported_iostats_.write_nanos +=
+            after.write_nanos - before.write_nanos;
+        unreported_iostats_.cpu_write_nanos +=
+            after.cpu_write_nanos - before.cpu_write_nanos;
+        unreported_iostats_.range_sync_nanos +=
+            after.range_sync_nanos - before.range_sync_nanos;
+        if (!s.ok() && status_.ok()) {
+          status_ = s;
+        }
+      }
+      writing_ = false;
+      w.buf.Size(0);
+      free_buffers_.push_back(std::move(w.buf));
+      cv_.SignalAll();
+    }
+  }
+
+  WritableFileWriter* const writer_;
+  // Number of buffers that can be queued or being written at a time
+  const size_t max_in_flight_;
+  port::Mutex mu_;
+  port::CondVar cv_;
+  std::deque<PendingWrite> pending_;
+  std::vector<AlignedBuffer> free_buffers_;
+  bool writing_ = false;
+  bool shutdown_ = false;
+  IOStatus status_;
+  WriteIOStats unreported_iostats_;
+  port::Thread thread_;
+};
+
+WritableFileWriter::WritableFileWriter(
+    std::unique_ptr<FSWritableFile>&& file, const std::string& _file_name,
+    const FileOptions& options, SystemClock* clock,
+    const std::shared_ptr<IOTracer>& io_tracer, Statistics* stats,
+    Histograms hist_type,
+    const std::vector<std::shared_ptr<EventListener>>& listeners,
+    FileChecksumGenFactory* file_checksum_gen_factory,
+    bool perform_data_verification, bool buffered_data_with_checksum)
+    : file_name_(_file_name),
+      writable_file_(std::move(file), io_tracer, _file_name),
+      clock_(clock),
+      buf_(),
+      max_buffer_size_(options.writable_file_max_buffer_size),
+      filesize_(0),
+      flushed_size_(0),
+      next_write_offset_(0),
+      pending_sync_(false),
+      seen_error_(false),
+#ifndef NDEBUG
+      seen_injected_error_(false),
+#endif  // NDEBUG
+      last_sync_size_(0),
+      bytes_per_sync_(options.bytes_per_sync),
+      rate_limiter_(options.rate_limiter),
+      stats_(stats),
+      hist_type_(hist_type),
+      listeners_(),
+      checksum_generator_(nullptr),
+      checksum_finalized_(false),
+      perform_data_verification_(perform_data_verification),
+      buffered_data_crc32c_checksum_(0),
+      buffered_data_with_checksum_(buffered_data_with_checksum) {
+  temperature_ = options.temperature;
+  assert(!use_direct_io() || max_buffer_size_ > 0);
+  TEST_SYNC_POINT_CALLBACK("WritableFileWriter::WritableFileWriter:0",
+                           reinterpret_cast<void*>(max_buffer_size_));
+  buf_.Alignment(writable_file_->GetRequiredBufferAlignment());
+  buf_.AllocateNewBuffer(std::min((size_t)65536, max_buffer_size_));
+  std::for_each(listeners.begin(), listeners.end(),
+                [this](const std::shared_ptr<EventListener>& e) {
+                  if (e->ShouldBeNotifiedOnFileIO()) {
+                    listeners_.emplace_back(e);
+                  }
+                });
+  if (file_checksum_gen_factory != nullptr) {
+    FileChecksumGenContext checksum_gen_context;
+    checksum_gen_context.file_name = _file_name;
+    checksum_generator_ =
+        file_checksum_gen_factory->CreateFileChecksumGenerator(
+            checksum_gen_context);
+  }
+  if (options.async_write_buffers >= 2 && !use_direct_io()) {
+    async_writer_.reset(new AsyncWriter(this, options.async_write_buffers));
+  }
+}
+
+WritableFileWriter::~WritableFileWriter() {
+  ThreadStatus::OperationType cur_op_type =
+      ThreadStatusUtil::GetThreadOperation();
+  ThreadStatusUtil::SetThreadOperation(ThreadStatus::OperationType::OP_UNKNOWN);
+  auto s = Close(IOOptions());
+  s.PermitUncheckedError();
+  ThreadStatusUtil::SetThreadOperation(cur_op_type);
+}
+
+IOStatus WritableFileWriter::WaitForAsyncWrites() {
+  if (async_writer_ == nullptr) {
+    return IOStatus::OK();
+  }
+  IOStatus s = async_writer_->WaitForPendingWrites();
+  if (!s.ok()) {
+    set_seen_error(s);
+  }
+  return s;
+}
+
+IOStatus WritableFileWriter::FlushForAppend(const IOOptions& opts) {
+  if (async_writer_ == nullptr || buf_.CurrentSize() == 0) {
+    return Flush(opts);
+  }
+  if (seen_error()) {
+    return GetWriterHasPreviousErrorStatus();
+  }
+  IOStatus s =
+      async_writer_->Submit(opts, &buf_, buffered_data_crc32c_checksum_);
+  if (s.ok()) {
+    buffered_data_crc32c_checksum_ = 0;
+  } else {
+    set_seen_error(s);
+  }
+  return s;
+}
+
 IOStatus WritableFileWriter::Create(const std::shared_ptr<FileSystem>& fs,
                                     const std::string& fname,
                                     const FileOptions& file_opts,
@@ -107,7 +380,7 @@ IOStatus WritableFileWriter::Append(const IOOptions& opts, const Slice& data,
   // Flush only when buffered I/O
   if (!use_direct_io() && (buf_.Capacity() - buf_.CurrentSize()) < left) {
     if (buf_.CurrentSize() > 0) {
-      s = Flush(io_options);
+      s = FlushForAppend(io_options);
       if (!s.ok()) {
         set_seen_error(s);
         return s;
@@ -138,7 +411,7 @@ IOStatus WritableFileWriter::Append(const IOOptions& opts, const Slice& data,
           src += appended;
 
           if (left > 0) {
-            s = Flush(io_options);
+            s = FlushForAppend(io_options);
             if (!s.ok()) {
               break;
             }
@@ -148,7 +421,10 @@ IOStatus WritableFileWriter::Append(const IOOptions& opts, const Slice& data,
     } else {
       assert(buf_.CurrentSize() == 0);
       buffered_data_crc32c_checksum_ = crc32c_checksum;
-      s = WriteBufferedWithChecksum(io_options, src, left);
+      s = WaitForAsyncWrites();
+      if (s.ok()) {
+        s = WriteBufferedWithChecksum(io_options, src, left);
+      }
     }
   } else {
     // In this case, either we do not need to do the data verification or
@@ -168,7 +444,7 @@ IOStatus WritableFileWriter::Append(const IOOptions& opts, const Slice& data,
         src += appended;
 
         if (left > 0) {
-          s = Flush(io_options);
+          s = FlushForAppend(io_options);
           if (!s.ok()) {
             break;
           }
@@ -177,11 +453,15 @@ IOStatus WritableFileWriter::Append(const IOOptions& opts, const Slice& data,
     } else {
       // Writing directly to file bypassing the buffer
       assert(buf_.CurrentSize() == 0);
-      if (perform_data_verification_ && buffered_data_with_checksum_) {
-        buffered_data_crc32c_checksum_ = crc32c::Value(src, left);
-        s = WriteBufferedWithChecksum(io_options, src, left);
-      } else {
-        s = WriteBuffered(io_options, src, left);
+      // Earlier buffers still being written in the background go first
+      s = WaitForAsyncWrites();
+      if (s.ok()) {
+        if (perform_data_verification_ && buffered_data_with_checksum_) {
+          buffered_data_crc32c_checksum_ = crc32c::Value(src, left);
+          s = WriteBufferedWithChecksum(io_options, src, left);
+        } else {
+          s = WriteBuffered(io_options, src, left);
+        }
       }
     }
   }
@@ -224,7 +504,7 @@ IOStatus WritableFileWriter::Pad(const IOOptions& opts,
     }
 
     if (left > 0) {
-      IOStatus s = Flush(io_options);
+      IOStatus s = FlushForAppend(io_options);
       if (!s.ok()) {
         set_seen_error(s);
         return s;
@@ -242,6 +522,8 @@ IOStatus WritableFileWriter::Pad(const IOOptions& opts,
 IOStatus WritableFileWriter::Close(const IOOptions& opts) {
   IOOptions io_options = FinalizeIOOptions(opts);
   if (seen_error()) {
+    // Stop the background writer before closing the file under it
+    async_writer_.reset();
     IOStatus interim;
     if (writable_file_.get() != nullptr) {
       interim = writable_file_->Close(io_options, nullptr);
@@ -267,6 +549,8 @@ IOStatus WritableFileWriter::Close(const IOOptions& opts) {
 
   IOStatus s;
   s = Flush(io_options);  // flush cache to OS
+  // No more buffers are pending after Flush(), even if it failed
+  async_writer_.reset();
 
   IOStatus interim;
   // In direct I/O mode we write whole pages so
@@ -353,9 +637,14 @@ IOStatus WritableFileWriter::Flush(const IOOptions& opts) {
 
   const IOOptions io_options = FinalizeIOOptions(opts);
 
-  IOStatus s;
   TEST_KILL_RANDOM_WITH_WEIGHT("WritableFileWriter::Flush:0", REDUCE_ODDS2);
 
+  // Buffers handed off by Append() precede the current one in the file
+  IOStatus s = WaitForAsyncWrites();
+  if (!s.ok()) {
+    return s;
+  }
+
   if (buf_.CurrentSize() > 0) {
     if (use_direct_io()) {
       if (pending_sync_) {
@@ -399,6 +688,10 @@ IOStatus WritableFileWriter::Flush(const IOOptions& opts) {
     return s;
   }
 
+  return MaybeRangeSync(io_options);
+}
+
+IOStatus WritableFileWriter::MaybeRangeSync(const IOOptions& opts) {
   // sync OS cache to disk for every bytes_per_sync_
   // TODO: give log file and sst file different options (log
   // files could be potentially cached in OS for their whole
@@ -410,18 +703,19 @@ IOStatus WritableFileWriter::Flush(const IOOptions& opts) {
   //     the page.
   // Xfs does neighbor page flushing outside of the specified ranges. We
   // need to make sure sync range is far from the write offset.
+  IOStatus s;
   if (!use_direct_io() && bytes_per_sync_) {
     const uint64_t kBytesNotSyncRange =
         1024 * 1024;                                // recent 1MB is not synced.
     const uint64_t kBytesAlignWhenSync = 4 * 1024;  // Align 4KB.
-    uint64_t cur_size = filesize_.load(std::memory_order_acquire);
+    uint64_t cur_size = flushed_size_.load(std::memory_order_acquire);
     if (cur_size > kBytesNotSyncRange) {
       uint64_t offset_sync_to = cur_size - kBytesNotSyncRange;
       offset_sync_to -= offset_sync_to % kBytesAlignWhenSync;
       assert(offset_sync_to >= last_sync_size_);
       if (offset_sync_to > 0 &&
           offset_sync_to - last_sync_size_ >= bytes_per_sync_) {
-        s = RangeSync(io_options, last_sync_size_,
+        s = RangeSync(opts, last_sync_size_,
                       offset_sync_to - last_sync_size_);
         if (!s.ok()) {
           set_seen_error(s);
@@ -564,14 +858,30 @@ IOStatus WritableFileWriter::RangeSync(const IOOptions& opts, uint64_t offset,
   return s;
 }
 
-// This method writes to disk the specified data and makes use of the rate
-// limiter if available
 IOStatus WritableFileWriter::WriteBuffered(const IOOptions& opts,
                                            const char* data, size_t size) {
   if (seen_error()) {
     return GetWriterHasPreviousErrorStatus();
   }
 
+  IOStatus s = WriteBufferedData(opts, data, size);
+  // If writable_file_->Append() failed, then the data may or may not exist in
+  // the underlying memory buffer, OS page cache, remote file system's buffer,
+  // etc. If WritableFileWriter keeps the data in buf_, then a future Close()
+  // or write retry may send the data to the underlying file again. If the
+  // data does exist in the underlying buffer and gets written to the file
+  // eventually despite returning error, the file may end up with two
+  // duplicate pieces of data. Therefore, clear the buf_ at the
+  // WritableFileWriter layer and let caller determine error handling.
+  buf_.Size(0);
+  buffered_data_crc32c_checksum_ = 0;
+  return s;
+}
+
+// This method writes to disk the specified data and makes use of the rate
+// limiter if available
+IOStatus WritableFileWriter::WriteBufferedData(const IOOptions& opts,
+                                               const char* data, size_t size) {
   IOStatus s;
   assert(!use_direct_io());
   const char* src = data;
@@ -611,19 +921,6 @@ IOStatus WritableFileWriter::WriteBuffered(const IOOptions& opts,
         } else {
           s = writable_file_->Append(Slice(src, allowed), opts, nullptr);
         }
-        if (!s.ok()) {
-          // If writable_file_->Append() failed, then the data may or may not
-          // exist in the underlying memory buffer, OS page cache, remote file
-          // system's buffer, etc. If WritableFileWriter keeps the data in
-          // buf_, then a future Close() or write retry may send the data to
-          // the underlying file again. If the data does exist in the
-          // underlying buffer and gets written to the file eventually despite
-          // returning error, the file may end up with two duplicate pieces of
-          // data. Therefore, clear the buf_ at the WritableFileWriter layer
-          // and let caller determine error handling.
-          buf_.Size(0);
-          buffered_data_crc32c_checksum_ = 0;
-        }
         SetPerfLevel(prev_perf_level);
       }
       if (ShouldNotifyListeners()) {
@@ -648,11 +945,6 @@ IOStatus WritableFileWriter::WriteBuffered(const IOOptions& opts,
     uint64_t cur_size = flushed_size_.load(std::memory_order_acquire);
     flushed_size_.store(cur_size + allowed, std::memory_order_release);
   }
-  buf_.Size(0);
-  buffered_data_crc32c_checksum_ = 0;
-  if (!s.ok()) {
-    set_seen_error(s);
-  }
   return s;
 }
 
@@ -663,6 +955,18 @@ IOStatus WritableFileWriter::WriteBufferedWithChecksum(const IOOptions& opts,
     return GetWriterHasPreviousErrorStatus();
   }
 
+  IOStatus s = WriteBufferedDataWithChecksum(opts, data, size,
+                                             buffered_data_crc32c_checksum_);
+  // Whether the write succeeded or not, the data is no longer buffered, see
+  // WriteBuffered().
+  buf_.Size(0);
+  buffered_data_crc32c_checksum_ = 0;
+  return s;
+}
+
+IOStatus WritableFileWriter::WriteBufferedDataWithChecksum(
+    const IOOptions& opts, const char* data, size_t size,
+    uint32_t crc32c_checksum) {
   IOStatus s;
   assert(!use_direct_io());
   assert(perform_data_verification_ && buffered_data_with_checksum_);
@@ -679,9 +983,9 @@ IOStatus WritableFileWriter::WriteBufferedWithChecksum(const IOOptions& opts,
   if (rate_limiter_ != nullptr && rate_limiter_priority_used != Env::IO_TOTAL) {
     while (data_size > 0) {
       size_t tmp_size;
-      tmp_size = rate_limiter_->RequestToken(data_size, buf_.Alignment(),
-                                             rate_limiter_priority_used, stats_,
-                                             RateLimiter::OpType::kWrite);
+      tmp_size = rate_limiter_->RequestToken(
+          data_size, writable_file_->GetRequiredBufferAlignment(),
+          rate_limiter_priority_used, stats_, RateLimiter::OpType::kWrite);
       data_size -= tmp_size;
     }
   }
@@ -701,7 +1005,7 @@ IOStatus WritableFileWriter::WriteBufferedWithChecksum(const IOOptions& opts,
 
       IOSTATS_CPU_TIMER_GUARD(cpu_write_nanos, clock_);
 
-      EncodeFixed32(checksum_buf, buffered_data_crc32c_checksum_);
+      EncodeFixed32(checksum_buf, crc32c_checksum);
       v_info.checksum = Slice(checksum_buf, sizeof(uint32_t));
       s = writable_file_->Append(Slice(src, left), opts, v_info, nullptr);
       SetPerfLevel(prev_perf_level);
@@ -715,17 +1019,6 @@ IOStatus WritableFileWriter::WriteBufferedWithChecksum(const IOOptions& opts,
       }
     }
     if (!s.ok()) {
-      // If writable_file_->Append() failed, then the data may or may not
-      // exist in the underlying memory buffer, OS page cache, remote file
-      // system's buffer, etc. If WritableFileWriter keeps the data in
-      // buf_, then a future Close() or write retry may send the data to
-      // the underlying file again. If the data does exist in the
-      // underlying buffer and gets written to the file eventually despite
-      // returning error, the file may end up with two duplicate pieces of
-      // data. Therefore, clear the buf_ at the WritableFileWriter layer
-      // and let caller determine error handling.
-      buf_.Size(0);
-      buffered_data_crc32c_checksum_ = 0;
       set_seen_error(s);
       return s;
     }
@@ -734,15 +1027,8 @@ IOStatus WritableFileWriter::WriteBufferedWithChecksum(const IOOptions& opts,
   IOSTATS_ADD(bytes_written, left);
   TEST_KILL_RANDOM("WritableFileWriter::WriteBuffered:0");
 
-  // Buffer write is successful, reset the buffer current size to 0 and reset
-  // the corresponding checksum value
-  buf_.Size(0);
-  buffered_data_crc32c_checksum_ = 0;
   uint64_t cur_size = flushed_size_.load(std::memory_order_acquire);
   flushed_size_.store(cur_size + left, std::memory_order_release);
-  if (!s.ok()) {
-    set_seen_error(s);
-  }
   return s;
 }
 
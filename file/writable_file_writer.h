@@ -9,6 +9,7 @@
 
 #pragma once
 #include <atomic>
+#include <memory>
 #include <string>
 
 #include "db/version_edit.h"
@@ -34,8 +35,14 @@ class SystemClock;
 // - Flush and Sync the data to the underlying filesystem.
 // - Notify any interested listeners on the completion of a write.
 // - Update IO stats.
+// - Optionally pipeline buffered writes: with
+//   FileOptions::async_write_buffers >= 2, a full buffer is handed off to a
+//   background thread to be written while Append() fills the next one.
 class WritableFileWriter {
  private:
+  // Writes handed-off buffers in the background, see async_write_buffers.
+  class AsyncWriter;
+
   void NotifyOnFileWriteFinish(
       uint64_t offset, size_t length,
       const FileOperationInfo::StartTimePoint& start_ts,
@@ -164,6 +171,9 @@ class WritableFileWriter {
   uint32_t buffered_data_crc32c_checksum_;
   bool buffered_data_with_checksum_;
   Temperature temperature_;
+  // Only set in pipelined mode, i.e. when async_write_buffers >= 2 and not
+  // using direct I/O.
+  std::unique_ptr<AsyncWriter> async_writer_;
 
  public:
   WritableFileWriter(
@@ -175,51 +185,7 @@ class WritableFileWriter {
       const std::vector<std::shared_ptr<EventListener>>& listeners = {},
       FileChecksumGenFactory* file_checksum_gen_factory = nullptr,
       bool perform_data_verification = false,
-      bool buffered_data_with_checksum = false)
-      : file_name_(_file_name),
-        writable_file_(std::move(file), io_tracer, _file_name),
-        clock_(clock),
-        buf_(),
-        max_buffer_size_(options.writable_file_max_buffer_size),
-        filesize_(0),
-        flushed_size_(0),
-        next_write_offset_(0),
-        pending_sync_(false),
-        seen_error_(false),
-#ifndef NDEBUG
-        seen_injected_error_(false),
-#endif  // NDEBUG
-        last_sync_size_(0),
-        bytes_per_sync_(options.bytes_per_sync),
-        rate_limiter_(options.rate_limiter),
-        stats_(stats),
-        hist_type_(hist_type),
-        listeners_(),
-        checksum_generator_(nullptr),
-        checksum_finalized_(false),
-        perform_data_verification_(perform_data_verification),
-        buffered_data_crc32c_checksum_(0),
-        buffered_data_with_checksum_(buffered_data_with_checksum) {
-    temperature_ = options.temperature;
-    assert(!use_direct_io() || max_buffer_size_ > 0);
-    TEST_SYNC_POINT_CALLBACK("WritableFileWriter::WritableFileWriter:0",
-                             reinterpret_cast<void*>(max_buffer_size_));
-    buf_.Alignment(writable_file_->GetRequiredBufferAlignment());
-    buf_.AllocateNewBuffer(std::min((size_t)65536, max_buffer_size_));
-    std::for_each(listeners.begin(), listeners.end(),
-                  [this](const std::shared_ptr<EventListener>& e) {
-                    if (e->ShouldBeNotifiedOnFileIO()) {
-                      listeners_.emplace_back(e);
-                    }
-                  });
-    if (file_checksum_gen_factory != nullptr) {
-      FileChecksumGenContext checksum_gen_context;
-      checksum_gen_context.file_name = _file_name;
-      checksum_generator_ =
-          file_checksum_gen_factory->CreateFileChecksumGenerator(
-              checksum_gen_context);
-    }
-  }
+      bool buffered_data_with_checksum = false);
 
   static IOStatus Create(const std::shared_ptr<FileSystem>& fs,
                          const std::string& fname, const FileOptions& file_opts,
@@ -232,15 +198,7 @@ class WritableFileWriter {
 
   WritableFileWriter& operator=(const WritableFileWriter&) = delete;
 
-  ~WritableFileWriter() {
-    ThreadStatus::OperationType cur_op_type =
-        ThreadStatusUtil::GetThreadOperation();
-    ThreadStatusUtil::SetThreadOperation(
-        ThreadStatus::OperationType::OP_UNKNOWN);
-    auto s = Close(IOOptions());
-    s.PermitUncheckedError();
-    ThreadStatusUtil::SetThreadOperation(cur_op_type);
-  }
+  ~WritableFileWriter();
 
   std::string file_name() const { return file_name_; }
 
@@ -350,6 +308,25 @@ class WritableFileWriter {
   // `opts` should've been called with `FinalizeIOOptions()` before passing in
   IOStatus WriteBufferedWithChecksum(const IOOptions& opts, const char* data,
                                      size_t size);
+  // Writes `data` to the file without touching buf_, so that it can also be
+  // used for buffers handed off to the background writer.
+  // `opts` should've been called with `FinalizeIOOptions()` before passing in
+  IOStatus WriteBufferedData(const IOOptions& opts, const char* data,
+                             size_t size);
+  // Same as above, with `crc32c_checksum` being the checksum of all of `data`.
+  // `opts` should've been called with `FinalizeIOOptions()` before passing in
+  IOStatus WriteBufferedDataWithChecksum(const IOOptions& opts,
+                                         const char* data, size_t size,
+                                         uint32_t crc32c_checksum);
+  // Makes room in a full buf_. In pipelined mode the buffer is handed off to
+  // the background writer, otherwise this is the same as Flush().
+  // `opts` should've been called with `FinalizeIOOptions()` before passing in
+  IOStatus FlushForAppend(const IOOptions& opts);
+  // Waits for all buffers handed off to the background writer to be written.
+  IOStatus WaitForAsyncWrites();
+  // Issues a RangeSync() for the flushed data every bytes_per_sync_ bytes.
+  // `opts` should've been called with `FinalizeIOOptions()` before passing in
+  IOStatus MaybeRangeSync(const IOOptions& opts);
   // `opts` should've been called with `FinalizeIOOptions()` before passing in
   IOStatus RangeSync(const IOOptions& opts, uint64_t offset, uint64_t nbytes);
   // `opts` should've been called with `FinalizeIOOptions()` before passing in
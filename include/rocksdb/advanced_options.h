@@ -59,6 +59,18 @@ enum CompactionPri : char {
   // level. The file picking process will cycle through all the files in a
   // round-robin manner.
   kRoundRobin = 0x4,
+  // EXPERIMENTAL
+  // Like kMinOverlappingRatio, but also takes the sampled reads of each file
+  // (see `SstFileMetaData::num_reads_sampled`) into account. A read probing a
+  // file that does not contain its key goes on to the next level; once the
+  // file is compacted into the next level, such reads skip this level. So
+  // the overlapping ratio of a file, which estimates the write cost per byte
+  // compacted, is divided by one plus the number of its reads relative to
+  // the average file in the level, and often read files are compacted
+  // earlier than others with a similar write cost. Without reads it behaves
+  // like kMinOverlappingRatio. The order is updated whenever the LSM tree
+  // changes, and read samples start over when the DB is reopened.
+  kReadWeightedOverlappingRatio = 0x5,
 };
 
 // Temperature of a file. Used to pass to FileSystem for a different
@@ -273,6 +285,32 @@ struct AdvancedColumnFamilyOptions {
   // [experimental]
   double experimental_mempurge_threshold = 0.0;
 
+  // EXPERIMENTAL
+  // Keeps the data of this column family in memory, for small and hot
+  // column families where flushing to L0 and compacting is wasted I/O:
+  //   - A flush triggered by a full write buffer always rewrites the
+  //     immutable memtables into a single compacted memtable (see
+  //     experimental_mempurge_threshold) instead of writing an L0 file, as
+  //     long as the live data fits in write_buffer_size.
+  //   - Other flushes, in particular those triggered by max_total_wal_size,
+  //     act as checkpoints: they write an L0 file as usual, which allows the
+  //     WAL to be truncated and bounds recovery time.
+  //   - Memtables written out by a checkpoint are retained in memory (up to
+  //     max_write_buffer_size_to_maintain, which defaults to
+  //     max_write_buffer_number * write_buffer_size for such column
+  //     families) and point lookups are served from them before consulting
+  //     the SST files. They are dropped whenever the SST files lose or
+  //     change data other than through newer writes: by compactions with a
+  //     compaction filter, FIFO deletions, DeleteFile() and
+  //     DeleteFilesInRanges().
+  // Not supported together with atomic_flush, in which case it only
+  // affects point lookups.
+  //
+  // Default: false
+  //
+  // Not dynamically changeable, change it requires db restart.
+  bool memtable_resident = false;
+
   // existing_value - pointer to previous value (from both memtable and sst).
   //                  nullptr if key doesn't exist
   // existing_value_size - pointer to size of existing_value).
@@ -356,6 +394,20 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   size_t memtable_huge_page_size = 0;
 
+  // EXPERIMENTAL
+  // If true, the memtable arena allocates the per-core blocks it hands out
+  // to concurrent writers from memory bound to the NUMA node of each core
+  // (MPOL_PREFERRED), rather than from blocks shared by all cores. This
+  // keeps memtable inserts and most lookups node-local on multi-socket
+  // machines. Combines with memtable_huge_page_size. Has no effect unless
+  // RocksDB is built with NUMA support (WITH_NUMA) and the machine has more
+  // than one NUMA node.
+  //
+  // Default: false
+  //
+  // Dynamically changeable through SetOptions() API
+  bool memtable_numa_aware = false;
+
   // If non-nullptr, memtable will use the specified function to extract
   // prefixes for keys, and for each prefix maintain a hint of insert location
   // to reduce CPU usage for inserting keys with the prefix. Keys out of
@@ -1090,6 +1142,26 @@ struct AdvancedColumnFamilyOptions {
   // Dynamically changeable through the SetOptions() API.
   uint32_t bottommost_file_compaction_delay = 0;
 
+  // EXPERIMENTAL
+  // If greater than 1, a flush splits the key range of the memtables it
+  // flushes into up to this many partitions, at keys sampled from the
+  // memtables, and writes one L0 file per partition in parallel, in the flush
+  // thread and in max_flush_partitions - 1 extra threads. The files of a
+  // flush have disjoint key ranges and share the same epoch number. The
+  // memtables are only released once all partitions are written.
+  //
+  // This reduces the wall time of flushing large memtables, at the cost of
+  // more (smaller) L0 files, each of which counts towards
+  // level0_file_num_compaction_trigger and the L0 write stall triggers. A
+  // flush is not partitioned when the memtables contain range deletions, with
+  // user-defined timestamps, with a memtable representation that does not
+  // support random sampling, or with a compaction style other than
+  // kCompactionStyleLevel.
+  //
+  // Default: 1 (no partitioning)
+  // Dynamically changeable through the SetOptions() API.
+  uint32_t max_flush_partitions = 1;
+
   // Create ColumnFamilyOptions with default values for all fields
   AdvancedColumnFamilyOptions();
   // Create ColumnFamilyOptions from Options
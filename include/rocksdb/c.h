@@ -1745,7 +1745,8 @@ enum {
   rocksdb_k_oldest_largest_seq_first_compaction_pri = 1,
   rocksdb_k_oldest_smallest_seq_first_compaction_pri = 2,
   rocksdb_k_min_overlapping_ratio_compaction_pri = 3,
-  rocksdb_k_round_robin_compaction_pri = 4
+  rocksdb_k_round_robin_compaction_pri = 4,
+  rocksdb_k_read_weighted_overlapping_ratio_compaction_pri = 5
 };
 extern ROCKSDB_LIBRARY_API void rocksdb_options_set_compaction_pri(
     rocksdb_options_t*, int);
@@ -528,6 +528,20 @@ enum TieredAdmissionPolicy {
   // and compressed, but may increase the compressed secondary cache hit rate
   // for some workloads
   kAdmPolicyAllowAll,
+  // EXPERIMENTAL
+  // Keep the compressed secondary cache as the main in-memory tier, holding
+  // blocks in their on-disk compressed form, with the primary cache as a
+  // smaller tier of decompressed hot blocks. A compressed block read from
+  // storage is inserted into the compressed secondary cache as is (without
+  // being recompressed), and is only handed to the reader, with a placeholder
+  // entry recording the access in the primary cache. A block is decompressed
+  // into the primary cache on its second access while the placeholder is
+  // still there, so admission into the hot tier follows the recency/frequency
+  // tracking of the primary cache (e.g. the CLOCK counters of
+  // HyperClockCache). Blocks evicted from the primary cache are never
+  // demoted, since the secondary cache keeps a copy. Not compatible with
+  // nvm_sec_cache, and cannot be switched to or from with UpdateTieredCache.
+  kAdmPolicyKeepCompressed,
   kAdmPolicyMax,
 };
 
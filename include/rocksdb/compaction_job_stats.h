@@ -94,6 +94,15 @@ struct CompactionJobStats {
   // Time spent on preparing file write (fallocate, etc)
   uint64_t file_prepare_write_nanos;
 
+  // Time spent compressing data blocks in the background, with
+  // CompressionOptions::parallel_threads > 1.
+  uint64_t parallel_compression_nanos;
+
+  // Time the compaction thread spent waiting for data blocks to be
+  // compressed in the background, with
+  // CompressionOptions::parallel_threads > 1.
+  uint64_t parallel_compression_wait_nanos;
+
   // 0-terminated strings storing the first 8 bytes of the smallest and
   // largest key in the output.
   static const size_t kMaxPrefixLength = 8;
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -1007,6 +1008,24 @@ class DB {
       const std::vector<ColumnFamilyHandle*>& column_families,
       std::vector<Iterator*>* iterators) = 0;
 
+  // EXPERIMENTAL
+  // Scans multiple key ranges of a column family from a consistent database
+  // state. The ranges are visited in ascending order of `start` using a
+  // single iterator, which is given all the ranges up front (see
+  // Iterator::Prepare()) so that the data blocks they cover can be read with
+  // batched and coalesced I/O instead of one block at a time.
+  //
+  // For each key in [start, limit) of `ranges[i]`, `callback` is invoked with
+  // `i`, the key and the value. The slices are only valid during the call.
+  // Returning false from `callback` stops the scan of the current range and
+  // moves on to the next one. Returns the first error encountered, if any.
+  // ReadOptions::iter_start_ts is not supported.
+  virtual Status MultiScan(
+      const ReadOptions& options, ColumnFamilyHandle* column_family,
+      const std::vector<ScanRange>& ranges,
+      const std::function<bool(size_t range_index, const Slice& key,
+                               const Slice& value)>& callback);
+
   // EXPERIMENTAL
   // Return a cross-column-family iterator from a consistent database state.
   //
@@ -1098,6 +1117,15 @@ class DB {
     // available in the map form.
     static const std::string kDBWriteStallStats;
 
+    // "rocksdb.db-write-stage-stats" - returns a multi-line string or map
+    //      with latency distributions (micros) of the stages of the write
+    //      path: thread-wait, wal, wal-sync, memtable and delay, for each
+    //      write queue ("main" and, with two_write_queues, "wal-only").
+    //      Map keys are "<queue>.<stage>.<stat>" with <stat> being one of
+    //      count, sum, p50, p99, p99.9 and max. DB-scope, so only reported
+    //      for the default column family.
+    static const std::string kDBWriteStageStats;
+
     //  "rocksdb.dbstats" - As a string property, returns a multi-line string
     //      with general database stats, both cumulative (over the db's
     //      lifetime) and interval (since the last retrieval of kDBStats).
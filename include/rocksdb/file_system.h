@@ -192,6 +192,13 @@ struct FileOptions : EnvOptions {
   // handoff during file writes.
   ChecksumType handoff_checksum_type;
 
+  // EXPERIMENTAL
+  // The number of buffers a WritableFileWriter of a new file uses to pipeline
+  // buffered (non-direct) writes: while one buffer is being filled, up to
+  // `async_write_buffers - 1` full ones are written to the file by a
+  // background thread. Values less than 2 disable pipelining.
+  size_t async_write_buffers = 0;
+
   FileOptions() : EnvOptions(), handoff_checksum_type(ChecksumType::kCRC32c) {}
 
   FileOptions(const DBOptions& opts)
@@ -204,7 +211,8 @@ struct FileOptions : EnvOptions {
       : EnvOptions(opts),
         io_options(opts.io_options),
         temperature(opts.temperature),
-        handoff_checksum_type(opts.handoff_checksum_type) {}
+        handoff_checksum_type(opts.handoff_checksum_type),
+        async_write_buffers(opts.async_write_buffers) {}
 
   FileOptions& operator=(const FileOptions&) = default;
 };
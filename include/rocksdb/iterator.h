@@ -19,12 +19,25 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "rocksdb/iterator_base.h"
 #include "rocksdb/wide_columns.h"
 
 namespace ROCKSDB_NAMESPACE {
 
+// EXPERIMENTAL
+// A key range [start, limit) to be scanned, see Iterator::Prepare() and
+// DB::MultiScan(). In case of user-defined timestamp, if enabled, `start` and
+// `limit` should point to keys without timestamp part.
+struct ScanRange {
+  Slice start;
+  Slice limit;
+
+  ScanRange() {}
+  ScanRange(const Slice& s, const Slice& l) : start(s), limit(l) {}
+};
+
 class Iterator : public IteratorBase {
  public:
   Iterator() {}
@@ -93,6 +106,17 @@ class Iterator : public IteratorBase {
     assert(false);
     return Slice();
   }
+
+  // EXPERIMENTAL
+  // Hints the iterator that it is about to be used to scan the given key
+  // ranges, sorted by `start` in ascending order. Iterators may use it to
+  // fetch the data blocks covering the ranges up front, coalescing adjacent
+  // blocks into fewer and larger reads, instead of reading them one at a time
+  // as the iterator advances.
+  //
+  // The iterator is not positioned after this call; one of the Seek methods
+  // needs to be called before using it. Default implementation is a no-op.
+  virtual void Prepare(const std::vector<ScanRange>& /*scan_ranges*/) {}
 };
 
 // Return an empty iterator (yields nothing).
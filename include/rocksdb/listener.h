@@ -157,6 +157,9 @@ enum class CompactionReason : int {
   // [InternalOnly] DBImpl::ReFitLevel treated as a compaction,
   // Used only for internal conflict checking with other compactions
   kRefitLevel,
+  // [Universal] a tier holds CompactionOptionsUniversal::max_runs_per_tier
+  // sorted runs, or merging runs of a tier avoids a write slowdown
+  kUniversalRunsPerTier,
   // total number of compaction reasons, new reasons must be added above this.
   kNumOfReasons,
 };
@@ -199,6 +199,10 @@ class MemTableRep {
     return 0;
   }
 
+  // Return true if the current MemTableRep implements UniqueRandomSample().
+  // Default: false
+  virtual bool IsRandomSampleSupported() const { return false; }
+
   // Returns a vector of unique random memtable entries of approximate
   // size 'target_sample_size' (this size is not strictly enforced).
   virtual void UniqueRandomSample(const uint64_t num_entries,
@@ -386,6 +390,34 @@ class VectorRepFactory : public MemTableRepFactory {
                                  Logger* logger) override;
 };
 
+// EXPERIMENTAL: This uses a B+-tree to store keys. Nodes are allocated from
+// the memtable arena and hold up to 32 contiguous key pointers, so that a
+// lookup touches fewer cache lines than in the skip list. Concurrent inserts
+// (allow_concurrent_memtable_write) and readers synchronize with optimistic
+// lock coupling. Inserts with a hint (e.g. with memtable_insert_with_hint_
+// prefix_extractor) skip the descent from the root when the key falls in the
+// leaf of the previous insert.
+class BTreeRepFactory : public MemTableRepFactory {
+ public:
+  BTreeRepFactory() {}
+
+  // Methods for Configurable/Customizable class overrides
+  static const char* kClassName() { return "BTreeRepFactory"; }
+  static const char* kNickName() { return "btree"; }
+  const char* Name() const override { return kClassName(); }
+  const char* NickName() const override { return kNickName(); }
+
+  // Methods for MemTableRepFactory class overrides
+  using MemTableRepFactory::CreateMemTableRep;
+  MemTableRep* CreateMemTableRep(const MemTableRep::KeyComparator&, Allocator*,
+                                 const SliceTransform*,
+                                 Logger* logger) override;
+
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
+  bool CanHandleDuplicatedKey() const override { return true; }
+};
+
 // This class contains a fixed array of buckets, each
 // pointing to a skiplist (null if the bucket is empty).
 // bucket_count: number of fixed array buckets
@@ -61,7 +61,7 @@ class FileSystem;
 struct Options;
 struct DbPath;
 
-using FileTypeSet = SmallEnumSet<FileType, FileType::kBlobFile>;
+using FileTypeSet = SmallEnumSet<FileType, FileType::kWalStreamFile>;
 
 struct ColumnFamilyOptions : public AdvancedColumnFamilyOptions {
   // The function recovers options to a previous version. Only 4.6 or later
@@ -350,6 +350,22 @@ struct ColumnFamilyOptions : public AdvancedColumnFamilyOptions {
   // Dynamically changeable through SetOptions() API
   uint32_t memtable_max_range_deletions = 0;
 
+  // EXPERIMENTAL
+  // If non-zero, values of at least this many bytes are stored in a separate
+  // append-only arena of the memtable, and the memtable entry holds only a
+  // pointer to the value. This keeps the entries of the memtable
+  // representation (e.g. skip list nodes) small and close together when
+  // values are large, which makes memtable lookups, inserts and iteration
+  // more cache friendly. Memtable memory usage is not reduced by this. Values
+  // are still handed to flush without copying, e.g. straight to blob files
+  // with `enable_blob_files`. Ignored with `inplace_update_support`.
+  //
+  // Default: 0 (disabled)
+  //
+  // Dynamically changeable through SetOptions() API; applies to new
+  // memtables.
+  uint32_t memtable_value_separation_min_size = 0;
+
   // EXPERIMENTAL
   // When > 0, RocksDB attempts to erase some block cache entries for files
   // that have become obsolete, which means they are about to be deleted.
@@ -834,6 +850,22 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   uint32_t max_subcompactions = 1;
 
+  // EXPERIMENTAL
+  // If greater than 1, a compaction that is split into subcompactions cuts
+  // its key range into up to this many times more subcompactions than it has
+  // threads (see `max_subcompactions`). The threads take subcompactions from
+  // a shared queue, largest estimated input first, so that a thread whose
+  // range was cheaper than estimated picks up remaining work instead of
+  // idling until the slowest subcompaction finishes. Each subcompaction
+  // still covers at least about one target output file worth of input, and
+  // output files are cut at subcompaction boundaries.
+  //
+  // Has no effect with compaction_pri = kRoundRobin, which plans one
+  // subcompaction per input file.
+  //
+  // Default: 1
+  uint32_t subcompaction_ranges_per_thread = 1;
+
   // DEPRECATED: RocksDB automatically decides this based on the
   // value of max_background_jobs. For backwards compatibility we will set
   // `max_background_jobs = max_background_compactions + max_background_flushes`
@@ -1065,6 +1097,32 @@ struct DBOptions {
   // Dynamically changeable through SetDBOptions() API.
   size_t writable_file_max_buffer_size = 1024 * 1024;
 
+  // EXPERIMENTAL
+  // If >= 2, compaction output files are written with this many buffers of
+  // up to `writable_file_max_buffer_size` bytes each: while the compaction
+  // thread fills one buffer, full ones are written to the file by a
+  // background thread, so that compression and file writes overlap.
+  // Sync() and Close() of the file wait for all buffers to be written.
+  // Has no effect with `use_direct_io_for_flush_and_compaction`.
+  //
+  // Default: 0 (disabled)
+  size_t compaction_async_write_buffers = 0;
+
+  // EXPERIMENTAL
+  // If non-zero, each (sub)compaction reads, decompresses and merges its
+  // input files in a separate thread, which buffers up to about this many
+  // bytes of input entries ahead of the compaction thread. The compaction
+  // thread then only runs the compaction filter, merge operator and snapshot
+  // logic and builds the output files, so that a single compaction can use
+  // several cores even when it cannot be split into subcompactions. Combine
+  // with `CompressionOptions::parallel_threads` and
+  // `compaction_async_write_buffers` to also move compression and file
+  // writes off the compaction thread.
+  // Compactions whose input files contain range deletions are not pipelined.
+  //
+  // Default: 0 (disabled)
+  size_t compaction_pipelined_input_size = 0;
+
   // Use adaptive mutex, which spins in the user space before resorting
   // to kernel. This could reduce context switch when the mutex is not
   // heavily contended. However, if the mutex is hot, we could end up
@@ -1207,6 +1265,38 @@ struct DBOptions {
   // Default: true
   bool allow_concurrent_memtable_write = true;
 
+  // EXPERIMENTAL
+  // If true, the point entries of a write group (or, with
+  // allow_concurrent_memtable_write, of each writer's batch) are encoded into
+  // the memtable while the batch is processed but only linked into the
+  // memtable representation once the whole group is processed, after sorting
+  // them by key. Consecutive sorted inserts reuse the search path of the
+  // previous insert (see MemTableRep::InsertKeyWithHint), which reduces the
+  // cost of inserting large batches with many keys.
+  //
+  // Not used for column families with max_successive_merges > 0 or
+  // inplace_update_support, which need to read the memtable during the
+  // insert, nor with WritePrepared / WriteUnprepared transactions.
+  //
+  // Default: false
+  bool memtable_sorted_batch_insert = false;
+
+  // EXPERIMENTAL
+  // If true, the batches of a write group are written to the WAL as separate
+  // records instead of being merged into one by the group leader. The leader
+  // only reserves the byte range of each record in a shared log buffer, and
+  // the writers checksum and copy their own records into it in parallel
+  // before the leader appends the buffer to the WAL file. This reduces the
+  // time other writers wait on the leader with many concurrent writers and
+  // large batches. The WAL format is unchanged.
+  //
+  // Not used with enable_pipelined_write, unordered_write, two_write_queues,
+  // seq_per_batch (WritePrepared / WriteUnprepared transactions) or
+  // wal_compression.
+  //
+  // Default: false
+  bool parallel_wal_writes = false;
+
   // If true, threads synchronizing with the write batch group leader will
   // wait for up to write_thread_max_yield_usec before blocking on a mutex.
   // This can substantially improve throughput for concurrent workloads,
@@ -1333,6 +1423,28 @@ struct DBOptions {
   // memtable.
   bool two_write_queues = false;
 
+  // EXPERIMENTAL
+  // If true (requires two_write_queues), each write queue appends to its own
+  // WAL stream, so WAL writes of the two queues no longer serialize on a
+  // single log writer. The stream of the queue for writes that skip the
+  // memtable is a companion file that shares the number of the WAL it
+  // belongs to (e.g. 000012.log.1 next to 000012.log), and is created,
+  // synced and deleted together with it. Recovery merges the records of the
+  // streams back into sequence number order.
+  //
+  // Syncing the WAL syncs both streams, including the records of writes
+  // that got their sequence numbers before the synced ones, so the synced
+  // writes recover as a prefix of the writes in sequence number order. But
+  // the unsynced records of the two streams are persisted independently: if
+  // a crash loses those of one stream only, the recovered writes past the
+  // last sync may have a hole rather than only miss a suffix. Not supported
+  // with manual_wal_flush, WAL archival (WAL_ttl_seconds and
+  // WAL_size_limit_MB), GetUpdatesSince() and secondary instances.
+  // recycle_log_file_num is ignored.
+  //
+  // Default: false
+  bool wal_per_write_queue = false;
+
   // If true WAL is not flushed automatically after each write. Instead it
   // relies on manual invocation of FlushWAL to write the WAL buffer to its
   // file.
@@ -1731,6 +1843,22 @@ struct ReadOptions {
   // comes at the expense of slightly higher CPU overhead.
   bool optimize_multiget_for_io = true;
 
+  // EXPERIMENTAL
+  //
+  // If non-zero, MultiGet software-pipelines the lookups of a batch within a
+  // block-based table: while it probes the data block of the i-th key, it
+  // issues CPU cache prefetches for the parts of the data block of the
+  // (i + multiget_prefetch_distance)-th key that the lookup touches first
+  // (hash index bucket, restart array and restart key prefix index), and the
+  // index block restart array is prefetched before the index lookups. This
+  // overlaps CPU cache misses across the keys of a batch, which mostly helps
+  // workloads where the blocks are resident in the block cache but not in
+  // the CPU caches. Filter cache lines are already prefetched batch-wise.
+  //
+  // See PerfContext::multiget_prefetch_count and
+  // PerfContext::multiget_block_probe_nanos.
+  size_t multiget_prefetch_distance = 0;
+
   // *** END options relevant to point lookups (as well as scans) ***
   // *** BEGIN options only relevant to iterators or scans ***
 
@@ -275,6 +275,15 @@ struct PerfContextBase {
   uint64_t decrypt_data_nanos;
 
   uint64_t number_async_seek;
+
+  // EXPERIMENTAL
+  // Number of data and index blocks prefetched into CPU caches ahead of use
+  // by MultiGet (see ReadOptions::multiget_prefetch_distance)
+  uint64_t multiget_prefetch_count;
+  // Total nanos spent by MultiGet seeking within data blocks that were found
+  // in the block cache or read in the batch. This is where cache miss stalls
+  // saved by ReadOptions::multiget_prefetch_distance show up.
+  uint64_t multiget_block_probe_nanos;
 };
 
 struct PerfContext : public PerfContextBase {
@@ -529,6 +529,16 @@ enum Tickers : uint32_t {
   // Footer corruption detected when opening an SST file for reading
   SST_FOOTER_CORRUPTION_COUNT,
 
+  // Total time in microseconds writers spent in a write queue waiting to
+  // become a write group leader or for their write to be done by another
+  // writer.
+  WRITE_THREAD_WAIT_MICROS,
+  // Total time in microseconds spent writing write groups to the WAL,
+  // including the WAL sync requested by the group.
+  WRITE_WAL_MICROS,
+  // Total time in microseconds writers spent inserting into memtables.
+  WRITE_MEMTABLE_MICROS,
+
   TICKER_ENUM_MAX
 };
 
@@ -662,6 +672,14 @@ enum Histograms : uint32_t {
   // system's prefetch) from the end of SST table during block based table open
   TABLE_OPEN_PREFETCH_TAIL_READ_BYTES,
 
+  // Latency breakdown of DB_WRITE by write path stage. See the tickers
+  // WRITE_THREAD_WAIT_MICROS, WRITE_WAL_MICROS and WRITE_MEMTABLE_MICROS for
+  // what each stage covers. The sync and the write stall stages are covered
+  // by WAL_FILE_SYNC_MICROS and WRITE_STALL.
+  DB_WRITE_THREAD_WAIT_MICROS,
+  DB_WRITE_WAL_MICROS,
+  DB_WRITE_MEMTABLE_MICROS,
+
   HISTOGRAM_ENUM_MAX
 };
 
@@ -232,6 +232,20 @@ struct BlockBasedTableOptions {
     // Makes the index significantly bigger (2x or more), especially when keys
     // are long.
     kBinarySearchWithFirstKey = 0x03,
+
+    // EXPERIMENTAL
+    // Like kBinarySearch, but also stores a piecewise-linear model mapping
+    // the first 8 bytes of a user key to its position in the index block,
+    // with a bounded error. Seeks only binary search the few index entries
+    // within the model's error window, which saves key comparisons (and
+    // cache misses) on large index blocks when keys are close to uniformly
+    // or piecewise-uniformly distributed, e.g. fixed-width keys assigned in
+    // increasing order.
+    // The model is only built when the user comparator is
+    // BytewiseComparator() and user-defined timestamps are not used.
+    // Otherwise this is equivalent to kBinarySearch. Files written with this
+    // index type cannot be read by older versions of RocksDB.
+    kLearnedIndexSearch = 0x04,
   };
 
   IndexType index_type = kBinarySearch;
@@ -248,6 +262,22 @@ struct BlockBasedTableOptions {
   // kDataBlockBinaryAndHash.
   double data_block_hash_table_util_ratio = 0.75;
 
+  // EXPERIMENTAL
+  //
+  // If true, data blocks store a fixed-width 8-byte prefix of the user key at
+  // each restart point, which lets seeks within a data block narrow down the
+  // restart point binary search with a (SIMD-accelerated where available)
+  // integer search before comparing any full keys. This mostly helps point
+  // lookups and seeks on blocks with many restart points. It costs 8 bytes
+  // per restart point, and is only applied to blocks smaller than 64KiB.
+  //
+  // Only takes effect when the user comparator is BytewiseComparator() and
+  // user-defined timestamps are not in use; otherwise it is ignored.
+  //
+  // Files written with this option cannot be read by RocksDB versions that do
+  // not support it (they will fail with a Corruption status).
+  bool data_block_restart_key_prefix = false;
+
   // Option hash_index_allow_collision is now deleted.
   // It will behave as if hash_index_allow_collision=true.
 
@@ -288,6 +318,21 @@ struct BlockBasedTableOptions {
   // value will be silently overwritten with 1.
   int block_restart_interval = 16;
 
+  // EXPERIMENTAL
+  //
+  // If true, the restart points of data blocks are placed adaptively rather
+  // than every `block_restart_interval` keys, based on how many bytes each key
+  // shares with the previous key in the block. Restarting where keys share
+  // few bytes is cheap and shortens the linear scan of seeks within a block,
+  // while runs of keys sharing long prefixes are delta encoded over more keys
+  // for smaller blocks. Restart points are kept between
+  // max(1, block_restart_interval / 2) and block_restart_interval * 4 keys
+  // apart. Ignored if `use_delta_encoding` is false.
+  //
+  // Every block records its own restart points, so files written with this
+  // option remain readable by all RocksDB versions.
+  bool adaptive_block_restart_interval = false;
+
   // Same as block_restart_interval but used for the index block.
   int index_block_restart_interval = 1;
 
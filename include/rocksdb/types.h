@@ -53,7 +53,8 @@ enum FileType {
   kMetaDatabase,
   kIdentityFile,
   kOptionsFile,
-  kBlobFile
+  kBlobFile,
+  kWalStreamFile  // See DBOptions::wal_per_write_queue
 };
 
 // User-oriented representation of internal key types.
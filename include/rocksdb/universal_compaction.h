@@ -95,6 +95,26 @@ class CompactionOptionsUniversal {
   // Default: -1
   int max_read_amp;
 
+  // EXPERIMENTAL
+  // If at least 2, universal compaction does lazy leveling: all sorted runs
+  // but the oldest one are tiered, and the oldest one is leveled. The tiered
+  // runs are grouped by size into tiers, tier i holding runs of
+  // [write_buffer_size * N^i, write_buffer_size * N^(i+1)) bytes, where N is
+  // this option. Once a tier has N consecutive runs, they are merged into
+  // one run, which belongs to a higher tier. `size_ratio`, `max_read_amp`,
+  // `min_merge_width` and `max_merge_width` are not used then.
+  // The tiered runs are merged into the oldest run when their total size
+  // reaches `max_size_amplification_percent` of it, in parts of up to
+  // `max_compaction_bytes` when `incremental` is set. Space amplification is
+  // thus bounded like with leveling while writes are mostly tiered.
+  // `level0_file_num_compaction_trigger` still needs to be reached before
+  // compactions are picked, so it must be at most this option, and
+  // `level0_slowdown_writes_trigger` must be larger than this option plus 1.
+  // When no tier is full but one more sorted run would slow down writes, the
+  // tier with the most runs is merged early.
+  // Default: 0 (disabled)
+  unsigned int max_runs_per_tier;
+
   // The algorithm used to stop picking files into a single compaction run
   // Default: kCompactionStopStyleTotalSize
   CompactionStopStyle stop_style;
@@ -119,6 +139,7 @@ class CompactionOptionsUniversal {
         max_size_amplification_percent(200),
         compression_size_percent(-1),
         max_read_amp(-1),
+        max_runs_per_tier(0),
         stop_style(kCompactionStopStyleTotalSize),
         allow_trivial_move(false),
         incremental(false) {}
@@ -0,0 +1,108 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/options.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// NOTE: the classes and functions in this header are EXPERIMENTAL and may
+// change in the future.
+//
+// LocalCompactionService is a reference CompactionService. It runs the
+// scheduled jobs with DB::OpenAndCompact() on its own pool of worker
+// threads, or in worker processes those threads start, each job writing to
+// its own directory, exactly like a remote compaction worker would. The
+// DB's background compaction threads only wait for the results and install
+// them. It also serves as an example for wiring up a real remote
+// CompactionService: only the transport of the serialized job input and
+// result differs.
+
+struct LocalCompactionServiceOptions {
+  // The number of worker threads running jobs. Jobs scheduled while all of
+  // them are busy wait in a queue, in the order they were scheduled.
+  int num_workers = 1;
+
+  // The directory under which every job gets its own output directory. It
+  // must be on the same file system as the DB, since the DB renames the
+  // output files into place, and must not be inside the DB directory. If
+  // empty, "<db_name>_compaction_service" is used.
+  std::string output_root;
+
+  // The number of times a failed job is run again before its failure is
+  // reported. Canceled jobs are not retried.
+  int max_retries = 0;
+
+  // If true, a job that is canceled or that still fails after `max_retries`
+  // retries makes the DB run the compaction itself. Otherwise the DB's
+  // compaction fails, which with `paranoid_checks` stops further writes.
+  bool fallback_to_local = true;
+
+  // If not empty, every worker thread hands its jobs to a worker process
+  // instead of running them itself, so that a crashing or memory hungry
+  // compaction does not take the DB down. The process is started with this
+  // program and arguments, plus the number of the file descriptor of a Unix
+  // socket as last argument. It must call RunLocalCompactionServiceWorker()
+  // with it, like tools/compaction_service_worker does. A worker process
+  // that exits is started again for the next job, and the job it was running
+  // fails like any other failed job. `options_override` is not used for the
+  // jobs then, only the worker's own. Not supported on Windows.
+  std::vector<std::string> worker_command;
+
+  // If not null, the service logs problems it does not report otherwise, like
+  // job directories it could not remove. Must outlive the service.
+  Logger* info_log = nullptr;
+
+  // The options that are not part of the serialized job input. They should
+  // be the same as those of the DB. The `env` is also used to manage the
+  // output directories, until the service is destroyed.
+  CompactionServiceOptionsOverride options_override;
+};
+
+struct LocalCompactionServiceStats {
+  uint64_t num_succeeded = 0;
+  // Jobs that failed after all retries. Does not include canceled jobs.
+  uint64_t num_failed = 0;
+  uint64_t num_canceled = 0;
+  uint64_t num_retries = 0;
+};
+
+class LocalCompactionService : public CompactionService {
+ public:
+  static const char* kClassName() { return "LocalCompactionService"; }
+  const char* Name() const override { return kClassName(); }
+
+  // Cancels a scheduled job. A queued job does not run anymore, a running one
+  // is interrupted. Waiting for the job then returns like a failed job that
+  // is not retried.
+  virtual void Cancel(const std::string& scheduled_job_id) = 0;
+
+  // Cancels all jobs scheduled so far, like Cancel(). Jobs scheduled
+  // afterwards run as usual.
+  virtual void CancelAllJobs() = 0;
+
+  virtual LocalCompactionServiceStats GetStats() const = 0;
+};
+
+// Creates a LocalCompactionService and starts its worker threads. They are
+// stopped when the returned object is destroyed, which cancels pending jobs.
+std::shared_ptr<LocalCompactionService> NewLocalCompactionService(
+    const LocalCompactionServiceOptions& options);
+
+// Runs the jobs a LocalCompactionService sends over the socket `fd` to a
+// worker process started from `worker_command`, with DB::OpenAndCompact()
+// and `options_override`, until the service closes the socket. Returns OK
+// then, or the error that broke the connection.
+Status RunLocalCompactionServiceWorker(
+    int fd, const CompactionServiceOptionsOverride& options_override);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -271,6 +271,14 @@ class StackableDB : public DB {
     return db_->NewIterators(options, column_families, iterators);
   }
 
+  Status MultiScan(
+      const ReadOptions& options, ColumnFamilyHandle* column_family,
+      const std::vector<ScanRange>& ranges,
+      const std::function<bool(size_t, const Slice&, const Slice&)>& callback)
+      override {
+    return db_->MultiScan(options, column_family, ranges, callback);
+  }
+
   using DB::NewCoalescingIterator;
   std::unique_ptr<Iterator> NewCoalescingIterator(
       const ReadOptions& options,
@@ -4761,6 +4761,8 @@ class CompactionPriorityJni {
         return 0x3;
       case ROCKSDB_NAMESPACE::CompactionPri::kRoundRobin:
         return 0x4;
+      case ROCKSDB_NAMESPACE::CompactionPri::kReadWeightedOverlappingRatio:
+        return 0x5;
       default:
         return 0x0;  // undefined
     }
@@ -4781,6 +4783,9 @@ class CompactionPriorityJni {
         return ROCKSDB_NAMESPACE::CompactionPri::kMinOverlappingRatio;
       case 0x4:
         return ROCKSDB_NAMESPACE::CompactionPri::kRoundRobin;
+      case 0x5:
+        return ROCKSDB_NAMESPACE::CompactionPri::
+            kReadWeightedOverlappingRatio;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::CompactionPri::kByCompensatedSize;
@@ -5269,6 +5274,12 @@ class TickerTypeJni {
         return -0x53;
       case ROCKSDB_NAMESPACE::Tickers::SST_FOOTER_CORRUPTION_COUNT:
         return -0x55;
+      case ROCKSDB_NAMESPACE::Tickers::WRITE_THREAD_WAIT_MICROS:
+        return -0x56;
+      case ROCKSDB_NAMESPACE::Tickers::WRITE_WAL_MICROS:
+        return -0x57;
+      case ROCKSDB_NAMESPACE::Tickers::WRITE_MEMTABLE_MICROS:
+        return -0x58;
       case ROCKSDB_NAMESPACE::Tickers::TICKER_ENUM_MAX:
         // -0x54 is the max value at this time. Since these values are exposed
         // directly to Java clients, we'll keep the value the same till the next
@@ -5726,6 +5737,12 @@ class TickerTypeJni {
         return ROCKSDB_NAMESPACE::Tickers::PREFETCH_HITS;
       case -0x55:
         return ROCKSDB_NAMESPACE::Tickers::SST_FOOTER_CORRUPTION_COUNT;
+      case -0x56:
+        return ROCKSDB_NAMESPACE::Tickers::WRITE_THREAD_WAIT_MICROS;
+      case -0x57:
+        return ROCKSDB_NAMESPACE::Tickers::WRITE_WAL_MICROS;
+      case -0x58:
+        return ROCKSDB_NAMESPACE::Tickers::WRITE_MEMTABLE_MICROS;
       case -0x54:
         // -0x54 is the max value at this time. Since these values are exposed
         // directly to Java clients, we'll keep the value the same till the next
@@ -5880,6 +5897,12 @@ class HistogramTypeJni {
         return 0x3C;
       case ROCKSDB_NAMESPACE::Histograms::TABLE_OPEN_PREFETCH_TAIL_READ_BYTES:
         return 0x3D;
+      case ROCKSDB_NAMESPACE::Histograms::DB_WRITE_THREAD_WAIT_MICROS:
+        return 0x3F;
+      case ROCKSDB_NAMESPACE::Histograms::DB_WRITE_WAL_MICROS:
+        return 0x40;
+      case ROCKSDB_NAMESPACE::Histograms::DB_WRITE_MEMTABLE_MICROS:
+        return 0x41;
       case ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX:
         // 0x3D for backwards compatibility on current minor version.
         return 0x3E;
@@ -6024,6 +6047,12 @@ class HistogramTypeJni {
       case 0x3D:
         return ROCKSDB_NAMESPACE::Histograms::
             TABLE_OPEN_PREFETCH_TAIL_READ_BYTES;
+      case 0x3F:
+        return ROCKSDB_NAMESPACE::Histograms::DB_WRITE_THREAD_WAIT_MICROS;
+      case 0x40:
+        return ROCKSDB_NAMESPACE::Histograms::DB_WRITE_WAL_MICROS;
+      case 0x41:
+        return ROCKSDB_NAMESPACE::Histograms::DB_WRITE_MEMTABLE_MICROS;
       case 0x3E:
         // 0x1F for backwards compatibility on current minor version.
         return ROCKSDB_NAMESPACE::Histograms::HISTOGRAM_ENUM_MAX;
@@ -6855,6 +6884,9 @@ class IndexTypeJni {
       case ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
           kBinarySearchWithFirstKey:
         return 0x3;
+      case ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
+          kLearnedIndexSearch:
+        return 0x4;
       default:
         return 0x7F;  // undefined
     }
@@ -6877,6 +6909,9 @@ class IndexTypeJni {
       case 0x3:
         return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
             kBinarySearchWithFirstKey;
+      case 0x4:
+        return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
+            kLearnedIndexSearch;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
@@ -7452,6 +7487,8 @@ class CompactionReasonJni {
         return 0x12;
       case ROCKSDB_NAMESPACE::CompactionReason::kRefitLevel:
         return 0x13;
+      case ROCKSDB_NAMESPACE::CompactionReason::kUniversalRunsPerTier:
+        return 0x14;
       default:
         return 0x7F;  // undefined
     }
@@ -7502,6 +7539,8 @@ class CompactionReasonJni {
         return ROCKSDB_NAMESPACE::CompactionReason::kRoundRobinTtl;
       case 0x13:
         return ROCKSDB_NAMESPACE::CompactionReason::kRefitLevel;
+      case 0x14:
+        return ROCKSDB_NAMESPACE::CompactionReason::kUniversalRunsPerTier;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::CompactionReason::kUnknown;
@@ -41,7 +41,14 @@ public enum CompactionPriority {
    * level. The file picking process will cycle through all the files in a
    * round-robin manner.
    */
-  RoundRobin((byte)0x4);
+  RoundRobin((byte)0x4),
+
+  /**
+   * Like {@link #MinOverlappingRatio}, but files that are read more often
+   * than the other files of their level are compacted earlier. Uses the
+   * sampled reads of each file. EXPERIMENTAL.
+   */
+  ReadWeightedOverlappingRatio((byte)0x5);
 
 
   private final byte value;
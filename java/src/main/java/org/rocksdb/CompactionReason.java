@@ -104,7 +104,13 @@ public enum CompactionReason {
   /**
    * Compaction by calling DBImpl::ReFitLevel
    */
-  kRefitLevel((byte) 0x13);
+  kRefitLevel((byte) 0x13),
+
+  /**
+   * [Universal] a tier holds CompactionOptionsUniversal::max_runs_per_tier
+   * sorted runs, or merging runs of a tier avoids a write slowdown
+   */
+  kUniversalRunsPerTier((byte) 0x14);
 
   private final byte value;
 
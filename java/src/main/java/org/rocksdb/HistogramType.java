@@ -210,6 +210,23 @@ public enum HistogramType {
    */
   TABLE_OPEN_PREFETCH_TAIL_READ_BYTES((byte) 0x3D),
 
+  /**
+   * Time writers spent in a write queue waiting to become a write group
+   * leader or for their write to be done by another writer.
+   */
+  DB_WRITE_THREAD_WAIT_MICROS((byte) 0x3F),
+
+  /**
+   * Time spent writing a write group to the WAL, including the WAL sync
+   * requested by the group.
+   */
+  DB_WRITE_WAL_MICROS((byte) 0x40),
+
+  /**
+   * Time a writer spent inserting into memtables.
+   */
+  DB_WRITE_MEMTABLE_MICROS((byte) 0x41),
+
   // 0x3E for backwards compatibility on current minor version.
   HISTOGRAM_ENUM_MAX((byte) 0x3E);
 
@@ -36,7 +36,14 @@ public enum IndexType {
    * Makes the index significantly bigger (2x or more), especially when keys
    * are long.
    */
-  kBinarySearchWithFirstKey((byte) 3);
+  kBinarySearchWithFirstKey((byte) 3),
+  /**
+   * EXPERIMENTAL. Like {@link #kBinarySearch}, but also stores a
+   * piecewise-linear model of the key distribution, used to narrow down the
+   * binary search over the index block. Only effective with the bytewise
+   * comparator and without user-defined timestamps.
+   */
+  kLearnedIndexSearch((byte) 4);
 
   /**
    * Returns the byte value of the enumerations value
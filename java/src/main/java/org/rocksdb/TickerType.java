@@ -878,6 +878,24 @@ public enum TickerType {
 
     SST_FOOTER_CORRUPTION_COUNT((byte) -0x55),
 
+    /**
+     * Total time in microseconds writers spent in a write queue waiting to
+     * become a write group leader or for their write to be done by another
+     * writer.
+     */
+    WRITE_THREAD_WAIT_MICROS((byte) -0x56),
+
+    /**
+     * Total time in microseconds spent writing write groups to the WAL,
+     * including the WAL sync requested by the group.
+     */
+    WRITE_WAL_MICROS((byte) -0x57),
+
+    /**
+     * Total time in microseconds writers spent inserting into memtables.
+     */
+    WRITE_MEMTABLE_MICROS((byte) -0x58),
+
     TICKER_ENUM_MAX((byte) -0x54);
 
     private final byte value;
@@ -33,8 +33,11 @@ size_t Arena::OptimizeBlockSize(size_t block_size) {
   return block_size;
 }
 
-Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size)
-    : kBlockSize(OptimizeBlockSize(block_size)), tracker_(tracker) {
+Arena::Arena(size_t block_size, AllocTracker* tracker, size_t huge_page_size,
+             int numa_node)
+    : kBlockSize(OptimizeBlockSize(block_size)),
+      numa_node_(numa_node),
+      tracker_(tracker) {
   assert(kBlockSize >= kMinBlockSize && kBlockSize <= kMaxBlockSize &&
          kBlockSize % kAlignUnit == 0);
   TEST_SYNC_POINT_CALLBACK("Arena::Arena:0", const_cast<size_t*>(&kBlockSize));
@@ -93,7 +96,11 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
 }
 
 char* Arena::AllocateFromHugePage(size_t bytes) {
-  MemMapping mm = MemMapping::AllocateHuge(bytes);
+  return AllocateMapped(bytes, /*huge*/ true);
+}
+
+char* Arena::AllocateMapped(size_t bytes, bool huge) {
+  MemMapping mm = MemMapping::AllocateOnNumaNode(bytes, huge, numa_node_);
   auto addr = static_cast<char*>(mm.Get());
   if (addr) {
     huge_blocks_.push_back(std::move(mm));
@@ -143,6 +150,14 @@ char* Arena::AllocateAligned(size_t bytes, size_t huge_page_size,
 }
 
 char* Arena::AllocateNewBlock(size_t block_bytes) {
+  if (numa_node_ >= 0) {
+    char* block = AllocateMapped(block_bytes, /*huge*/ false);
+    if (block != nullptr) {
+      return block;
+    }
+    // fall back to malloc
+  }
+
   // NOTE: std::make_unique zero-initializes the block so is not appropriate
   // here
   char* block = new char[block_bytes];
@@ -39,8 +39,12 @@ class Arena : public Allocator {
   // huge_page_size: if 0, don't use huge page TLB. If > 0 (should set to the
   // supported hugepage size of the system), block allocation will try huge
   // page TLB first. If allocation fails, will fall back to normal case.
+  // numa_node: if >= 0, blocks are mmap-ed and the kernel is asked to prefer
+  // pages from that NUMA node (see MemMapping::AllocateOnNumaNode). If the
+  // mapping fails, will fall back to malloc.
   explicit Arena(size_t block_size = kMinBlockSize,
-                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0);
+                 AllocTracker* tracker = nullptr, size_t huge_page_size = 0,
+                 int numa_node = -1);
   ~Arena();
 
   char* Allocate(size_t bytes) override;
@@ -93,7 +97,7 @@ class Arena : public Allocator {
   const size_t kBlockSize;
   // Allocated memory blocks
   std::deque<std::unique_ptr<char[]>> blocks_;
-  // Huge page allocations
+  // Huge page and NUMA node bound allocations
   std::deque<MemMapping> huge_blocks_;
   size_t irregular_block_num = 0;
 
@@ -109,7 +113,10 @@ class Arena : public Allocator {
 
   size_t hugetlb_size_ = 0;
 
+  const int numa_node_;
+
   char* AllocateFromHugePage(size_t bytes);
+  char* AllocateMapped(size_t bytes, bool huge);
   char* AllocateFallback(size_t bytes, bool aligned);
   char* AllocateNewBlock(size_t block_bytes);
 
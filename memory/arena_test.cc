@@ -12,8 +12,10 @@
 #ifndef OS_WIN
 #include <sys/resource.h>
 #endif
+#include "memory/concurrent_arena.h"
 #include "port/jemalloc_helper.h"
 #include "port/port.h"
+#include "test_util/sync_point.h"
 #include "test_util/testharness.h"
 #include "util/random.h"
 
@@ -308,6 +310,84 @@ TEST_F(ArenaTest, UnmappedAllocation) {
   }
 }
 
+TEST_F(ArenaTest, NumaNode) {
+  // Node 0 always exists; the placement itself is best effort.
+  constexpr size_t kBlockSize = 64 << 10;
+  Arena arena(kBlockSize, nullptr, 0, /*numa_node*/ 0);
+  size_t bytes = 0;
+  for (size_t size : {size_t{1000}, kBlockSize, size_t{100}, size_t{10000}}) {
+    char* p = arena.AllocateAligned(size);
+    memset(p, 0xa5, size);
+    bytes += size;
+  }
+  ASSERT_GE(arena.MemoryAllocatedBytes(), bytes);
+  ASSERT_GE(arena.ApproximateMemoryUsage(), bytes);
+  ASSERT_EQ(arena.IrregularBlockNum(), 1U);
+}
+
+TEST_F(ArenaTest, ConcurrentArenaNumaAware) {
+  constexpr size_t kBlockSize = 64 << 10;
+  {
+    ConcurrentArena arena(kBlockSize, nullptr, 0, /*numa_aware*/ true);
+    ASSERT_EQ(arena.IsNumaAware(), port::NumaNodeCount() > 1);
+  }
+  {
+    ConcurrentArena arena(kBlockSize, nullptr, 0, /*numa_aware*/ false);
+    ASSERT_FALSE(arena.IsNumaAware());
+  }
+}
+
+#ifndef NDEBUG
+TEST_F(ArenaTest, ConcurrentArenaSimulatedNumaNodes) {
+  // Simulate two NUMA nodes, with the even cores on node 0 and the odd cores
+  // on node 1.
+  SyncPoint::GetInstance()->SetCallBack(
+      "ConcurrentArena::ConcurrentArena:NumaNodes",
+      [](void* arg) { *static_cast<int*>(arg) = 2; });
+  SyncPoint::GetInstance()->SetCallBack(
+      "ConcurrentArena::GetNodeArena:NumaNodeOfCpu", [](void* arg) {
+        auto* cpu_and_node = static_cast<std::pair<int*, int*>*>(arg);
+        *cpu_and_node->second = *cpu_and_node->first % 2;
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  constexpr size_t kBlockSize = 64 << 10;
+  constexpr size_t kAllocSize = 100;
+  constexpr int kAllocsPerCore = 200;
+  ConcurrentArena arena(kBlockSize, nullptr, 0, /*numa_aware*/ true);
+  ASSERT_TRUE(arena.IsNumaAware());
+  ASSERT_EQ(arena.TEST_NumaNodeMemoryAllocatedBytes(0), 0U);
+  ASSERT_EQ(arena.TEST_NumaNodeMemoryAllocatedBytes(1), 0U);
+
+  std::vector<std::pair<char*, char>> allocs;
+  for (size_t core : {0, 1, 2}) {
+    arena.TEST_PickShard(core);
+    for (int i = 0; i < kAllocsPerCore; ++i) {
+      char* p = arena.Allocate(kAllocSize);
+      char fill = static_cast<char>(allocs.size());
+      memset(p, fill, kAllocSize);
+      allocs.emplace_back(p, fill);
+    }
+  }
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Each node arena allocated a whole block to carve the shard blocks from
+  ASSERT_GE(arena.TEST_NumaNodeMemoryAllocatedBytes(0), kBlockSize);
+  ASSERT_GE(arena.TEST_NumaNodeMemoryAllocatedBytes(1), kBlockSize);
+  ASSERT_GE(arena.MemoryAllocatedBytes(),
+            arena.TEST_NumaNodeMemoryAllocatedBytes(0) +
+                arena.TEST_NumaNodeMemoryAllocatedBytes(1));
+  ASSERT_GE(arena.ApproximateMemoryUsage(), allocs.size() * kAllocSize);
+  ASSERT_LT(arena.ApproximateMemoryUsage(), arena.MemoryAllocatedBytes());
+  for (const auto& alloc : allocs) {
+    for (size_t i = 0; i < kAllocSize; ++i) {
+      ASSERT_EQ(alloc.first[i], alloc.second);
+    }
+  }
+}
+#endif  // !NDEBUG
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
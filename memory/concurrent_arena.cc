@@ -12,6 +12,7 @@
 #include <thread>
 
 #include "port/port.h"
+#include "test_util/sync_point.h"
 #include "util/random.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -27,13 +28,32 @@ const size_t kMaxShardBlockSize = size_t{128 * 1024};
 }  // namespace
 
 ConcurrentArena::ConcurrentArena(size_t block_size, AllocTracker* tracker,
-                                 size_t huge_page_size)
+                                 size_t huge_page_size, bool numa_aware)
     : shard_block_size_(std::min(kMaxShardBlockSize, block_size / 8)),
       shards_(),
+      num_numa_nodes_(0),
+      huge_page_size_(huge_page_size),
+      tracker_(tracker),
       arena_(block_size, tracker, huge_page_size) {
+  if (numa_aware) {
+    int num_nodes = port::NumaNodeCount();
+    // Allows tests to simulate several nodes on a single-node system.
+    TEST_SYNC_POINT_CALLBACK("ConcurrentArena::ConcurrentArena:NumaNodes",
+                             &num_nodes);
+    if (num_nodes > 1) {
+      num_numa_nodes_ = num_nodes;
+      node_arenas_.reset(new std::atomic<NodeArena*>[num_nodes]());
+    }
+  }
   Fixup();
 }
 
+ConcurrentArena::~ConcurrentArena() {
+  for (int i = 0; i < num_numa_nodes_; ++i) {
+    delete node_arenas_[i].load(std::memory_order_relaxed);
+  }
+}
+
 ConcurrentArena::Shard* ConcurrentArena::Repick() {
   auto shard_and_index = shards_.AccessElementAndIndex();
   // even if we are cpu 0, use a non-zero tls_cpuid so we can tell we
@@ -42,4 +62,66 @@ ConcurrentArena::Shard* ConcurrentArena::Repick() {
   return shard_and_index.first;
 }
 
+ConcurrentArena::NodeArena* ConcurrentArena::GetNodeArena(Shard* s) {
+  if (s->numa_node_ < 0) {
+    int cpu = static_cast<int>(s - shards_.AccessAtCore(0));
+    int node = port::NumaNodeOfCpu(cpu);
+#ifndef NDEBUG
+    std::pair<int*, int*> cpu_and_node(&cpu, &node);
+    TEST_SYNC_POINT_CALLBACK("ConcurrentArena::GetNodeArena:NumaNodeOfCpu",
+                             &cpu_and_node);
+#endif  // NDEBUG
+    s->numa_node_ = node >= 0 && node < num_numa_nodes_ ? node : 0;
+  }
+  NodeArena* node_arena =
+      node_arenas_[s->numa_node_].load(std::memory_order_relaxed);
+  if (node_arena == nullptr) {
+    // Node arenas use the same block size as the main arena, so that their
+    // blocks are carved into shard blocks without waste.
+    node_arena = new NodeArena(arena_.BlockSize(), tracker_, huge_page_size_,
+                               s->numa_node_);
+    node_arenas_[s->numa_node_].store(node_arena, std::memory_order_release);
+  }
+  return node_arena;
+}
+
+char* ConcurrentArena::AllocateShardBlockOnNode(NodeArena* node_arena,
+                                                size_t* avail) {
+  std::lock_guard<SpinMutex> lock(node_arena->mutex);
+  // As for the main arena, adjust the request to use up the current block
+  // if it is within a factor of 2 of the right size.
+  size_t exact = node_arena->arena.AllocatedAndUnused();
+  *avail = exact >= shard_block_size_ / 2 && exact < shard_block_size_ * 2
+               ? exact
+               : shard_block_size_;
+  char* rv = node_arena->arena.AllocateAligned(*avail);
+  node_arena->allocated_and_unused.store(node_arena->arena.AllocatedAndUnused(),
+                                         std::memory_order_relaxed);
+  node_arena->memory_allocated_bytes.store(
+      node_arena->arena.MemoryAllocatedBytes(), std::memory_order_relaxed);
+  return rv;
+}
+
+size_t ConcurrentArena::NodeApproximateMemoryUsage() const {
+  size_t total = 0;
+  for (int i = 0; i < num_numa_nodes_; ++i) {
+    NodeArena* n = node_arenas_[i].load(std::memory_order_acquire);
+    if (n != nullptr) {
+      std::lock_guard<SpinMutex> lock(n->mutex);
+      total += n->arena.ApproximateMemoryUsage();
+    }
+  }
+  return total;
+}
+
+size_t ConcurrentArena::TEST_NumaNodeMemoryAllocatedBytes(int node) const {
+  if (node < 0 || node >= num_numa_nodes_) {
+    return 0;
+  }
+  NodeArena* n = node_arenas_[node].load(std::memory_order_acquire);
+  return n == nullptr
+             ? 0
+             : n->memory_allocated_bytes.load(std::memory_order_relaxed);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -39,15 +39,22 @@ class Logger;
 // only if ConcurrentArena actually notices concurrent use, and they
 // adjust their size so that there is no fragmentation waste when the
 // shard blocks are allocated from the underlying main arena.
+//
+// In NUMA-aware mode, the shard blocks are instead allocated from one
+// additional arena per NUMA node, whose blocks are bound to that node, so
+// that each core allocates (and later reads) node-local memory.
 class ConcurrentArena : public Allocator {
  public:
   // block_size and huge_page_size are the same as for Arena (and are
   // in fact just passed to the constructor of arena_.  The core-local
   // shards compute their shard_block_size as a fraction of block_size
   // that varies according to the hardware concurrency level.
+  // numa_aware enables the NUMA-aware mode described above. It has no
+  // effect on single-node systems or without NUMA support (see WITH_NUMA).
   explicit ConcurrentArena(size_t block_size = Arena::kMinBlockSize,
                            AllocTracker* tracker = nullptr,
-                           size_t huge_page_size = 0);
+                           size_t huge_page_size = 0, bool numa_aware = false);
+  ~ConcurrentArena();
 
   char* Allocate(size_t bytes) override {
     return AllocateImpl(bytes, false /*force_arena*/,
@@ -70,16 +77,18 @@ class ConcurrentArena : public Allocator {
   size_t ApproximateMemoryUsage() const {
     std::unique_lock<SpinMutex> lock(arena_mutex_, std::defer_lock);
     lock.lock();
-    return arena_.ApproximateMemoryUsage() - ShardAllocatedAndUnused();
+    return arena_.ApproximateMemoryUsage() + NodeApproximateMemoryUsage() -
+           ShardAllocatedAndUnused();
   }
 
   size_t MemoryAllocatedBytes() const {
-    return memory_allocated_bytes_.load(std::memory_order_relaxed);
+    return memory_allocated_bytes_.load(std::memory_order_relaxed) +
+           NodeMemoryAllocatedBytes();
   }
 
   size_t AllocatedAndUnused() const {
     return arena_allocated_and_unused_.load(std::memory_order_relaxed) +
-           ShardAllocatedAndUnused();
+           NodeAllocatedAndUnused() + ShardAllocatedAndUnused();
   }
 
   size_t IrregularBlockNum() const {
@@ -88,14 +97,41 @@ class ConcurrentArena : public Allocator {
 
   size_t BlockSize() const override { return arena_.BlockSize(); }
 
+  bool IsNumaAware() const { return num_numa_nodes_ > 0; }
+
+  // Makes the calling thread allocate from the shard of the given core, as
+  // if it had been repicked there.
+  void TEST_PickShard(size_t core_idx) {
+    tls_cpuid = (core_idx & (shards_.Size() - 1)) | shards_.Size();
+  }
+
+  // Memory allocated by the arena of the given NUMA node.
+  size_t TEST_NumaNodeMemoryAllocatedBytes(int node) const;
+
  private:
   struct Shard {
-    char padding[40] ROCKSDB_FIELD_UNUSED;
+    char padding[36] ROCKSDB_FIELD_UNUSED;
+    // NUMA node of the core owning this shard, -1 until first needed.
+    int numa_node_;
     mutable SpinMutex mutex;
     char* free_begin_;
     std::atomic<size_t> allocated_and_unused_;
 
-    Shard() : free_begin_(nullptr), allocated_and_unused_(0) {}
+    Shard() : numa_node_(-1), free_begin_(nullptr), allocated_and_unused_(0) {}
+  };
+
+  // Source of shard blocks for the cores of one NUMA node.
+  struct NodeArena {
+    NodeArena(size_t block_size, AllocTracker* tracker, size_t huge_page_size,
+              int node)
+        : arena(block_size, tracker, huge_page_size, node),
+          allocated_and_unused(0),
+          memory_allocated_bytes(0) {}
+
+    mutable SpinMutex mutex;
+    Arena arena;
+    std::atomic<size_t> allocated_and_unused;
+    std::atomic<size_t> memory_allocated_bytes;
   };
 
   static thread_local size_t tls_cpuid;
@@ -106,6 +142,13 @@ class ConcurrentArena : public Allocator {
 
   CoreLocalArray<Shard> shards_;
 
+  // Number of NUMA nodes, or 0 if not NUMA-aware. The node arenas are
+  // created lazily, under arena_mutex_, by the first shard needing them.
+  int num_numa_nodes_;
+  std::unique_ptr<std::atomic<NodeArena*>[]> node_arenas_;
+  size_t huge_page_size_;
+  AllocTracker* tracker_;
+
   Arena arena_;
   mutable SpinMutex arena_mutex_;
   std::atomic<size_t> arena_allocated_and_unused_;
@@ -116,6 +159,37 @@ class ConcurrentArena : public Allocator {
 
   Shard* Repick();
 
+  // REQUIRES: arena_mutex_ held
+  NodeArena* GetNodeArena(Shard* s);
+
+  // Allocates a new block of about shard_block_size_ for s from the arena of
+  // its NUMA node, returning its size in *avail.
+  char* AllocateShardBlockOnNode(NodeArena* node_arena, size_t* avail);
+
+  size_t NodeApproximateMemoryUsage() const;
+
+  size_t NodeMemoryAllocatedBytes() const {
+    size_t total = 0;
+    for (int i = 0; i < num_numa_nodes_; ++i) {
+      NodeArena* n = node_arenas_[i].load(std::memory_order_acquire);
+      if (n != nullptr) {
+        total += n->memory_allocated_bytes.load(std::memory_order_relaxed);
+      }
+    }
+    return total;
+  }
+
+  size_t NodeAllocatedAndUnused() const {
+    size_t total = 0;
+    for (int i = 0; i < num_numa_nodes_; ++i) {
+      NodeArena* n = node_arenas_[i].load(std::memory_order_acquire);
+      if (n != nullptr) {
+        total += n->allocated_and_unused.load(std::memory_order_relaxed);
+      }
+    }
+    return total;
+  }
+
   size_t ShardAllocatedAndUnused() const {
     size_t total = 0;
     for (size_t i = 0; i < shards_.Size(); ++i) {
@@ -158,7 +232,7 @@ class ConcurrentArena : public Allocator {
     size_t avail = s->allocated_and_unused_.load(std::memory_order_relaxed);
     if (avail < bytes) {
       // reload
-      std::lock_guard<SpinMutex> reload_lock(arena_mutex_);
+      std::unique_lock<SpinMutex> reload_lock(arena_mutex_);
 
       // If the arena's current block is within a factor of 2 of the right
       // size, we adjust our request to avoid arena waste.
@@ -179,11 +253,17 @@ class ConcurrentArena : public Allocator {
         return rv;
       }
 
-      avail = exact >= shard_block_size_ / 2 && exact < shard_block_size_ * 2
-                  ? exact
-                  : shard_block_size_;
-      s->free_begin_ = arena_.AllocateAligned(avail);
-      Fixup();
+      if (IsNumaAware()) {
+        NodeArena* node_arena = GetNodeArena(s);
+        reload_lock.unlock();
+        s->free_begin_ = AllocateShardBlockOnNode(node_arena, &avail);
+      } else {
+        avail = exact >= shard_block_size_ / 2 && exact < shard_block_size_ * 2
+                    ? exact
+                    : shard_block_size_;
+        s->free_begin_ = arena_.AllocateAligned(avail);
+        Fixup();
+      }
     }
     s->allocated_and_unused_.store(avail - bytes, std::memory_order_relaxed);
 
@@ -0,0 +1,690 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// A memtable representation backed by a B+-tree, in the spirit of
+// "The ART of Practical Synchronization" (Leis et al.), which synchronizes
+// with optimistic lock coupling (OLC):
+//
+// - Every node has a version lock. Writers lock the nodes they modify (at most
+//   a node and its parent, for a split); readers never write to shared memory
+//   and instead validate that the version of each node they read did not
+//   change, restarting from the root otherwise.
+// - Full inner nodes are split eagerly on the way down, so a split of a child
+//   always finds room in its parent.
+// - Nodes are allocated from the memtable arena and never freed (entries are
+//   never removed from a memtable), so readers can safely dereference stale
+//   pointers before validating them.
+//
+// Compared to the skip list, a lookup touches O(log_32(n)) nodes whose key
+// pointers are contiguous in memory, instead of O(log(n)) scattered nodes.
+// Each leaf remembers its key range ("fences"), which lets iterators move to
+// the neighboring leaves without sibling pointers, and lets writers with an
+// insert hint append to the leaf of the previous insert without a descent
+// from the root.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+#include "db/memtable.h"
+#include "memory/arena.h"
+#include "port/port.h"
+#include "rocksdb/memtablerep.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+
+// Maximum number of keys in a leaf, and of children of an inner node. With
+// 8-byte key pointers, a node spans a handful of cache lines and is searched
+// with ~5 key comparisons.
+constexpr uint32_t kLeafCapacity = 32;
+constexpr uint32_t kInnerCapacity = 32;
+
+// The version of a node is odd while the node is write locked, and is bumped
+// by two by every modification.
+class VersionLock {
+ public:
+  // Returns false if the node is write locked. Otherwise, `*version` can be
+  // validated (or upgraded) after reading the node.
+  bool ReadLock(uint64_t* version) const {
+    *version = version_.load(std::memory_order_acquire);
+    return (*version & 1) == 0;
+  }
+
+  // Returns true iff the node was not modified since ReadLock() returned
+  // `version`, i.e. everything read from the node in between is consistent.
+  bool Validate(uint64_t version) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version_.load(std::memory_order_relaxed) == version;
+  }
+
+  // Write locks the node iff it was not modified since ReadLock() returned
+  // `version`.
+  bool TryUpgrade(uint64_t version) {
+    if (!version_.compare_exchange_strong(version, version + 1,
+                                          std::memory_order_acquire)) {
+      return false;
+    }
+    // Order the modifications after the version change for optimistic readers
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+  }
+
+  void WriteUnlock() { version_.fetch_add(1, std::memory_order_release); }
+
+ private:
+  std::atomic<uint64_t> version_{0};
+};
+
+struct Node {
+  explicit Node(bool leaf) : is_leaf(leaf) {}
+
+  VersionLock lock;
+  const bool is_leaf;
+  // Number of keys of a leaf, or of children of an inner node
+  std::atomic<uint32_t> count{0};
+};
+
+struct LeafNode : public Node {
+  LeafNode() : Node(true) {}
+
+  // Sorted memtable keys. Only the first `count` are meaningful.
+  std::atomic<const char*> keys[kLeafCapacity] = {};
+  // The leaf holds the keys in [low_fence, high_fence), where nullptr stands
+  // for unbounded. A leaf always holds its low fence key.
+  std::atomic<const char*> low_fence{nullptr};
+  std::atomic<const char*> high_fence{nullptr};
+};
+
+struct InnerNode : public Node {
+  InnerNode() : Node(false) {}
+
+  // children[i] holds the keys in [keys[i - 1], keys[i])
+  std::atomic<const char*> keys[kInnerCapacity - 1] = {};
+  std::atomic<Node*> children[kInnerCapacity] = {};
+};
+
+// A consistent copy of a leaf, read optimistically
+struct LeafSnapshot {
+  uint32_t count = 0;
+  const char* low_fence = nullptr;
+  const char* high_fence = nullptr;
+  const char* keys[kLeafCapacity];
+
+  // Returns the index of the first key >= `key` (or > `key` if `inclusive`)
+  uint32_t LowerBound(const MemTableRep::KeyComparator& cmp, const char* key,
+                      bool inclusive = false) const {
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      int c = cmp(keys[mid], key);
+      if (c < 0 || (inclusive && c == 0)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+};
+
+struct InsertHint {
+  // The leaf of the previous insert
+  LeafNode* leaf = nullptr;
+};
+
+void Backoff(uint32_t attempt) {
+  if (attempt < 64) {
+    port::AsmVolatilePause();
+  } else {
+    std::this_thread::yield();
+  }
+}
+
+class BTreeRep : public MemTableRep {
+ public:
+  BTreeRep(const MemTableRep::KeyComparator& compare, Allocator* allocator)
+      : MemTableRep(allocator), cmp_(compare), root_(NewLeaf()) {}
+
+  void Insert(KeyHandle handle) override {
+    bool inserted = InsertKey(handle);
+    assert(inserted);
+    (void)inserted;
+  }
+
+  bool InsertKey(KeyHandle handle) override {
+    return InsertImpl(static_cast<const char*>(handle), nullptr);
+  }
+
+  void InsertWithHint(KeyHandle handle, void** hint) override {
+    bool inserted = InsertKeyWithHint(handle, hint);
+    assert(inserted);
+    (void)inserted;
+  }
+
+  bool InsertKeyWithHint(KeyHandle handle, void** hint) override {
+    assert(hint != nullptr);
+    if (*hint == nullptr) {
+      *hint =
+          new (allocator_->AllocateAligned(sizeof(InsertHint))) InsertHint();
+    }
+    return InsertImpl(static_cast<const char*>(handle),
+                      static_cast<InsertHint*>(*hint));
+  }
+
+  void InsertWithHintConcurrently(KeyHandle handle, void** hint) override {
+    bool inserted = InsertKeyWithHintConcurrently(handle, hint);
+    assert(inserted);
+    (void)inserted;
+  }
+
+  bool InsertKeyWithHintConcurrently(KeyHandle handle, void** hint) override {
+    assert(hint != nullptr);
+    if (*hint == nullptr) {
+      // Owned by the caller, which frees it with delete[]
+      *hint = new (new char[sizeof(InsertHint)]) InsertHint();
+    }
+    return InsertImpl(static_cast<const char*>(handle),
+                      static_cast<InsertHint*>(*hint));
+  }
+
+  // Every insert is thread-safe
+  void InsertConcurrently(KeyHandle handle) override { Insert(handle); }
+
+  bool InsertKeyConcurrently(KeyHandle handle) override {
+    return InsertKey(handle);
+  }
+
+  bool Contains(const char* key) const override {
+    LeafSnapshot leaf;
+    ReadLeaf(key, Descent::kFloor, &leaf);
+    uint32_t pos = leaf.LowerBound(cmp_, key);
+    return pos < leaf.count && cmp_(leaf.keys[pos], key) == 0;
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    BTreeRep::Iterator iter(this);
+    Slice dummy_slice;
+    for (iter.Seek(dummy_slice, k.memtable_key().data());
+         iter.Valid() && callback_func(callback_args, iter.key());
+         iter.Next()) {
+    }
+  }
+
+  bool IsRandomSampleSupported() const override { return true; }
+
+  void UniqueRandomSample(const uint64_t num_entries,
+                          const uint64_t target_sample_size,
+                          std::unordered_set<const char*>* entries) override {
+    entries->clear();
+    // Avoid divide-by-0.
+    assert(target_sample_size > 0);
+    assert(num_entries > 0);
+    // There is no random access to the tree, so add each entry i to the
+    // sample set with probability
+    // (target_sample_size - entries.size()) / (num_entries - i).
+    Random* rnd = Random::GetTLSInstance();
+    BTreeRep::Iterator iter(this);
+    uint64_t counter = 0, num_samples_left = target_sample_size;
+    for (iter.SeekToFirst();
+         iter.Valid() && num_samples_left > 0 && counter < num_entries;
+         iter.Next(), counter++) {
+      if (rnd->Next() % (num_entries - counter) < num_samples_left) {
+        entries->insert(iter.key());
+        num_samples_left--;
+      }
+    }
+  }
+
+  ~BTreeRep() override = default;
+
+  // Iteration over the contents of the tree. The iterator works on a copy of
+  // one leaf at a time, so concurrent inserts never invalidate it.
+  class Iterator : public MemTableRep::Iterator {
+   public:
+    explicit Iterator(const BTreeRep* rep) : rep_(rep) {}
+
+    ~Iterator() override = default;
+
+    bool Valid() const override {
+      return pos_ >= 0 && static_cast<uint32_t>(pos_) < leaf_.count;
+    }
+
+    const char* key() const override {
+      assert(Valid());
+      return leaf_.keys[pos_];
+    }
+
+    void Next() override {
+      assert(Valid());
+      ++pos_;
+      SkipForward();
+    }
+
+    void Prev() override {
+      assert(Valid());
+      --pos_;
+      SkipBackward();
+    }
+
+    // Advance to the first entry with a key >= target
+    void Seek(const Slice& user_key, const char* memtable_key) override {
+      const char* target = memtable_key != nullptr
+                               ? memtable_key
+                               : EncodeKey(&tmp_, user_key);
+      rep_->ReadLeaf(target, Descent::kFloor, &leaf_);
+      pos_ = static_cast<int32_t>(leaf_.LowerBound(rep_->cmp_, target));
+      SkipForward();
+    }
+
+    // Retreat to the last entry with a key <= target
+    void SeekForPrev(const Slice& user_key, const char* memtable_key) override {
+      const char* target = memtable_key != nullptr
+                               ? memtable_key
+                               : EncodeKey(&tmp_, user_key);
+      rep_->ReadLeaf(target, Descent::kFloor, &leaf_);
+      pos_ = static_cast<int32_t>(
+                 leaf_.LowerBound(rep_->cmp_, target, true /* inclusive */)) -
+             1;
+      SkipBackward();
+    }
+
+    void SeekToFirst() override {
+      rep_->ReadLeaf(nullptr, Descent::kFirst, &leaf_);
+      pos_ = 0;
+      SkipForward();
+    }
+
+    void SeekToLast() override {
+      rep_->ReadLeaf(nullptr, Descent::kLast, &leaf_);
+      pos_ = static_cast<int32_t>(leaf_.count) - 1;
+      SkipBackward();
+    }
+
+   private:
+    // Moves to the following leaves while past the end of the current one.
+    // The high fence is the first key of the next leaf.
+    void SkipForward() {
+      while (static_cast<uint32_t>(pos_) >= leaf_.count &&
+             leaf_.high_fence != nullptr) {
+        const char* fence = leaf_.high_fence;
+        rep_->ReadLeaf(fence, Descent::kFloor, &leaf_);
+        pos_ = static_cast<int32_t>(leaf_.LowerBound(rep_->cmp_, fence));
+      }
+    }
+
+    // Moves to the preceding leaves while before the start of the current one
+    void SkipBackward() {
+      while (pos_ < 0 && leaf_.low_fence != nullptr) {
+        const char* fence = leaf_.low_fence;
+        rep_->ReadLeaf(fence, Descent::kBelow, &leaf_);
+        pos_ = static_cast<int32_t>(leaf_.LowerBound(rep_->cmp_, fence)) - 1;
+      }
+    }
+
+    const BTreeRep* rep_;
+    LeafSnapshot leaf_;
+    int32_t pos_ = -1;
+    std::string tmp_;  // For passing to EncodeKey
+  };
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void* mem = arena ? arena->AllocateAligned(sizeof(BTreeRep::Iterator))
+                      : operator new(sizeof(BTreeRep::Iterator));
+    return new (mem) BTreeRep::Iterator(this);
+  }
+
+ private:
+  // Which child to descend to in an inner node
+  enum class Descent {
+    kFirst,
+    kLast,
+    // The child whose key range holds `key`
+    kFloor,
+    // The child whose key range holds the largest key < `key`
+    kBelow,
+  };
+
+  enum class InsertResult { kInserted, kDuplicate, kRetry };
+
+  LeafNode* NewLeaf() {
+    return new (allocator_->AllocateAligned(sizeof(LeafNode))) LeafNode();
+  }
+
+  InnerNode* NewInner() {
+    return new (allocator_->AllocateAligned(sizeof(InnerNode))) InnerNode();
+  }
+
+  // Finds the index of the child of `inner` to descend to. Returns false if
+  // `inner` was observed in an inconsistent state.
+  bool FindChild(const InnerNode* inner, const char* key, Descent descent,
+                 uint32_t* index) const {
+    uint32_t n = inner->count.load(std::memory_order_acquire);
+    if (n < 2 || n > kInnerCapacity) {
+      return false;
+    }
+    if (descent == Descent::kFirst) {
+      *index = 0;
+      return true;
+    }
+    if (descent == Descent::kLast) {
+      *index = n - 1;
+      return true;
+    }
+    // Count the separators <= key (or < key for kBelow)
+    uint32_t lo = 0;
+    uint32_t hi = n - 1;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      const char* separator = inner->keys[mid].load(std::memory_order_acquire);
+      if (separator == nullptr) {
+        return false;
+      }
+      int c = cmp_(separator, key);
+      if (c < 0 || (c == 0 && descent == Descent::kFloor)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    *index = lo;
+    return true;
+  }
+
+  void ReadLeaf(const char* key, Descent descent, LeafSnapshot* leaf) const {
+    for (uint32_t attempt = 0; !TryReadLeaf(key, descent, leaf); ++attempt) {
+      Backoff(attempt);
+    }
+  }
+
+  bool TryReadLeaf(const char* key, Descent descent,
+                   LeafSnapshot* snapshot) const {
+    const Node* node = root_.load(std::memory_order_acquire);
+    uint64_t version;
+    if (!node->lock.ReadLock(&version) ||
+        node != root_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    while (!node->is_leaf) {
+      const InnerNode* inner = static_cast<const InnerNode*>(node);
+      uint32_t index;
+      if (!FindChild(inner, key, descent, &index)) {
+        return false;
+      }
+      const Node* child =
+          inner->children[index].load(std::memory_order_acquire);
+      uint64_t child_version;
+      if (child == nullptr || !child->lock.ReadLock(&child_version) ||
+          !inner->lock.Validate(version)) {
+        return false;
+      }
+      node = child;
+      version = child_version;
+    }
+    const LeafNode* leaf = static_cast<const LeafNode*>(node);
+    uint32_t n = leaf->count.load(std::memory_order_acquire);
+    if (n > kLeafCapacity) {
+      return false;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+      snapshot->keys[i] = leaf->keys[i].load(std::memory_order_acquire);
+    }
+    snapshot->count = n;
+    snapshot->low_fence = leaf->low_fence.load(std::memory_order_acquire);
+    snapshot->high_fence = leaf->high_fence.load(std::memory_order_acquire);
+    return leaf->lock.Validate(version);
+  }
+
+  bool InsertImpl(const char* key, InsertHint* hint) {
+    if (hint != nullptr && hint->leaf != nullptr) {
+      InsertResult result = TryInsertIntoLeaf(hint->leaf, key);
+      if (result != InsertResult::kRetry) {
+        return result == InsertResult::kInserted;
+      }
+    }
+    for (uint32_t attempt = 0;; ++attempt) {
+      LeafNode* leaf = nullptr;
+      InsertResult result = TryInsertFromRoot(key, &leaf);
+      if (result != InsertResult::kRetry) {
+        if (hint != nullptr) {
+          hint->leaf = leaf;
+        }
+        return result == InsertResult::kInserted;
+      }
+      Backoff(attempt);
+    }
+  }
+
+  // Inserts into `leaf` if it is not full and its key range holds `key`
+  InsertResult TryInsertIntoLeaf(LeafNode* leaf, const char* key) {
+    uint64_t version;
+    if (!leaf->lock.ReadLock(&version)) {
+      return InsertResult::kRetry;
+    }
+    const char* low_fence = leaf->low_fence.load(std::memory_order_acquire);
+    const char* high_fence = leaf->high_fence.load(std::memory_order_acquire);
+    if (leaf->count.load(std::memory_order_acquire) >= kLeafCapacity ||
+        (low_fence != nullptr && cmp_(key, low_fence) < 0) ||
+        (high_fence != nullptr && cmp_(key, high_fence) >= 0) ||
+        !leaf->lock.TryUpgrade(version)) {
+      return InsertResult::kRetry;
+    }
+    bool inserted = InsertIntoLockedLeaf(leaf, key);
+    leaf->lock.WriteUnlock();
+    return inserted ? InsertResult::kInserted : InsertResult::kDuplicate;
+  }
+
+  InsertResult TryInsertFromRoot(const char* key, LeafNode** inserted_leaf) {
+    Node* node = root_.load(std::memory_order_acquire);
+    uint64_t version;
+    if (!node->lock.ReadLock(&version) ||
+        node != root_.load(std::memory_order_acquire)) {
+      return InsertResult::kRetry;
+    }
+    InnerNode* parent = nullptr;
+    uint64_t parent_version = 0;
+    while (!node->is_leaf) {
+      InnerNode* inner = static_cast<InnerNode*>(node);
+      if (inner->count.load(std::memory_order_acquire) == kInnerCapacity) {
+        if (LockForSplit(parent, parent_version, inner, version)) {
+          SplitInner(inner, parent);
+          UnlockAfterSplit(parent, inner);
+        }
+        return InsertResult::kRetry;
+      }
+      uint32_t index;
+      if (!FindChild(inner, key, Descent::kFloor, &index)) {
+        return InsertResult::kRetry;
+      }
+      Node* child = inner->children[index].load(std::memory_order_acquire);
+      uint64_t child_version;
+      if (child == nullptr || !child->lock.ReadLock(&child_version) ||
+          !inner->lock.Validate(version)) {
+        return InsertResult::kRetry;
+      }
+      parent = inner;
+      parent_version = version;
+      node = child;
+      version = child_version;
+    }
+    LeafNode* leaf = static_cast<LeafNode*>(node);
+    if (leaf->count.load(std::memory_order_acquire) == kLeafCapacity) {
+      if (LockForSplit(parent, parent_version, leaf, version)) {
+        SplitLeaf(leaf, parent, key);
+        UnlockAfterSplit(parent, leaf);
+      }
+      return InsertResult::kRetry;
+    }
+    // The leaf was not modified since its parent pointed to it for `key`, so
+    // its key range still holds `key`.
+    if (!leaf->lock.TryUpgrade(version)) {
+      return InsertResult::kRetry;
+    }
+    bool inserted = InsertIntoLockedLeaf(leaf, key);
+    leaf->lock.WriteUnlock();
+    *inserted_leaf = leaf;
+    return inserted ? InsertResult::kInserted : InsertResult::kDuplicate;
+  }
+
+  // Returns false if `key` is already in `leaf`.
+  // REQUIRES: `leaf` is write locked and not full.
+  bool InsertIntoLockedLeaf(LeafNode* leaf, const char* key) {
+    uint32_t n = leaf->count.load(std::memory_order_relaxed);
+    assert(n < kLeafCapacity);
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      int c = cmp_(leaf->keys[mid].load(std::memory_order_relaxed), key);
+      if (c == 0) {
+        return false;
+      } else if (c < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    for (uint32_t i = n; i > lo; --i) {
+      leaf->keys[i].store(leaf->keys[i - 1].load(std::memory_order_relaxed),
+                          std::memory_order_release);
+    }
+    leaf->keys[lo].store(key, std::memory_order_release);
+    leaf->count.store(n + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Write locks `node` and its parent (if any) for a split, iff neither was
+  // modified since read locked.
+  bool LockForSplit(InnerNode* parent, uint64_t parent_version, Node* node,
+                    uint64_t version) {
+    if (parent != nullptr && !parent->lock.TryUpgrade(parent_version)) {
+      return false;
+    }
+    if (!node->lock.TryUpgrade(version)) {
+      if (parent != nullptr) {
+        parent->lock.WriteUnlock();
+      }
+      return false;
+    }
+    assert(parent != nullptr ||
+           node == root_.load(std::memory_order_relaxed));
+    return true;
+  }
+
+  void UnlockAfterSplit(InnerNode* parent, Node* node) {
+    node->lock.WriteUnlock();
+    if (parent != nullptr) {
+      parent->lock.WriteUnlock();
+    }
+  }
+
+  // Moves the upper part of a full leaf to a new right sibling. `key` is the
+  // key being inserted: when it goes past the end of the leaf (e.g. for
+  // sequential inserts), the leaf is kept nearly full instead of half full.
+  void SplitLeaf(LeafNode* leaf, InnerNode* parent, const char* key) {
+    uint32_t n = leaf->count.load(std::memory_order_relaxed);
+    assert(n == kLeafCapacity);
+    uint32_t split =
+        cmp_(key, leaf->keys[n - 1].load(std::memory_order_relaxed)) > 0
+            ? n - 1
+            : n / 2;
+    LeafNode* right = NewLeaf();
+    for (uint32_t i = split; i < n; ++i) {
+      right->keys[i - split].store(
+          leaf->keys[i].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+    right->count.store(n - split, std::memory_order_relaxed);
+    const char* separator = right->keys[0].load(std::memory_order_relaxed);
+    right->low_fence.store(separator, std::memory_order_relaxed);
+    right->high_fence.store(leaf->high_fence.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+    leaf->high_fence.store(separator, std::memory_order_release);
+    leaf->count.store(split, std::memory_order_release);
+    InsertIntoParent(parent, leaf, separator, right);
+  }
+
+  // Moves the upper half of a full inner node to a new right sibling
+  void SplitInner(InnerNode* inner, InnerNode* parent) {
+    uint32_t n = inner->count.load(std::memory_order_relaxed);
+    assert(n == kInnerCapacity);
+    uint32_t split = n / 2;
+    InnerNode* right = NewInner();
+    for (uint32_t i = split; i < n; ++i) {
+      right->children[i - split].store(
+          inner->children[i].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+    for (uint32_t i = split; i + 1 < n; ++i) {
+      right->keys[i - split].store(
+          inner->keys[i].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+    right->count.store(n - split, std::memory_order_relaxed);
+    const char* separator =
+        inner->keys[split - 1].load(std::memory_order_relaxed);
+    inner->count.store(split, std::memory_order_release);
+    InsertIntoParent(parent, inner, separator, right);
+  }
+
+  // Publishes `right`, the new right sibling of `left`, in `parent`, or in a
+  // new root if `left` was the root.
+  // REQUIRES: `parent` (if any) is write locked and not full.
+  void InsertIntoParent(InnerNode* parent, Node* left, const char* separator,
+                        Node* right) {
+    if (parent == nullptr) {
+      InnerNode* root = NewInner();
+      root->children[0].store(left, std::memory_order_relaxed);
+      root->children[1].store(right, std::memory_order_relaxed);
+      root->keys[0].store(separator, std::memory_order_relaxed);
+      root->count.store(2, std::memory_order_relaxed);
+      root_.store(root, std::memory_order_release);
+      return;
+    }
+    uint32_t n = parent->count.load(std::memory_order_relaxed);
+    assert(n < kInnerCapacity);
+    uint32_t pos = 0;
+    while (parent->children[pos].load(std::memory_order_relaxed) != left) {
+      ++pos;
+      assert(pos < n);
+    }
+    for (uint32_t i = n; i > pos + 1; --i) {
+      parent->children[i].store(
+          parent->children[i - 1].load(std::memory_order_relaxed),
+          std::memory_order_release);
+    }
+    for (uint32_t i = n - 1; i > pos; --i) {
+      parent->keys[i].store(parent->keys[i - 1].load(std::memory_order_relaxed),
+                            std::memory_order_release);
+    }
+    parent->keys[pos].store(separator, std::memory_order_release);
+    parent->children[pos + 1].store(right, std::memory_order_release);
+    parent->count.store(n + 1, std::memory_order_release);
+  }
+
+  const MemTableRep::KeyComparator& cmp_;
+  std::atomic<Node*> root_;
+};
+}  // namespace
+
+MemTableRep* BTreeRepFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, Allocator* allocator,
+    const SliceTransform* /*transform*/, Logger* /*logger*/) {
+  return new BTreeRep(compare, allocator);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -15,6 +15,7 @@ int main() {
 }
 #else
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 #include <memory>
@@ -25,6 +26,7 @@ int main() {
 #include "db/dbformat.h"
 #include "db/memtable.h"
 #include "memory/arena.h"
+#include "memory/concurrent_arena.h"
 #include "port/port.h"
 #include "port/stack_trace.h"
 #include "rocksdb/comparator.h"
@@ -47,6 +49,8 @@ DEFINE_string(benchmarks, "fillrandom",
               "Comma-separated list of benchmarks to run. Options:\n"
               "\tfillrandom             -- write N random values\n"
               "\tfillseq                -- write N values in sequential order\n"
+              "\tfillrandomconcurrent   -- N threads concurrently write N "
+              "random values\n"
               "\treadrandom             -- read N values in random order\n"
               "\treadseq                -- scan the DB\n"
               "\treadwrite              -- 1 thread writes while N - 1 threads "
@@ -60,6 +64,7 @@ DEFINE_string(memtablerep, "skiplist",
               "include/memtablerep.h for\n"
               "  more details. Options:\n"
               "\tskiplist            -- backed by a skiplist\n"
+              "\tbtree               -- backed by a B+-tree\n"
               "\tvector              -- backed by an std::vector\n"
               "\thashskiplist        -- backed by a hash skip list\n"
               "\thashlinklist        -- backed by a hash linked list\n"
@@ -96,10 +101,23 @@ DEFINE_int32(
 DEFINE_int64(write_buffer_size, 256,
              "write_buffer_size parameter to pass into WriteBufferManager");
 
+DEFINE_int64(arena_block_size, ROCKSDB_NAMESPACE::Arena::kMinBlockSize,
+             "Block size of the arena backing the memtablerep");
+
+DEFINE_int64(arena_huge_page_size, 0,
+             "huge_page_size parameter to pass into the arena backing the "
+             "memtablerep");
+
+DEFINE_bool(numa_aware_arena, false,
+            "If true, the arena allocates its per-core blocks from memory "
+            "local to the NUMA node of each core. Compare fillrandomconcurrent "
+            "and readrandom with --num_threads spanning several nodes.");
+
 DEFINE_int32(
     num_threads, 1,
     "Number of concurrent threads to run. If the benchmark includes writes,\n"
-    "then at most one thread will be a writer");
+    "then at most one thread will be a writer, except for "
+    "fillrandomconcurrent");
 
 DEFINE_int32(num_operations, 1000000,
              "Number of operations to do for write and random read benchmarks");
@@ -180,11 +198,11 @@ class KeyGenerator {
   uint64_t Next() {
     switch (mode_) {
       case SEQUENTIAL:
-        return next_++;
+        return next_.fetch_add(1, std::memory_order_relaxed);
       case RANDOM:
         return rand_->Next() % num_;
       case UNIQUE_RANDOM:
-        return values_[next_++];
+        return values_[next_.fetch_add(1, std::memory_order_relaxed)];
     }
     assert(false);
     return std::numeric_limits<uint64_t>::max();
@@ -194,7 +212,8 @@ class KeyGenerator {
   Random64* rand_;
   WriteMode mode_;
   const uint64_t num_;
-  uint64_t next_;
+  // Shared by the writers of fillrandomconcurrent
+  std::atomic<uint64_t> next_;
   std::vector<uint64_t> values_;
 };
 
@@ -234,7 +253,7 @@ class FillBenchmarkThread : public BenchmarkThread {
       : BenchmarkThread(table, key_gen, bytes_written, bytes_read, sequence,
                         num_ops, read_hits) {}
 
-  void FillOne() {
+  void FillOne(bool concurrently = false) {
     char* buf = nullptr;
     auto internal_key_size = 16;
     auto encoded_len =
@@ -251,7 +270,11 @@ class FillBenchmarkThread : public BenchmarkThread {
     memcpy(p, bytes.data(), FLAGS_item_size);
     p += FLAGS_item_size;
     assert(p == buf + encoded_len);
-    table_->Insert(handle);
+    if (concurrently) {
+      table_->InsertConcurrently(handle);
+    } else {
+      table_->Insert(handle);
+    }
     *bytes_written_ += encoded_len;
   }
 
@@ -286,6 +309,23 @@ class ConcurrentFillBenchmarkThread : public FillBenchmarkThread {
   std::atomic_int* threads_done_;
 };
 
+// One of the writers of fillrandomconcurrent
+class ConcurrentWriterBenchmarkThread : public FillBenchmarkThread {
+ public:
+  ConcurrentWriterBenchmarkThread(MemTableRep* table, KeyGenerator* key_gen,
+                                  uint64_t* bytes_written, uint64_t* bytes_read,
+                                  uint64_t* sequence, uint64_t num_ops,
+                                  uint64_t* read_hits)
+      : FillBenchmarkThread(table, key_gen, bytes_written, bytes_read, sequence,
+                            num_ops, read_hits) {}
+
+  void operator()() override {
+    for (unsigned int i = 0; i < num_ops_; ++i) {
+      FillOne(true /* concurrently */);
+    }
+  }
+};
+
 class ReadBenchmarkThread : public BenchmarkThread {
  public:
   ReadBenchmarkThread(MemTableRep* table, KeyGenerator* key_gen,
@@ -475,6 +515,35 @@ class FillBenchmark : public Benchmark {
   }
 };
 
+class ConcurrentFillBenchmark : public Benchmark {
+ public:
+  explicit ConcurrentFillBenchmark(MemTableRep* table, KeyGenerator* key_gen,
+                                   uint64_t* sequence)
+      : Benchmark(table, key_gen, sequence, FLAGS_num_threads) {
+    num_write_ops_per_thread_ = FLAGS_num_operations / FLAGS_num_threads;
+  }
+
+  void RunThreads(std::vector<port::Thread>* threads, uint64_t* bytes_written,
+                  uint64_t* bytes_read, bool /*write*/,
+                  uint64_t* read_hits) override {
+    // The keys are unique, so each writer can use its own sequence numbers
+    std::vector<uint64_t> thread_bytes_written(num_threads_, 0);
+    std::vector<uint64_t> thread_sequences(num_threads_, 0);
+    for (uint32_t i = 0; i < num_threads_; ++i) {
+      threads->emplace_back(ConcurrentWriterBenchmarkThread(
+          table_, key_gen_, &thread_bytes_written[i], bytes_read,
+          &thread_sequences[i], num_write_ops_per_thread_, read_hits));
+    }
+    for (auto& thread : *threads) {
+      thread.join();
+    }
+    for (uint32_t i = 0; i < num_threads_; ++i) {
+      *bytes_written += thread_bytes_written[i];
+      *sequence_ = std::max(*sequence_, thread_sequences[i]);
+    }
+  }
+};
+
 class ReadBenchmark : public Benchmark {
  public:
   explicit ReadBenchmark(MemTableRep* table, KeyGenerator* key_gen,
@@ -612,7 +681,14 @@ int main(int argc, char** argv) {
   ROCKSDB_NAMESPACE::InternalKeyComparator internal_key_comp(
       ROCKSDB_NAMESPACE::BytewiseComparator());
   ROCKSDB_NAMESPACE::MemTable::KeyComparator key_comp(internal_key_comp);
-  ROCKSDB_NAMESPACE::Arena arena;
+  ROCKSDB_NAMESPACE::ConcurrentArena arena(
+      static_cast<size_t>(FLAGS_arena_block_size), nullptr /* tracker */,
+      static_cast<size_t>(FLAGS_arena_huge_page_size), FLAGS_numa_aware_arena);
+  if (FLAGS_numa_aware_arena && !arena.IsNumaAware()) {
+    fprintf(stderr,
+            "Warning: NUMA-aware arena requested, but NUMA support is not "
+            "available or there is a single NUMA node\n");
+  }
   ROCKSDB_NAMESPACE::WriteBufferManager wb(FLAGS_write_buffer_size);
   uint64_t sequence;
   auto createMemtableRep = [&] {
@@ -648,6 +724,17 @@ int main(int argc, char** argv) {
           &rng, ROCKSDB_NAMESPACE::UNIQUE_RANDOM, FLAGS_num_operations));
       benchmark.reset(new ROCKSDB_NAMESPACE::FillBenchmark(
           memtablerep.get(), key_gen.get(), &sequence));
+    } else if (name == ROCKSDB_NAMESPACE::Slice("fillrandomconcurrent")) {
+      if (!factory->IsInsertConcurrentlySupported()) {
+        std::cout << "WARNING: skipping fillrandomconcurrent, which "
+                  << FLAGS_memtablerep << " does not support" << std::endl;
+        continue;
+      }
+      memtablerep.reset(createMemtableRep());
+      key_gen.reset(new ROCKSDB_NAMESPACE::KeyGenerator(
+          &rng, ROCKSDB_NAMESPACE::UNIQUE_RANDOM, FLAGS_num_operations));
+      benchmark.reset(new ROCKSDB_NAMESPACE::ConcurrentFillBenchmark(
+          memtablerep.get(), key_gen.get(), &sequence));
     } else if (name == ROCKSDB_NAMESPACE::Slice("readrandom")) {
       key_gen.reset(new ROCKSDB_NAMESPACE::KeyGenerator(
           &rng, ROCKSDB_NAMESPACE::RANDOM, FLAGS_num_operations));
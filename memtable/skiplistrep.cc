@@ -101,6 +101,8 @@ class SkipListRep : public MemTableRep {
     return (end_count >= start_count) ? (end_count - start_count) : 0;
   }
 
+  bool IsRandomSampleSupported() const override { return true; }
+
   void UniqueRandomSample(const uint64_t num_entries,
                           const uint64_t target_sample_size,
                           std::unordered_set<const char*>* entries) override {
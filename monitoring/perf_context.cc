@@ -153,7 +153,9 @@ struct PerfContextByLevelInt {
   defCmd(iter_seek_count)                          \
   defCmd(encrypt_data_nanos)                       \
   defCmd(decrypt_data_nanos)                       \
-  defCmd(number_async_seek)
+  defCmd(number_async_seek)                        \
+  defCmd(multiget_prefetch_count)                  \
+  defCmd(multiget_block_probe_nanos)
 // clang-format on
 
 struct PerfContextInt {
@@ -266,6 +266,9 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {PREFETCH_BYTES_USEFUL, "rocksdb.prefetch.bytes.useful"},
     {PREFETCH_HITS, "rocksdb.prefetch.hits"},
     {SST_FOOTER_CORRUPTION_COUNT, "rocksdb.footer.corruption.count"},
+    {WRITE_THREAD_WAIT_MICROS, "rocksdb.write.thread.wait.micros"},
+    {WRITE_WAL_MICROS, "rocksdb.write.wal.micros"},
+    {WRITE_MEMTABLE_MICROS, "rocksdb.write.memtable.micros"},
 };
 
 const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
@@ -336,6 +339,9 @@ const std::vector<std::pair<Histograms, std::string>> HistogramsNameMap = {
     {ASYNC_PREFETCH_ABORT_MICROS, "rocksdb.async.prefetch.abort.micros"},
     {TABLE_OPEN_PREFETCH_TAIL_READ_BYTES,
      "rocksdb.table.open.prefetch.tail.read.bytes"},
+    {DB_WRITE_THREAD_WAIT_MICROS, "rocksdb.db.write.thread.wait.micros"},
+    {DB_WRITE_WAL_MICROS, "rocksdb.db.write.wal.micros"},
+    {DB_WRITE_MEMTABLE_MICROS, "rocksdb.db.write.memtable.micros"},
 };
 
 std::shared_ptr<Statistics> CreateDBStatistics() {
@@ -88,6 +88,8 @@ struct ImmutableCFOptions {
   std::shared_ptr<Cache> blob_cache;
 
   bool persist_user_defined_timestamps;
+
+  bool memtable_resident;
 };
 
 struct ImmutableOptions : public ImmutableDBOptions, public ImmutableCFOptions {
@@ -117,6 +119,7 @@ struct MutableCFOptions {
             options.memtable_prefix_bloom_size_ratio),
         memtable_whole_key_filtering(options.memtable_whole_key_filtering),
         memtable_huge_page_size(options.memtable_huge_page_size),
+        memtable_numa_aware(options.memtable_numa_aware),
         max_successive_merges(options.max_successive_merges),
         strict_max_successive_merges(options.strict_max_successive_merges),
         inplace_update_num_locks(options.inplace_update_num_locks),
@@ -172,8 +175,11 @@ struct MutableCFOptions {
             options.sample_for_compression),  // TODO: is 0 fine here?
         compression_per_level(options.compression_per_level),
         memtable_max_range_deletions(options.memtable_max_range_deletions),
+        memtable_value_separation_min_size(
+            options.memtable_value_separation_min_size),
         bottommost_file_compaction_delay(
             options.bottommost_file_compaction_delay),
+        max_flush_partitions(options.max_flush_partitions),
         uncache_aggressiveness(options.uncache_aggressiveness) {
     RefreshDerivedOptions(options.num_levels, options.compaction_style);
   }
@@ -185,6 +191,7 @@ struct MutableCFOptions {
         memtable_prefix_bloom_size_ratio(0),
         memtable_whole_key_filtering(false),
         memtable_huge_page_size(0),
+        memtable_numa_aware(false),
         max_successive_merges(0),
         strict_max_successive_merges(false),
         inplace_update_num_locks(0),
@@ -225,7 +232,9 @@ struct MutableCFOptions {
         block_protection_bytes_per_key(0),
         sample_for_compression(0),
         memtable_max_range_deletions(0),
+        memtable_value_separation_min_size(0),
         bottommost_file_compaction_delay(0),
+        max_flush_partitions(1),
         uncache_aggressiveness(0) {}
 
   explicit MutableCFOptions(const Options& options);
@@ -254,6 +263,7 @@ struct MutableCFOptions {
   double memtable_prefix_bloom_size_ratio;
   bool memtable_whole_key_filtering;
   size_t memtable_huge_page_size;
+  bool memtable_numa_aware;
   size_t max_successive_merges;
   bool strict_max_successive_merges;
   size_t inplace_update_num_locks;
@@ -321,7 +331,9 @@ struct MutableCFOptions {
   uint64_t sample_for_compression;
   std::vector<CompressionType> compression_per_level;
   uint32_t memtable_max_range_deletions;
+  uint32_t memtable_value_separation_min_size;
   uint32_t bottommost_file_compaction_delay;
+  uint32_t max_flush_partitions;
   uint32_t uncache_aggressiveness;
 
   // Derived options
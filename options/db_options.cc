@@ -334,6 +334,14 @@ static std::unordered_map<std::string, OptionTypeInfo>
          OptionTypeInfo::Enum<WALRecoveryMode>(
              offsetof(struct ImmutableDBOptions, wal_recovery_mode),
              &wal_recovery_mode_string_map)},
+        {"memtable_sorted_batch_insert",
+         {offsetof(struct ImmutableDBOptions, memtable_sorted_batch_insert),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"parallel_wal_writes",
+         {offsetof(struct ImmutableDBOptions, parallel_wal_writes),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"enable_write_thread_adaptive_yield",
          {offsetof(struct ImmutableDBOptions,
                    enable_write_thread_adaptive_yield),
@@ -380,6 +388,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, two_write_queues),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"wal_per_write_queue",
+         {offsetof(struct ImmutableDBOptions, wal_per_write_queue),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"manual_wal_flush",
          {offsetof(struct ImmutableDBOptions, manual_wal_flush),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -576,6 +588,18 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, follower_catchup_retry_wait_ms),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"compaction_async_write_buffers",
+         {offsetof(struct ImmutableDBOptions, compaction_async_write_buffers),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"compaction_pipelined_input_size",
+         {offsetof(struct ImmutableDBOptions, compaction_pipelined_input_size),
+          OptionType::kSizeT, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"subcompaction_ranges_per_thread",
+         {offsetof(struct ImmutableDBOptions, subcompaction_ranges_per_thread),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
 };
 
 const std::string OptionsHelper::kDBOptionsName = "DBOptions";
@@ -741,6 +765,8 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       enable_pipelined_write(options.enable_pipelined_write),
       unordered_write(options.unordered_write),
       allow_concurrent_memtable_write(options.allow_concurrent_memtable_write),
+      memtable_sorted_batch_insert(options.memtable_sorted_batch_insert),
+      parallel_wal_writes(options.parallel_wal_writes),
       enable_write_thread_adaptive_yield(
           options.enable_write_thread_adaptive_yield),
       write_thread_max_yield_usec(options.write_thread_max_yield_usec),
@@ -757,6 +783,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       avoid_flush_during_recovery(options.avoid_flush_during_recovery),
       allow_ingest_behind(options.allow_ingest_behind),
       two_write_queues(options.two_write_queues),
+      wal_per_write_queue(options.wal_per_write_queue),
       manual_wal_flush(options.manual_wal_flush),
       wal_compression(options.wal_compression),
       background_close_inactive_wals(options.background_close_inactive_wals),
@@ -778,7 +805,10 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       follower_refresh_catchup_period_ms(
           options.follower_refresh_catchup_period_ms),
       follower_catchup_retry_count(options.follower_catchup_retry_count),
-      follower_catchup_retry_wait_ms(options.follower_catchup_retry_wait_ms) {
+      follower_catchup_retry_wait_ms(options.follower_catchup_retry_wait_ms),
+      compaction_async_write_buffers(options.compaction_async_write_buffers),
+      compaction_pipelined_input_size(options.compaction_pipelined_input_size),
+      subcompaction_ranges_per_thread(options.subcompaction_ranges_per_thread) {
   fs = env->GetFileSystem();
   clock = env->GetSystemClock().get();
   logger = info_log.get();
@@ -896,6 +926,10 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    unordered_write);
   ROCKS_LOG_HEADER(log, "        Options.allow_concurrent_memtable_write: %d",
                    allow_concurrent_memtable_write);
+  ROCKS_LOG_HEADER(log, "           Options.memtable_sorted_batch_insert: %d",
+                   memtable_sorted_batch_insert);
+  ROCKS_LOG_HEADER(log, "                    Options.parallel_wal_writes: %d",
+                   parallel_wal_writes);
   ROCKS_LOG_HEADER(log, "     Options.enable_write_thread_adaptive_yield: %d",
                    enable_write_thread_adaptive_yield);
   ROCKS_LOG_HEADER(log,
@@ -922,6 +956,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    allow_ingest_behind);
   ROCKS_LOG_HEADER(log, "            Options.two_write_queues: %d",
                    two_write_queues);
+  ROCKS_LOG_HEADER(log, "            Options.wal_per_write_queue: %d",
+                   wal_per_write_queue);
   ROCKS_LOG_HEADER(log, "            Options.manual_wal_flush: %d",
                    manual_wal_flush);
   ROCKS_LOG_HEADER(log, "            Options.wal_compression: %d",
@@ -956,6 +992,14 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    db_host_id.c_str());
   ROCKS_LOG_HEADER(log, "            Options.enforce_single_del_contracts: %s",
                    enforce_single_del_contracts ? "true" : "false");
+  ROCKS_LOG_HEADER(
+      log, "          Options.compaction_async_write_buffers: %" ROCKSDB_PRIszt,
+      compaction_async_write_buffers);
+  ROCKS_LOG_HEADER(
+      log, "         Options.compaction_pipelined_input_size: %" ROCKSDB_PRIszt,
+      compaction_pipelined_input_size);
+  ROCKS_LOG_HEADER(log, "         Options.subcompaction_ranges_per_thread: %u",
+                   subcompaction_ranges_per_thread);
 }
 
 bool ImmutableDBOptions::IsWalDirSameAsDBPath() const {
@@ -68,6 +68,8 @@ struct ImmutableDBOptions {
   bool enable_pipelined_write;
   bool unordered_write;
   bool allow_concurrent_memtable_write;
+  bool memtable_sorted_batch_insert;
+  bool parallel_wal_writes;
   bool enable_write_thread_adaptive_yield;
   uint64_t write_thread_max_yield_usec;
   uint64_t write_thread_slow_yield_usec;
@@ -82,6 +84,7 @@ struct ImmutableDBOptions {
   bool avoid_flush_during_recovery;
   bool allow_ingest_behind;
   bool two_write_queues;
+  bool wal_per_write_queue;
   bool manual_wal_flush;
   CompressionType wal_compression;
   bool background_close_inactive_wals;
@@ -108,6 +111,9 @@ struct ImmutableDBOptions {
   uint64_t follower_refresh_catchup_period_ms;
   uint64_t follower_catchup_retry_count;
   uint64_t follower_catchup_retry_wait_ms;
+  size_t compaction_async_write_buffers;
+  size_t compaction_pipelined_input_size;
+  uint32_t subcompaction_ranges_per_thread;
 
   bool IsWalDirSameAsDBPath() const;
   bool IsWalDirSameAsDBPath(const std::string& path) const;
@@ -134,6 +134,9 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.unordered_write = immutable_db_options.unordered_write;
   options.allow_concurrent_memtable_write =
       immutable_db_options.allow_concurrent_memtable_write;
+  options.memtable_sorted_batch_insert =
+      immutable_db_options.memtable_sorted_batch_insert;
+  options.parallel_wal_writes = immutable_db_options.parallel_wal_writes;
   options.enable_write_thread_adaptive_yield =
       immutable_db_options.enable_write_thread_adaptive_yield;
   options.max_write_batch_group_size_bytes =
@@ -159,6 +162,7 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
       mutable_db_options.avoid_flush_during_shutdown;
   options.allow_ingest_behind = immutable_db_options.allow_ingest_behind;
   options.two_write_queues = immutable_db_options.two_write_queues;
+  options.wal_per_write_queue = immutable_db_options.wal_per_write_queue;
   options.manual_wal_flush = immutable_db_options.manual_wal_flush;
   options.wal_compression = immutable_db_options.wal_compression;
   options.atomic_flush = immutable_db_options.atomic_flush;
@@ -179,6 +183,12 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.lowest_used_cache_tier = immutable_db_options.lowest_used_cache_tier;
   options.enforce_single_del_contracts =
       immutable_db_options.enforce_single_del_contracts;
+  options.compaction_async_write_buffers =
+      immutable_db_options.compaction_async_write_buffers;
+  options.compaction_pipelined_input_size =
+      immutable_db_options.compaction_pipelined_input_size;
+  options.subcompaction_ranges_per_thread =
+      immutable_db_options.subcompaction_ranges_per_thread;
   options.daily_offpeak_time_utc = mutable_db_options.daily_offpeak_time_utc;
   return options;
 }
@@ -203,6 +213,7 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
       moptions.memtable_prefix_bloom_size_ratio;
   cf_opts->memtable_whole_key_filtering = moptions.memtable_whole_key_filtering;
   cf_opts->memtable_huge_page_size = moptions.memtable_huge_page_size;
+  cf_opts->memtable_numa_aware = moptions.memtable_numa_aware;
   cf_opts->max_successive_merges = moptions.max_successive_merges;
   cf_opts->strict_max_successive_merges = moptions.strict_max_successive_merges;
   cf_opts->inplace_update_num_locks = moptions.inplace_update_num_locks;
@@ -215,6 +226,7 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
       moptions.block_protection_bytes_per_key;
   cf_opts->bottommost_file_compaction_delay =
       moptions.bottommost_file_compaction_delay;
+  cf_opts->max_flush_partitions = moptions.max_flush_partitions;
 
   // Compaction related options
   cf_opts->disable_auto_compactions = moptions.disable_auto_compactions;
@@ -274,6 +286,8 @@ void UpdateColumnFamilyOptions(const MutableCFOptions& moptions,
   cf_opts->last_level_temperature = moptions.last_level_temperature;
   cf_opts->default_write_temperature = moptions.default_write_temperature;
   cf_opts->memtable_max_range_deletions = moptions.memtable_max_range_deletions;
+  cf_opts->memtable_value_separation_min_size =
+      moptions.memtable_value_separation_min_size;
   cf_opts->uncache_aggressiveness = moptions.uncache_aggressiveness;
 }
 
@@ -315,6 +329,7 @@ void UpdateColumnFamilyOptions(const ImmutableCFOptions& ioptions,
       ioptions.preserve_internal_time_seconds;
   cf_opts->persist_user_defined_timestamps =
       ioptions.persist_user_defined_timestamps;
+  cf_opts->memtable_resident = ioptions.memtable_resident;
   cf_opts->default_temperature = ioptions.default_temperature;
 
   // TODO(yhchiang): find some way to handle the following derived options
@@ -333,7 +348,8 @@ std::map<CompactionPri, std::string> OptionsHelper::compaction_pri_to_string = {
     {kOldestLargestSeqFirst, "kOldestLargestSeqFirst"},
     {kOldestSmallestSeqFirst, "kOldestSmallestSeqFirst"},
     {kMinOverlappingRatio, "kMinOverlappingRatio"},
-    {kRoundRobin, "kRoundRobin"}};
+    {kRoundRobin, "kRoundRobin"},
+    {kReadWeightedOverlappingRatio, "kReadWeightedOverlappingRatio"}};
 
 std::map<CompactionStopStyle, std::string>
     OptionsHelper::compaction_stop_style_to_string = {
@@ -805,7 +821,8 @@ std::unordered_map<std::string, CompactionPri>
         {"kOldestLargestSeqFirst", kOldestLargestSeqFirst},
         {"kOldestSmallestSeqFirst", kOldestSmallestSeqFirst},
         {"kMinOverlappingRatio", kMinOverlappingRatio},
-        {"kRoundRobin", kRoundRobin}};
+        {"kRoundRobin", kRoundRobin},
+        {"kReadWeightedOverlappingRatio", kReadWeightedOverlappingRatio}};
 
 std::unordered_map<std::string, CompactionStopStyle>
     OptionsHelper::compaction_stop_style_string_map = {
@@ -183,9 +183,11 @@ TEST_F(OptionsSettableTest, BlockBasedTableOptionsAllFieldsSettable) {
       "data_block_index_type=kDataBlockBinaryAndHash;"
       "index_shortening=kNoShortening;"
       "data_block_hash_table_util_ratio=0.75;"
+      "data_block_restart_key_prefix=true;"
       "checksum=kxxHash;no_block_cache=1;"
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;"
       "block_size_deviation=8;block_restart_interval=4; "
+      "adaptive_block_restart_interval=true;"
       "metadata_block_size=1024;"
       "partition_filters=false;"
       "optimize_filters_for_memory=true;"
@@ -339,6 +341,8 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "enable_pipelined_write=false;"
                              "unordered_write=false;"
                              "allow_concurrent_memtable_write=true;"
+                             "memtable_sorted_batch_insert=false;"
+                             "parallel_wal_writes=false;"
                              "wal_recovery_mode=kPointInTimeRecovery;"
                              "enable_write_thread_adaptive_yield=true;"
                              "write_thread_slow_yield_usec=5;"
@@ -351,6 +355,7 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "allow_ingest_behind=false;"
                              "concurrent_prepare=false;"
                              "two_write_queues=false;"
+                             "wal_per_write_queue=false;"
                              "manual_wal_flush=false;"
                              "wal_compression=kZSTD;"
                              "background_close_inactive_wals=true;"
@@ -366,6 +371,9 @@ TEST_F(OptionsSettableTest, DBOptionsAllFieldsSettable) {
                              "lowest_used_cache_tier=kNonVolatileBlockTier;"
                              "allow_data_in_errors=false;"
                              "enforce_single_del_contracts=false;"
+                             "compaction_async_write_buffers=2;"
+                             "compaction_pipelined_input_size=1048576;"
+                             "subcompaction_ranges_per_thread=4;"
                              "daily_offpeak_time_utc=08:30-19:00;",
                              new_options));
 
@@ -491,6 +499,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "bloom_locality=8016;"
       "target_file_size_base=4294976376;"
       "memtable_huge_page_size=2557;"
+      "memtable_numa_aware=true;"
       "max_successive_merges=5497;"
       "strict_max_successive_merges=true;"
       "max_sequential_skip_in_iterations=4294971408;"
@@ -530,6 +539,7 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "force_consistency_checks=true;"
       "inplace_update_num_locks=7429;"
       "experimental_mempurge_threshold=0.0001;"
+      "memtable_resident=true;"
       "optimize_filters_for_hits=false;"
       "level_compaction_dynamic_level_bytes=false;"
       "level_compaction_dynamic_file_size=true;"
@@ -566,7 +576,9 @@ TEST_F(OptionsSettableTest, ColumnFamilyOptionsAllFieldsSettable) {
       "persist_user_defined_timestamps=true;"
       "block_protection_bytes_per_key=1;"
       "memtable_max_range_deletions=999999;"
+      "memtable_value_separation_min_size=4096;"
       "bottommost_file_compaction_delay=7200;"
+      "max_flush_partitions=3;"
       "uncache_aggressiveness=1234;",
       new_options));
 
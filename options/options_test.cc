@@ -1335,6 +1335,16 @@ TEST_F(OptionsTest, MemTableRepFactoryCreateFromString) {
       config_options, "id=vector; count=42", &new_mem_factory));
   ASSERT_NOK(MemTableRepFactory::CreateFromString(
       config_options, "id=vector; invalid=unknown", &new_mem_factory));
+  ASSERT_OK(MemTableRepFactory::CreateFromString(config_options, "btree",
+                                                 &new_mem_factory));
+  ASSERT_STREQ(new_mem_factory->Name(), "BTreeRepFactory");
+  ASSERT_TRUE(new_mem_factory->IsInstanceOf("btree"));
+  ASSERT_TRUE(new_mem_factory->IsInstanceOf("BTreeRepFactory"));
+  ASSERT_TRUE(new_mem_factory->IsInsertConcurrentlySupported());
+  ASSERT_OK(MemTableRepFactory::CreateFromString(
+      config_options, "id=BTreeRepFactory", &new_mem_factory));
+  ASSERT_NOK(MemTableRepFactory::CreateFromString(
+      config_options, "id=btree; invalid=unknown", &new_mem_factory));
   ASSERT_NOK(MemTableRepFactory::CreateFromString(config_options, "cuckoo",
                                                   &new_mem_factory));
   // CuckooHash memtable is already removed.
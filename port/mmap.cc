@@ -5,6 +5,10 @@
 
 #include "port/mmap.h"
 
+#if defined(NUMA) && !defined(OS_WIN)
+#include <numaif.h>
+#endif  // NUMA && !OS_WIN
+
 #include <cassert>
 #include <cstdio>
 #include <cstring>
@@ -95,4 +99,23 @@ MemMapping MemMapping::AllocateLazyZeroed(size_t length) {
   return AllocateAnonymous(length, /*huge*/ false);
 }
 
+MemMapping MemMapping::AllocateOnNumaNode(size_t length, bool huge,
+                                          int numa_node) {
+  MemMapping mm = AllocateAnonymous(length, huge);
+#if defined(NUMA) && !defined(OS_WIN)
+  constexpr int kBitsPerWord = static_cast<int>(8 * sizeof(unsigned long));
+  unsigned long nodemask[4] = {};
+  constexpr int kMaxNodes = static_cast<int>(4 * kBitsPerWord);
+  if (mm.addr_ != nullptr && numa_node >= 0 && numa_node < kMaxNodes) {
+    nodemask[numa_node / kBitsPerWord] |= 1UL << (numa_node % kBitsPerWord);
+    // Nothing has touched the mapping yet, so the policy applies to every
+    // page. Failure only costs locality, so the result is ignored.
+    (void)mbind(mm.addr_, length, MPOL_PREFERRED, nodemask, kMaxNodes, 0);
+  }
+#else
+  (void)numa_node;
+#endif  // NUMA && !OS_WIN
+  return mm;
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -40,6 +40,14 @@ class MemMapping {
   // back the full mapping.
   static MemMapping AllocateLazyZeroed(size_t length);
 
+  // Like AllocateLazyZeroed (or AllocateHuge if `huge`), but additionally
+  // asks the kernel to prefer backing the memory with pages from the given
+  // NUMA node (MPOL_PREFERRED). The placement is advisory: it is silently
+  // ignored when NUMA support was not compiled in (see WITH_NUMA), when the
+  // node does not exist, or when numa_node < 0.
+  static MemMapping AllocateOnNumaNode(size_t length, bool huge,
+                                       int numa_node);
+
   // No copies
   MemMapping(const MemMapping&) = delete;
   MemMapping& operator=(const MemMapping&) = delete;
@@ -15,6 +15,9 @@
 #if defined(__i386__) || defined(__x86_64__)
 #include <cpuid.h>
 #endif
+#ifdef NUMA
+#include <numa.h>
+#endif
 #include <sched.h>
 #include <sys/resource.h>
 #include <sys/time.h>
@@ -198,6 +201,31 @@ int PhysicalCoreID() {
 #endif
 }
 
+int NumaNodeCount() {
+#ifdef NUMA
+  if (numa_available() < 0) {
+    return 1;
+  }
+  return numa_max_node() + 1;
+#else
+  return 1;
+#endif  // NUMA
+}
+
+int NumaNodeOfCpu(int cpu) {
+#ifdef NUMA
+  if (cpu >= 0 && numa_available() >= 0) {
+    int node = numa_node_of_cpu(cpu);
+    if (node >= 0) {
+      return node;
+    }
+  }
+#else
+  (void)cpu;
+#endif  // NUMA
+  return 0;
+}
+
 void InitOnce(OnceType* once, void (*initializer)()) {
   PthreadCall("once", pthread_once(once, initializer));
 }
@@ -181,6 +181,13 @@ static inline void AsmVolatilePause() {
 // Returns -1 if not available on this platform
 int PhysicalCoreID();
 
+// Returns the number of NUMA nodes in the system, or 1 if NUMA support was not
+// compiled in (see WITH_NUMA) or is not available at runtime.
+int NumaNodeCount();
+
+// Returns the NUMA node of the given cpu, or 0 if unknown.
+int NumaNodeOfCpu(int cpu);
+
 using OnceType = pthread_once_t;
 #define LEVELDB_ONCE_INIT PTHREAD_ONCE_INIT
 void InitOnce(OnceType* once, void (*initializer)());
@@ -255,6 +255,11 @@ static inline void AsmVolatilePause() {
 
 int PhysicalCoreID();
 
+// NUMA placement is not supported on Windows; the system is presented as a
+// single node.
+inline int NumaNodeCount() { return 1; }
+inline int NumaNodeOfCpu(int /*cpu*/) { return 0; }
+
 // For Thread Local Storage abstraction
 using pthread_key_t = DWORD;
 
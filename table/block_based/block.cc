@@ -22,6 +22,7 @@
 #include "rocksdb/comparator.h"
 #include "table/block_based/block_prefix_index.h"
 #include "table/block_based/data_block_footer.h"
+#include "table/block_based/learned_index.h"
 #include "table/format.h"
 #include "util/coding.h"
 
@@ -299,6 +300,18 @@ void DataBlockIter::PrevImpl() {
   prev_entries_idx_ = static_cast<int32_t>(prev_entries_.size()) - 1;
 }
 
+inline bool DataBlockIter::BinarySeekWithRestartKeyPrefix(
+    const Slice& target, uint32_t* index, bool* skip_linear_scan) {
+  if (restart_key_prefix_index_ == nullptr) {
+    return BinarySeek<DecodeKey>(target, index, skip_linear_scan);
+  }
+  uint32_t lower = 0;
+  uint32_t upper = 0;
+  restart_key_prefix_index_->FindRestartRange(ExtractUserKey(target), &lower,
+                                              &upper);
+  return BinarySeek<DecodeKey>(target, index, skip_linear_scan, lower, upper);
+}
+
 void DataBlockIter::SeekImpl(const Slice& target) {
   Slice seek_key = target;
   PERF_TIMER_GUARD(block_seek_nanos);
@@ -307,7 +320,7 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = BinarySeekWithRestartKeyPrefix(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -494,10 +507,19 @@ void IndexBlockIter::SeekImpl(const Slice& target) {
     // restart interval must be one when hash search is enabled so the binary
     // search simply lands at the right place.
     skip_linear_scan = true;
-  } else if (value_delta_encoded_) {
-    ok = BinarySeek<DecodeKeyV4>(seek_key, &index, &skip_linear_scan);
   } else {
-    ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+    uint32_t lower = 0;
+    uint32_t upper = std::numeric_limits<uint32_t>::max();
+    if (learned_index_) {
+      learned_index_->FindRestartRange(ExtractUserKey(target), &lower, &upper);
+    }
+    if (value_delta_encoded_) {
+      ok = BinarySeek<DecodeKeyV4>(seek_key, &index, &skip_linear_scan, lower,
+                                   upper);
+    } else {
+      ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan, lower,
+                                 upper);
+    }
   }
 
   if (!ok) {
@@ -514,7 +536,7 @@ void DataBlockIter::SeekForPrevImpl(const Slice& target) {
   }
   uint32_t index = 0;
   bool skip_linear_scan = false;
-  bool ok = BinarySeek<DecodeKey>(seek_key, &index, &skip_linear_scan);
+  bool ok = BinarySeekWithRestartKeyPrefix(seek_key, &index, &skip_linear_scan);
 
   if (!ok) {
     return;
@@ -827,7 +849,8 @@ void BlockIter<TValue>::FindKeyAfterBinarySeek(const Slice& target,
 template <class TValue>
 template <typename DecodeKeyFunc>
 bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
-                                   bool* skip_linear_scan) {
+                                   bool* skip_linear_scan, uint32_t lower,
+                                   uint32_t upper) {
   if (restarts_ == 0) {
     // SST files dedicated to range tombstones are written with index blocks
     // that have no keys while also having `num_restarts_ == 1`. This would
@@ -845,7 +868,9 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   //   keys.
   // - Any restart keys after index `right` are strictly greater than the target
   //   key.
-  int64_t left = -1, right = num_restarts_ - 1;
+  int64_t left = static_cast<int64_t>(lower) - 1;
+  int64_t right = static_cast<int64_t>(std::min(upper, num_restarts_)) - 1;
+  assert(left <= right);
   while (left != right) {
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
@@ -1037,6 +1062,20 @@ uint32_t Block::NumRestarts() const {
   return num_restarts;
 }
 
+bool Block::HasRestartKeyPrefix() const {
+  assert(size_ >= 2 * sizeof(uint32_t));
+  if (size_ > kMaxBlockSizeSupportedByHashIndex) {
+    // The check is for the same reason as that in NumRestarts()
+    return false;
+  }
+  uint32_t block_footer = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  bool has_restart_key_prefix = false;
+  UnPackIndexTypeAndNumRestarts(block_footer, nullptr /* index_type */,
+                                nullptr /* num_restarts */,
+                                &has_restart_key_prefix);
+  return has_restart_key_prefix;
+}
+
 BlockBasedTableOptions::DataBlockIndexType Block::IndexType() const {
   assert(size_ >= 2 * sizeof(uint32_t));
   if (size_ > kMaxBlockSizeSupportedByHashIndex) {
@@ -1070,28 +1109,39 @@ Block::Block(BlockContents&& contents, size_t read_amp_bytes_per_bit,
   } else {
     // Should only decode restart points for uncompressed blocks
     num_restarts_ = NumRestarts();
-    switch (IndexType()) {
+    // End of the restarts array and, if present, the hash index
+    size_t index_end = size_ - sizeof(uint32_t); /* chop off NUM_RESTARTS */
+    if (HasRestartKeyPrefix()) {
+      size_t prefix_index_size =
+          static_cast<size_t>(num_restarts_) * kRestartKeyPrefixSize;
+      if (prefix_index_size > index_end) {
+        size_ = 0;  // Error marker
+      } else {
+        index_end -= prefix_index_size;
+        restart_key_prefix_index_.Initialize(data_ + index_end,
+                                             num_restarts_);
+      }
+    }
+    switch (size_ == 0 ? BlockBasedTableOptions::kDataBlockBinarySearch
+                       : IndexType()) {
       case BlockBasedTableOptions::kDataBlockBinarySearch:
-        restart_offset_ = static_cast<uint32_t>(size_) -
-                          (1 + num_restarts_) * sizeof(uint32_t);
-        if (restart_offset_ > size_ - sizeof(uint32_t)) {
+        restart_offset_ = static_cast<uint32_t>(index_end) -
+                          num_restarts_ * sizeof(uint32_t);
+        if (size_ == 0 || restart_offset_ > index_end) {
           // The size is too small for NumRestarts() and therefore
           // restart_offset_ wrapped around.
           size_ = 0;
         }
         break;
       case BlockBasedTableOptions::kDataBlockBinaryAndHash:
-        if (size_ < sizeof(uint32_t) /* block footer */ +
-                        sizeof(uint16_t) /* NUM_BUCK */) {
+        if (index_end < sizeof(uint16_t) /* NUM_BUCK */) {
           size_ = 0;
           break;
         }
 
         uint16_t map_offset;
         data_block_hash_index_.Initialize(
-            data_, static_cast<uint16_t>(size_ - sizeof(uint32_t)), /*chop off
-                                                                NUM_RESTARTS*/
-            &map_offset);
+            data_, static_cast<uint16_t>(index_end), &map_offset);
 
         restart_offset_ = map_offset - num_restarts_ * sizeof(uint32_t);
 
@@ -1279,6 +1329,9 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
         read_amp_bitmap_.get(), block_contents_pinned,
         user_defined_timestamps_persisted,
         data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
+        restart_key_prefix_index_.Valid() && raw_ucmp == BytewiseComparator()
+            ? &restart_key_prefix_index_
+            : nullptr,
         protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
@@ -1296,7 +1349,7 @@ IndexBlockIter* Block::NewIndexIterator(
     IndexBlockIter* iter, Statistics* /*stats*/, bool total_order_seek,
     bool have_first_key, bool key_includes_seq, bool value_is_full,
     bool block_contents_pinned, bool user_defined_timestamps_persisted,
-    BlockPrefixIndex* prefix_index) {
+    BlockPrefixIndex* prefix_index, const LearnedIndexModel* learned_index) {
   IndexBlockIter* ret_iter;
   if (iter != nullptr) {
     ret_iter = iter;
@@ -1314,16 +1367,69 @@ IndexBlockIter* Block::NewIndexIterator(
   } else {
     BlockPrefixIndex* prefix_index_ptr =
         total_order_seek ? nullptr : prefix_index;
+    // The model is only usable for the index block it was built with
+    const LearnedIndexModel* learned_index_ptr =
+        learned_index != nullptr &&
+                learned_index->NumRestarts() == num_restarts_ &&
+                raw_ucmp == BytewiseComparator()
+            ? learned_index
+            : nullptr;
     ret_iter->Initialize(
         raw_ucmp, data_, restart_offset_, num_restarts_, global_seqno,
         prefix_index_ptr, have_first_key, key_includes_seq, value_is_full,
         block_contents_pinned, user_defined_timestamps_persisted,
-        protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
+        protection_bytes_per_key_, kv_checksum_, block_restart_interval_,
+        learned_index_ptr);
   }
 
   return ret_iter;
 }
 
+namespace {
+// Prefetches the elements of a sorted array of `num` `elem_size`-byte
+// elements that a binary search over it probes first, i.e. the top levels of
+// the implicit search tree, so that their cache misses overlap rather than
+// being taken one after the other.
+void PrefetchBinarySearchProbes(const char* base, uint32_t num,
+                                size_t elem_size) {
+  constexpr uint32_t kLevels = 3;
+  for (uint32_t level = 1; level <= kLevels && num >= (1u << level);
+       ++level) {
+    const uint32_t parts = 1u << level;
+    for (uint32_t i = 1; i < parts; i += 2) {
+      const uint64_t pos = uint64_t{num} * i / parts;
+      PREFETCH(base + pos * elem_size, 0 /* rw */, 3 /* locality */);
+    }
+  }
+}
+}  // namespace
+
+void Block::PrefetchForSeek(const Slice& user_key) const {
+  if (size_ == 0) {
+    return;
+  }
+  if (data_block_hash_index_.Valid()) {
+    data_block_hash_index_.Prefetch(
+        data_, restart_offset_ + num_restarts_ * sizeof(uint32_t), user_key);
+  }
+  PrefetchBinarySearchProbes(data_ + restart_offset_, num_restarts_,
+                             sizeof(uint32_t));
+  if (restart_key_prefix_index_.Valid()) {
+    // The prefix index sits right before the block footer
+    PrefetchBinarySearchProbes(data_ + size_ - sizeof(uint32_t) -
+                                   num_restarts_ * kRestartKeyPrefixSize,
+                               num_restarts_, kRestartKeyPrefixSize);
+  }
+}
+
+void IndexBlockIter::PrefetchForSeek() const {
+  if (data_ == nullptr) {
+    return;
+  }
+  PrefetchBinarySearchProbes(data_ + restarts_, num_restarts_,
+                             sizeof(uint32_t));
+}
+
 size_t Block::ApproximateMemoryUsage() const {
   size_t usage = usable_size();
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
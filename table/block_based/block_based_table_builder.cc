@@ -11,10 +11,14 @@
 
 #include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstdio>
+#include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -52,7 +56,7 @@
 #include "util/compression.h"
 #include "util/stop_watch.h"
 #include "util/string_util.h"
-#include "util/work_queue.h"
+#include "util/threadpool_imp.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -460,7 +464,13 @@ struct BlockBasedTableBuilder::Rep {
                        ? BlockBasedTableOptions::kDataBlockBinarySearch
                        : table_options.data_block_index_type,
                    table_options.data_block_hash_table_util_ratio, ts_sz,
-                   persist_user_defined_timestamps),
+                   persist_user_defined_timestamps, false /* is_user_key */,
+                   table_options.data_block_restart_key_prefix &&
+                       tbo.internal_comparator.user_comparator() ==
+                           BytewiseComparator() &&
+                       ts_sz == 0,
+                   table_options.adaptive_block_restart_interval &&
+                       table_options.use_delta_encoding),
         range_del_block(
             1 /* block_restart_interval */, true /* use_delta_encoding */,
             false /* use_value_delta_encoding */,
@@ -686,8 +696,6 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
   };
   std::unique_ptr<Keys> curr_block_keys;
 
-  class BlockRepSlot;
-
   // BlockRep instances are fetched from and recycled to
   // block_rep_pool during parallel compression.
   struct BlockRep {
@@ -698,51 +706,35 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     CompressionType compression_type;
     std::unique_ptr<std::string> first_key_in_next_block;
     std::unique_ptr<Keys> keys;
-    std::unique_ptr<BlockRepSlot> slot;
     Status status;
+    // Contexts only used for compressing this block, so that the blocks in
+    // flight can be compressed concurrently.
+    const CompressionContext* compression_ctx;
+    UncompressionContext* verify_ctx;
+    // Time spent compressing (and verifying) the block
+    uint64_t compress_nanos;
+    // Set by the compression job when done, protected by `mutex`
+    bool compressed;
   };
   // Use a vector of BlockRep as a buffer for a determined number
   // of BlockRep structures. All data referenced by pointers in
   // BlockRep will be freed when this vector is destructed.
   using BlockRepBuffer = std::vector<BlockRep>;
   BlockRepBuffer block_rep_buf;
-  // Use a thread-safe queue for concurrent access from block
-  // building thread and writer thread.
-  using BlockRepPool = WorkQueue<BlockRep*>;
-  BlockRepPool block_rep_pool;
-
-  // Use BlockRepSlot to keep block order in write thread.
-  // slot_ will pass references to BlockRep
-  class BlockRepSlot {
-   public:
-    BlockRepSlot() : slot_(1) {}
-    template <typename T>
-    void Fill(T&& rep) {
-      slot_.push(std::forward<T>(rep));
-    }
-    void Take(BlockRep*& rep) { slot_.pop(rep); }
+  // BlockReps not in flight. Only accessed by the builder's thread.
+  std::vector<BlockRep*> block_rep_pool;
 
-   private:
-    // slot_ will pass references to BlockRep in block_rep_buf,
-    // and those references are always valid before the destruction of
-    // block_rep_buf.
-    WorkQueue<BlockRep*> slot_;
-  };
+  // Blocks submitted to the compression thread pool, in file order. The
+  // builder's thread writes them to the file once they are compressed, which
+  // keeps the index, filter and file writes single threaded.
+  std::deque<BlockRep*> inflight;
+  std::mutex mutex;
+  std::condition_variable compressed_cond;
 
-  // Compression queue will pass references to BlockRep in block_rep_buf,
-  // and those references are always valid before the destruction of
-  // block_rep_buf.
-  using CompressQueue = WorkQueue<BlockRep*>;
-  CompressQueue compress_queue;
-  std::vector<port::Thread> compress_thread_pool;
-
-  // Write queue will pass references to BlockRep::slot in block_rep_buf,
-  // and those references are always valid before the corresponding
-  // BlockRep::slot is destructed, which is before the destruction of
-  // block_rep_buf.
-  using WriteQueue = WorkQueue<BlockRepSlot*>;
-  WriteQueue write_queue;
-  std::unique_ptr<port::Thread> write_thread;
+  // Shared by all table builders, see GetParallelCompressionThreadPool()
+  ThreadPoolImpl* thread_pool;
+  // Compresses a block, run in thread_pool
+  std::function<void(BlockRep*)> compress_block;
 
   // Estimate output file size when parallel compression is enabled. This is
   // necessary because compression & flush are no longer synchronized,
@@ -840,27 +832,34 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     std::atomic<uint64_t> uncomp_bytes_inflight;
     // Number of blocks under compression and not appended yet.
     std::atomic<uint64_t> blocks_inflight;
-    // Current compression ratio, maintained by BGWorkWriteMaybeCompressedBlock.
+    // Current compression ratio, maintained by WriteCompressedBlocks.
     std::atomic<double> curr_compression_ratio;
     // Estimated SST file size.
     std::atomic<uint64_t> estimated_file_size;
   };
   FileSizeEstimator file_size_estimator;
 
-  // Facilities used for waiting first block completion. Need to Wait for
-  // the completion of first block compression and flush to get a non-zero
-  // compression ratio.
-  std::atomic<bool> first_block_processed;
-  std::condition_variable first_block_cond;
-  std::mutex first_block_mutex;
+  // Whether a block has been written. Until then, the estimator has no
+  // compression ratio, so the first block is waited for right away.
+  bool first_block_processed;
+
+  // Time spent by the compression jobs of written blocks, and by the
+  // builder's thread waiting for blocks to be compressed.
+  uint64_t compress_nanos;
+  uint64_t wait_nanos;
 
-  explicit ParallelCompressionRep(uint32_t parallel_threads)
+  ParallelCompressionRep(
+      uint32_t parallel_threads,
+      const std::vector<std::unique_ptr<CompressionContext>>& compression_ctxs,
+      const std::vector<std::unique_ptr<UncompressionContext>>& verify_ctxs,
+      ThreadPoolImpl* _thread_pool)
       : curr_block_keys(new Keys()),
         block_rep_buf(parallel_threads),
-        block_rep_pool(parallel_threads),
-        compress_queue(parallel_threads),
-        write_queue(parallel_threads),
-        first_block_processed(false) {
+        thread_pool(_thread_pool),
+        first_block_processed(false),
+        compress_nanos(0),
+        wait_nanos(0) {
+    block_rep_pool.reserve(parallel_threads);
     for (uint32_t i = 0; i < parallel_threads; i++) {
       block_rep_buf[i].contents = Slice();
       block_rep_buf[i].compressed_contents = Slice();
@@ -869,13 +868,16 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
       block_rep_buf[i].compression_type = CompressionType();
       block_rep_buf[i].first_key_in_next_block.reset(new std::string());
       block_rep_buf[i].keys.reset(new Keys());
-      block_rep_buf[i].slot.reset(new BlockRepSlot());
       block_rep_buf[i].status = Status::OK();
-      block_rep_pool.push(&block_rep_buf[i]);
+      block_rep_buf[i].compression_ctx = compression_ctxs[i].get();
+      block_rep_buf[i].verify_ctx = verify_ctxs[i].get();
+      block_rep_buf[i].compress_nanos = 0;
+      block_rep_buf[i].compressed = false;
+      block_rep_pool.push_back(&block_rep_buf[i]);
     }
   }
 
-  ~ParallelCompressionRep() { block_rep_pool.finish(); }
+  ~ParallelCompressionRep() { assert(inflight.empty()); }
 
   // Make a block prepared to be emitted to compression thread
   // Used in non-buffered mode
@@ -906,43 +908,52 @@ struct BlockBasedTableBuilder::ParallelCompressionRep {
     return block_rep;
   }
 
-  // Emit a block to compression thread
+  // Emit a block to the compression thread pool
   void EmitBlock(BlockRep* block_rep) {
     assert(block_rep != nullptr);
     assert(block_rep->status.ok());
-    if (!write_queue.push(block_rep->slot.get())) {
-      return;
-    }
-    if (!compress_queue.push(block_rep)) {
-      return;
-    }
+    block_rep->compressed = false;
+    inflight.push_back(block_rep);
+    // compress_block uses the builder through the `this` it captures, which
+    // is safe because StopParallelCompression() waits for every emitted
+    // block before the builder is destroyed. The job still runs a copy of the
+    // function, as the builder may be destroyed as soon as MarkCompressed()
+    // has returned, before the call to the function does.
+    thread_pool->SubmitJob(
+        [fn = compress_block, block_rep]() { fn(block_rep); });
+  }
 
-    if (!first_block_processed.load(std::memory_order_relaxed)) {
-      std::unique_lock<std::mutex> lock(first_block_mutex);
-      first_block_cond.wait(lock, [this] {
-        return first_block_processed.load(std::memory_order_relaxed);
-      });
-    }
+  // Called by the compression job as the last access to this block
+  void MarkCompressed(BlockRep* block_rep) {
+    std::lock_guard<std::mutex> lock(mutex);
+    block_rep->compressed = true;
+    compressed_cond.notify_all();
+  }
+
+  bool IsCompressed(BlockRep* block_rep) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return block_rep->compressed;
+  }
+
+  void WaitForCompression(BlockRep* block_rep) {
+    std::unique_lock<std::mutex> lock(mutex);
+    compressed_cond.wait(lock, [block_rep] { return block_rep->compressed; });
   }
 
-  // Reap a block from compression thread
+  // Recycle a block once written
   void ReapBlock(BlockRep* block_rep) {
     assert(block_rep != nullptr);
     block_rep->compressed_data->clear();
-    block_rep_pool.push(block_rep);
-
-    if (!first_block_processed.load(std::memory_order_relaxed)) {
-      std::lock_guard<std::mutex> lock(first_block_mutex);
-      first_block_processed.store(true, std::memory_order_relaxed);
-      first_block_cond.notify_one();
-    }
+    block_rep_pool.push_back(block_rep);
+    first_block_processed = true;
   }
 
  private:
   BlockRep* PrepareBlockInternal(CompressionType compression_type,
                                  const Slice* first_key_in_next_block) {
-    BlockRep* block_rep = nullptr;
-    block_rep_pool.pop(block_rep);
+    assert(!block_rep_pool.empty());
+    BlockRep* block_rep = block_rep_pool.back();
+    block_rep_pool.pop_back();
     assert(block_rep != nullptr);
 
     assert(block_rep->data);
@@ -1134,6 +1145,13 @@ void BlockBasedTableBuilder::Flush() {
   }
   if (r->IsParallelCompressionEnabled() &&
       r->state == Rep::State::kUnbuffered) {
+    if (r->pc_rep->block_rep_pool.empty()) {
+      // All blocks are in flight, write the oldest one to make room
+      WriteCompressedBlocks(1);
+      if (!ok()) {
+        return;
+      }
+    }
     r->data_block.Finish();
     ParallelCompressionRep::BlockRep* block_rep = r->pc_rep->PrepareBlock(
         r->compression_type, r->first_key_in_next_block, &(r->data_block));
@@ -1141,6 +1159,9 @@ void BlockBasedTableBuilder::Flush() {
     r->pc_rep->file_size_estimator.EmitBlock(block_rep->data->size(),
                                              r->get_offset());
     r->pc_rep->EmitBlock(block_rep);
+    // Write whatever is already compressed. The first block is waited for,
+    // so that the file size estimator has a compression ratio.
+    WriteCompressedBlocks(r->pc_rep->first_block_processed ? 0 : 1);
   } else {
     WriteBlock(&r->data_block, &r->pending_handle, BlockType::kData);
   }
@@ -1192,21 +1213,6 @@ void BlockBasedTableBuilder::WriteBlock(const Slice& uncompressed_block_data,
   }
 }
 
-void BlockBasedTableBuilder::BGWorkCompression(
-    const CompressionContext& compression_ctx,
-    UncompressionContext* verify_ctx) {
-  ParallelCompressionRep::BlockRep* block_rep = nullptr;
-  while (rep_->pc_rep->compress_queue.pop(block_rep)) {
-    assert(block_rep != nullptr);
-    CompressAndVerifyBlock(block_rep->contents, true, /* is_data_block*/
-                           compression_ctx, verify_ctx,
-                           block_rep->compressed_data.get(),
-                           &block_rep->compressed_contents,
-                           &(block_rep->compression_type), &block_rep->status);
-    block_rep->slot->Fill(block_rep);
-  }
-}
-
 void BlockBasedTableBuilder::CompressAndVerifyBlock(
     const Slice& uncompressed_block_data, bool is_data_block,
     const CompressionContext& compression_ctx, UncompressionContext* verify_ctx,
@@ -1447,20 +1453,34 @@ void BlockBasedTableBuilder::WriteMaybeCompressedBlock(
   }
 }
 
-void BlockBasedTableBuilder::BGWorkWriteMaybeCompressedBlock() {
+void BlockBasedTableBuilder::WriteCompressedBlocks(size_t min_blocks) {
   Rep* r = rep_;
-  ParallelCompressionRep::BlockRepSlot* slot = nullptr;
-  ParallelCompressionRep::BlockRep* block_rep = nullptr;
-  while (r->pc_rep->write_queue.pop(slot)) {
-    assert(slot != nullptr);
-    slot->Take(block_rep);
-    assert(block_rep != nullptr);
+  ParallelCompressionRep* pc_rep = r->pc_rep.get();
+  size_t blocks_written = 0;
+  while (!pc_rep->inflight.empty()) {
+    ParallelCompressionRep::BlockRep* block_rep = pc_rep->inflight.front();
+    if (!pc_rep->IsCompressed(block_rep)) {
+      if (blocks_written >= min_blocks) {
+        break;
+      }
+      StopWatchNano timer(r->ioptions.clock, true /* auto_start */);
+      pc_rep->WaitForCompression(block_rep);
+      pc_rep->wait_nanos += timer.ElapsedNanos();
+    }
+    pc_rep->inflight.pop_front();
+    blocks_written++;
+    pc_rep->compress_nanos += block_rep->compress_nanos;
+
     if (!block_rep->status.ok()) {
       r->SetStatus(block_rep->status);
-      // Reap block so that blocked Flush() can finish
-      // if there is one, and Flush() will notice !ok() next time.
+      // Reap block so that it can be reused, and Flush() will notice !ok()
+      // next time.
       block_rep->status = Status::OK();
-      r->pc_rep->ReapBlock(block_rep);
+      pc_rep->ReapBlock(block_rep);
+      continue;
+    }
+    if (!ok()) {
+      pc_rep->ReapBlock(block_rep);
       continue;
     }
 
@@ -1472,55 +1492,78 @@ void BlockBasedTableBuilder::BGWorkWriteMaybeCompressedBlock() {
       r->index_builder->OnKeyAdded(key);
     }
 
-    r->pc_rep->file_size_estimator.SetCurrBlockUncompSize(
+    pc_rep->file_size_estimator.SetCurrBlockUncompSize(
         block_rep->data->size());
     WriteMaybeCompressedBlock(block_rep->compressed_contents,
                               block_rep->compression_type, &r->pending_handle,
                               BlockType::kData, &block_rep->contents);
-    if (!ok()) {
-      break;
-    }
-
-    r->props.data_size = r->get_offset();
-    ++r->props.num_data_blocks;
+    if (ok()) {
+      r->props.data_size = r->get_offset();
+      ++r->props.num_data_blocks;
 
-    if (block_rep->first_key_in_next_block == nullptr) {
-      r->index_builder->AddIndexEntry(&(block_rep->keys->Back()), nullptr,
-                                      r->pending_handle);
-    } else {
-      Slice first_key_in_next_block =
-          Slice(*block_rep->first_key_in_next_block);
-      r->index_builder->AddIndexEntry(&(block_rep->keys->Back()),
-                                      &first_key_in_next_block,
-                                      r->pending_handle);
+      if (block_rep->first_key_in_next_block == nullptr) {
+        r->index_builder->AddIndexEntry(&(block_rep->keys->Back()), nullptr,
+                                        r->pending_handle);
+      } else {
+        Slice first_key_in_next_block =
+            Slice(*block_rep->first_key_in_next_block);
+        r->index_builder->AddIndexEntry(&(block_rep->keys->Back()),
+                                        &first_key_in_next_block,
+                                        r->pending_handle);
+      }
     }
 
-    r->pc_rep->ReapBlock(block_rep);
+    pc_rep->ReapBlock(block_rep);
   }
 }
 
+namespace {
+// Compression jobs of all table builders run in one process-wide pool, which
+// grows to the largest `parallel_threads` requested so far. This avoids
+// creating and joining threads for every SST file.
+ThreadPoolImpl* GetParallelCompressionThreadPool(int num_threads) {
+  struct SharedThreadPool {
+    ~SharedThreadPool() { pool.JoinAllThreads(); }
+    ThreadPoolImpl pool;
+  };
+  static SharedThreadPool shared_pool;
+  shared_pool.pool.IncBackgroundThreadsIfNeeded(num_threads);
+  return &shared_pool.pool;
+}
+}  // namespace
+
 void BlockBasedTableBuilder::StartParallelCompression() {
-  rep_->pc_rep.reset(
-      new ParallelCompressionRep(rep_->compression_opts.parallel_threads));
-  rep_->pc_rep->compress_thread_pool.reserve(
-      rep_->compression_opts.parallel_threads);
-  for (uint32_t i = 0; i < rep_->compression_opts.parallel_threads; i++) {
-    rep_->pc_rep->compress_thread_pool.emplace_back([this, i] {
-      BGWorkCompression(*(rep_->compression_ctxs[i]),
-                        rep_->verify_ctxs[i].get());
-    });
-  }
-  rep_->pc_rep->write_thread.reset(
-      new port::Thread([this] { BGWorkWriteMaybeCompressedBlock(); }));
+  Rep* r = rep_;
+  r->pc_rep.reset(new ParallelCompressionRep(
+      r->compression_opts.parallel_threads, r->compression_ctxs,
+      r->verify_ctxs,
+      GetParallelCompressionThreadPool(
+          static_cast<int>(r->compression_opts.parallel_threads))));
+  r->pc_rep->compress_block = [this](ParallelCompressionRep::BlockRep* br) {
+    StopWatchNano timer(rep_->ioptions.clock, true /* auto_start */);
+    CompressAndVerifyBlock(br->contents, true, /* is_data_block*/
+                           *br->compression_ctx, br->verify_ctx,
+                           br->compressed_data.get(), &br->compressed_contents,
+                           &(br->compression_type), &br->status);
+    br->compress_nanos = timer.ElapsedNanos();
+    rep_->pc_rep->MarkCompressed(br);
+  };
 }
 
-void BlockBasedTableBuilder::StopParallelCompression() {
-  rep_->pc_rep->compress_queue.finish();
-  for (auto& thread : rep_->pc_rep->compress_thread_pool) {
-    thread.join();
+void BlockBasedTableBuilder::StopParallelCompression(bool abandon) {
+  ParallelCompressionRep* pc_rep = rep_->pc_rep.get();
+  if (!abandon) {
+    WriteCompressedBlocks(std::numeric_limits<size_t>::max());
+  }
+  // Not writing, or after a failure
+  while (!pc_rep->inflight.empty()) {
+    ParallelCompressionRep::BlockRep* block_rep = pc_rep->inflight.front();
+    pc_rep->inflight.pop_front();
+    pc_rep->WaitForCompression(block_rep);
+    block_rep->status.PermitUncheckedError();
+    block_rep->status = Status::OK();
+    pc_rep->ReapBlock(block_rep);
   }
-  rep_->pc_rep->write_queue.finish();
-  rep_->pc_rep->write_thread->join();
 }
 
 Status BlockBasedTableBuilder::status() const { return rep_->GetStatus(); }
@@ -1963,6 +2006,12 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
         keys.emplace_back(iter->key().ToString());
       }
 
+      if (r->pc_rep->block_rep_pool.empty()) {
+        WriteCompressedBlocks(1);
+        if (!ok()) {
+          break;
+        }
+      }
       ParallelCompressionRep::BlockRep* block_rep = r->pc_rep->PrepareBlock(
           r->compression_type, first_key_in_next_block_ptr, &data_block, &keys);
 
@@ -1970,6 +2019,7 @@ void BlockBasedTableBuilder::EnterUnbuffered() {
       r->pc_rep->file_size_estimator.EmitBlock(block_rep->data->size(),
                                                r->get_offset());
       r->pc_rep->EmitBlock(block_rep);
+      WriteCompressedBlocks(r->pc_rep->first_block_processed ? 0 : 1);
     } else {
       for (; iter->Valid(); iter->Next()) {
         Slice key = iter->key();
@@ -2014,7 +2064,7 @@ Status BlockBasedTableBuilder::Finish() {
     EnterUnbuffered();
   }
   if (r->IsParallelCompressionEnabled()) {
-    StopParallelCompression();
+    StopParallelCompression(false /* abandon */);
 #ifndef NDEBUG
     for (const auto& br : r->pc_rep->block_rep_buf) {
       assert(br.status.ok());
@@ -2069,7 +2119,7 @@ Status BlockBasedTableBuilder::Finish() {
 void BlockBasedTableBuilder::Abandon() {
   assert(rep_->state != Rep::State::kClosed);
   if (rep_->IsParallelCompressionEnabled()) {
-    StopParallelCompression();
+    StopParallelCompression(true /* abandon */);
   }
   rep_->state = Rep::State::kClosed;
 #ifdef ROCKSDB_ASSERT_STATUS_CHECKED  // Avoid unnecessary lock acquisition
@@ -2088,6 +2138,17 @@ bool BlockBasedTableBuilder::IsEmpty() const {
 
 uint64_t BlockBasedTableBuilder::FileSize() const { return rep_->offset; }
 
+void BlockBasedTableBuilder::GetParallelCompressionTimes(
+    uint64_t* compress_nanos, uint64_t* wait_nanos) const {
+  if (rep_->IsParallelCompressionEnabled()) {
+    *compress_nanos = rep_->pc_rep->compress_nanos;
+    *wait_nanos = rep_->pc_rep->wait_nanos;
+  } else {
+    *compress_nanos = 0;
+    *wait_nanos = 0;
+  }
+}
+
 uint64_t BlockBasedTableBuilder::EstimatedFileSize() const {
   if (rep_->IsParallelCompressionEnabled()) {
     // Use compression ratio so far and inflight uncompressed bytes to estimate
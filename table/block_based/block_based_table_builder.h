@@ -95,6 +95,9 @@ class BlockBasedTableBuilder : public TableBuilder {
   // all blocks after data blocks till the end of the SST file.
   uint64_t GetTailSize() const override;
 
+  void GetParallelCompressionTimes(uint64_t* compress_nanos,
+                                   uint64_t* wait_nanos) const override;
+
   bool NeedCompact() const override;
 
   // Get table properties
@@ -172,11 +175,6 @@ class BlockBasedTableBuilder : public TableBuilder {
   // compress it
   const uint64_t kCompressionSizeLimit = std::numeric_limits<int>::max();
 
-  // Get blocks from mem-table walking thread, compress them and
-  // pass them to the write thread. Used in parallel compression mode only
-  void BGWorkCompression(const CompressionContext& compression_ctx,
-                         UncompressionContext* verify_ctx);
-
   // Given uncompressed block content, try to compress it and return result and
   // compression type
   void CompressAndVerifyBlock(const Slice& uncompressed_block_data,
@@ -188,15 +186,18 @@ class BlockBasedTableBuilder : public TableBuilder {
                               CompressionType* result_compression_type,
                               Status* out_status);
 
-  // Get compressed blocks from BGWorkCompression and write them into SST
-  void BGWorkWriteMaybeCompressedBlock();
+  // Write the compressed blocks at the front of the parallel compression
+  // queue into SST, in order. Waits for compression until at least
+  // `min_blocks` blocks (or all blocks in flight) are written. Used in
+  // parallel compression mode only
+  void WriteCompressedBlocks(size_t min_blocks);
 
-  // Initialize parallel compression context and
-  // start BGWorkCompression and BGWorkWriteMaybeCompressedBlock threads
+  // Initialize parallel compression context, compression jobs run in a
+  // thread pool shared by all table builders
   void StartParallelCompression();
 
-  // Stop BGWorkCompression and BGWorkWriteMaybeCompressedBlock threads
-  void StopParallelCompression();
+  // Wait for the blocks in flight, writing them into SST unless `abandon`
+  void StopParallelCompression(bool abandon);
 };
 
 Slice CompressBlock(const Slice& uncompressed_data, const CompressionInfo& info,
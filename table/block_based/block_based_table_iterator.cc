@@ -266,6 +266,72 @@ void BlockBasedTableIterator::SeekToLast() {
   CheckDataBlockWithinUpperBound();
 }
 
+void BlockBasedTableIterator::Prepare(
+    const std::vector<ScanRange>& scan_ranges) {
+  if (prepared_blocks_ != nullptr) {
+    prepared_blocks_->clear();
+  }
+  if (table_->get_rep()->ioptions.allow_mmap_reads ||
+      read_options_.read_tier == kBlockCacheTier || async_read_in_progress_) {
+    return;
+  }
+
+  // Collecting the block handles moves index_iter_, so the iterator is left
+  // unpositioned.
+  ResetBlockCacheLookupVar();
+  ResetDataIter();
+  is_out_of_bound_ = false;
+  is_at_first_key_from_index_ = false;
+  is_index_at_curr_block_ = true;
+
+  // Cap the memory held by blocks read ahead of time. Blocks beyond it are
+  // read as usual when the iterator gets to them.
+  constexpr uint64_t kMaxPreparedBytes = 8 << 20;
+  std::vector<BlockHandle> handles;
+  uint64_t prepared_bytes = 0;
+  for (const ScanRange& range : scan_ranges) {
+    for (index_iter_->Seek(range.start);
+         index_iter_->Valid() && prepared_bytes < kMaxPreparedBytes;
+         index_iter_->Next()) {
+      const BlockHandle handle = index_iter_->value().handle;
+      handles.push_back(handle);
+      prepared_bytes += BlockBasedTable::BlockSizeWithTrailer(handle);
+      // Keys in the following blocks are larger than this index key.
+      if (user_comparator_.Compare(index_iter_->user_key(),
+                                   ExtractUserKey(range.limit)) >= 0) {
+        break;
+      }
+    }
+  }
+  if (handles.empty()) {
+    return;
+  }
+  std::sort(handles.begin(), handles.end(),
+            [](const BlockHandle& a, const BlockHandle& b) {
+              return a.offset() < b.offset();
+            });
+  handles.erase(std::unique(handles.begin(), handles.end(),
+                            [](const BlockHandle& a, const BlockHandle& b) {
+                              return a.offset() == b.offset();
+                            }),
+                handles.end());
+
+  std::vector<CachableEntry<Block>> blocks;
+  std::vector<Status> statuses;
+  table_->MultiReadDataBlocks(read_options_, handles, &blocks, &statuses);
+  if (prepared_blocks_ == nullptr) {
+    prepared_blocks_.reset(
+        new std::unordered_map<uint64_t, CachableEntry<Block>>());
+  }
+  for (size_t i = 0; i < handles.size(); ++i) {
+    // Blocks that failed to be read are retried, and their errors surfaced,
+    // by the regular read path.
+    if (statuses[i].ok() && blocks[i].GetValue() != nullptr) {
+      prepared_blocks_->emplace(handles[i].offset(), std::move(blocks[i]));
+    }
+  }
+}
+
 void BlockBasedTableIterator::Next() {
   if (is_at_first_key_from_index_ && !MaterializeCurrentBlock()) {
     return;
@@ -356,6 +422,13 @@ void BlockBasedTableIterator::InitDataBlock() {
     bool is_for_compaction =
         lookup_context_.caller == TableReaderCaller::kCompaction;
 
+    CachableEntry<Block>* prepared_block = nullptr;
+    if (prepared_blocks_ != nullptr && !prepared_blocks_->empty()) {
+      auto it = prepared_blocks_->find(data_block_handle.offset());
+      if (it != prepared_blocks_->end()) {
+        prepared_block = &it->second;
+      }
+    }
     // Initialize Data Block From CacheableEntry.
     if (is_in_cache) {
       Status s;
@@ -363,6 +436,13 @@ void BlockBasedTableIterator::InitDataBlock() {
       table_->NewDataBlockIterator<DataBlockIter>(
           read_options_, (block_handles_->front().cachable_entry_).As<Block>(),
           &block_iter_, s);
+    } else if (prepared_block != nullptr) {
+      // Read ahead of time by Prepare()
+      Status s;
+      block_iter_.Invalidate(Status::OK());
+      table_->NewDataBlockIterator<DataBlockIter>(
+          read_options_, *prepared_block, &block_iter_, s);
+      prepared_blocks_->erase(data_block_handle.offset());
     } else {
       auto* rep = table_->get_rep();
 
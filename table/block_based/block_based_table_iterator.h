@@ -8,6 +8,7 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #pragma once
 #include <deque>
+#include <unordered_map>
 
 #include "db/seqno_to_time_mapping.h"
 #include "table/block_based/block_based_table_reader.h"
@@ -53,6 +54,9 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   void SeekForPrev(const Slice& target) override;
   void SeekToFirst() override;
   void SeekToLast() override;
+  // Reads the data blocks overlapping `scan_ranges` with batched I/O. See
+  // InternalIteratorBase::Prepare().
+  void Prepare(const std::vector<ScanRange>& scan_ranges) override;
   void Next() final override;
   bool NextAndGetResult(IterateResult* result) override;
   void Prev() override;
@@ -341,6 +345,12 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   // `block_handles_` is lazily constructed to save CPU when it is unused
   std::unique_ptr<std::deque<BlockHandleInfo>> block_handles_;
 
+  // Data blocks read up front by Prepare(), keyed by block offset. A block is
+  // handed over to block_iter_ once the iterator reaches it.
+  // `prepared_blocks_` is lazily constructed to save CPU when it is unused
+  std::unique_ptr<std::unordered_map<uint64_t, CachableEntry<Block>>>
+      prepared_blocks_;
+
   // During cache lookup to find readahead size, index_iter_ is iterated and it
   // can point to a different block. is_index_at_curr_block_ keeps track of
   // that.
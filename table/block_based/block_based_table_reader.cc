@@ -56,6 +56,7 @@
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
 #include "table/block_based/hash_index_reader.h"
+#include "table/block_based/learned_index_reader.h"
 #include "table/block_based/partitioned_filter_block.h"
 #include "table/block_based/partitioned_index_reader.h"
 #include "table/block_fetcher.h"
@@ -1609,6 +1610,424 @@ Status BlockBasedTable::LookupAndPinBlocksInCache(
   return s;
 }
 
+void BlockBasedTable::PrepareDataBlockReads(const DataBlockHandles& handles,
+                                            char* scratch, bool use_fs_scratch,
+                                            DataBlockReads* reads) const {
+  RandomAccessFileReader* file = rep_->file.get();
+  // In direct IO mode, blocks share the direct io buffer.
+  // Otherwise, blocks share the scratch buffer.
+  const bool use_shared_buffer = file->use_direct_io() || scratch != nullptr;
+
+  auto& read_reqs = reads->read_reqs;
+  auto& req_idx_for_block = reads->req_idx_for_block;
+  auto& req_offset_for_block = reads->req_offset_for_block;
+  size_t buf_offset = 0;
+
+  uint64_t prev_offset = 0;
+  size_t prev_len = 0;
+  for (const BlockHandle& handle : handles) {
+    if (handle.IsNull()) {
+      continue;
+    }
+
+    size_t prev_end = static_cast<size_t>(prev_offset) + prev_len;
+
+    // If current block is adjacent to the previous one, at the same time,
+    // compression is enabled and there is no compressed cache, we combine
+    // the two block read as one.
+    // We don't combine block reads here in direct IO mode, because when doing
+    // direct IO read, the block requests will be realigned and merged when
+    // necessary.
+    if ((use_shared_buffer || use_fs_scratch) && !file->use_direct_io() &&
+        prev_end == handle.offset()) {
+      req_offset_for_block.emplace_back(prev_len);
+      prev_len += BlockSizeWithTrailer(handle);
+    } else {
+      // No compression or current block and previous one is not adjacent:
+      // Step 1, create a new request for previous blocks
+      if (prev_len != 0) {
+        FSReadRequest req;
+        req.offset = prev_offset;
+        req.len = prev_len;
+        if (file->use_direct_io() || use_fs_scratch) {
+          req.scratch = nullptr;
+        } else if (use_shared_buffer) {
+          req.scratch = scratch + buf_offset;
+          buf_offset += req.len;
+        } else {
+          req.scratch = new char[req.len];
+        }
+        read_reqs.emplace_back(std::move(req));
+      }
+
+      // Step 2, remember the previous block info
+      prev_offset = handle.offset();
+      prev_len = BlockSizeWithTrailer(handle);
+      req_offset_for_block.emplace_back(0);
+    }
+    req_idx_for_block.emplace_back(read_reqs.size());
+
+    PERF_COUNTER_ADD(block_read_count, 1);
+    PERF_COUNTER_ADD(block_read_byte, BlockSizeWithTrailer(handle));
+  }
+  // Handle the last block and process the pending last request
+  if (prev_len != 0) {
+    FSReadRequest req;
+    req.offset = prev_offset;
+    req.len = prev_len;
+    if (file->use_direct_io() || use_fs_scratch) {
+      req.scratch = nullptr;
+    } else if (use_shared_buffer) {
+      req.scratch = scratch + buf_offset;
+    } else {
+      req.scratch = new char[req.len];
+    }
+    read_reqs.emplace_back(std::move(req));
+  }
+}
+
+void BlockBasedTable::FinishDataBlockReads(
+    const ReadOptions& options, const DataBlockHandles& handles,
+    GetContext* const* get_contexts, char* scratch, bool use_fs_scratch,
+    const UncompressionDict& uncompression_dict, DataBlockReads* reads,
+    Status* statuses, CachableEntry<Block_kData>* results) const {
+  RandomAccessFileReader* file = rep_->file.get();
+  const Footer& footer = rep_->footer;
+  const ImmutableOptions& ioptions = rep_->ioptions;
+  size_t read_amp_bytes_per_bit = rep_->table_options.read_amp_bytes_per_bit;
+  MemoryAllocator* memory_allocator = GetMemoryAllocator(rep_->table_options);
+  const bool use_shared_buffer = file->use_direct_io() || scratch != nullptr;
+  auto& read_reqs = reads->read_reqs;
+  auto& req_idx_for_block = reads->req_idx_for_block;
+  auto& req_offset_for_block = reads->req_offset_for_block;
+
+  // Verify the checksums of all the blocks read successfully at once, so
+  // that they can be computed in parallel
+  std::array<Status, MultiGetContext::MAX_BATCH_SIZE> checksum_statuses;
+  if (options.verify_checksums) {
+    std::array<const char*, MultiGetContext::MAX_BATCH_SIZE> block_data;
+    std::array<size_t, MultiGetContext::MAX_BATCH_SIZE> block_sizes;
+    std::array<uint64_t, MultiGetContext::MAX_BATCH_SIZE> block_offsets;
+    std::array<size_t, MultiGetContext::MAX_BATCH_SIZE> block_valid_idx;
+    size_t num_to_verify = 0;
+    size_t valid_idx = 0;
+    for (const BlockHandle& handle : handles) {
+      if (handle.IsNull()) {
+        continue;
+      }
+      const FSReadRequest& req = read_reqs[req_idx_for_block[valid_idx]];
+      size_t req_offset = req_offset_for_block[valid_idx];
+      if (req.status.ok() && req.result.size() == req.len &&
+          req_offset + BlockSizeWithTrailer(handle) <= req.result.size()) {
+        block_data[num_to_verify] = req.result.data() + req_offset;
+        block_sizes[num_to_verify] = handle.size();
+        block_offsets[num_to_verify] = handle.offset();
+        block_valid_idx[num_to_verify] = valid_idx;
+        ++num_to_verify;
+      }
+      ++valid_idx;
+    }
+    std::array<Status, MultiGetContext::MAX_BATCH_SIZE> verify_statuses;
+    VerifyBlockChecksums(footer, num_to_verify, block_data.data(),
+                         block_sizes.data(), block_offsets.data(),
+                         rep_->file->file_name(), verify_statuses.data());
+    for (size_t i = 0; i < num_to_verify; ++i) {
+      checksum_statuses[block_valid_idx[i]] = std::move(verify_statuses[i]);
+    }
+  }
+
+  size_t valid_batch_idx = 0;
+  for (size_t idx_in_batch = 0; idx_in_batch < handles.size();
+       ++idx_in_batch) {
+    const BlockHandle& handle = handles[idx_in_batch];
+
+    if (handle.IsNull()) {
+      continue;
+    }
+
+    Status& checksum_status = checksum_statuses[valid_batch_idx];
+
+    assert(valid_batch_idx < req_idx_for_block.size());
+    assert(valid_batch_idx < req_offset_for_block.size());
+    assert(req_idx_for_block[valid_batch_idx] < read_reqs.size());
+    size_t& req_idx = req_idx_for_block[valid_batch_idx];
+    size_t& req_offset = req_offset_for_block[valid_batch_idx];
+    valid_batch_idx++;
+    FSReadRequest& req = read_reqs[req_idx];
+    Status s = req.status;
+    if (s.ok()) {
+      if ((req.result.size() != req.len) ||
+          (req_offset + BlockSizeWithTrailer(handle) > req.result.size())) {
+        s = Status::Corruption("truncated block read from " +
+                               rep_->file->file_name() + " offset " +
+                               std::to_string(handle.offset()) + ", expected " +
+                               std::to_string(req.len) + " bytes, got " +
+                               std::to_string(req.result.size()));
+      }
+    }
+
+    BlockContents serialized_block;
+    if (s.ok()) {
+      if (!use_fs_scratch && !use_shared_buffer) {
+        // We allocated a buffer for this block. Give ownership of it to
+        // BlockContents so it can free the memory
+        assert(req.result.data() == req.scratch);
+        assert(req.result.size() == BlockSizeWithTrailer(handle));
+        assert(req_offset == 0);
+        serialized_block =
+            BlockContents(std::unique_ptr<char[]>(req.scratch), handle.size());
+      } else {
+        // We used the scratch buffer or direct io buffer
+        // which are shared by the blocks.
+        // In case of use_fs_scratch, underlying file system provided buffer is
+        // used. serialized_block does not have the ownership.
+        serialized_block =
+            BlockContents(Slice(req.result.data() + req_offset, handle.size()));
+      }
+#ifndef NDEBUG
+      serialized_block.has_trailer = true;
+#endif
+
+      if (options.verify_checksums) {
+        const char* data = serialized_block.data.data();
+        // Verified above
+        s = std::move(checksum_status);
+        RecordTick(ioptions.stats, BLOCK_CHECKSUM_COMPUTE_COUNT);
+        TEST_SYNC_POINT_CALLBACK("RetrieveMultipleBlocks:VerifyChecksum", &s);
+        if (!s.ok() &&
+            CheckFSFeatureSupport(ioptions.fs.get(),
+                                  FSSupportedOps::kVerifyAndReconstructRead)) {
+          assert(s.IsCorruption());
+          assert(!ioptions.allow_mmap_reads);
+          RecordTick(ioptions.stats, BLOCK_CHECKSUM_MISMATCH_COUNT);
+
+          // Repeat the read for this particular block using the regular
+          // synchronous Read API. We can use the same chunk of memory
+          // pointed to by data, since the size is identical and we know
+          // its not a memory mapped file
+          Slice result;
+          IOOptions opts;
+          IOStatus io_s = file->PrepareIOOptions(options, opts);
+          opts.verify_and_reconstruct_read = true;
+          io_s = file->Read(opts, handle.offset(), BlockSizeWithTrailer(handle),
+                            &result, const_cast<char*>(data), nullptr);
+          if (io_s.ok()) {
+            assert(result.data() == data);
+            assert(result.size() == BlockSizeWithTrailer(handle));
+            s = VerifyBlockChecksum(footer, data, handle.size(),
+                                    rep_->file->file_name(), handle.offset());
+          } else {
+            s = io_s;
+          }
+        }
+      }
+    } else if (!use_shared_buffer) {
+      // Free the allocated scratch buffer.
+      delete[] req.scratch;
+    }
+
+    if (s.ok()) {
+      // When the blocks share the same underlying buffer (scratch or direct io
+      // buffer), we may need to manually copy the block into heap if the
+      // serialized block has to be inserted into a cache. That falls into the
+      // following cases -
+      // 1. serialized block is not compressed, it needs to be inserted into
+      //    the uncompressed block cache if there is one
+      // 2. If the serialized block is compressed, it needs to be inserted
+      //    into the compressed block cache if there is one
+      //
+      // In all other cases, the serialized block is either uncompressed into a
+      // heap buffer or there is no cache at all.
+      CompressionType compression_type =
+          GetBlockCompressionType(serialized_block);
+      if ((use_fs_scratch || use_shared_buffer) &&
+          compression_type == kNoCompression) {
+        Slice serialized =
+            Slice(req.result.data() + req_offset, BlockSizeWithTrailer(handle));
+        serialized_block = BlockContents(
+            CopyBufferToHeap(GetMemoryAllocator(rep_->table_options),
+                             serialized),
+            handle.size());
+#ifndef NDEBUG
+        serialized_block.has_trailer = true;
+#endif
+      }
+    }
+
+    if (s.ok()) {
+      if (options.fill_cache) {
+        CachableEntry<Block_kData>* block_entry = &results[idx_in_batch];
+        // MaybeReadBlockAndLoadToCache will insert into the block caches if
+        // necessary. Since we're passing the serialized block contents, it
+        // will avoid looking up the block cache
+        s = MaybeReadBlockAndLoadToCache(
+            nullptr, options, handle, uncompression_dict,
+            /*for_compaction=*/false, block_entry, get_contexts != nullptr ? get_contexts[idx_in_batch] : nullptr,
+            /*lookup_context=*/nullptr, &serialized_block,
+            /*async_read=*/false, /*use_block_cache_for_lookup=*/true);
+
+        // block_entry value could be null if no block cache is present, i.e
+        // BlockBasedTableOptions::no_block_cache is true and no compressed
+        // block cache is configured. In that case, fall
+        // through and set up the block explicitly
+        if (block_entry->GetValue() != nullptr) {
+          s.PermitUncheckedError();
+          continue;
+        }
+      }
+
+      CompressionType compression_type =
+          GetBlockCompressionType(serialized_block);
+      BlockContents contents;
+      if (compression_type != kNoCompression) {
+        UncompressionContext context(compression_type);
+        UncompressionInfo info(context, uncompression_dict, compression_type);
+        s = UncompressSerializedBlock(
+            info, req.result.data() + req_offset, handle.size(), &contents,
+            footer.format_version(), rep_->ioptions, memory_allocator);
+      } else {
+        // There are two cases here:
+        // 1) caller uses the shared buffer (scratch or direct io buffer);
+        // 2) we use the requst buffer.
+        // If scratch buffer or direct io buffer is used, we ensure that
+        // all serialized blocks are copyed to the heap as single blocks. If
+        // scratch buffer is not used, we also have no combined read, so the
+        // serialized block can be used directly.
+        contents = std::move(serialized_block);
+      }
+      if (s.ok()) {
+        results[idx_in_batch].SetOwnedValue(std::make_unique<Block_kData>(
+            std::move(contents), read_amp_bytes_per_bit, ioptions.stats));
+      }
+    }
+    statuses[idx_in_batch] = s;
+  }
+
+  if (use_fs_scratch) {
+    // Free the allocated scratch buffer by fs here as read requests might have
+    // been combined into one.
+    for (FSReadRequest& req : read_reqs) {
+      if (req.fs_scratch != nullptr) {
+        req.fs_scratch.reset();
+        req.fs_scratch = nullptr;
+      }
+    }
+  }
+}
+
+void BlockBasedTable::MultiReadDataBlocks(
+    const ReadOptions& ro, const std::vector<BlockHandle>& handles,
+    std::vector<CachableEntry<Block>>* results,
+    std::vector<Status>* statuses) const {
+  assert(results);
+  assert(statuses);
+  const size_t num_blocks = handles.size();
+  results->clear();
+  results->resize(num_blocks);
+  statuses->assign(num_blocks, Status::OK());
+  if (num_blocks == 0) {
+    return;
+  }
+
+  CachableEntry<UncompressionDict> uncompression_dict;
+  if (rep_->uncompression_dict_reader) {
+    Status s =
+        rep_->uncompression_dict_reader->GetOrReadUncompressionDictionary(
+            /* prefetch_buffer= */ nullptr, ro,
+            /* get_context= */ nullptr, /* lookup_context= */ nullptr,
+            &uncompression_dict);
+    if (!s.ok()) {
+      statuses->assign(num_blocks, s);
+      return;
+    }
+  }
+  const UncompressionDict& dict = uncompression_dict.GetValue()
+                                      ? *uncompression_dict.GetValue()
+                                      : UncompressionDict::GetEmptyDict();
+
+  // Blocks already in the block cache need no I/O.
+  if (rep_->table_options.block_cache) {
+    for (size_t i = 0; i < num_blocks; ++i) {
+      Status s = LookupAndPinBlocksInCache<Block_kData>(
+          ro, handles[i], &(*results)[i].As<Block_kData>());
+      // Treat lookup errors as cache misses
+      s.PermitUncheckedError();
+    }
+  }
+
+  RandomAccessFileReader* file = rep_->file.get();
+  for (size_t begin = 0; begin < num_blocks;
+       begin += MultiGetContext::MAX_BATCH_SIZE) {
+    const size_t end =
+        std::min(num_blocks, begin + MultiGetContext::MAX_BATCH_SIZE);
+    // Blocks pinned from the block cache are left out as null handles
+    DataBlockHandles batch_handles;
+    size_t total_len = 0;
+    for (size_t i = begin; i < end; ++i) {
+      if ((*results)[i].GetValue() != nullptr) {
+        batch_handles.emplace_back(BlockHandle::NullBlockHandle());
+      } else {
+        assert(i == 0 || handles[i - 1].offset() < handles[i].offset());
+        batch_handles.emplace_back(handles[i]);
+        total_len += BlockSizeWithTrailer(handles[i]);
+      }
+    }
+    if (total_len == 0) {
+      continue;
+    }
+
+    // Reading into one buffer lets runs of adjacent blocks share a request.
+    // In direct IO mode, MultiRead() aligns and merges requests on its own.
+    std::unique_ptr<char[]> scratch;
+    if (!file->use_direct_io()) {
+      scratch.reset(new char[total_len]);
+    }
+    DataBlockReads reads;
+    PrepareDataBlockReads(batch_handles, scratch.get(),
+                          /*use_fs_scratch=*/false, &reads);
+#ifndef NDEBUG
+    // The number of blocks read and of the requests reading them
+    std::pair<size_t, size_t> blocks_and_requests(
+        reads.req_idx_for_block.size(), reads.read_reqs.size());
+    TEST_SYNC_POINT_CALLBACK("BlockBasedTable::MultiReadDataBlocks:MultiRead",
+                             &blocks_and_requests);
+#endif  // NDEBUG
+
+    AlignedBuf direct_io_buf;
+    {
+      PERF_TIMER_GUARD(block_read_time);
+      PERF_CPU_TIMER_GUARD(
+          block_read_cpu_time,
+          rep_->ioptions.env ? rep_->ioptions.env->GetSystemClock().get()
+                             : nullptr);
+      IOOptions opts;
+      IOStatus io_s = file->PrepareIOOptions(ro, opts);
+      if (io_s.ok()) {
+        io_s = file->MultiRead(opts, &reads.read_reqs[0],
+                               reads.read_reqs.size(), &direct_io_buf);
+      }
+      if (!io_s.ok()) {
+        for (FSReadRequest& req : reads.read_reqs) {
+          req.status = io_s;
+        }
+      }
+    }
+
+    std::array<Status, MultiGetContext::MAX_BATCH_SIZE> batch_statuses;
+    std::array<CachableEntry<Block_kData>, MultiGetContext::MAX_BATCH_SIZE>
+        batch_results;
+    FinishDataBlockReads(ro, batch_handles, /*get_contexts=*/nullptr,
+                         scratch.get(), /*use_fs_scratch=*/false, dict, &reads,
+                         batch_statuses.data(), batch_results.data());
+    for (size_t i = begin; i < end; ++i) {
+      if (!batch_handles[i - begin].IsNull()) {
+        (*statuses)[i] = std::move(batch_statuses[i - begin]);
+        (*results)[i].As<Block_kData>() = std::move(batch_results[i - begin]);
+      }
+    }
+  }
+}
+
 // If contents is nullptr, this function looks up the block caches for the
 // data block referenced by handle, and read the block from disk if necessary.
 // If contents is non-null, it skips the cache lookup and disk read, since
@@ -1849,6 +2268,14 @@ BlockBasedTable::SaveLookupContextOrTraceRecord(
   }
 }
 
+void BlockBasedTable::PrefetchDataBlockForSeek(
+    const CachableEntry<Block_kData>& block, const Slice& user_key) {
+  if (block.GetValue() != nullptr) {
+    block.GetValue()->PrefetchForSeek(user_key);
+    PERF_COUNTER_ADD(multiget_prefetch_count, 1);
+  }
+}
+
 void BlockBasedTable::FinishTraceRecord(
     const BlockCacheLookupContext& lookup_context, const Slice& block_key,
     const Slice& referenced_key, bool does_referenced_key_exist,
@@ -2645,6 +3072,10 @@ BlockType BlockBasedTable::GetBlockTypeForMetaBlockByName(
     return BlockType::kHashIndexMetadata;
   }
 
+  if (meta_block_name == kLearnedIndexModelBlock) {
+    return BlockType::kLearnedIndexModel;
+  }
+
   if (meta_block_name == kIndexBlockName) {
     return BlockType::kIndex;
   }
@@ -2798,6 +3229,11 @@ Status BlockBasedTable::CreateIndexReader(
                                              use_cache, prefetch, pin,
                                              lookup_context, index_reader);
     }
+    case BlockBasedTableOptions::kLearnedIndexSearch: {
+      return LearnedIndexReader::Create(this, ro, prefetch_buffer, meta_iter,
+                                        use_cache, prefetch, pin,
+                                        lookup_context, index_reader);
+    }
     case BlockBasedTableOptions::kHashSearch: {
       if (!rep_->table_prefix_extractor) {
         ROCKS_LOG_WARN(rep_->ioptions.logger,
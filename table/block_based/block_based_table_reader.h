@@ -298,6 +298,18 @@ class BlockBasedTable : public TableReader {
       const ReadOptions& ro, const BlockHandle& handle,
       CachableEntry<TBlocklike>* out_parsed_block) const;
 
+  // Retrieves the data blocks in `handles`, which must be sorted by offset
+  // and distinct. Blocks found in the block cache are pinned; the remaining
+  // ones are read like RetrieveMultipleBlocks() does, with one MultiRead()
+  // call per MultiGetContext::MAX_BATCH_SIZE blocks, in which adjacent blocks
+  // are coalesced into one request, and loaded into the block cache if
+  // `ro.fill_cache` is set. (*results)[i] and (*statuses)[i] correspond to
+  // handles[i].
+  void MultiReadDataBlocks(const ReadOptions& ro,
+                           const std::vector<BlockHandle>& handles,
+                           std::vector<CachableEntry<Block>>* results,
+                           std::vector<Status>* statuses) const;
+
   struct Rep;
 
   Rep* get_rep() { return rep_; }
@@ -392,6 +404,42 @@ class BlockBasedTable : public TableReader {
                          bool does_referenced_key_exist,
                          uint64_t referenced_data_size) const;
 
+  // Prefetches into CPU caches the parts of `block` (if loaded) that a
+  // MultiGet lookup of `user_key` touches first
+  static void PrefetchDataBlockForSeek(const CachableEntry<Block_kData>& block,
+                                       const Slice& user_key);
+
+  using DataBlockHandles =
+      autovector<BlockHandle, MultiGetContext::MAX_BATCH_SIZE>;
+
+  // The requests of one MultiRead() call reading a batch of data blocks
+  struct DataBlockReads {
+    autovector<FSReadRequest, MultiGetContext::MAX_BATCH_SIZE> read_reqs;
+    // For each non-null block handle, the request reading it and the offset
+    // of the block in that request
+    autovector<size_t, MultiGetContext::MAX_BATCH_SIZE> req_idx_for_block;
+    autovector<size_t, MultiGetContext::MAX_BATCH_SIZE> req_offset_for_block;
+  };
+
+  // Builds the requests reading the non-null blocks of `handles`, which are
+  // sorted by offset. Adjacent blocks read into the shared `scratch` buffer or
+  // into buffers provided by the file system share a request, except in
+  // direct IO mode. Without either, each request gets its own buffer.
+  void PrepareDataBlockReads(const DataBlockHandles& handles, char* scratch,
+                             bool use_fs_scratch, DataBlockReads* reads) const;
+
+  // Once `reads` were issued, verifies the checksums of the blocks read and
+  // sets results[i] and statuses[i] for every non-null handles[i], loading
+  // the blocks into the block cache if options.fill_cache is set.
+  // `get_contexts` is indexed like `handles` and may be null.
+  void FinishDataBlockReads(const ReadOptions& options,
+                            const DataBlockHandles& handles,
+                            GetContext* const* get_contexts, char* scratch,
+                            bool use_fs_scratch,
+                            const UncompressionDict& uncompression_dict,
+                            DataBlockReads* reads, Status* statuses,
+                            CachableEntry<Block_kData>* results) const;
+
   DECLARE_SYNC_AND_ASYNC_CONST(
       void, RetrieveMultipleBlocks, const ReadOptions& options,
       const MultiGetRange* batch,
@@ -35,12 +35,8 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
  Status* statuses, CachableEntry<Block_kData>* results, char* scratch,
  const UncompressionDict& uncompression_dict, bool use_fs_scratch) const {
   RandomAccessFileReader* file = rep_->file.get();
-  const Footer& footer = rep_->footer;
-  const ImmutableOptions& ioptions = rep_->ioptions;
-  size_t read_amp_bytes_per_bit = rep_->table_options.read_amp_bytes_per_bit;
-  MemoryAllocator* memory_allocator = GetMemoryAllocator(rep_->table_options);
 
-  if (ioptions.allow_mmap_reads) {
+  if (rep_->ioptions.allow_mmap_reads) {
     size_t idx_in_batch = 0;
     for (auto mget_iter = batch->begin(); mget_iter != batch->end();
          ++mget_iter, ++idx_in_batch) {
@@ -61,79 +57,10 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
     CO_RETURN;
   }
 
-  // In direct IO mode, blocks share the direct io buffer.
-  // Otherwise, blocks share the scratch buffer.
-  const bool use_shared_buffer = file->use_direct_io() || scratch != nullptr;
-
-  autovector<FSReadRequest, MultiGetContext::MAX_BATCH_SIZE> read_reqs;
-  size_t buf_offset = 0;
-  size_t idx_in_batch = 0;
-
-  uint64_t prev_offset = 0;
-  size_t prev_len = 0;
-  autovector<size_t, MultiGetContext::MAX_BATCH_SIZE> req_idx_for_block;
-  autovector<size_t, MultiGetContext::MAX_BATCH_SIZE> req_offset_for_block;
-  for (auto mget_iter = batch->begin(); mget_iter != batch->end();
-       ++mget_iter, ++idx_in_batch) {
-    const BlockHandle& handle = (*handles)[idx_in_batch];
-    if (handle.IsNull()) {
-      continue;
-    }
-
-    size_t prev_end = static_cast<size_t>(prev_offset) + prev_len;
-
-    // If current block is adjacent to the previous one, at the same time,
-    // compression is enabled and there is no compressed cache, we combine
-    // the two block read as one.
-    // We don't combine block reads here in direct IO mode, because when doing
-    // direct IO read, the block requests will be realigned and merged when
-    // necessary.
-    if ((use_shared_buffer || use_fs_scratch) && !file->use_direct_io() &&
-        prev_end == handle.offset()) {
-      req_offset_for_block.emplace_back(prev_len);
-      prev_len += BlockSizeWithTrailer(handle);
-    } else {
-      // No compression or current block and previous one is not adjacent:
-      // Step 1, create a new request for previous blocks
-      if (prev_len != 0) {
-        FSReadRequest req;
-        req.offset = prev_offset;
-        req.len = prev_len;
-        if (file->use_direct_io() || use_fs_scratch) {
-          req.scratch = nullptr;
-        } else if (use_shared_buffer) {
-          req.scratch = scratch + buf_offset;
-          buf_offset += req.len;
-        } else {
-          req.scratch = new char[req.len];
-        }
-        read_reqs.emplace_back(std::move(req));
-      }
-
-      // Step 2, remember the previous block info
-      prev_offset = handle.offset();
-      prev_len = BlockSizeWithTrailer(handle);
-      req_offset_for_block.emplace_back(0);
-    }
-    req_idx_for_block.emplace_back(read_reqs.size());
-
-    PERF_COUNTER_ADD(block_read_count, 1);
-    PERF_COUNTER_ADD(block_read_byte, BlockSizeWithTrailer(handle));
-  }
-  // Handle the last block and process the pending last request
-  if (prev_len != 0) {
-    FSReadRequest req;
-    req.offset = prev_offset;
-    req.len = prev_len;
-    if (file->use_direct_io() || use_fs_scratch) {
-      req.scratch = nullptr;
-    } else if (use_shared_buffer) {
-      req.scratch = scratch + buf_offset;
-    } else {
-      req.scratch = new char[req.len];
-    }
-    read_reqs.emplace_back(std::move(req));
-  }
+  DataBlockReads reads;
+  PrepareDataBlockReads(*handles, scratch, use_fs_scratch, &reads);
+  autovector<FSReadRequest, MultiGetContext::MAX_BATCH_SIZE>& read_reqs =
+      reads.read_reqs;
 
   AlignedBuf direct_io_buf;
   {
@@ -161,188 +88,15 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::RetrieveMultipleBlocks)
     }
   }
 
-  idx_in_batch = 0;
-  size_t valid_batch_idx = 0;
+  std::array<GetContext*, MultiGetContext::MAX_BATCH_SIZE> get_contexts;
+  size_t idx_in_batch = 0;
   for (auto mget_iter = batch->begin(); mget_iter != batch->end();
        ++mget_iter, ++idx_in_batch) {
-    const BlockHandle& handle = (*handles)[idx_in_batch];
-
-    if (handle.IsNull()) {
-      continue;
-    }
-
-    assert(valid_batch_idx < req_idx_for_block.size());
-    assert(valid_batch_idx < req_offset_for_block.size());
-    assert(req_idx_for_block[valid_batch_idx] < read_reqs.size());
-    size_t& req_idx = req_idx_for_block[valid_batch_idx];
-    size_t& req_offset = req_offset_for_block[valid_batch_idx];
-    valid_batch_idx++;
-    FSReadRequest& req = read_reqs[req_idx];
-    Status s = req.status;
-    if (s.ok()) {
-      if ((req.result.size() != req.len) ||
-          (req_offset + BlockSizeWithTrailer(handle) > req.result.size())) {
-        s = Status::Corruption("truncated block read from " +
-                               rep_->file->file_name() + " offset " +
-                               std::to_string(handle.offset()) + ", expected " +
-                               std::to_string(req.len) + " bytes, got " +
-                               std::to_string(req.result.size()));
-      }
-    }
-
-    BlockContents serialized_block;
-    if (s.ok()) {
-      if (!use_fs_scratch && !use_shared_buffer) {
-        // We allocated a buffer for this block. Give ownership of it to
-        // BlockContents so it can free the memory
-        assert(req.result.data() == req.scratch);
-        assert(req.result.size() == BlockSizeWithTrailer(handle));
-        assert(req_offset == 0);
-        serialized_block =
-            BlockContents(std::unique_ptr<char[]>(req.scratch), handle.size());
-      } else {
-        // We used the scratch buffer or direct io buffer
-        // which are shared by the blocks.
-        // In case of use_fs_scratch, underlying file system provided buffer is
-        // used. serialized_block does not have the ownership.
-        serialized_block =
-            BlockContents(Slice(req.result.data() + req_offset, handle.size()));
-      }
-#ifndef NDEBUG
-      serialized_block.has_trailer = true;
-#endif
-
-      if (options.verify_checksums) {
-        PERF_TIMER_GUARD(block_checksum_time);
-        const char* data = serialized_block.data.data();
-        // Since the scratch might be shared, the offset of the data block in
-        // the buffer might not be 0. req.result.data() only point to the
-        // begin address of each read request, we need to add the offset
-        // in each read request. Checksum is stored in the block trailer,
-        // beyond the payload size.
-        s = VerifyBlockChecksum(footer, data, handle.size(),
-                                rep_->file->file_name(), handle.offset());
-        RecordTick(ioptions.stats, BLOCK_CHECKSUM_COMPUTE_COUNT);
-        TEST_SYNC_POINT_CALLBACK("RetrieveMultipleBlocks:VerifyChecksum", &s);
-        if (!s.ok() &&
-            CheckFSFeatureSupport(ioptions.fs.get(),
-                                  FSSupportedOps::kVerifyAndReconstructRead)) {
-          assert(s.IsCorruption());
-          assert(!ioptions.allow_mmap_reads);
-          RecordTick(ioptions.stats, BLOCK_CHECKSUM_MISMATCH_COUNT);
-
-          // Repeat the read for this particular block using the regular
-          // synchronous Read API. We can use the same chunk of memory
-          // pointed to by data, since the size is identical and we know
-          // its not a memory mapped file
-          Slice result;
-          IOOptions opts;
-          IOStatus io_s = file->PrepareIOOptions(options, opts);
-          opts.verify_and_reconstruct_read = true;
-          io_s = file->Read(opts, handle.offset(), BlockSizeWithTrailer(handle),
-                            &result, const_cast<char*>(data), nullptr);
-          if (io_s.ok()) {
-            assert(result.data() == data);
-            assert(result.size() == BlockSizeWithTrailer(handle));
-            s = VerifyBlockChecksum(footer, data, handle.size(),
-                                    rep_->file->file_name(), handle.offset());
-          } else {
-            s = io_s;
-          }
-        }
-      }
-    } else if (!use_shared_buffer) {
-      // Free the allocated scratch buffer.
-      delete[] req.scratch;
-    }
-
-    if (s.ok()) {
-      // When the blocks share the same underlying buffer (scratch or direct io
-      // buffer), we may need to manually copy the block into heap if the
-      // serialized block has to be inserted into a cache. That falls into the
-      // following cases -
-      // 1. serialized block is not compressed, it needs to be inserted into
-      //    the uncompressed block cache if there is one
-      // 2. If the serialized block is compressed, it needs to be inserted
-      //    into the compressed block cache if there is one
-      //
-      // In all other cases, the serialized block is either uncompressed into a
-      // heap buffer or there is no cache at all.
-      CompressionType compression_type =
-          GetBlockCompressionType(serialized_block);
-      if ((use_fs_scratch || use_shared_buffer) &&
-          compression_type == kNoCompression) {
-        Slice serialized =
-            Slice(req.result.data() + req_offset, BlockSizeWithTrailer(handle));
-        serialized_block = BlockContents(
-            CopyBufferToHeap(GetMemoryAllocator(rep_->table_options),
-                             serialized),
-            handle.size());
-#ifndef NDEBUG
-        serialized_block.has_trailer = true;
-#endif
-      }
-    }
-
-    if (s.ok()) {
-      if (options.fill_cache) {
-        CachableEntry<Block_kData>* block_entry = &results[idx_in_batch];
-        // MaybeReadBlockAndLoadToCache will insert into the block caches if
-        // necessary. Since we're passing the serialized block contents, it
-        // will avoid looking up the block cache
-        s = MaybeReadBlockAndLoadToCache(
-            nullptr, options, handle, uncompression_dict,
-            /*for_compaction=*/false, block_entry, mget_iter->get_context,
-            /*lookup_context=*/nullptr, &serialized_block,
-            /*async_read=*/false, /*use_block_cache_for_lookup=*/true);
-
-        // block_entry value could be null if no block cache is present, i.e
-        // BlockBasedTableOptions::no_block_cache is true and no compressed
-        // block cache is configured. In that case, fall
-        // through and set up the block explicitly
-        if (block_entry->GetValue() != nullptr) {
-          s.PermitUncheckedError();
-          continue;
-        }
-      }
-
-      CompressionType compression_type =
-          GetBlockCompressionType(serialized_block);
-      BlockContents contents;
-      if (compression_type != kNoCompression) {
-        UncompressionContext context(compression_type);
-        UncompressionInfo info(context, uncompression_dict, compression_type);
-        s = UncompressSerializedBlock(
-            info, req.result.data() + req_offset, handle.size(), &contents,
-            footer.format_version(), rep_->ioptions, memory_allocator);
-      } else {
-        // There are two cases here:
-        // 1) caller uses the shared buffer (scratch or direct io buffer);
-        // 2) we use the requst buffer.
-        // If scratch buffer or direct io buffer is used, we ensure that
-        // all serialized blocks are copyed to the heap as single blocks. If
-        // scratch buffer is not used, we also have no combined read, so the
-        // serialized block can be used directly.
-        contents = std::move(serialized_block);
-      }
-      if (s.ok()) {
-        results[idx_in_batch].SetOwnedValue(std::make_unique<Block_kData>(
-            std::move(contents), read_amp_bytes_per_bit, ioptions.stats));
-      }
-    }
-    statuses[idx_in_batch] = s;
-  }
-
-  if (use_fs_scratch) {
-    // Free the allocated scratch buffer by fs here as read requests might have
-    // been combined into one.
-    for (FSReadRequest& req : read_reqs) {
-      if (req.fs_scratch != nullptr) {
-        req.fs_scratch.reset();
-        req.fs_scratch = nullptr;
-      }
-    }
+    get_contexts[idx_in_batch] = mget_iter->get_context;
   }
+  FinishDataBlockReads(options, *handles, get_contexts.data(), scratch,
+                       use_fs_scratch, uncompression_dict, &reads, statuses,
+                       results);
 }
 
 using MultiGetRange = MultiGetContext::Range;
@@ -388,6 +142,11 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
     std::unique_ptr<InternalIteratorBase<IndexValue>> iiter_unique_ptr;
     if (iiter != &iiter_on_stack) {
       iiter_unique_ptr.reset(iiter);
+    } else if (read_options.multiget_prefetch_distance > 0) {
+      // The first probes of the index binary search are shared by all the
+      // keys, so fetch them in parallel rather than one miss at a time.
+      iiter_on_stack.PrefetchForSeek();
+      PERF_COUNTER_ADD(multiget_prefetch_count, 1);
     }
 
     uint64_t prev_offset = std::numeric_limits<uint64_t>::max();
@@ -596,6 +355,22 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
       }
     }
 
+    // Software pipelining of the data block lookups: prefetch the block of
+    // the key `prefetch_distance` positions ahead while processing each key.
+    const size_t prefetch_distance = read_options.multiget_prefetch_distance;
+    autovector<Slice, MultiGetContext::MAX_BATCH_SIZE> prefetch_user_keys;
+    if (prefetch_distance > 0) {
+      for (auto miter = sst_file_range.begin(); miter != sst_file_range.end();
+           ++miter) {
+        prefetch_user_keys.push_back(ExtractUserKey(miter->ikey));
+      }
+      assert(prefetch_user_keys.size() == block_handles.size());
+      for (size_t i = 0;
+           i < std::min(prefetch_distance, prefetch_user_keys.size()); ++i) {
+        PrefetchDataBlockForSeek(results[i], prefetch_user_keys[i]);
+      }
+    }
+
     DataBlockIter first_biter;
     DataBlockIter next_biter;
     size_t idx_in_batch = 0;
@@ -605,6 +380,12 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
       Status s;
       GetContext* get_context = miter->get_context;
       const Slice& key = miter->ikey;
+      if (prefetch_distance > 0 &&
+          idx_in_batch + prefetch_distance < prefetch_user_keys.size()) {
+        PrefetchDataBlockForSeek(
+            results[idx_in_batch + prefetch_distance],
+            prefetch_user_keys[idx_in_batch + prefetch_distance]);
+      }
       bool matched = false;  // if such user key matched a key in SST
       bool done = false;
       bool first_block = true;
@@ -718,7 +499,11 @@ DEFINE_SYNC_AND_ASYNC(void, BlockBasedTable::MultiGet)
           value_pinner = nullptr;
         }
 
-        bool may_exist = biter->SeekForGet(key);
+        bool may_exist;
+        {
+          PERF_TIMER_GUARD(multiget_block_probe_nanos);
+          may_exist = biter->SeekForGet(key);
+        }
         if (!may_exist) {
           // HashSeek cannot find the key this block and the the iter is not
           // the end of the block, i.e. cannot be in the following blocks
@@ -30,6 +30,9 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+// Data blocks may carry an optional data block hash index and restart key
+// prefix index between the restarts and the footer, flagged in the high bits
+// of num_restarts (see data_block_footer.h).
 
 #include "table/block_based/block_builder.h"
 
@@ -48,8 +51,16 @@ BlockBuilder::BlockBuilder(
     bool use_value_delta_encoding,
     BlockBasedTableOptions::DataBlockIndexType index_type,
     double data_block_hash_table_util_ratio, size_t ts_sz,
-    bool persist_user_defined_timestamps, bool is_user_key)
+    bool persist_user_defined_timestamps, bool is_user_key,
+    bool use_restart_key_prefix, bool adaptive_restart_interval)
     : block_restart_interval_(block_restart_interval),
+      adaptive_restart_interval_(adaptive_restart_interval),
+      min_restart_interval_(adaptive_restart_interval
+                                ? std::max(1, block_restart_interval / 2)
+                                : block_restart_interval),
+      max_restart_interval_(adaptive_restart_interval
+                                ? block_restart_interval * 4
+                                : block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       use_value_delta_encoding_(use_value_delta_encoding),
       strip_ts_sz_(persist_user_defined_timestamps ? 0 : ts_sz),
@@ -67,7 +78,17 @@ BlockBuilder::BlockBuilder(
     default:
       assert(0);
   }
+  if (use_restart_key_prefix) {
+    // Restart key prefixes are derived from user keys of internal keys that
+    // are persisted as-is.
+    assert(!is_user_key_ && strip_ts_sz_ == 0);
+    restart_key_prefix_index_builder_.Initialize();
+  }
   assert(block_restart_interval_ >= 1);
+  // Adaptive restart points are chosen by the bytes shared between keys, and
+  // are only supported for data blocks
+  assert(!adaptive_restart_interval_ ||
+         (use_delta_encoding_ && !use_value_delta_encoding_));
   estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
 }
 
@@ -77,11 +98,16 @@ void BlockBuilder::Reset() {
   assert(restarts_[0] == 0);
   estimate_ = sizeof(uint32_t) + sizeof(uint32_t);
   counter_ = 0;
+  shared_bytes_sum_ = 0;
+  shared_bytes_count_ = 0;
   finished_ = false;
   last_key_.clear();
   if (data_block_hash_index_builder_.Valid()) {
     data_block_hash_index_builder_.Reset();
   }
+  if (restart_key_prefix_index_builder_.Valid()) {
+    restart_key_prefix_index_builder_.Reset();
+  }
 #ifndef NDEBUG
   add_with_last_key_called_ = false;
 #endif
@@ -108,7 +134,7 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key,
           ? value.size()
           : value.size() / 2;
 
-  if (counter_ >= block_restart_interval_) {
+  if (counter_ >= min_restart_interval_) {
     estimate += sizeof(uint32_t);  // a new restart entry.
   }
 
@@ -132,14 +158,30 @@ Slice BlockBuilder::Finish() {
   uint32_t num_restarts = static_cast<uint32_t>(restarts_.size());
   BlockBasedTableOptions::DataBlockIndexType index_type =
       BlockBasedTableOptions::kDataBlockBinarySearch;
+  size_t block_size = estimate_;
   if (data_block_hash_index_builder_.Valid() &&
-      CurrentSizeEstimate() <= kMaxBlockSizeSupportedByHashIndex) {
+      block_size + data_block_hash_index_builder_.EstimateSize() <=
+          kMaxBlockSizeSupportedByHashIndex) {
     data_block_hash_index_builder_.Finish(buffer_);
     index_type = BlockBasedTableOptions::kDataBlockBinaryAndHash;
+    block_size += data_block_hash_index_builder_.EstimateSize();
+  }
+
+  // Like the hash index, the restart key prefix index is flagged in the
+  // footer, which is only interpreted as such for blocks smaller than 64KiB.
+  bool has_restart_key_prefix = false;
+  if (restart_key_prefix_index_builder_.Valid() &&
+      restart_key_prefix_index_builder_.NumPrefixes() == num_restarts &&
+      block_size + restart_key_prefix_index_builder_.EstimateSize() <=
+          kMaxBlockSizeSupportedByHashIndex) {
+    restart_key_prefix_index_builder_.Finish(buffer_);
+    has_restart_key_prefix = true;
   }
 
-  // footer is a packed format of data_block_index_type and num_restarts
-  uint32_t block_footer = PackIndexTypeAndNumRestarts(index_type, num_restarts);
+  // footer is a packed format of data_block_index_type, num_restarts and
+  // whether restart key prefixes are present
+  uint32_t block_footer = PackIndexTypeAndNumRestarts(index_type, num_restarts,
+                                                      has_restart_key_prefix);
 
   PutFixed32(&buffer_, block_footer);
   finished_ = true;
@@ -190,7 +232,7 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
                                              const Slice* const delta_value,
                                              size_t buffer_size) {
   assert(!finished_);
-  assert(counter_ <= block_restart_interval_);
+  assert(counter_ <= max_restart_interval_);
   assert(!use_value_delta_encoding_ || delta_value);
   std::string key_buf;
   std::string last_key_buf;
@@ -202,7 +244,20 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
           ? last_key
           : MaybeStripTimestampFromKey(&last_key_buf, last_key);
   size_t shared = 0;  // number of bytes shared with prev key
-  if (counter_ >= block_restart_interval_) {
+  if (adaptive_restart_interval_) {
+    shared = key_to_persist.difference_offset(last_key_persisted);
+    bool restart = ShouldRestart(shared);
+    if (counter_ > 0) {
+      shared_bytes_sum_ += shared;
+      shared_bytes_count_++;
+    }
+    if (restart) {
+      restarts_.push_back(static_cast<uint32_t>(buffer_size));
+      estimate_ += sizeof(uint32_t);
+      counter_ = 0;
+      shared = 0;
+    }
+  } else if (counter_ >= block_restart_interval_) {
     // Restart compression
     restarts_.push_back(static_cast<uint32_t>(buffer_size));
     estimate_ += sizeof(uint32_t);
@@ -245,11 +300,36 @@ inline void BlockBuilder::AddWithLastKeyImpl(const Slice& key,
     data_block_hash_index_builder_.Add(ExtractUserKey(key),
                                        restarts_.size() - 1);
   }
+  if (counter_ == 0 && restart_key_prefix_index_builder_.Valid()) {
+    // First key of a restart interval
+    restart_key_prefix_index_builder_.Add(ExtractUserKey(key));
+  }
 
   counter_++;
   estimate_ += buffer_.size() - buffer_size;
 }
 
+inline bool BlockBuilder::ShouldRestart(size_t shared) const {
+  if (counter_ < min_restart_interval_) {
+    return false;
+  }
+  if (counter_ >= max_restart_interval_) {
+    // Bound the linear scan of seeks
+    return true;
+  }
+  // A restart costs a restart array entry plus storing the bytes shared with
+  // the previous key. Restart early where that is no more than a few bytes,
+  // e.g. keys with random suffixes, or at the boundary of a group of keys
+  // sharing a long prefix.
+  if (shared <= sizeof(uint32_t)) {
+    return true;
+  }
+  // Past the configured interval, restart where this costs no more than
+  // for the average key of the block, and keep delta encoding otherwise.
+  return counter_ >= block_restart_interval_ &&
+         shared * shared_bytes_count_ <= shared_bytes_sum_;
+}
+
 const Slice BlockBuilder::MaybeStripTimestampFromKey(std::string* key_buf,
                                                      const Slice& key) {
   Slice stripped_key = key;
@@ -15,6 +15,7 @@
 #include "rocksdb/slice.h"
 #include "rocksdb/table.h"
 #include "table/block_based/data_block_hash_index.h"
+#include "table/block_based/restart_key_prefix_index.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -31,7 +32,9 @@ class BlockBuilder {
                         double data_block_hash_table_util_ratio = 0.75,
                         size_t ts_sz = 0,
                         bool persist_user_defined_timestamps = true,
-                        bool is_user_key = false);
+                        bool is_user_key = false,
+                        bool use_restart_key_prefix = false,
+                        bool adaptive_restart_interval = false);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -69,9 +72,13 @@ class BlockBuilder {
   // Returns an estimate of the current (uncompressed) size of the block
   // we are building.
   inline size_t CurrentSizeEstimate() const {
-    return estimate_ + (data_block_hash_index_builder_.Valid()
-                            ? data_block_hash_index_builder_.EstimateSize()
-                            : 0);
+    return estimate_ +
+           (data_block_hash_index_builder_.Valid()
+                ? data_block_hash_index_builder_.EstimateSize()
+                : 0) +
+           (restart_key_prefix_index_builder_.Valid()
+                ? restart_key_prefix_index_builder_.EstimateSize()
+                : 0);
   }
 
   // Returns an estimated block size after appending key and value.
@@ -89,7 +96,16 @@ class BlockBuilder {
   inline const Slice MaybeStripTimestampFromKey(std::string* key_buf,
                                                 const Slice& key);
 
+  // Whether the next key, sharing `shared` bytes with the previous key,
+  // starts a new restart interval.
+  inline bool ShouldRestart(size_t shared) const;
+
   const int block_restart_interval_;
+  // See BlockBasedTableOptions::adaptive_block_restart_interval. When not
+  // adaptive, both are block_restart_interval_.
+  const bool adaptive_restart_interval_;
+  const int min_restart_interval_;
+  const int max_restart_interval_;
   // TODO(myabandeh): put it into a separate IndexBlockBuilder
   const bool use_delta_encoding_;
   // Refer to BlockIter::DecodeCurrentValue for format of delta encoded values
@@ -117,9 +133,14 @@ class BlockBuilder {
   std::vector<uint32_t> restarts_;  // Restart points
   size_t estimate_;
   int counter_;    // Number of entries emitted since restart
+  // For adaptive restart intervals, the total bytes shared by keys with their
+  // previous key in this block, and the number of such keys
+  uint64_t shared_bytes_sum_ = 0;
+  uint64_t shared_bytes_count_ = 0;
   bool finished_;  // Has Finish() been called?
   std::string last_key_;
   DataBlockHashIndexBuilder data_block_hash_index_builder_;
+  RestartKeyPrefixIndexBuilder restart_key_prefix_index_builder_;
 #ifndef NDEBUG
   bool add_with_last_key_called_ = false;
 #endif
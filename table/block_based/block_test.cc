@@ -25,9 +25,12 @@
 #include "rocksdb/table.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/learned_index.h"
 #include "table/format.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
+#include "util/coding.h"
+#include "util/math.h"
 #include "util/random.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -301,6 +304,396 @@ INSTANTIATE_TEST_CASE_P(
             BlockBasedTableOptions::DataBlockIndexType::
                 kDataBlockBinaryAndHash)));
 
+// Param 1: restart interval
+// Param 2: data block index type
+class DataBlockFormatTest
+    : public testing::Test,
+      public testing::WithParamInterface<
+          std::tuple<int, BlockBasedTableOptions::DataBlockIndexType>> {
+ public:
+  int restartInterval() const { return std::get<0>(GetParam()); }
+  BlockBasedTableOptions::DataBlockIndexType dataBlockIndexType() const {
+    return std::get<1>(GetParam());
+  }
+
+  // Builds a data block of `user_keys` whose i-th value is i, with the
+  // format options under test.
+  std::string BuildBlock(const std::vector<std::string> &user_keys,
+                         bool use_restart_key_prefix,
+                         bool adaptive_restart_interval = false) {
+    BlockBuilder builder(restartInterval(), true /* use_delta_encoding */,
+                         false /* use_value_delta_encoding */,
+                         dataBlockIndexType(),
+                         0.75 /* data_block_hash_table_util_ratio */,
+                         0 /* ts_sz */, true /* persist_udt */,
+                         false /* is_user_key */, use_restart_key_prefix,
+                         adaptive_restart_interval);
+    for (size_t i = 0; i < user_keys.size(); ++i) {
+      builder.Add(InternalKey(user_keys[i], 100, kTypeValue).Encode(),
+                  std::to_string(i));
+    }
+    return builder.Finish().ToString();
+  }
+
+  // Checks that a full scan of a block from BuildBlock() returns all of
+  // `user_keys` with their values.
+  void VerifyScan(Block &block, const std::vector<std::string> &user_keys) {
+    std::unique_ptr<DataBlockIter> iter(block.NewDataIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber));
+    size_t count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_LT(count, user_keys.size());
+      ASSERT_EQ(ExtractUserKey(iter->key()), user_keys[count]);
+      ASSERT_EQ(iter->value(), std::to_string(count));
+      ++count;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, user_keys.size());
+  }
+};
+
+const auto kDataBlockFormatTestParams = ::testing::Combine(
+    ::testing::Values(1, 4, 16),
+    ::testing::Values(
+        BlockBasedTableOptions::DataBlockIndexType::kDataBlockBinarySearch,
+        BlockBasedTableOptions::DataBlockIndexType::kDataBlockBinaryAndHash));
+
+class RestartKeyPrefixTest : public DataBlockFormatTest {
+ public:
+  void VerifySeeks(const std::vector<std::string> &user_keys,
+                   const std::vector<std::string> &targets) {
+    std::string plain = BuildBlock(user_keys, false);
+    std::string with_prefix = BuildBlock(user_keys, true);
+    Block plain_block{BlockContents(plain)};
+    Block prefix_block{BlockContents(with_prefix)};
+    ASSERT_FALSE(plain_block.HasRestartKeyPrefix());
+    ASSERT_TRUE(prefix_block.HasRestartKeyPrefix());
+    ASSERT_EQ(plain_block.NumRestarts(), prefix_block.NumRestarts());
+    ASSERT_EQ(plain_block.IndexType(), prefix_block.IndexType());
+    ASSERT_EQ(plain.size() + prefix_block.NumRestarts() * sizeof(uint64_t),
+              with_prefix.size());
+
+    std::unique_ptr<DataBlockIter> expected(plain_block.NewDataIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber));
+    std::unique_ptr<DataBlockIter> actual(prefix_block.NewDataIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber));
+
+    // Full scan is unaffected
+    ASSERT_NO_FATAL_FAILURE(VerifyScan(prefix_block, user_keys));
+
+    for (const auto &target : targets) {
+      for (SequenceNumber seq : {SequenceNumber{0}, kMaxSequenceNumber}) {
+        std::string ikey =
+            InternalKey(target, seq, kTypeValue).Encode().ToString();
+        expected->Seek(ikey);
+        actual->Seek(ikey);
+        ASSERT_OK(actual->status());
+        ASSERT_EQ(expected->Valid(), actual->Valid());
+        if (expected->Valid()) {
+          ASSERT_EQ(expected->key(), actual->key());
+        }
+
+        expected->SeekForPrev(ikey);
+        actual->SeekForPrev(ikey);
+        ASSERT_OK(actual->status());
+        ASSERT_EQ(expected->Valid(), actual->Valid());
+        if (expected->Valid()) {
+          ASSERT_EQ(expected->key(), actual->key());
+        }
+
+        ASSERT_EQ(expected->SeekForGet(ikey), actual->SeekForGet(ikey));
+        ASSERT_EQ(expected->Valid(), actual->Valid());
+        if (expected->Valid()) {
+          ASSERT_EQ(expected->key(), actual->key());
+        }
+      }
+    }
+  }
+};
+
+TEST_P(RestartKeyPrefixTest, SeekMatchesBinarySearch) {
+  Random rnd(301);
+  for (size_t max_key_len : {1, 4, 8, 9, 16, 30}) {
+    for (size_t common_prefix_len : {0, 3, 8, 12}) {
+      std::string common_prefix = rnd.RandomBinaryString(
+          static_cast<int>(std::min(common_prefix_len, max_key_len)));
+      std::set<std::string> key_set;
+      // Small alphabet to get keys sharing partial prefixes, and keys that
+      // are prefixes of other keys
+      for (int i = 0; i < 400; ++i) {
+        std::string key = common_prefix;
+        size_t len = rnd.Uniform(static_cast<int>(max_key_len) + 1);
+        while (key.size() < len) {
+          key.push_back(static_cast<char>('\0' + rnd.Uniform(3)));
+        }
+        key_set.insert(key);
+      }
+      std::vector<std::string> user_keys(key_set.begin(), key_set.end());
+      std::vector<std::string> targets = user_keys;
+      for (int i = 0; i < 400; ++i) {
+        std::string target = common_prefix;
+        size_t len = rnd.Uniform(static_cast<int>(max_key_len) + 2);
+        while (target.size() < len) {
+          target.push_back(static_cast<char>('\0' + rnd.Uniform(4)));
+        }
+        targets.push_back(target);
+      }
+      targets.emplace_back("");
+      targets.emplace_back(std::string(40, '\xff'));
+      VerifySeeks(user_keys, targets);
+    }
+  }
+}
+
+TEST_P(RestartKeyPrefixTest, NotUsedForLargeBlocks) {
+  std::vector<std::string> user_keys;
+  for (int i = 0; i < 10000; ++i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%08d", i);
+    user_keys.emplace_back(buf);
+  }
+  std::string contents = BuildBlock(user_keys, true);
+  ASSERT_GT(contents.size(), kMaxBlockSizeSupportedByHashIndex);
+  Block block{BlockContents(contents)};
+  ASSERT_FALSE(block.HasRestartKeyPrefix());
+  std::unique_ptr<DataBlockIter> iter(block.NewDataIterator(
+      BytewiseComparator(), kDisableGlobalSequenceNumber));
+  for (const auto &user_key : user_keys) {
+    iter->Seek(InternalKey(user_key, kMaxSequenceNumber, kTypeValue).Encode());
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(ExtractUserKey(iter->key()), user_key);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(P, RestartKeyPrefixTest, kDataBlockFormatTestParams);
+
+class AdaptiveRestartIntervalTest : public DataBlockFormatTest {
+ public:
+  // Verifies the adaptive block, and returns its number of restarts
+  uint32_t VerifyAdaptiveBlock(const std::vector<std::string> &user_keys) {
+    std::string contents = BuildBlock(user_keys, true, true);
+    Block block{BlockContents(contents)};
+    const uint32_t num_keys = static_cast<uint32_t>(user_keys.size());
+    const uint32_t min_interval =
+        static_cast<uint32_t>(std::max(1, restartInterval() / 2));
+    const uint32_t max_interval =
+        static_cast<uint32_t>(restartInterval() * 4);
+    EXPECT_GE(block.NumRestarts(),
+              (num_keys + max_interval - 1) / max_interval);
+    EXPECT_LE(block.NumRestarts(),
+              (num_keys + min_interval - 1) / min_interval);
+
+    VerifyScan(block, user_keys);
+    std::unique_ptr<DataBlockIter> iter(block.NewDataIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber));
+    for (size_t i = 0; i < user_keys.size(); ++i) {
+      std::string ikey =
+          InternalKey(user_keys[i], kMaxSequenceNumber, kTypeValue)
+              .Encode()
+              .ToString();
+      iter->Seek(ikey);
+      EXPECT_TRUE(iter->Valid());
+      EXPECT_EQ(iter->value(), std::to_string(i));
+      EXPECT_TRUE(iter->SeekForGet(ikey));
+      EXPECT_TRUE(iter->Valid());
+      EXPECT_EQ(iter->value(), std::to_string(i));
+      iter->SeekForPrev(InternalKey(user_keys[i], 0, kTypeValue).Encode());
+      EXPECT_TRUE(iter->Valid());
+      EXPECT_EQ(iter->value(), std::to_string(i));
+    }
+    return block.NumRestarts();
+  }
+};
+
+TEST_P(AdaptiveRestartIntervalTest, LongSharedPrefixes) {
+  // Keys sharing a long prefix are delta encoded over longer runs
+  std::vector<std::string> user_keys;
+  for (int i = 0; i < 1000; ++i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%08d", i);
+    user_keys.push_back(std::string(40, 'p') + buf);
+  }
+  uint32_t num_restarts = VerifyAdaptiveBlock(user_keys);
+  std::string fixed = BuildBlock(user_keys, true);
+  std::string adaptive = BuildBlock(user_keys, true, true);
+  if (restartInterval() > 1) {
+    ASSERT_LT(num_restarts, Block{BlockContents(fixed)}.NumRestarts());
+    ASSERT_LT(adaptive.size(), fixed.size());
+  }
+}
+
+TEST_P(AdaptiveRestartIntervalTest, RandomKeys) {
+  // Keys sharing (almost) no bytes get restart points more often
+  Random rnd(301);
+  std::set<std::string> key_set;
+  while (key_set.size() < 1000) {
+    key_set.insert(rnd.RandomBinaryString(16));
+  }
+  std::vector<std::string> user_keys(key_set.begin(), key_set.end());
+  uint32_t num_restarts = VerifyAdaptiveBlock(user_keys);
+  std::string fixed = BuildBlock(user_keys, true);
+  ASSERT_GE(num_restarts, Block{BlockContents(fixed)}.NumRestarts());
+}
+
+TEST_P(AdaptiveRestartIntervalTest, PrefixGroups) {
+  // Restart points tend to align with the boundaries of groups of keys
+  // sharing a long prefix
+  Random rnd(301);
+  std::vector<std::string> user_keys;
+  for (int group = 0; group < 50; ++group) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%04d", group);
+    std::string prefix = std::string(buf) + rnd.RandomString(30);
+    int group_size = 1 + static_cast<int>(rnd.Uniform(40));
+    for (int i = 0; i < group_size; ++i) {
+      snprintf(buf, sizeof(buf), "%04d", i);
+      user_keys.push_back(prefix + buf);
+    }
+  }
+  VerifyAdaptiveBlock(user_keys);
+}
+
+INSTANTIATE_TEST_CASE_P(P, AdaptiveRestartIntervalTest,
+                        kDataBlockFormatTestParams);
+
+// Param: index block restart interval
+class LearnedIndexTest : public testing::Test,
+                         public testing::WithParamInterface<int> {
+ public:
+  int restartInterval() const { return GetParam(); }
+
+  // Builds an index block (with user keys) and its model over `user_keys`,
+  // and checks that seeks narrowed by the model land on the same entry as a
+  // plain binary search.
+  void VerifySeeks(const std::vector<std::string> &user_keys,
+                   const std::vector<std::string> &targets,
+                   size_t *num_segments = nullptr) {
+    BlockBuilder builder(restartInterval(), true /* use_delta_encoding */,
+                         false /* use_value_delta_encoding */,
+                         BlockBasedTableOptions::kDataBlockBinarySearch,
+                         0.75 /* data_block_hash_table_util_ratio */,
+                         0 /* ts_sz */, true /* persist_udt */,
+                         true /* is_user_key */);
+    LearnedIndexModelBuilder model_builder;
+    for (size_t i = 0; i < user_keys.size(); ++i) {
+      std::string handle;
+      BlockHandle(i * 4096, 4000).EncodeTo(&handle);
+      builder.Add(user_keys[i], handle);
+      model_builder.Add(user_keys[i]);
+    }
+    std::string contents = builder.Finish().ToString();
+    std::string model_contents;
+    model_builder.Finish(static_cast<uint32_t>(restartInterval()),
+                         &model_contents);
+
+    LearnedIndexModel *raw_model = nullptr;
+    ASSERT_OK(LearnedIndexModel::Create(model_contents, &raw_model));
+    std::unique_ptr<LearnedIndexModel> model(raw_model);
+    if (num_segments != nullptr) {
+      *num_segments = model->NumSegments();
+    }
+
+    Block block{BlockContents(contents)};
+    ASSERT_EQ(block.NumRestarts(), model->NumRestarts());
+    std::unique_ptr<IndexBlockIter> expected(block.NewIndexIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber, nullptr, nullptr,
+        true /* total_order_seek */, false /* have_first_key */,
+        false /* key_includes_seq */, true /* value_is_full */));
+    std::unique_ptr<IndexBlockIter> actual(block.NewIndexIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber, nullptr, nullptr,
+        true /* total_order_seek */, false /* have_first_key */,
+        false /* key_includes_seq */, true /* value_is_full */,
+        false /* block_contents_pinned */, true /* udt_persisted */,
+        nullptr /* prefix_index */, model.get()));
+
+    for (const auto &target : targets) {
+      std::string ikey = InternalKey(target, kMaxSequenceNumber, kTypeValue)
+                             .Encode()
+                             .ToString();
+      expected->Seek(ikey);
+      actual->Seek(ikey);
+      ASSERT_OK(actual->status());
+      ASSERT_EQ(expected->Valid(), actual->Valid()) << target;
+      if (expected->Valid()) {
+        ASSERT_EQ(expected->key(), actual->key());
+        ASSERT_EQ(expected->value().handle.offset(),
+                  actual->value().handle.offset());
+      }
+    }
+  }
+};
+
+namespace {
+std::string EncodeIntegerKey(uint64_t value, const std::string &suffix) {
+  std::string key;
+  PutFixed64(&key, EndianSwapValue(value));
+  return key + suffix;
+}
+}  // namespace
+
+TEST_P(LearnedIndexTest, SequentialIntegerKeys) {
+  std::vector<std::string> user_keys;
+  std::vector<std::string> targets;
+  for (uint64_t i = 0; i < 2000; ++i) {
+    user_keys.push_back(EncodeIntegerKey(1000 + i * 7, "suffix"));
+    targets.push_back(user_keys.back());
+    targets.push_back(EncodeIntegerKey(1000 + i * 7, ""));
+    targets.push_back(EncodeIntegerKey(1000 + i * 7 + 3, ""));
+  }
+  targets.emplace_back("");
+  targets.push_back(EncodeIntegerKey(0, ""));
+  targets.emplace_back(std::string(20, '\xff'));
+  size_t num_segments = 0;
+  VerifySeeks(user_keys, targets, &num_segments);
+  // Evenly spaced keys fit in a single segment
+  ASSERT_EQ(num_segments, 1);
+}
+
+TEST_P(LearnedIndexTest, RandomKeys) {
+  Random rnd(301);
+  for (size_t max_key_len : {1, 4, 8, 12, 24}) {
+    std::set<std::string> key_set;
+    std::vector<std::string> targets;
+    for (int i = 0; i < 1000; ++i) {
+      // Mix clustered and skewed keys, and keys sharing the same prefix
+      size_t len = 1 + rnd.Uniform(static_cast<int>(max_key_len));
+      std::string key = rnd.Uniform(4) == 0
+                            ? rnd.RandomBinaryString(static_cast<int>(len))
+                            : std::string(len, static_cast<char>(
+                                                   'a' + rnd.Uniform(3)));
+      key.back() = static_cast<char>(rnd.Uniform(256));
+      key_set.insert(key);
+      targets.push_back(rnd.RandomBinaryString(
+          static_cast<int>(rnd.Uniform(static_cast<int>(max_key_len) + 2))));
+    }
+    std::vector<std::string> user_keys(key_set.begin(), key_set.end());
+    targets.insert(targets.end(), user_keys.begin(), user_keys.end());
+    targets.emplace_back("");
+    targets.emplace_back(std::string(30, '\xff'));
+    VerifySeeks(user_keys, targets);
+  }
+}
+
+TEST_P(LearnedIndexTest, CorruptModel) {
+  LearnedIndexModelBuilder model_builder;
+  for (uint64_t i = 0; i < 100; ++i) {
+    model_builder.Add(EncodeIntegerKey(i * i, ""));
+  }
+  std::string model_contents;
+  model_builder.Finish(static_cast<uint32_t>(restartInterval()),
+                       &model_contents);
+  LearnedIndexModel *raw_model = nullptr;
+  ASSERT_OK(LearnedIndexModel::Create(model_contents, &raw_model));
+  delete raw_model;
+
+  model_contents.pop_back();
+  ASSERT_TRUE(
+      LearnedIndexModel::Create(model_contents, &raw_model).IsCorruption());
+  ASSERT_TRUE(LearnedIndexModel::Create(Slice(), &raw_model).IsCorruption());
+}
+
+INSTANTIATE_TEST_CASE_P(P, LearnedIndexTest, ::testing::Values(1, 4, 16));
+
 // A slow and accurate version of BlockReadAmpBitmap that simply store
 // all the marked ranges in a set.
 class BlockReadAmpBitmapSlowAndAccurate {
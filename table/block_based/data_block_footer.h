@@ -13,13 +13,17 @@
 
 namespace ROCKSDB_NAMESPACE {
 
+// The block footer packs num_restarts together with flags describing the
+// optional data block index sections: the MSB marks a data block hash index
+// (see data_block_hash_index.h) and the next bit marks a restart key prefix
+// index (see restart_key_prefix_index.h).
 uint32_t PackIndexTypeAndNumRestarts(
     BlockBasedTableOptions::DataBlockIndexType index_type,
-    uint32_t num_restarts);
+    uint32_t num_restarts, bool has_restart_key_prefix = false);
 
 void UnPackIndexTypeAndNumRestarts(
     uint32_t block_footer,
     BlockBasedTableOptions::DataBlockIndexType* index_type,
-    uint32_t* num_restarts);
+    uint32_t* num_restarts, bool* has_restart_key_prefix = nullptr);
 
 }  // namespace ROCKSDB_NAMESPACE
@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 
+#include "port/port.h"
 #include "rocksdb/slice.h"
 #include "util/coding.h"
 #include "util/hash.h"
@@ -91,4 +92,12 @@ uint8_t DataBlockHashIndex::Lookup(const char* data, uint32_t map_offset,
   return static_cast<uint8_t>(*(bucket_table + idx * sizeof(uint8_t)));
 }
 
+void DataBlockHashIndex::Prefetch(const char* data, uint32_t map_offset,
+                                  const Slice& key) const {
+  uint32_t hash_value = GetSliceHash(key);
+  uint16_t idx = static_cast<uint16_t>(hash_value % num_buckets_);
+  PREFETCH(data + map_offset + idx * sizeof(uint8_t), 0 /* rw */,
+           3 /* locality */);
+}
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,190 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/learned_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include "table/block_based/restart_key_prefix_index.h"
+#include "util/coding.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+void PutDouble(std::string* dst, double value) {
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(value), "");
+  memcpy(&bits, &value, sizeof(bits));
+  PutFixed64(dst, bits);
+}
+
+double DecodeDouble(const char* ptr) {
+  uint64_t bits = DecodeFixed64(ptr);
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+}  // namespace
+
+void LearnedIndexModelBuilder::Add(const Slice& user_key) {
+  uint64_t prefix = RestartKeyPrefixIndex::EncodePrefix(user_key);
+  uint32_t rank = num_entries_++;
+  if (!has_prefix_) {
+    has_prefix_ = true;
+    AddPoint(prefix, rank);
+  } else if (prefix != last_prefix_) {
+    assert(prefix > last_prefix_);
+    // g() steps up right after the previous prefix, and stays constant until
+    // this prefix.
+    if (last_prefix_ + 1 < prefix) {
+      AddPoint(last_prefix_ + 1, rank);
+    }
+    AddPoint(prefix, rank);
+  }
+  last_prefix_ = prefix;
+}
+
+void LearnedIndexModelBuilder::AddPoint(uint64_t x, uint32_t y) {
+  if (segment_open_) {
+    assert(x > current_.first_key);
+    const double dx = static_cast<double>(x - current_.first_key);
+    const double dy = static_cast<double>(y) - current_.first_rank;
+    const double min_slope = std::max(min_slope_, (dy - epsilon_) / dx);
+    const double max_slope = std::min(max_slope_, (dy + epsilon_) / dx);
+    if (min_slope <= max_slope) {
+      min_slope_ = min_slope;
+      max_slope_ = max_slope;
+      current_.last_key = x;
+      return;
+    }
+    CloseSegment();
+  }
+  // Start a new segment at this point. g() is non-decreasing, so a
+  // non-negative slope is always feasible.
+  segment_open_ = true;
+  current_.first_key = x;
+  current_.last_key = x;
+  current_.first_rank = y;
+  current_.slope = 0;
+  min_slope_ = 0;
+  max_slope_ = std::numeric_limits<double>::infinity();
+}
+
+void LearnedIndexModelBuilder::CloseSegment() {
+  assert(segment_open_);
+  if (current_.last_key != current_.first_key) {
+    current_.slope = min_slope_ + (max_slope_ - min_slope_) / 2;
+  }
+  segments_.push_back(current_);
+  segment_open_ = false;
+}
+
+void LearnedIndexModelBuilder::Finish(uint32_t restart_interval,
+                                      std::string* buffer) {
+  assert(restart_interval > 0);
+  if (has_prefix_ && last_prefix_ != std::numeric_limits<uint64_t>::max()) {
+    AddPoint(last_prefix_ + 1, num_entries_);
+  }
+  if (segment_open_) {
+    CloseSegment();
+  }
+  PutVarint32Varint32(buffer, num_entries_, restart_interval);
+  PutVarint32Varint32(buffer, epsilon_,
+                      static_cast<uint32_t>(segments_.size()));
+  for (const auto& segment : segments_) {
+    PutFixed64(buffer, segment.first_key);
+    PutFixed64(buffer, segment.last_key);
+    PutFixed32(buffer, segment.first_rank);
+    PutDouble(buffer, segment.slope);
+  }
+}
+
+Status LearnedIndexModel::Create(const Slice& contents,
+                                 LearnedIndexModel** model) {
+  Slice input = contents;
+  uint32_t num_entries = 0;
+  uint32_t restart_interval = 0;
+  uint32_t epsilon = 0;
+  uint32_t num_segments = 0;
+  if (!GetVarint32(&input, &num_entries) ||
+      !GetVarint32(&input, &restart_interval) ||
+      !GetVarint32(&input, &epsilon) || !GetVarint32(&input, &num_segments) ||
+      restart_interval == 0) {
+    return Status::Corruption("Bad learned index model header");
+  }
+  constexpr size_t kSegmentSize =
+      2 * sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t);
+  if (input.size() != static_cast<size_t>(num_segments) * kSegmentSize) {
+    return Status::Corruption("Bad learned index model size");
+  }
+
+  std::unique_ptr<LearnedIndexModel> result(new LearnedIndexModel());
+  result->num_entries_ = num_entries;
+  result->restart_interval_ = restart_interval;
+  result->epsilon_ = epsilon;
+  result->segments_.reserve(num_segments);
+  const char* ptr = input.data();
+  for (uint32_t i = 0; i < num_segments; i++) {
+    Segment segment;
+    segment.first_key = DecodeFixed64(ptr);
+    segment.last_key = DecodeFixed64(ptr + 8);
+    segment.first_rank = DecodeFixed32(ptr + 16);
+    segment.slope = DecodeDouble(ptr + 20);
+    ptr += kSegmentSize;
+    if (segment.last_key < segment.first_key || !(segment.slope >= 0) ||
+        std::isinf(segment.slope) ||
+        (i > 0 && segment.first_key <= result->segments_.back().last_key)) {
+      return Status::Corruption("Bad learned index model segment");
+    }
+    result->segments_.push_back(segment);
+  }
+  *model = result.release();
+  return Status::OK();
+}
+
+double LearnedIndexModel::Predict(uint64_t x) const {
+  auto it = std::upper_bound(
+      segments_.begin(), segments_.end(), x,
+      [](uint64_t key, const Segment& s) { return key < s.first_key; });
+  if (it == segments_.begin()) {
+    // Before the first index entry's prefix
+    return 0;
+  }
+  --it;
+  // g() is constant between the last point of a segment and the first point
+  // of the next one, so don't extrapolate.
+  uint64_t clamped = std::min(x, it->last_key);
+  return it->first_rank +
+         it->slope * static_cast<double>(clamped - it->first_key);
+}
+
+void LearnedIndexModel::FindRestartRange(const Slice& user_key,
+                                         uint32_t* lower,
+                                         uint32_t* upper) const {
+  uint64_t x = RestartKeyPrefixIndex::EncodePrefix(user_key);
+  // One more than epsilon absorbs floating point rounding
+  const double margin = epsilon_ + 1.0;
+  const double lo = Predict(x) - margin;
+  const double hi = x == std::numeric_limits<uint64_t>::max()
+                        ? num_entries_
+                        : Predict(x + 1) + margin;
+  uint32_t lower_entry =
+      lo <= 0 ? 0 : static_cast<uint32_t>(std::min<double>(lo, num_entries_));
+  uint32_t upper_entry = hi >= num_entries_
+                             ? num_entries_
+                             : static_cast<uint32_t>(std::ceil(hi));
+  upper_entry = std::max(lower_entry, upper_entry);
+  *lower = lower_entry / restart_interval_;
+  *upper = (upper_entry + restart_interval_ - 1) / restart_interval_;
+  assert(*lower <= *upper);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,135 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+// This is an experimental feature backing
+// BlockBasedTableOptions::kLearnedIndexSearch. It aims to reduce the number of
+// key comparisons needed to find a data block in the index block, for keys
+// whose distribution is close to piecewise linear (e.g. fixed width,
+// monotonically assigned keys).
+//
+// Index keys are mapped to the first kRestartKeyPrefixSize bytes of their user
+// key, zero padded and read as a big-endian integer (like the restart key
+// prefix index of data blocks). Let g(x) be the number of index entries whose
+// prefix is less than x. g is a non-decreasing step function, and the model is
+// a piecewise-linear function f with |f(x) - g(x)| <= epsilon for all x, in
+// the spirit of the PGM-index. It is built in one pass with the greedy
+// "shrinking cone" algorithm over the points where g changes value.
+//
+// For a seek target whose prefix is x, index entries before g(x) are strictly
+// less than the target and index entries at or after g(x + 1) are strictly
+// greater, so the binary search over the index block only needs to consider
+// the entries in [f(x) - epsilon, f(x + 1) + epsilon].
+//
+// The model is stored in a meta block (kLearnedIndexModelBlock) next to a
+// regular binary search index block, which keeps the index block format
+// unchanged and lets readers fall back to a full binary search when the model
+// is missing. It is only written for tables whose user comparator is
+// BytewiseComparator() and which do not use user-defined timestamps.
+//
+// Model block format:
+//
+// [NUM_ENTRIES RESTART_INTERVAL EPSILON NUM_SEGMENTS] as varint32
+// NUM_SEGMENTS x [FIRST_KEY LAST_KEY as fixed64, FIRST_RANK as fixed32,
+//                 SLOPE as fixed64 (IEEE 754 bits)]
+class LearnedIndexModel {
+ public:
+  struct Segment {
+    // Prefixes of the first and last points covered by the segment
+    uint64_t first_key;
+    uint64_t last_key;
+    // g(first_key)
+    uint32_t first_rank;
+    double slope;
+  };
+
+  static constexpr uint32_t kDefaultEpsilon = 4;
+
+  // Parses a model block. The returned model references no memory of
+  // `contents`.
+  static Status Create(const Slice& contents, LearnedIndexModel** model);
+
+  // Finds the range of restart points of the index block that may need a full
+  // key comparison against `user_key`: restart keys before `*lower` are
+  // strictly less than `user_key`, and restart keys at or after `*upper` are
+  // strictly greater.
+  void FindRestartRange(const Slice& user_key, uint32_t* lower,
+                        uint32_t* upper) const;
+
+  // Number of restart points of the index block the model was built for
+  uint32_t NumRestarts() const {
+    return (num_entries_ + restart_interval_ - 1) / restart_interval_;
+  }
+
+  size_t NumSegments() const { return segments_.size(); }
+
+  size_t ApproximateMemoryUsage() const {
+    return sizeof(*this) + segments_.capacity() * sizeof(Segment);
+  }
+
+ private:
+  friend class LearnedIndexModelBuilder;
+
+  LearnedIndexModel() = default;
+
+  // Returns f(x)
+  double Predict(uint64_t x) const;
+
+  uint32_t num_entries_ = 0;
+  uint32_t restart_interval_ = 1;
+  uint32_t epsilon_ = kDefaultEpsilon;
+  std::vector<Segment> segments_;
+};
+
+class LearnedIndexModelBuilder {
+ public:
+  explicit LearnedIndexModelBuilder(
+      uint32_t epsilon = LearnedIndexModel::kDefaultEpsilon)
+      : epsilon_(epsilon) {}
+
+  // REQUIRES: called with the user key of every index entry, in order.
+  void Add(const Slice& user_key);
+
+  // Appends the model block for an index block with `restart_interval` to
+  // `buffer`.
+  void Finish(uint32_t restart_interval, std::string* buffer);
+
+  size_t EstimateSize() const {
+    return (segments_.size() + 1) * kEncodedSegmentSize;
+  }
+
+ private:
+  static constexpr size_t kEncodedSegmentSize =
+      2 * sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+  void AddPoint(uint64_t x, uint32_t y);
+  void CloseSegment();
+
+  const uint32_t epsilon_;
+  uint32_t num_entries_ = 0;
+  bool has_prefix_ = false;
+  uint64_t last_prefix_ = 0;
+
+  // The segment being built, and the range of slopes keeping all of its
+  // points within epsilon.
+  bool segment_open_ = false;
+  LearnedIndexModel::Segment current_{};
+  double min_slope_ = 0;
+  double max_slope_ = 0;
+
+  std::vector<LearnedIndexModel::Segment> segments_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
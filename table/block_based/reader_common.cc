@@ -8,6 +8,9 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "table/block_based/reader_common.h"
 
+#include <algorithm>
+#include <array>
+
 #include "monitoring/perf_context_imp.h"
 #include "rocksdb/table.h"
 #include "table/format.h"
@@ -22,22 +25,14 @@ void ForceReleaseCachedEntry(void* arg, void* h) {
   cache->Release(handle, true /* erase_if_last_ref */);
 }
 
-// WART: this is specific to block-based table
-Status VerifyBlockChecksum(const Footer& footer, const char* data,
-                           size_t block_size, const std::string& file_name,
-                           uint64_t offset) {
-  PERF_TIMER_GUARD(block_checksum_time);
-
-  assert(footer.GetBlockTrailerSize() == 5);
+namespace {
+Status CheckBlockChecksum(const Footer& footer, const char* data,
+                          size_t block_size, const std::string& file_name,
+                          uint64_t offset, uint32_t computed) {
   ChecksumType type = footer.checksum_type();
-
   // After block_size bytes is compression type (1 byte), which is part of
-  // the checksummed section.
-  size_t len = block_size + 1;
-  // And then the stored checksum value (4 bytes).
-  uint32_t stored = DecodeFixed32(data + len);
-
-  uint32_t computed = ComputeBuiltinChecksum(type, data, len);
+  // the checksummed section. And then the stored checksum value (4 bytes).
+  uint32_t stored = DecodeFixed32(data + block_size + 1);
 
   // Unapply context to 'stored' rather than apply to 'computed, for people
   // who might look for reference crc value in error message
@@ -61,4 +56,45 @@ Status VerifyBlockChecksum(const Footer& footer, const char* data,
         std::to_string(offset) + " size " + std::to_string(block_size));
   }
 }
+}  // namespace
+
+// WART: this is specific to block-based table
+Status VerifyBlockChecksum(const Footer& footer, const char* data,
+                           size_t block_size, const std::string& file_name,
+                           uint64_t offset) {
+  PERF_TIMER_GUARD(block_checksum_time);
+
+  assert(footer.GetBlockTrailerSize() == 5);
+  uint32_t computed =
+      ComputeBuiltinChecksum(footer.checksum_type(), data, block_size + 1);
+  return CheckBlockChecksum(footer, data, block_size, file_name, offset,
+                            computed);
+}
+
+void VerifyBlockChecksums(const Footer& footer, size_t num_blocks,
+                          const char* const* data, const size_t* block_sizes,
+                          const uint64_t* offsets,
+                          const std::string& file_name, Status* statuses) {
+  PERF_TIMER_GUARD(block_checksum_time);
+
+  assert(footer.GetBlockTrailerSize() == 5);
+  // Verify in chunks to bound the stack space used
+  constexpr size_t kChunkSize = 32;
+  std::array<size_t, kChunkSize> lens;
+  std::array<uint32_t, kChunkSize> computed;
+  for (size_t begin = 0; begin < num_blocks; begin += kChunkSize) {
+    size_t n = std::min(kChunkSize, num_blocks - begin);
+    for (size_t i = 0; i < n; ++i) {
+      // Include the compression type byte in the checksummed section
+      lens[i] = block_sizes[begin + i] + 1;
+    }
+    ComputeBuiltinChecksums(footer.checksum_type(), n, data + begin,
+                            lens.data(), computed.data());
+    for (size_t i = 0; i < n; ++i) {
+      statuses[begin + i] =
+          CheckBlockChecksum(footer, data[begin + i], block_sizes[begin + i],
+                             file_name, offsets[begin + i], computed[i]);
+    }
+  }
+}
 }  // namespace ROCKSDB_NAMESPACE
@@ -33,4 +33,12 @@ inline MemoryAllocator* GetMemoryAllocator(
 Status VerifyBlockChecksum(const Footer& footer, const char* data,
                            size_t block_size, const std::string& file_name,
                            uint64_t offset);
+
+// Like VerifyBlockChecksum() for `num_blocks` blocks, setting `statuses[i]`
+// for block i. Verifying several blocks at once allows their checksums to be
+// computed in parallel (see ComputeBuiltinChecksums()).
+void VerifyBlockChecksums(const Footer& footer, size_t num_blocks,
+                          const char* const* data, const size_t* block_sizes,
+                          const uint64_t* offsets,
+                          const std::string& file_name, Status* statuses);
 }  // namespace ROCKSDB_NAMESPACE
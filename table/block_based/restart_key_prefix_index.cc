@@ -0,0 +1,121 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/restart_key_prefix_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "util/coding.h"
+#include "util/math.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+// Below this many candidates, a (vectorized) linear count is cheaper than
+// more branchy binary search steps.
+constexpr uint32_t kLinearCountThreshold = 16;
+}  // namespace
+
+uint64_t RestartKeyPrefixIndex::EncodePrefix(const Slice& user_key) {
+  char buf[kRestartKeyPrefixSize] = {};
+  memcpy(buf, user_key.data(),
+         std::min(user_key.size(), kRestartKeyPrefixSize));
+  return EndianSwapValue(DecodeFixed64(buf));
+}
+
+void RestartKeyPrefixIndexBuilder::Add(const Slice& user_key) {
+  assert(Valid());
+  prefixes_.push_back(RestartKeyPrefixIndex::EncodePrefix(user_key));
+}
+
+void RestartKeyPrefixIndexBuilder::Finish(std::string& buffer) const {
+  assert(Valid());
+  for (uint64_t prefix : prefixes_) {
+    PutFixed64(&buffer, EndianSwapValue(prefix));
+  }
+}
+
+uint64_t RestartKeyPrefixIndex::PrefixAt(uint32_t index) const {
+  assert(index < num_restarts_);
+  return EndianSwapValue(
+      DecodeFixed64(prefixes_ + index * kRestartKeyPrefixSize));
+}
+
+uint32_t RestartKeyPrefixIndex::CountLess(uint32_t begin, uint32_t end,
+                                          uint64_t prefix,
+                                          bool inclusive) const {
+  // Narrow down with binary search first
+  while (end - begin > kLinearCountThreshold) {
+    uint32_t mid = begin + (end - begin) / 2;
+    uint64_t mid_prefix = PrefixAt(mid);
+    if (mid_prefix < prefix || (inclusive && mid_prefix == prefix)) {
+      begin = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+
+  // The prefixes are sorted, so the number of matching prefixes in
+  // [begin, end) is the offset of the first non-matching one.
+  uint32_t i = begin;
+  uint32_t count = 0;
+#ifdef __AVX2__
+  // Byte shuffle reversing each 64-bit lane (big-endian to native), and sign
+  // flip to emulate unsigned comparison with the signed compare instruction.
+  const __m256i kByteSwap =
+      _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7,
+                       6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  const __m256i kSignFlip =
+      _mm256_set1_epi64x(static_cast<int64_t>(uint64_t{1} << 63));
+  const __m256i target = _mm256_xor_si256(
+      _mm256_set1_epi64x(static_cast<int64_t>(prefix)), kSignFlip);
+  for (; i + 4 <= end; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+        prefixes_ + i * kRestartKeyPrefixSize));
+    v = _mm256_xor_si256(_mm256_shuffle_epi8(v, kByteSwap), kSignFlip);
+    // inclusive: !(v > target); otherwise: target > v
+    __m256i cmp = inclusive ? _mm256_cmpgt_epi64(v, target)
+                            : _mm256_cmpgt_epi64(target, v);
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+    count += static_cast<uint32_t>(
+        BitsSetToOne(static_cast<uint32_t>(inclusive ? (~mask & 0xf) : mask)));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint64x2_t target = vdupq_n_u64(prefix);
+  for (; i + 2 <= end; i += 2) {
+    uint64x2_t v = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(reinterpret_cast<
+        const uint8_t*>(prefixes_ + i * kRestartKeyPrefixSize))));
+    uint64x2_t cmp = inclusive ? vcleq_u64(v, target) : vcltq_u64(v, target);
+    count += static_cast<uint32_t>((vgetq_lane_u64(cmp, 0) & 1) +
+                                   (vgetq_lane_u64(cmp, 1) & 1));
+  }
+#endif
+  for (; i < end; ++i) {
+    uint64_t p = PrefixAt(i);
+    count += (p < prefix || (inclusive && p == prefix)) ? 1 : 0;
+  }
+  return begin + count;
+}
+
+void RestartKeyPrefixIndex::FindRestartRange(const Slice& user_key,
+                                             uint32_t* lower,
+                                             uint32_t* upper) const {
+  assert(Valid());
+  uint64_t prefix = EncodePrefix(user_key);
+  *lower = CountLess(0, num_restarts_, prefix, false /* inclusive */);
+  *upper = CountLess(*lower, num_restarts_, prefix, true /* inclusive */);
+  assert(*lower <= *upper);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
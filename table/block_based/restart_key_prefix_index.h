@@ -0,0 +1,102 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+// This is an experimental feature aiming to reduce the CPU cost of seeking
+// within a data block. It is only used in data blocks of tables whose user
+// comparator is BytewiseComparator() and which do not use user-defined
+// timestamps.
+//
+// For every restart point, the first kRestartKeyPrefixSize bytes of the
+// restart key's user key (zero padded when shorter) are appended to the block
+// as a fixed-width array, right before the block footer:
+//
+// DATA_BLOCK: [RI RI RI ... RI RI_IDX (HASH_IDX) PREFIX_IDX FOOTER]
+//
+// PREFIX_IDX: [P P P ... P], one 8-byte prefix per restart point
+// FOOTER:     NUM_RESTARTS with bit 30 set as the flag indicating that
+//             PREFIX_IDX is present (see data_block_footer.h).
+//
+// The prefixes are stored big-endian (i.e. as the raw key bytes), so they
+// can be compared as unsigned 64-bit integers and order the same way as the
+// keys under a bytewise comparator. Zero-padded truncation is monotonic, so
+// the prefix array is sorted and, for a target user key with prefix `p`:
+//  - every restart key whose prefix is < `p` is strictly less than target,
+//  - every restart key whose prefix is > `p` is strictly greater than target.
+// A seek can therefore narrow the restart binary search down to the restart
+// points sharing the target's prefix (usually zero or one) with a cheap
+// integer search over a contiguous array, vectorized with AVX2 or NEON where
+// available, before falling back to the regular comparator-based search.
+//
+// Like the hash index, the prefix index is only written for blocks smaller
+// than 64KiB, since larger blocks interpret the footer as a raw restart count
+// for backward compatibility.
+
+const size_t kRestartKeyPrefixSize = sizeof(uint64_t);
+
+class RestartKeyPrefixIndexBuilder {
+ public:
+  RestartKeyPrefixIndexBuilder() : valid_(false) {}
+
+  void Initialize() { valid_ = true; }
+
+  inline bool Valid() const { return valid_; }
+  // REQUIRES: called with the user key of each restart point, in order.
+  void Add(const Slice& user_key);
+  void Finish(std::string& buffer) const;
+  void Reset() { prefixes_.clear(); }
+  inline size_t NumPrefixes() const { return prefixes_.size(); }
+  inline size_t EstimateSize() const {
+    return prefixes_.size() * kRestartKeyPrefixSize;
+  }
+
+ private:
+  bool valid_;
+  std::vector<uint64_t> prefixes_;
+};
+
+class RestartKeyPrefixIndex {
+ public:
+  RestartKeyPrefixIndex() : prefixes_(nullptr), num_restarts_(0) {}
+
+  // `data` points to the PREFIX_IDX section of a block with `num_restarts`
+  // restart points.
+  void Initialize(const char* data, uint32_t num_restarts) {
+    prefixes_ = data;
+    num_restarts_ = num_restarts;
+  }
+
+  inline bool Valid() const { return prefixes_ != nullptr; }
+
+  // Finds the range of restart points that may need a full key comparison
+  // against `user_key`: restart keys before `*lower` are strictly less than
+  // `user_key`, and restart keys at or after `*upper` are strictly greater.
+  void FindRestartRange(const Slice& user_key, uint32_t* lower,
+                        uint32_t* upper) const;
+
+  // Returns the zero-padded big-endian prefix of `user_key` as an integer.
+  static uint64_t EncodePrefix(const Slice& user_key);
+
+ private:
+  // Returns the number of prefixes in [begin, end) that are less than (or
+  // less than or equal to, if `inclusive`) `prefix`.
+  uint32_t CountLess(uint32_t begin, uint32_t end, uint64_t prefix,
+                     bool inclusive) const;
+  uint64_t PrefixAt(uint32_t index) const;
+
+  const char* prefixes_;
+  uint32_t num_restarts_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
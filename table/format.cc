@@ -582,6 +582,23 @@ uint32_t ComputeBuiltinChecksum(ChecksumType type, const char* data,
   }
 }
 
+void ComputeBuiltinChecksums(ChecksumType type, size_t count,
+                             const char* const* data, const size_t* sizes,
+                             uint32_t* out) {
+  if (type == kCRC32c) {
+    crc32c::ValueBatch(count, data, sizes, out);
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = crc32c::Mask(out[i]);
+    }
+    return;
+  }
+  // XXH3 and the older xxHash variants already use all the lanes available
+  // within one (block sized) input.
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = ComputeBuiltinChecksum(type, data[i], sizes[i]);
+  }
+}
+
 uint32_t ComputeBuiltinChecksumWithLastByte(ChecksumType type, const char* data,
                                             size_t data_size, char last_byte) {
   switch (type) {
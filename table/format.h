@@ -317,6 +317,13 @@ uint32_t ComputeBuiltinChecksum(ChecksumType type, const char* data,
 uint32_t ComputeBuiltinChecksumWithLastByte(ChecksumType type, const char* data,
                                             size_t size, char last_byte);
 
+// For i in [0, count), sets out[i] = ComputeBuiltinChecksum(type, data[i],
+// sizes[i]). Independent inputs are checksummed in parallel where supported
+// (currently interleaved crc32c streams, see crc32c::ValueBatch()).
+void ComputeBuiltinChecksums(ChecksumType type, size_t count,
+                             const char* const* data, const size_t* sizes,
+                             uint32_t* out);
+
 // Represents the contents of a block read from an SST file. Depending on how
 // it's created, it may or may not own the actual block bytes. As an example,
 // BlockContents objects representing data read from mmapped files only point
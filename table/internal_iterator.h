@@ -205,6 +205,14 @@ class InternalIteratorBase : public Cleanable {
   // Default implementation is no-op and its implemented by iterators.
   virtual void SetReadaheadState(ReadaheadFileInfo* /*readahead_file_info*/) {}
 
+  // Hints the iterator about the internal key ranges [start, limit) that are
+  // about to be scanned, sorted by start. See Iterator::Prepare(). The
+  // iterator is left unpositioned. Implementations may keep referring to the
+  // memory pointed to by the range slices, which is owned by the caller and
+  // needs to outlive the iterator or the next call to Prepare(). Default
+  // implementation is no-op.
+  virtual void Prepare(const std::vector<ScanRange>& /*scan_ranges*/) {}
+
   // When used under merging iterator, LevelIterator treats file boundaries
   // as sentinel keys to prevent it from moving to next SST file before range
   // tombstones in the current SST file are no longer needed. This method makes
@@ -183,6 +183,12 @@ class IteratorWrapperBase {
     return iter_->user_key();
   }
 
+  void Prepare(const std::vector<ScanRange>& scan_ranges) {
+    assert(iter_);
+    iter_->Prepare(scan_ranges);
+    Update();
+  }
+
   void UpdateReadaheadState(InternalIteratorBase<TValue>* old_iter) {
     if (old_iter && iter_) {
       ReadaheadFileInfo readahead_file_info;
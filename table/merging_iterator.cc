@@ -463,6 +463,13 @@ class MergingIterator : public InternalIterator {
     return current_->UpperBoundCheckResult();
   }
 
+  void Prepare(const std::vector<ScanRange>& scan_ranges) override {
+    for (auto& child : children_) {
+      child.iter.Prepare(scan_ranges);
+    }
+    current_ = nullptr;
+  }
+
   void SetPinnedItersMgr(PinnedIteratorsManager* pinned_iters_mgr) override {
     pinned_iters_mgr_ = pinned_iters_mgr;
     for (auto& child : children_) {
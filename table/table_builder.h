@@ -216,6 +216,15 @@ class TableBuilder {
 
   virtual uint64_t GetTailSize() const { return 0; }
 
+  // Time spent compressing data blocks in the background, and waiting for
+  // that compression in the caller's thread, when compression is
+  // parallelized. Only valid after Finish().
+  virtual void GetParallelCompressionTimes(uint64_t* compress_nanos,
+                                           uint64_t* wait_nanos) const {
+    *compress_nanos = 0;
+    *wait_nanos = 0;
+  }
+
   // If the user defined table properties collector suggest the file to
   // be further compacted.
   virtual bool NeedCompact() const { return false; }
@@ -15,6 +15,7 @@ int main() {
 #include "db/dbformat.h"
 #include "file/random_access_file_reader.h"
 #include "monitoring/histogram.h"
+#include "rocksdb/convenience.h"
 #include "rocksdb/db.h"
 #include "rocksdb/file_system.h"
 #include "rocksdb/slice_transform.h"
@@ -27,7 +28,9 @@ int main() {
 #include "table/table_builder.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
+#include "util/coding.h"
 #include "util/gflags_compat.h"
+#include "util/math.h"
 
 using GFLAGS_NAMESPACE::ParseCommandLineFlags;
 using GFLAGS_NAMESPACE::SetUsageMessage;
@@ -36,18 +39,27 @@ namespace ROCKSDB_NAMESPACE {
 
 namespace {
 // Make a key that i determines the first 4 characters and j determines the
-// last 4 characters.
-static std::string MakeKey(int i, int j, bool through_db) {
+// last 4 characters. With `integer_keys`, the key starts with i and j encoded
+// as a big-endian integer instead, like fixed-width keys assigned in
+// increasing order.
+static std::string MakeKey(int i, int j, bool through_db, bool integer_keys) {
   char buf[100];
-  snprintf(buf, sizeof(buf), "%04d__key___%04d", i, j);
+  if (integer_keys) {
+    assert(j >= 0 && j <= 0xffff);
+    uint64_t id = (static_cast<uint64_t>(i) << 16) | static_cast<uint64_t>(j);
+    EncodeFixed64(buf, EndianSwapValue(id));
+    snprintf(buf + sizeof(id), sizeof(buf) - sizeof(id), "__key___");
+  } else {
+    snprintf(buf, sizeof(buf), "%04d__key___%04d", i, j);
+  }
   if (through_db) {
-    return std::string(buf);
+    return std::string(buf, 16);
   }
   // If we directly query table, which operates on internal keys
   // instead of user keys, we need to add 8 bytes of internal
   // information (row type etc) to user key to make an internal
   // key.
-  InternalKey key(std::string(buf), 0, ValueType::kTypeValue);
+  InternalKey key(std::string(buf, 16), 0, ValueType::kTypeValue);
   return key.Encode().ToString();
 }
 
@@ -74,7 +86,8 @@ void TableReaderBenchmark(Options& opts, EnvOptions& env_options,
                           ReadOptions& read_options, int num_keys1,
                           int num_keys2, int num_iter, int /*prefix_len*/,
                           bool if_query_empty_keys, bool for_iterator,
-                          bool through_db, bool measured_by_nanosecond) {
+                          bool through_db, bool measured_by_nanosecond,
+                          bool integer_keys) {
   ROCKSDB_NAMESPACE::InternalKeyComparator ikc(opts.comparator);
 
   std::string file_name =
@@ -114,7 +127,7 @@ void TableReaderBenchmark(Options& opts, EnvOptions& env_options,
   // Populate slightly more than 1M keys
   for (int i = 0; i < num_keys1; i++) {
     for (int j = 0; j < num_keys2; j++) {
-      std::string key = MakeKey(i * 2, j, through_db);
+      std::string key = MakeKey(i * 2, j, through_db, integer_keys);
       if (!through_db) {
         tb->Add(key, key);
       } else {
@@ -170,7 +183,7 @@ void TableReaderBenchmark(Options& opts, EnvOptions& env_options,
 
         if (!for_iterator) {
           // Query one existing key;
-          std::string key = MakeKey(r1, r2, through_db);
+          std::string key = MakeKey(r1, r2, through_db, integer_keys);
           uint64_t start_time = Now(clock, measured_by_nanosecond);
           if (!through_db) {
             PinnableSlice value;
@@ -196,8 +209,9 @@ void TableReaderBenchmark(Options& opts, EnvOptions& env_options,
               r2_len = num_keys2 - r2;
             }
           }
-          std::string start_key = MakeKey(r1, r2, through_db);
-          std::string end_key = MakeKey(r1, r2 + r2_len, through_db);
+          std::string start_key = MakeKey(r1, r2, through_db, integer_keys);
+          std::string end_key =
+              MakeKey(r1, r2 + r2_len, through_db, integer_keys);
           uint64_t total_time = 0;
           uint64_t start_time = Now(clock, measured_by_nanosecond);
           Iterator* iter = nullptr;
@@ -218,7 +232,7 @@ void TableReaderBenchmark(Options& opts, EnvOptions& env_options,
             }
             // verify key;
             total_time += Now(clock, measured_by_nanosecond) - start_time;
-            assert(Slice(MakeKey(r1, r2 + count, through_db)) ==
+            assert(Slice(MakeKey(r1, r2 + count, through_db, integer_keys)) ==
                    (through_db ? iter->key() : iiter->key()));
             start_time = Now(clock, measured_by_nanosecond);
             if (++count >= r2_len) {
@@ -253,6 +267,13 @@ void TableReaderBenchmark(Options& opts, EnvOptions& env_options,
       for_iterator ? "iterator" : (if_query_empty_keys ? "empty" : "non_empty"),
       measured_by_nanosecond ? "nanosecond" : "microsecond",
       hist.ToString().c_str());
+  if (!through_db) {
+    fprintf(stderr,
+            "Index size: %" PRIu64
+            " bytes, table reader memory usage: %" ROCKSDB_PRIszt " bytes\n",
+            table_reader->GetTableProperties()->index_size,
+            table_reader->ApproximateMemoryUsage());
+  }
   if (!through_db) {
     env->DeleteFile(file_name);
   } else {
@@ -278,6 +299,24 @@ DEFINE_bool(mmap_read, true, "Whether use mmap read");
 DEFINE_string(table_factory, "block_based",
               "Table factory to use: `block_based` (default), `plain_table` or "
               "`cuckoo_hash`.");
+DEFINE_int32(block_size, 4096,
+             "Data block size for the `block_based` table factory");
+DEFINE_int32(block_restart_interval, 16,
+             "Restart interval of data blocks for the `block_based` table "
+             "factory");
+DEFINE_bool(adaptive_block_restart_interval, false,
+            "Whether to place data block restart points adaptively for the "
+            "`block_based` table factory");
+DEFINE_bool(data_block_restart_key_prefix, false,
+            "Whether to store restart key prefixes in data blocks for the "
+            "`block_based` table factory, accelerating seeks within blocks");
+DEFINE_string(index_type, "kBinarySearch",
+              "Index type for the `block_based` table factory, e.g. "
+              "`kBinarySearch`, `kTwoLevelIndexSearch` or "
+              "`kLearnedIndexSearch`");
+DEFINE_bool(integer_keys, false,
+            "Start keys with a big-endian integer rather than decimal digits, "
+            "like fixed-width keys assigned in increasing order");
 DEFINE_string(time_unit, "microsecond",
               "The time unit used for measuring performance. User can specify "
               "`microsecond` (default) or `nanosecond`");
@@ -317,7 +356,24 @@ int main(int argc, char** argv) {
     options.prefix_extractor.reset(
         ROCKSDB_NAMESPACE::NewFixedPrefixTransform(FLAGS_prefix_len));
   } else if (FLAGS_table_factory == "block_based") {
-    tf.reset(new ROCKSDB_NAMESPACE::BlockBasedTableFactory());
+    ROCKSDB_NAMESPACE::BlockBasedTableOptions table_options;
+    table_options.block_size = FLAGS_block_size;
+    table_options.block_restart_interval = FLAGS_block_restart_interval;
+    table_options.adaptive_block_restart_interval =
+        FLAGS_adaptive_block_restart_interval;
+    table_options.data_block_restart_key_prefix =
+        FLAGS_data_block_restart_key_prefix;
+    ROCKSDB_NAMESPACE::ConfigOptions config_options;
+    ROCKSDB_NAMESPACE::Status s =
+        ROCKSDB_NAMESPACE::GetBlockBasedTableOptionsFromString(
+            config_options, table_options, "index_type=" + FLAGS_index_type,
+            &table_options);
+    if (!s.ok()) {
+      fprintf(stderr, "Invalid index type %s: %s\n", FLAGS_index_type.c_str(),
+              s.ToString().c_str());
+      return 1;
+    }
+    tf.reset(new ROCKSDB_NAMESPACE::BlockBasedTableFactory(table_options));
   } else {
     fprintf(stderr, "Invalid table type %s\n", FLAGS_table_factory.c_str());
   }
@@ -330,7 +386,7 @@ int main(int argc, char** argv) {
     ROCKSDB_NAMESPACE::TableReaderBenchmark(
         options, env_options, ro, FLAGS_num_keys1, FLAGS_num_keys2, FLAGS_iter,
         FLAGS_prefix_len, FLAGS_query_empty, FLAGS_iterator, FLAGS_through_db,
-        measured_by_nanosecond);
+        measured_by_nanosecond, FLAGS_integer_keys);
   } else {
     return 1;
   }
@@ -2433,6 +2433,26 @@ TEST_P(BuiltinChecksumTest, ChecksumZeroInputs) {
   }
 }
 
+TEST_P(BuiltinChecksumTest, ChecksumBatch) {
+  Random rnd(301);
+  std::vector<std::string> inputs;
+  for (size_t len : {0, 1, 7, 8, 100, 217, 4096, 5000, 16 * 1024 + 3}) {
+    inputs.push_back(rnd.RandomBinaryString(static_cast<int>(len)));
+  }
+  std::vector<const char*> data;
+  std::vector<size_t> sizes;
+  for (const auto& input : inputs) {
+    data.push_back(input.data());
+    sizes.push_back(input.size());
+  }
+  std::vector<uint32_t> out(inputs.size());
+  ComputeBuiltinChecksums(GetParam(), inputs.size(), data.data(),
+                          sizes.data(), out.data());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    EXPECT_EQ(out[i], ComputeBuiltinChecksum(GetParam(), data[i], sizes[i]));
+  }
+}
+
 void AddInternalKey(TableConstructor* c, const std::string& prefix,
                     std::string value = "v", int /*suffix_len*/ = 800) {
   static Random rnd(1023);
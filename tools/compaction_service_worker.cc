@@ -0,0 +1,38 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// A worker process for LocalCompactionService, to be used as its
+// `worker_command`. It only knows the default options, so DBs with e.g. a
+// merge operator, a compaction filter or a custom table factory need a
+// worker of their own that sets them in the CompactionServiceOptionsOverride.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "rocksdb/env.h"
+#include "rocksdb/table.h"
+#include "rocksdb/utilities/local_compaction_service.h"
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s [args...] <socket fd>\n", argv[0]);
+    return 1;
+  }
+  // The service appends the socket to the configured command line.
+  const int fd = atoi(argv[argc - 1]);
+
+  ROCKSDB_NAMESPACE::CompactionServiceOptionsOverride options_override;
+  options_override.env = ROCKSDB_NAMESPACE::Env::Default();
+  options_override.table_factory.reset(
+      ROCKSDB_NAMESPACE::NewBlockBasedTableFactory());
+  ROCKSDB_NAMESPACE::Status s =
+      ROCKSDB_NAMESPACE::RunLocalCompactionServiceWorker(fd, options_override);
+  if (!s.ok()) {
+    fprintf(stderr, "%s\n", s.ToString().c_str());
+    return 1;
+  }
+  return 0;
+}
@@ -63,6 +63,7 @@
 #include "rocksdb/stats_history.h"
 #include "rocksdb/table.h"
 #include "rocksdb/utilities/backup_engine.h"
+#include "rocksdb/utilities/local_compaction_service.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "rocksdb/utilities/optimistic_transaction_db.h"
 #include "rocksdb/utilities/options_type.h"
@@ -230,6 +231,8 @@ DEFINE_string(
     "\tstats       -- Print DB stats\n"
     "\tresetstats  -- Reset DB stats\n"
     "\tlevelstats  -- Print the number of files and bytes per level\n"
+    "\tampstats    -- Print the write and space amplification and the number "
+    "of sorted runs of the default column family\n"
     "\tmemstats  -- Print memtable stats\n"
     "\tsstables    -- Print sstable info\n"
     "\theapprofile -- Dump a heap profile (if supported by this port)\n"
@@ -510,6 +513,17 @@ DEFINE_uint64(subcompactions, 1,
 static const bool FLAGS_subcompactions_dummy __attribute__((__unused__)) =
     RegisterFlagValidator(&FLAGS_subcompactions, &ValidateUint32Range);
 
+DEFINE_uint32(subcompaction_ranges_per_thread,
+              ROCKSDB_NAMESPACE::Options().subcompaction_ranges_per_thread,
+              "Split compactions into up to this many times more "
+              "subcompactions than threads, and balance them dynamically "
+              "across the threads.");
+
+DEFINE_int32(compaction_service_workers, 0,
+             "If > 0, compactions are run with DB::OpenAndCompact() by a "
+             "LocalCompactionService with this many worker threads, and the "
+             "DB's background threads only install the results.");
+
 DEFINE_int32(max_background_flushes,
              ROCKSDB_NAMESPACE::Options().max_background_flushes,
              "The maximum number of concurrent background flushes"
@@ -523,7 +537,10 @@ DEFINE_int32(compaction_style,
 static ROCKSDB_NAMESPACE::CompactionPri FLAGS_compaction_pri_e;
 DEFINE_int32(compaction_pri,
              (int32_t)ROCKSDB_NAMESPACE::Options().compaction_pri,
-             "priority of files to compaction: by size or by data age");
+             "priority of files to compaction: 0 = by compensated size, 1 = "
+             "oldest largest seq first, 2 = oldest smallest seq first, 3 = "
+             "min overlapping ratio, 4 = round robin, 5 = read weighted "
+             "overlapping ratio");
 
 DEFINE_int32(universal_size_ratio, 0,
              "Percentage flexibility while comparing file size "
@@ -553,6 +570,11 @@ DEFINE_bool(universal_allow_trivial_move, false,
 DEFINE_bool(universal_incremental, false,
             "Enable incremental compactions in universal compaction.");
 
+DEFINE_uint32(universal_max_runs_per_tier,
+              ROCKSDB_NAMESPACE::CompactionOptionsUniversal().max_runs_per_tier,
+              "If at least 2, universal compaction does lazy leveling with "
+              "this many sorted runs per tier.");
+
 DEFINE_int32(
     universal_stop_style,
     (int32_t)ROCKSDB_NAMESPACE::CompactionOptionsUniversal().stop_style,
@@ -626,7 +648,8 @@ DEFINE_bool(use_tiered_cache, false,
 DEFINE_string(
     tiered_adm_policy, "auto",
     "Admission policy to use for the secondary cache(s) in the tiered cache. "
-    "Allowed values are auto, placeholder, allow_cache_hits, and three_queue.");
+    "Allowed values are auto, placeholder, allow_cache_hits, three_queue, "
+    "allow_all, and keep_compressed.");
 
 DEFINE_int64(simcache_size, -1,
              "Number of bytes to use as a simcache of "
@@ -689,6 +712,12 @@ DEFINE_int32(block_restart_interval,
              "Number of keys between restart points "
              "for delta encoding of keys in data block.");
 
+DEFINE_bool(adaptive_block_restart_interval,
+            ROCKSDB_NAMESPACE::BlockBasedTableOptions()
+                .adaptive_block_restart_interval,
+            "Place data block restart points adaptively around "
+            "block_restart_interval, based on the bytes shared between keys.");
+
 DEFINE_int32(
     index_block_restart_interval,
     ROCKSDB_NAMESPACE::BlockBasedTableOptions().index_block_restart_interval,
@@ -728,6 +757,10 @@ DEFINE_double(data_block_hash_table_util_ratio, 0.75,
               "This is only valid if use_data_block_hash_index is "
               "set to true");
 
+DEFINE_bool(data_block_restart_key_prefix, false,
+            "Store restart key prefixes in data blocks to accelerate seeks "
+            "within blocks. This is valid if only we use BlockTable");
+
 DEFINE_int64(compressed_cache_size, -1,
              "Number of bytes to use as a cache of compressed data.");
 
@@ -756,6 +789,16 @@ DEFINE_int32(random_access_max_buffer_size, 1024 * 1024,
 DEFINE_int32(writable_file_max_buffer_size, 1024 * 1024,
              "Maximum write buffer for Writable File");
 
+DEFINE_uint64(compaction_async_write_buffers,
+              ROCKSDB_NAMESPACE::Options().compaction_async_write_buffers,
+              "Number of buffers used to pipeline writes of compaction output "
+              "files. Less than 2 disables pipelining.");
+
+DEFINE_uint64(compaction_pipelined_input_size,
+              ROCKSDB_NAMESPACE::Options().compaction_pipelined_input_size,
+              "If non-zero, compactions read and merge their input in a "
+              "separate thread, buffering up to this many bytes ahead.");
+
 DEFINE_int32(bloom_bits, -1,
              "Bloom filter bits per key. Negative means use default."
              "Zero disables.");
@@ -769,6 +812,10 @@ DEFINE_bool(memtable_whole_key_filtering, false,
             "Try to use whole key bloom filter in memtables.");
 DEFINE_bool(memtable_use_huge_page, false,
             "Try to use huge page in memtables.");
+DEFINE_bool(memtable_numa_aware,
+            ROCKSDB_NAMESPACE::Options().memtable_numa_aware,
+            "Allocate per-core memtable arena blocks from memory local to "
+            "the NUMA node of each core.");
 
 DEFINE_bool(whole_key_filtering,
             ROCKSDB_NAMESPACE::BlockBasedTableOptions().whole_key_filtering,
@@ -1208,6 +1255,11 @@ DEFINE_bool(optimize_multiget_for_io, true,
             "When set true, RocksDB does asynchronous reads for SST files in "
             "multiple levels for MultiGet.");
 
+DEFINE_uint64(multiget_prefetch_distance,
+              ROCKSDB_NAMESPACE::ReadOptions().multiget_prefetch_distance,
+              "ReadOptions.multiget_prefetch_distance: how many keys ahead "
+              "MultiGet prefetches data blocks into CPU caches (0 disables).");
+
 DEFINE_bool(charge_compression_dictionary_building_buffer, false,
             "Setting for "
             "CacheEntryRoleOptions::charged of "
@@ -1315,6 +1367,8 @@ static enum ROCKSDB_NAMESPACE::TieredAdmissionPolicy StringToAdmissionPolicy(
     return ROCKSDB_NAMESPACE::kAdmPolicyThreeQueue;
   } else if (!strcasecmp(policy, "allow_all")) {
     return ROCKSDB_NAMESPACE::kAdmPolicyAllowAll;
+  } else if (!strcasecmp(policy, "keep_compressed")) {
+    return ROCKSDB_NAMESPACE::kAdmPolicyKeepCompressed;
   } else {
     fprintf(stderr, "Cannot parse admission policy %s\n", policy);
     exit(1);
@@ -1460,10 +1514,30 @@ DEFINE_bool(
 DEFINE_bool(allow_concurrent_memtable_write, true,
             "Allow multi-writers to update mem tables in parallel.");
 
+DEFINE_bool(memtable_sorted_batch_insert,
+            ROCKSDB_NAMESPACE::Options().memtable_sorted_batch_insert,
+            "Insert the entries of a write group into the memtable in sorted "
+            "order.");
+
+DEFINE_bool(parallel_wal_writes,
+            ROCKSDB_NAMESPACE::Options().parallel_wal_writes,
+            "Let the writers of a write group encode their own WAL records "
+            "in parallel.");
+
+DEFINE_bool(wal_per_write_queue,
+            ROCKSDB_NAMESPACE::Options().wal_per_write_queue,
+            "Give each write queue its own WAL stream (requires "
+            "two_write_queues).");
+
 DEFINE_double(experimental_mempurge_threshold, 0.0,
               "Maximum useful payload ratio estimate that triggers a mempurge "
               "(memtable garbage collection).");
 
+DEFINE_bool(memtable_resident, ROCKSDB_NAMESPACE::Options().memtable_resident,
+            "Keep the data of the column family in memory: mempurge instead "
+            "of flushing on full write buffers and serve point lookups from "
+            "retained memtables.");
+
 DEFINE_bool(inplace_update_support,
             ROCKSDB_NAMESPACE::Options().inplace_update_support,
             "Support in-place memtable update for smaller or same-size values");
@@ -1779,6 +1853,17 @@ DEFINE_uint32(write_batch_protection_bytes_per_key, 0,
               "Size of per-key-value checksum in each write batch. Currently "
               "only value 0 and 8 are supported.");
 
+DEFINE_uint32(memtable_value_separation_min_size,
+              ROCKSDB_NAMESPACE::Options().memtable_value_separation_min_size,
+              "If non-zero, memtables store values of at least this many "
+              "bytes out of line, in a separate arena.");
+
+DEFINE_uint32(max_flush_partitions,
+              ROCKSDB_NAMESPACE::Options().max_flush_partitions,
+              "If greater than 1, a flush splits the memtables into up to "
+              "this many key ranges and writes one L0 file per range in "
+              "parallel.");
+
 DEFINE_uint32(
     memtable_protection_bytes_per_key, 0,
     "Enable memtable per key-value checksum protection. "
@@ -3474,6 +3559,8 @@ class Benchmark {
       read_options_.adaptive_readahead = FLAGS_adaptive_readahead;
       read_options_.async_io = FLAGS_async_io;
       read_options_.optimize_multiget_for_io = FLAGS_optimize_multiget_for_io;
+      read_options_.multiget_prefetch_distance =
+          static_cast<size_t>(FLAGS_multiget_prefetch_distance);
       read_options_.auto_readahead_size = FLAGS_auto_readahead_size;
 
       void (Benchmark::*method)(ThreadState*) = nullptr;
@@ -3718,6 +3805,8 @@ class Benchmark {
         VerifyDBFromDB(FLAGS_truth_db);
       } else if (name == "levelstats") {
         PrintStats("rocksdb.levelstats");
+      } else if (name == "ampstats") {
+        PrintAmplificationStats();
       } else if (name == "memstats") {
         std::vector<std::string> keys{"rocksdb.num-immutable-mem-table",
                                       "rocksdb.cur-size-active-mem-table",
@@ -4250,6 +4339,8 @@ class Benchmark {
     options.max_background_jobs = FLAGS_max_background_jobs;
     options.max_background_compactions = FLAGS_max_background_compactions;
     options.max_subcompactions = static_cast<uint32_t>(FLAGS_subcompactions);
+    options.subcompaction_ranges_per_thread =
+        FLAGS_subcompaction_ranges_per_thread;
     options.max_background_flushes = FLAGS_max_background_flushes;
     options.compaction_style = FLAGS_compaction_style_e;
     options.compaction_pri = FLAGS_compaction_pri_e;
@@ -4277,6 +4368,7 @@ class Benchmark {
       options.info_log = std::make_shared<StderrLogger>();
     }
     options.memtable_huge_page_size = FLAGS_memtable_use_huge_page ? 2048 : 0;
+    options.memtable_numa_aware = FLAGS_memtable_numa_aware;
     options.memtable_prefix_bloom_size_ratio = FLAGS_memtable_bloom_size_ratio;
     options.memtable_whole_key_filtering = FLAGS_memtable_whole_key_filtering;
     if (FLAGS_memtable_insert_with_hint_prefix_size > 0) {
@@ -4290,6 +4382,10 @@ class Benchmark {
     options.log_readahead_size = FLAGS_log_readahead_size;
     options.random_access_max_buffer_size = FLAGS_random_access_max_buffer_size;
     options.writable_file_max_buffer_size = FLAGS_writable_file_max_buffer_size;
+    options.compaction_async_write_buffers =
+        static_cast<size_t>(FLAGS_compaction_async_write_buffers);
+    options.compaction_pipelined_input_size =
+        static_cast<size_t>(FLAGS_compaction_pipelined_input_size);
     options.use_fsync = FLAGS_use_fsync;
     options.num_levels = FLAGS_num_levels;
     options.target_file_size_base = FLAGS_target_file_size_base;
@@ -4451,6 +4547,8 @@ class Benchmark {
                 : CacheEntryRoleOptions::Decision::kDisabled}});
       block_based_options.block_size = FLAGS_block_size;
       block_based_options.block_restart_interval = FLAGS_block_restart_interval;
+      block_based_options.adaptive_block_restart_interval =
+          FLAGS_adaptive_block_restart_interval;
       block_based_options.index_block_restart_interval =
           FLAGS_index_block_restart_interval;
       block_based_options.format_version =
@@ -4490,6 +4588,8 @@ class Benchmark {
       }
       block_based_options.data_block_hash_table_util_ratio =
           FLAGS_data_block_hash_table_util_ratio;
+      block_based_options.data_block_restart_key_prefix =
+          FLAGS_data_block_restart_key_prefix;
       if (FLAGS_read_cache_path != "") {
         Status rc_status;
 
@@ -4620,8 +4720,13 @@ class Benchmark {
     options.delayed_write_rate = FLAGS_delayed_write_rate;
     options.allow_concurrent_memtable_write =
         FLAGS_allow_concurrent_memtable_write;
+    options.memtable_sorted_batch_insert = FLAGS_memtable_sorted_batch_insert;
+    options.parallel_wal_writes = FLAGS_parallel_wal_writes;
+    options.wal_per_write_queue = FLAGS_wal_per_write_queue;
     options.experimental_mempurge_threshold =
         FLAGS_experimental_mempurge_threshold;
+    options.memtable_resident = FLAGS_memtable_resident;
+    options.max_flush_partitions = FLAGS_max_flush_partitions;
     options.inplace_update_support = FLAGS_inplace_update_support;
     options.inplace_update_num_locks = FLAGS_inplace_update_num_locks;
     options.enable_write_thread_adaptive_yield =
@@ -4655,6 +4760,8 @@ class Benchmark {
       }
     }
     options.max_successive_merges = FLAGS_max_successive_merges;
+    options.memtable_value_separation_min_size =
+        FLAGS_memtable_value_separation_min_size;
     options.strict_max_successive_merges = FLAGS_strict_max_successive_merges;
     options.report_bg_io_stats = FLAGS_report_bg_io_stats;
 
@@ -4685,6 +4792,8 @@ class Benchmark {
         FLAGS_universal_allow_trivial_move;
     options.compaction_options_universal.incremental =
         FLAGS_universal_incremental;
+    options.compaction_options_universal.max_runs_per_tier =
+        FLAGS_universal_max_runs_per_tier;
     options.compaction_options_universal.stop_style =
         static_cast<CompactionStopStyle>(FLAGS_universal_stop_style);
     if (FLAGS_thread_status_per_interval > 0) {
@@ -4826,6 +4935,26 @@ class Benchmark {
       }
     }
 
+    if (options.compaction_service == nullptr &&
+        FLAGS_compaction_service_workers > 0) {
+      LocalCompactionServiceOptions cs_options;
+      cs_options.num_workers = FLAGS_compaction_service_workers;
+      auto& cs_override = cs_options.options_override;
+      cs_override.env = options.env;
+      cs_override.file_checksum_gen_factory = options.file_checksum_gen_factory;
+      cs_override.comparator = options.comparator;
+      cs_override.merge_operator = options.merge_operator;
+      cs_override.compaction_filter = options.compaction_filter;
+      cs_override.compaction_filter_factory = options.compaction_filter_factory;
+      cs_override.prefix_extractor = options.prefix_extractor;
+      cs_override.table_factory = options.table_factory;
+      cs_override.sst_partitioner_factory = options.sst_partitioner_factory;
+      cs_override.statistics = options.statistics;
+      cs_override.table_properties_collector_factories =
+          options.table_properties_collector_factories;
+      options.compaction_service = NewLocalCompactionService(cs_options);
+    }
+
     if (FLAGS_num_multi_db <= 1) {
       OpenDb(options, FLAGS_db, &db_);
     } else {
@@ -8462,6 +8591,56 @@ class Benchmark {
     fprintf(stdout, "\n%s\n", stats.c_str());
   }
 
+  void PrintAmplificationStats() {
+    if (db_.db != nullptr) {
+      PrintAmplificationStats(db_.db, false);
+    }
+    for (const auto& db_with_cfh : multi_dbs_) {
+      PrintAmplificationStats(db_with_cfh.db, true);
+    }
+  }
+
+  // Prints one point of the write/space/read amplification trade-off of the
+  // compaction configuration for the default column family: bytes written by
+  // flushes and compactions per byte flushed or ingested, SST bytes per live
+  // byte, and sorted runs.
+  void PrintAmplificationStats(DB* db, bool print_header) {
+    if (print_header) {
+      fprintf(stdout, "\n==== DB: %s ===\n", db->GetName().c_str());
+    }
+    double write_amp = 0;
+    std::map<std::string, std::string> cf_stats;
+    if (db->GetMapProperty(DB::Properties::kCFStats, &cf_stats)) {
+      auto it = cf_stats.find("compaction.Sum.WriteAmp");
+      if (it != cf_stats.end()) {
+        write_amp = std::stod(it->second);
+      }
+    }
+    double space_amp = 0;
+    uint64_t sst_size = 0;
+    uint64_t live_size = 0;
+    if (db->GetIntProperty(DB::Properties::kTotalSstFilesSize, &sst_size) &&
+        db->GetIntProperty(DB::Properties::kEstimateLiveDataSize,
+                           &live_size) &&
+        live_size > 0) {
+      space_amp = static_cast<double>(sst_size) / live_size;
+    }
+    ColumnFamilyMetaData cf_meta;
+    db->GetColumnFamilyMetaData(&cf_meta);
+    size_t sorted_runs = 0;
+    for (const auto& level : cf_meta.levels) {
+      if (level.level == 0) {
+        sorted_runs += level.files.size();
+      } else if (!level.files.empty()) {
+        ++sorted_runs;
+      }
+    }
+    fprintf(stdout,
+            "Default column family write amplification: %.2f, space "
+            "amplification: %.2f, sorted runs: %" ROCKSDB_PRIszt "\n",
+            write_amp, space_amp, sorted_runs);
+  }
+
   void PrintStats(const std::vector<std::string>& keys) {
     if (db_.db != nullptr) {
       PrintStats(db_.db, keys);
@@ -72,9 +72,10 @@ default_params = {
     # Disabled because of various likely related failures with
     # "Cannot delete table file #N from level 0 since it is on level X"
     "promote_l0_one_in": 0,
-    "compaction_pri": random.randint(0, 4),
+    "compaction_pri": random.randint(0, 5),
     "key_may_exist_one_in": lambda: random.choice([100, 100000]),
     "data_block_index_type": lambda: random.choice([0, 1]),
+    "data_block_restart_key_prefix": lambda: random.choice([0, 1]),
     "delpercent": 4,
     "delrangepercent": 1,
     "destroy_db_initially": 0,
@@ -102,7 +103,7 @@ default_params = {
     "get_sorted_wal_files_one_in": 0,
     "get_current_wal_file_one_in": 0,
     # Temporarily disable hash index
-    "index_type": lambda: random.choice([0, 0, 0, 2, 2, 3]),
+    "index_type": lambda: random.choice([0, 0, 0, 2, 2, 3, 4]),
     "ingest_external_file_one_in": lambda: random.choice([1000, 1000000]),
     "iterpercent": 10,
     "lock_wal_one_in": lambda: random.choice([10000, 1000000]),
@@ -113,6 +114,7 @@ default_params = {
     "max_key": random.choice([100000, 25000000]),
     "max_sequential_skip_in_iterations": lambda: random.choice([1, 2, 8, 16]),
     "max_write_buffer_number": 3,
+    "memtablerep": lambda: random.choice(["skip_list"] * 7 + ["btree"]),
     "mmap_read": lambda: random.randint(0, 1),
     # Setting `nooverwritepercent > 0` is only possible because we do not vary
     # the random seed, so the same keys are chosen by every run for disallowing
@@ -139,6 +141,7 @@ default_params = {
     "sst_file_manager_bytes_per_truncate": lambda: random.choice([0, 1048576]),
     "long_running_snapshots": lambda: random.randint(0, 1),
     "subcompactions": lambda: random.randint(1, 4),
+    "subcompaction_ranges_per_thread": lambda: random.choice([1, 1, 4]),
     "target_file_size_base": lambda: random.choice([512 * 1024, 2048 * 1024]),
     "target_file_size_multiplier": 2,
     "test_batches_snapshots": random.randint(0, 1),
@@ -178,6 +181,7 @@ default_params = {
     "writepercent": 35,
     "format_version": lambda: random.choice([2, 3, 4, 5, 6, 6]),
     "index_block_restart_interval": lambda: random.choice(range(1, 16)),
+    "adaptive_block_restart_interval": lambda: random.choice([0, 1]),
     "use_multiget": lambda: random.randint(0, 1),
     "use_get_entity": lambda: random.choice([0] * 7 + [1]),
     "use_multi_get_entity": lambda: random.choice([0] * 7 + [1]),
@@ -201,6 +205,10 @@ default_params = {
     # that it won't recover past the WAL data hole created by this option
     "wal_bytes_per_sync": 0,
     "compaction_readahead_size": lambda: random.choice([0, 0, 1024 * 1024]),
+    "compaction_async_write_buffers": lambda: random.choice([0, 0, 2, 4]),
+    "compaction_pipelined_input_size": lambda: random.choice(
+        [0, 0, 64 * 1024, 4 * 1024 * 1024]
+    ),
     "db_write_buffer_size": lambda: random.choice(
         [0, 0, 0, 1024 * 1024, 8 * 1024 * 1024, 128 * 1024 * 1024]
     ),
@@ -265,6 +273,9 @@ default_params = {
     "min_write_buffer_number_to_merge": lambda: random.choice([1, 2]),
     "preserve_internal_time_seconds": lambda: random.choice([0, 60, 3600, 36000]),
     "memtable_max_range_deletions": lambda: random.choice([0] * 6 + [100, 1000]),
+    "memtable_value_separation_min_size": lambda: random.choice([0] * 3 + [8, 64]),
+    "memtable_numa_aware": lambda: random.randint(0, 1),
+    "max_flush_partitions": lambda: random.choice([1] * 3 + [2, 4]),
     # 0 (disable) is the default and more commonly used value.
     "bottommost_file_compaction_delay": lambda: random.choice(
         [0, 0, 0, 600, 3600, 86400]
@@ -274,6 +285,9 @@ default_params = {
     "allow_fallocate": lambda: random.choice([0, 1]),
     "table_cache_numshardbits": lambda: random.choice([6] * 3 + [-1] * 2 + [0]),
     "enable_write_thread_adaptive_yield": lambda: random.choice([0, 1]),
+    "memtable_sorted_batch_insert": lambda: random.choice([0, 1]),
+    "parallel_wal_writes": lambda: random.choice([0, 1]),
+    "wal_per_write_queue": lambda: random.choice([0, 1]),
     "log_readahead_size": lambda: random.choice([0, 16 * 1024 * 1024]),
     "bgerror_resume_retry_interval": lambda: random.choice([100, 1000000]),
     "delete_obsolete_files_period_micros": lambda: random.choice(
@@ -289,6 +303,7 @@ default_params = {
     "avoid_flush_during_shutdown": lambda: random.choice([0, 1]),
     "fill_cache": lambda: random.choice([0, 1]),
     "optimize_multiget_for_io": lambda: random.choice([0, 1]),
+    "multiget_prefetch_distance": lambda: random.choice([0, 0, 1, 4]),
     "memtable_insert_hint_per_batch": lambda: random.choice([0, 1]),
     "dump_malloc_stats": lambda: random.choice([0, 1]),
     "stats_history_buffer_size": lambda: random.choice([0, 1024 * 1024]),
@@ -321,7 +336,7 @@ default_params = {
     "block_align": lambda: random.choice([0, 1]),
     "lowest_used_cache_tier": lambda: random.choice([0, 1, 2]),
     "enable_custom_split_merge": lambda: random.choice([0, 1]),
-    "adm_policy": lambda: random.choice([0, 1, 2, 3]),
+    "adm_policy": lambda: random.choice([0, 1, 2, 3, 5]),
     "last_level_temperature": lambda: random.choice(
         ["kUnknown", "kHot", "kWarm", "kCold"]
     ),
@@ -338,6 +353,8 @@ default_params = {
     "check_multiget_entity_consistency": lambda: random.choice([0, 0, 0, 1]),
     "use_timed_put_one_in": lambda: random.choice([0] * 7 + [1, 5, 10]),
     "universal_max_read_amp": lambda: random.choice([-1] * 3 + [0, 4, 10]),
+    # At least the largest level0_file_num_compaction_trigger set by db_stress
+    "universal_max_runs_per_tier": lambda: random.choice([0] * 3 + [8, 16]),
 }
 _TEST_DIR_ENV_VAR = "TEST_TMPDIR"
 # If TEST_TMPDIR_EXPECTED is not specified, default value will be TEST_TMPDIR
@@ -819,6 +836,18 @@ def finalize_and_sanitize(src_params):
         dest_params["memtable_prefix_bloom_size_ratio"] = 0
     if dest_params.get("two_write_queues") == 1:
         dest_params["enable_pipelined_write"] = 0
+    if dest_params.get("wal_per_write_queue") == 1:
+        if (
+            dest_params.get("use_txn") != 1
+            or dest_params.get("use_optimistic_txn") == 1
+            or dest_params.get("two_write_queues") != 1
+        ):
+            dest_params["wal_per_write_queue"] = 0
+        else:
+            # Rejected with the option
+            dest_params["manual_wal_flush_one_in"] = 0
+            dest_params["WAL_ttl_seconds"] = 0
+            dest_params["WAL_size_limit_MB"] = 0
     if dest_params.get("best_efforts_recovery") == 1:
         dest_params["disable_wal"] = 1
         dest_params["enable_compaction_filter"] = 0
@@ -903,7 +932,9 @@ def finalize_and_sanitize(src_params):
         # disable atomic flush.
         if dest_params["test_best_efforts_recovery"] == 0:
             dest_params["disable_wal"] = 0
-    if dest_params.get("allow_concurrent_memtable_write", 1) == 1:
+    if dest_params.get("allow_concurrent_memtable_write", 1) == 1 and dest_params.get(
+        "memtablerep"
+    ) not in ("skip_list", "btree"):
         dest_params["memtablerep"] = "skip_list"
     if (
         dest_params.get("enable_compaction_filter", 0) == 1
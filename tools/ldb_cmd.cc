@@ -2212,6 +2212,7 @@ void DBDumperCommand::DoCommand() {
 
     switch (type) {
       case kWalFile:
+      case kWalStreamFile:
         // TODO(myabandeh): allow configuring is_write_commited
         DumpWalFile(options_, path_, /* print_header_ */ true,
                     /* print_values_ */ true, true /* is_write_commited */,
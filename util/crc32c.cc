@@ -11,6 +11,7 @@
 // four bytes at a time.
 #include "util/crc32c.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <utility>
@@ -1133,6 +1134,42 @@ uint32_t Extend(uint32_t crc, const char* buf, size_t size) {
   return ChosenExtend(crc, buf, size);
 }
 
+#if defined(__SSE4_2__) && (defined(__LP64__) || defined(_WIN64))
+// Computes out[i] = Value(data[i], n[i]) for i in [0, 3), interleaving the
+// three crc32c streams over their common length.
+static void ValueTriple(const char* const* data, const size_t* n,
+                        uint32_t* out) {
+  const size_t common = std::min({n[0], n[1], n[2]}) & ~size_t{7};
+  uint64_t l0 = 0xffffffffu;
+  uint64_t l1 = 0xffffffffu;
+  uint64_t l2 = 0xffffffffu;
+  for (size_t off = 0; off < common; off += 8) {
+    l0 = _mm_crc32_u64(l0, DecodeFixed64(data[0] + off));
+    l1 = _mm_crc32_u64(l1, DecodeFixed64(data[1] + off));
+    l2 = _mm_crc32_u64(l2, DecodeFixed64(data[2] + off));
+  }
+  out[0] = Extend(static_cast<uint32_t>(l0 ^ 0xffffffffu), data[0] + common,
+                  n[0] - common);
+  out[1] = Extend(static_cast<uint32_t>(l1 ^ 0xffffffffu), data[1] + common,
+                  n[1] - common);
+  out[2] = Extend(static_cast<uint32_t>(l2 ^ 0xffffffffu), data[2] + common,
+                  n[2] - common);
+}
+#endif
+
+void ValueBatch(size_t count, const char* const* data, const size_t* n,
+                uint32_t* out) {
+  size_t i = 0;
+#if defined(__SSE4_2__) && (defined(__LP64__) || defined(_WIN64))
+  for (; i + 3 <= count; i += 3) {
+    ValueTriple(data + i, n + i, out + i);
+  }
+#endif
+  for (; i < count; ++i) {
+    out[i] = Value(data[i], n[i]);
+  }
+}
+
 // The code for crc32c combine, copied with permission from folly
 
 // Standard galois-field multiply.  The only modification is that a,
@@ -34,6 +34,14 @@ uint32_t Crc32cCombine(uint32_t crc1, uint32_t crc2, size_t crc2len);
 // Return the crc32c of data[0,n-1]
 inline uint32_t Value(const char* data, size_t n) { return Extend(0, data, n); }
 
+// For i in [0, count), sets out[i] = Value(data[i], n[i]). Where a hardware
+// crc32c instruction is available, independent inputs are processed in
+// lockstep, three at a time, so that the latency of one input's dependency
+// chain is hidden by the others. This is most beneficial for short inputs,
+// which Extend() processes as a single stream.
+void ValueBatch(size_t count, const char* const* data, const size_t* n,
+                uint32_t* out);
+
 static const uint32_t kMaskDelta = 0xa282ead8ul;
 
 // Return a masked representation of crc.
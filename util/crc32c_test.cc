@@ -169,6 +169,30 @@ TEST(CRC, Crc32cCombineBigSizeTest) {
   ASSERT_EQ(crc1_2, crc1_2_combine);
 }
 
+TEST(CRC, ValueBatch) {
+  Random rnd(test::RandomSeed());
+  // Include empty, short, unaligned and long inputs, in uneven batches
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 40; i++) {
+    size_t len = i < 20 ? static_cast<size_t>(i) * 7 : rnd.Uniform(10000);
+    inputs.push_back(rnd.RandomBinaryString(static_cast<int>(len) + 1));
+  }
+  std::vector<const char*> data;
+  std::vector<size_t> n;
+  for (auto& input : inputs) {
+    // Skip the first byte to vary alignment
+    data.push_back(input.data() + 1);
+    n.push_back(input.size() - 1);
+  }
+  for (size_t count : {size_t{0}, size_t{1}, size_t{3}, size_t{5}, n.size()}) {
+    std::vector<uint32_t> out(count);
+    ValueBatch(count, data.data(), n.data(), out.data());
+    for (size_t i = 0; i < count; i++) {
+      ASSERT_EQ(out[i], Value(data[i], n[i]));
+    }
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE::crc32c
 
 // copied from folly
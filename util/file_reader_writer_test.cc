@@ -15,6 +15,7 @@
 #include "file/sequence_file_reader.h"
 #include "file/writable_file_writer.h"
 #include "rocksdb/file_system.h"
+#include "rocksdb/iostats_context.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
 #include "util/crc32c.h"
@@ -230,6 +231,112 @@ TEST_F(WritableFileWriterTest, IncrementalBuffer) {
   }
 }
 
+TEST_F(WritableFileWriterTest, AsyncWrites) {
+  class FakeWF : public FSWritableFile {
+   public:
+    explicit FakeWF(std::string* _file_data) : file_data_(_file_data) {}
+    ~FakeWF() override = default;
+
+    using FSWritableFile::Append;
+    IOStatus Append(const Slice& data, const IOOptions& /*options*/,
+                    IODebugContext* /*dbg*/) override {
+      if (io_error_.load()) {
+        return IOStatus::IOError("Fake IO error");
+      }
+      file_data_->append(data.data(), data.size());
+      return IOStatus::OK();
+    }
+    IOStatus Append(const Slice& data, const IOOptions& options,
+                    const DataVerificationInfo& verification_info,
+                    IODebugContext* dbg) override {
+      EXPECT_EQ(crc32c::Value(data.data(), data.size()),
+                DecodeFixed32(verification_info.checksum.data()));
+      return Append(data, options, dbg);
+    }
+    IOStatus Close(const IOOptions& /*options*/,
+                   IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    IOStatus Flush(const IOOptions& /*options*/,
+                   IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    IOStatus Sync(const IOOptions& /*options*/,
+                  IODebugContext* /*dbg*/) override {
+      return IOStatus::OK();
+    }
+    uint64_t GetFileSize(const IOOptions& /*options*/,
+                         IODebugContext* /*dbg*/) override {
+      return file_data_->size();
+    }
+    void SetIOError(bool val) { io_error_.store(val); }
+
+    std::string* file_data_;
+    std::atomic<bool> io_error_{false};
+  };
+
+  Random r(301);
+  for (int attempt = 0; attempt < 4; attempt++) {
+    // Checksum handoff with and without the caller providing the checksum
+    bool verify = attempt >= 2;
+    bool with_checksum = attempt == 3;
+    FileOptions file_options;
+    file_options.writable_file_max_buffer_size = 64 * 1024;
+    file_options.async_write_buffers = 3;
+    std::string actual;
+    std::unique_ptr<WritableFileWriter> writer(new WritableFileWriter(
+        std::unique_ptr<FakeWF>(new FakeWF(&actual)), "" /* don't care */,
+        file_options, nullptr /* clock */, nullptr /* io_tracer */,
+        nullptr /* stats */, Histograms::HISTOGRAM_ENUM_MAX,
+        {} /* listeners */, nullptr /* file_checksum_gen_factory */, verify,
+        with_checksum));
+    get_iostats_context()->Reset();
+
+    std::string target;
+    for (int i = 0; i < 200; i++) {
+      // Mostly smaller than the buffer, sometimes larger
+      uint32_t num = r.Skewed(17) + 1;
+      std::string random_string = r.RandomString(num);
+      uint32_t crc =
+          with_checksum ? crc32c::Value(random_string.data(), num) : 0;
+      ASSERT_OK(writer->Append(IOOptions(), random_string, crc));
+      target.append(random_string);
+      if (r.OneIn(50)) {
+        ASSERT_OK(writer->Flush(IOOptions()));
+        ASSERT_EQ(target, actual);
+      }
+    }
+    ASSERT_OK(writer->Sync(IOOptions(), false /* use_fsync */));
+    ASSERT_EQ(target, actual);
+    ASSERT_EQ(target.size(), writer->GetFlushedSize());
+    // Background writes are accounted to the thread using the writer
+    ASSERT_EQ(target.size(), get_iostats_context()->bytes_written);
+    ASSERT_OK(writer->Close(IOOptions()));
+    ASSERT_EQ(target, actual);
+  }
+
+  // A failed background write surfaces in later operations
+  std::string actual;
+  FileOptions file_options;
+  file_options.writable_file_max_buffer_size = 64 * 1024;
+  file_options.async_write_buffers = 2;
+  FakeWF* wf = new FakeWF(&actual);
+  std::unique_ptr<WritableFileWriter> writer(
+      new WritableFileWriter(std::unique_ptr<FakeWF>(wf), "" /* don't care */,
+                             file_options));
+  wf->SetIOError(true);
+  IOStatus s;
+  for (int i = 0; i < 16 && s.ok(); i++) {
+    s = writer->Append(IOOptions(), std::string(16 * 1024, 'a'));
+  }
+  if (s.ok()) {
+    s = writer->Sync(IOOptions(), false /* use_fsync */);
+  }
+  ASSERT_NOK(s);
+  ASSERT_TRUE(writer->seen_error());
+  ASSERT_NOK(writer->Close(IOOptions()));
+}
+
 TEST_F(WritableFileWriterTest, BufferWithZeroCapacityDirectIO) {
   EnvOptions env_opts;
   env_opts.use_direct_writes = true;
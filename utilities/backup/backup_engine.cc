@@ -1971,8 +1971,8 @@ IOStatus BackupEngineImpl::RestoreDBFromBackup(
                                   dst);
     }
     // 3. Construct the final path
-    // kWalFile lives in wal_dir and all the rest live in db_dir
-    if (type == kWalFile) {
+    // WAL files live in wal_dir and all the rest live in db_dir
+    if (type == kWalFile || type == kWalStreamFile) {
       dst = wal_dir + "/" + dst;
       if (options_.sync && !wal_dir_for_fsync) {
         io_s = db_fs_->NewDirectory(wal_dir, io_options_, &wal_dir_for_fsync,
@@ -0,0 +1,220 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "utilities/compaction_service/compaction_service_worker.h"
+
+#ifndef OS_WIN
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <deque>
+
+#include "port/port.h"
+#include "rocksdb/db.h"
+#include "rocksdb/utilities/local_compaction_service.h"
+#include "util/coding.h"
+#include "util/mutexlock.h"
+#include "util/string_util.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+#ifndef OS_WIN
+
+namespace {
+
+// Larger messages mean a corrupted stream rather than a huge job input.
+constexpr uint32_t kMaxWorkerMessageSize = 1U << 30;
+
+Status WriteFully(int fd, const char* data, size_t size) {
+  while (size > 0) {
+#ifdef MSG_NOSIGNAL
+    // A worker process that died must not kill the DB with SIGPIPE.
+    ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+#else
+    ssize_t n = write(fd, data, size);
+#endif
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::IOError("Write to compaction service worker socket",
+                             errnoStr(errno).c_str());
+    }
+    data += n;
+    size -= static_cast<size_t>(n);
+  }
+  return Status::OK();
+}
+
+// Sets `*eof` if the peer closed the socket before anything was read.
+Status ReadFully(int fd, char* data, size_t size, bool* eof) {
+  *eof = false;
+  const size_t total = size;
+  while (size > 0) {
+    ssize_t n = read(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Status::IOError("Read from compaction service worker socket",
+                             errnoStr(errno).c_str());
+    }
+    if (n == 0) {
+      if (size == total) {
+        *eof = true;
+        return Status::Incomplete("Compaction service worker socket closed");
+      }
+      return Status::IOError("Truncated compaction service worker message");
+    }
+    data += n;
+    size -= static_cast<size_t>(n);
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status WriteWorkerMessage(int fd, const std::string& message) {
+  char size[sizeof(uint32_t)];
+  EncodeFixed32(size, static_cast<uint32_t>(message.size()));
+  Status s = WriteFully(fd, size, sizeof(size));
+  if (s.ok()) {
+    s = WriteFully(fd, message.data(), message.size());
+  }
+  return s;
+}
+
+Status ReadWorkerMessage(int fd, std::string* message) {
+  char size_buf[sizeof(uint32_t)];
+  bool eof = false;
+  Status s = ReadFully(fd, size_buf, sizeof(size_buf), &eof);
+  if (!s.ok()) {
+    return s;
+  }
+  const uint32_t size = DecodeFixed32(size_buf);
+  if (size == 0 || size > kMaxWorkerMessageSize) {
+    return Status::Corruption("Bad compaction service worker message size");
+  }
+  message->resize(size);
+  s = ReadFully(fd, &(*message)[0], size, &eof);
+  if (eof) {
+    return Status::IOError("Truncated compaction service worker message");
+  }
+  return s;
+}
+
+Status RunLocalCompactionServiceWorker(
+    int fd, const CompactionServiceOptionsOverride& options_override) {
+  port::Mutex mu;
+  port::CondVar cv(&mu);
+  // Guarded by `mu`.
+  std::deque<std::string> jobs;
+  bool closed = false;
+  Status read_status;
+  std::atomic<bool> canceled{false};
+
+  // Reads ahead so that a cancel arrives while a job runs.
+  port::Thread reader([&]() {
+    while (true) {
+      std::string message;
+      Status s = ReadWorkerMessage(fd, &message);
+      MutexLock l(&mu);
+      if (!s.ok()) {
+        if (!s.IsIncomplete()) {
+          read_status = s;
+        }
+        // Nobody waits for the result of the running job anymore.
+        canceled.store(true, std::memory_order_release);
+        closed = true;
+        cv.SignalAll();
+        return;
+      }
+      if (message[0] == static_cast<char>(WorkerMessageType::kCancelJob)) {
+        canceled.store(true, std::memory_order_release);
+      } else {
+        // The service sends the next job only after it got the result of the
+        // previous one, so a cancel read before was meant for an older job.
+        canceled.store(false, std::memory_order_release);
+        jobs.push_back(std::move(message));
+        cv.SignalAll();
+      }
+    }
+  });
+
+  Status s;
+  while (true) {
+    std::string message;
+    {
+      MutexLock l(&mu);
+      while (jobs.empty() && !closed) {
+        cv.Wait();
+      }
+      if (jobs.empty()) {
+        s = read_status;
+        break;
+      }
+      message = std::move(jobs.front());
+      jobs.pop_front();
+    }
+
+    Slice input(message);
+    Slice db_name;
+    Slice output_dir;
+    Slice job_input;
+    bool valid = input[0] == static_cast<char>(WorkerMessageType::kRunJob);
+    input.remove_prefix(1);
+    valid = valid && GetLengthPrefixedSlice(&input, &db_name) &&
+            GetLengthPrefixedSlice(&input, &output_dir) &&
+            GetLengthPrefixedSlice(&input, &job_input);
+    if (!valid) {
+      s = Status::Corruption("Bad compaction service worker message");
+      break;
+    }
+
+    OpenAndCompactOptions open_and_compact_options;
+    open_and_compact_options.canceled = &canceled;
+    std::string result;
+    Status job_status = DB::OpenAndCompact(
+        open_and_compact_options, db_name.ToString(), output_dir.ToString(),
+        job_input.ToString(), &result, options_override);
+
+    std::string reply(1, static_cast<char>(WorkerMessageType::kJobResult));
+    reply.push_back(job_status.ok() ? 1 : 0);
+    PutLengthPrefixedSlice(&reply, job_status.ToString());
+    PutLengthPrefixedSlice(&reply, result);
+    s = WriteWorkerMessage(fd, reply);
+    if (!s.ok()) {
+      break;
+    }
+  }
+
+  // Wakes up the reader if it is still blocked.
+  shutdown(fd, SHUT_RDWR);
+  reader.join();
+  return s;
+}
+
+#else  // OS_WIN
+
+Status WriteWorkerMessage(int /*fd*/, const std::string& /*message*/) {
+  return Status::NotSupported("Compaction service worker processes");
+}
+
+Status ReadWorkerMessage(int /*fd*/, std::string* /*message*/) {
+  return Status::NotSupported("Compaction service worker processes");
+}
+
+Status RunLocalCompactionServiceWorker(
+    int /*fd*/, const CompactionServiceOptionsOverride& /*options_override*/) {
+  return Status::NotSupported("Compaction service worker processes");
+}
+
+#endif  // OS_WIN
+
+}  // namespace ROCKSDB_NAMESPACE
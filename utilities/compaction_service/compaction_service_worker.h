@@ -0,0 +1,37 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <string>
+
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// The messages LocalCompactionService exchanges with its worker processes
+// over a Unix stream socket. Each message is its size as a fixed32 followed
+// by that many bytes, the first of which is the message type.
+enum class WorkerMessageType : char {
+  // Service to worker: run a job. Followed by the db_name, the output
+  // directory and the serialized job input, each length prefixed.
+  kRunJob = 1,
+  // Service to worker: cancel the running job, if any.
+  kCancelJob = 2,
+  // Worker to service: the job finished. Followed by one byte that is 1 if
+  // DB::OpenAndCompact() succeeded and 0 otherwise, its status as a string
+  // and the serialized result, both length prefixed.
+  kJobResult = 3,
+};
+
+// Writes the whole message to `fd`, retrying short writes.
+Status WriteWorkerMessage(int fd, const std::string& message);
+
+// Reads the next message from `fd`. Returns Status::Incomplete() if the peer
+// closed the socket before a new message started.
+Status ReadWorkerMessage(int fd, std::string* message);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,583 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/utilities/local_compaction_service.h"
+
+#ifndef OS_WIN
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "db/compaction/compaction_job.h"
+#include "logging/logging.h"
+#include "port/port.h"
+#include "rocksdb/db.h"
+#include "rocksdb/env.h"
+#include "util/coding.h"
+#include "util/mutexlock.h"
+#include "util/string_util.h"
+#include "utilities/compaction_service/compaction_service_worker.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+
+class LocalCompactionServiceImpl : public LocalCompactionService {
+ public:
+  explicit LocalCompactionServiceImpl(
+      const LocalCompactionServiceOptions& options)
+      : options_(options), cv_(&mu_) {
+    if (options_.options_override.env == nullptr) {
+      options_.options_override.env = Env::Default();
+    }
+    env_ = options_.options_override.env;
+    const int num_workers = std::max(options_.num_workers, 1);
+    for (int i = 0; i < num_workers; ++i) {
+      workers_.emplace_back(&LocalCompactionServiceImpl::WorkerThread, this);
+    }
+  }
+
+  ~LocalCompactionServiceImpl() override {
+    std::vector<CancelRequest> requests;
+    {
+      MutexLock l(&mu_);
+      shutting_down_ = true;
+      CancelJobs(&requests);
+    }
+    SendCancels(requests);
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+    // Nobody waits for the remaining jobs anymore, so their output files are
+    // not used.
+    for (auto& job : jobs_) {
+      if (job.second->status == CompactionServiceJobStatus::kSuccess) {
+        RemoveOutputDir(job.second->output_dir, /*keep=*/{});
+      }
+    }
+    RemoveFinishedDirs(/*last=*/true);
+    // Only removed if no job directory is left in it.
+    for (const auto& root : output_roots_) {
+      env_->DeleteDir(root).PermitUncheckedError();
+    }
+  }
+
+  CompactionServiceScheduleResponse Schedule(
+      const CompactionServiceJobInfo& info,
+      const std::string& compaction_service_input) override {
+    auto job = std::make_shared<Job>();
+    job->id = env_->GenerateUniqueId();
+    job->db_name = info.db_name;
+    job->output_root = options_.output_root.empty()
+                           ? DefaultOutputRoot(info.db_name)
+                           : options_.output_root;
+    job->output_dir = job->output_root + "/" + job->id;
+    job->input = compaction_service_input;
+
+    MutexLock l(&mu_);
+    if (shutting_down_) {
+      return CompactionServiceScheduleResponse(
+          CompactionServiceJobStatus::kUseLocal);
+    }
+    output_roots_.insert(job->output_root);
+    jobs_.emplace(job->id, job);
+    queue_.push_back(job);
+    cv_.SignalAll();
+    return CompactionServiceScheduleResponse(
+        job->id, CompactionServiceJobStatus::kSuccess);
+  }
+
+  CompactionServiceJobStatus Wait(const std::string& scheduled_job_id,
+                                  std::string* result) override {
+    MutexLock l(&mu_);
+    auto it = jobs_.find(scheduled_job_id);
+    if (it == jobs_.end()) {
+      return CompactionServiceJobStatus::kFailure;
+    }
+    std::shared_ptr<Job> job = it->second;
+    while (!job->done) {
+      cv_.Wait();
+    }
+    if (job->status == CompactionServiceJobStatus::kSuccess) {
+      // The DB renames the output files into place once it got the result,
+      // so the directory can only be removed afterwards.
+      finished_dirs_.emplace_back(job->output_dir);
+    }
+    jobs_.erase(it);
+    *result = std::move(job->result);
+    return job->status;
+  }
+
+  void Cancel(const std::string& scheduled_job_id) override {
+    std::vector<CancelRequest> requests;
+    {
+      MutexLock l(&mu_);
+      auto it = jobs_.find(scheduled_job_id);
+      if (it != jobs_.end()) {
+        CancelJob(it->second, &requests);
+      }
+    }
+    SendCancels(requests);
+  }
+
+  void CancelAllJobs() override {
+    std::vector<CancelRequest> requests;
+    {
+      MutexLock l(&mu_);
+      CancelJobs(&requests);
+    }
+    SendCancels(requests);
+  }
+
+  LocalCompactionServiceStats GetStats() const override {
+    MutexLock l(&mu_);
+    return stats_;
+  }
+
+ private:
+  // A worker process started from `worker_command`. Each worker thread owns
+  // one.
+  struct Job;
+
+  struct WorkerProcess {
+    int pid = -1;
+    // Keeps the messages of the owning worker thread and of Cancel() apart.
+    port::Mutex write_mu;
+    // Guarded by `write_mu`, only changed by the owning worker thread.
+    int fd = -1;
+    // The job sent to the process, until its result is read. Guarded by
+    // `write_mu`.
+    const Job* job = nullptr;
+  };
+
+  struct Job {
+    std::string id;
+    std::string db_name;
+    std::string output_root;
+    std::string output_dir;
+    std::string input;
+    std::atomic<bool> canceled{false};
+    // The fields below are guarded by `mu_`.
+    bool running = false;
+    // The worker process running the job, if any.
+    WorkerProcess* process = nullptr;
+    bool done = false;
+    CompactionServiceJobStatus status = CompactionServiceJobStatus::kFailure;
+    std::string result;
+  };
+
+  // A running job whose worker process must be told that it was canceled.
+  // The message is sent after `mu_` is released, since a stuck process can
+  // block the write.
+  struct CancelRequest {
+    WorkerProcess* process;
+    // Keeps the job alive, so that it is not mistaken for a new job at the
+    // same address.
+    std::shared_ptr<Job> job;
+  };
+
+  // Cancels the jobs scheduled so far.
+  // REQUIRES: `mu_` is held.
+  void CancelJobs(std::vector<CancelRequest>* requests) {
+    for (auto& job : jobs_) {
+      CancelJob(job.second, requests);
+    }
+    cv_.SignalAll();
+  }
+
+  // REQUIRES: `mu_` is held.
+  void CancelJob(const std::shared_ptr<Job>& job,
+                 std::vector<CancelRequest>* requests) {
+    job->canceled.store(true, std::memory_order_release);
+    if (job->process != nullptr) {
+      requests->push_back({job->process, job});
+    }
+    if (!job->running && !job->done) {
+      // Still queued: the worker picking it up skips it.
+      FinishJob(job.get(), CanceledStatus(), "");
+      ++stats_.num_canceled;
+    }
+  }
+
+  // REQUIRES: `mu_` is not held.
+  void SendCancels(const std::vector<CancelRequest>& requests) {
+    for (const auto& request : requests) {
+      SendCancel(request.process, request.job.get());
+    }
+  }
+
+  // REQUIRES: `mu_` is held.
+  void FinishJob(Job* job, CompactionServiceJobStatus status,
+                 std::string result) {
+    job->status = status;
+    job->result = std::move(result);
+    job->done = true;
+    cv_.SignalAll();
+  }
+
+  // A sibling of the DB directory, so that the DB does not see the job
+  // directories but can rename the output files into place.
+  static std::string DefaultOutputRoot(const std::string& db_name) {
+    std::string root = db_name;
+    while (root.size() > 1 && root.back() == '/') {
+      root.pop_back();
+    }
+    return root + "_compaction_service";
+  }
+
+  CompactionServiceJobStatus CanceledStatus() const {
+    return options_.fallback_to_local ? CompactionServiceJobStatus::kUseLocal
+                                      : CompactionServiceJobStatus::kFailure;
+  }
+
+  void WorkerThread() {
+    WorkerProcess process;
+    mu_.Lock();
+    while (true) {
+      while (queue_.empty() && !shutting_down_) {
+        cv_.Wait();
+      }
+      if (queue_.empty()) {
+        break;
+      }
+      std::shared_ptr<Job> job = std::move(queue_.front());
+      queue_.pop_front();
+      if (job->done) {
+        // Canceled while queued.
+        continue;
+      }
+      job->running = true;
+
+      mu_.Unlock();
+      RemoveFinishedDirs(/*last=*/false);
+      std::string result;
+      int retries = 0;
+      Status s = RunJob(job.get(), &process, &result, &retries);
+      mu_.Lock();
+
+      job->running = false;
+      stats_.num_retries += retries;
+      if (s.ok()) {
+        ++stats_.num_succeeded;
+        FinishJob(job.get(), CompactionServiceJobStatus::kSuccess,
+                  std::move(result));
+      } else if (job->canceled.load(std::memory_order_acquire)) {
+        ++stats_.num_canceled;
+        FinishJob(job.get(), CanceledStatus(), "");
+      } else {
+        ++stats_.num_failed;
+        FinishJob(job.get(),
+                  options_.fallback_to_local
+                      ? CompactionServiceJobStatus::kUseLocal
+                      : CompactionServiceJobStatus::kFailure,
+                  std::move(result));
+      }
+    }
+    mu_.Unlock();
+    StopWorkerProcess(&process, /*kill_process=*/false);
+  }
+
+  Status RunJob(Job* job, WorkerProcess* process, std::string* result,
+                int* retries) {
+    OpenAndCompactOptions open_and_compact_options;
+    open_and_compact_options.canceled = &job->canceled;
+    Status s;
+    for (int attempt = 0;; ++attempt) {
+      if (attempt > 0) {
+        ++*retries;
+      }
+      result->clear();
+      s = env_->CreateDirIfMissing(job->output_root);
+      if (s.ok() && !options_.worker_command.empty()) {
+        s = RunJobInWorkerProcess(job, process, result);
+      } else if (s.ok()) {
+        s = DB::OpenAndCompact(open_and_compact_options, job->db_name,
+                               job->output_dir, job->input, result,
+                               options_.options_override);
+      }
+      if (s.ok() || job->canceled.load(std::memory_order_acquire) ||
+          attempt >= options_.max_retries) {
+        break;
+      }
+      RemoveOutputDir(job->output_dir, /*keep=*/{});
+    }
+
+    if (!s.ok()) {
+      RemoveOutputDir(job->output_dir, /*keep=*/{});
+      return s;
+    }
+    // Keep only the output files, not the info log and other files of the
+    // secondary instance that ran the compaction.
+    CompactionServiceResult compaction_result;
+    s = CompactionServiceResult::Read(*result, &compaction_result);
+    if (!s.ok()) {
+      RemoveOutputDir(job->output_dir, /*keep=*/{});
+      return s;
+    }
+    compaction_result.status.PermitUncheckedError();
+    std::unordered_set<std::string> keep;
+    for (const auto& file : compaction_result.output_files) {
+      keep.insert(file.file_name);
+    }
+    RemoveOutputDir(job->output_dir, keep);
+    return s;
+  }
+
+  // Sends the job to `process`, started first if needed, and waits for its
+  // result. The process is stopped if it does not deliver one, so that the
+  // next attempt starts a new one.
+  Status RunJobInWorkerProcess(Job* job, WorkerProcess* process,
+                               std::string* result) {
+    Status s;
+    if (process->fd < 0) {
+      s = StartWorkerProcess(process);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    std::string message(1, static_cast<char>(WorkerMessageType::kRunJob));
+    PutLengthPrefixedSlice(&message, job->db_name);
+    PutLengthPrefixedSlice(&message, job->output_dir);
+    PutLengthPrefixedSlice(&message, job->input);
+    {
+      MutexLock l(&mu_);
+      job->process = process;
+    }
+    {
+      MutexLock l(&process->write_mu);
+      s = WriteWorkerMessage(process->fd, message);
+      if (s.ok()) {
+        process->job = job;
+      }
+    }
+    std::string reply;
+    if (s.ok()) {
+      // Cancel() did not send the cancel if it came before the job.
+      if (job->canceled.load(std::memory_order_acquire)) {
+        SendCancel(process, job);
+      }
+      s = ReadWorkerMessage(process->fd, &reply);
+      MutexLock l(&process->write_mu);
+      process->job = nullptr;
+    }
+    {
+      MutexLock l(&mu_);
+      job->process = nullptr;
+    }
+
+    Slice input(reply);
+    Slice job_status;
+    Slice job_result;
+    if (s.ok()) {
+      bool valid = input.size() >= 2 &&
+                   input[0] == static_cast<char>(WorkerMessageType::kJobResult);
+      const bool job_ok = valid && input[1] == 1;
+      if (valid) {
+        input.remove_prefix(2);
+      }
+      valid = valid && GetLengthPrefixedSlice(&input, &job_status) &&
+              GetLengthPrefixedSlice(&input, &job_result);
+      if (!valid) {
+        s = Status::Corruption("Bad compaction service worker message");
+      } else if (!job_ok) {
+        // The process is fine, only the job failed.
+        return Status::Aborted("Compaction service worker", job_status);
+      } else {
+        *result = job_result.ToString();
+        return s;
+      }
+    }
+    StopWorkerProcess(process, /*kill_process=*/true);
+    return s;
+  }
+
+  Status StartWorkerProcess(WorkerProcess* process) {
+#ifdef OS_WIN
+    (void)process;
+    return Status::NotSupported("Compaction service worker processes");
+#else
+    int type = SOCK_STREAM;
+#ifdef SOCK_CLOEXEC
+    // Processes started concurrently by other worker threads must not
+    // inherit the socket, or the worker would not see it closed.
+    type |= SOCK_CLOEXEC;
+#endif
+    int fds[2];
+    if (socketpair(AF_UNIX, type, 0, fds) != 0) {
+      return Status::IOError("Create compaction service worker socket",
+                             errnoStr(errno).c_str());
+    }
+#ifndef SOCK_CLOEXEC
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+#ifdef SO_NOSIGPIPE
+    int no_sigpipe = 1;
+    setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe,
+               sizeof(no_sigpipe));
+#endif
+    // Built before fork(), since the child may only make async-signal-safe
+    // calls until it execs.
+    std::vector<std::string> args = options_.worker_command;
+    args.push_back(std::to_string(fds[1]));
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+      argv.push_back(&arg[0]);
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+      fcntl(fds[1], F_SETFD, 0);
+      execv(argv[0], argv.data());
+      _exit(127);
+    }
+    const int fork_errno = errno;
+    close(fds[1]);
+    if (pid < 0) {
+      close(fds[0]);
+      return Status::IOError("Start compaction service worker",
+                             errnoStr(fork_errno).c_str());
+    }
+    process->pid = pid;
+    MutexLock l(&process->write_mu);
+    process->fd = fds[0];
+    return Status::OK();
+#endif
+  }
+
+  // Closes the socket, which makes the worker process exit, and reaps it.
+  void StopWorkerProcess(WorkerProcess* process, bool kill_process) {
+#ifdef OS_WIN
+    (void)process;
+    (void)kill_process;
+#else
+    if (process->fd < 0) {
+      return;
+    }
+    {
+      // A late cancel must not write to a reused file descriptor.
+      MutexLock l(&process->write_mu);
+      close(process->fd);
+      process->fd = -1;
+    }
+    if (kill_process) {
+      kill(process->pid, SIGKILL);
+    }
+    int wait_status;
+    while (waitpid(process->pid, &wait_status, 0) < 0 && errno == EINTR) {
+    }
+    process->pid = -1;
+#endif
+  }
+
+  // Tells `process` to cancel `job` if it is still running it. A failure only
+  // means that the job's result shows up anyway.
+  void SendCancel(WorkerProcess* process, const Job* job) {
+    std::string message(1, static_cast<char>(WorkerMessageType::kCancelJob));
+    MutexLock l(&process->write_mu);
+    if (process->fd < 0 || process->job != job) {
+      return;
+    }
+    WriteWorkerMessage(process->fd, message).PermitUncheckedError();
+  }
+
+  // Deletes the files in `dir` except those in `keep`, and `dir` itself if
+  // nothing is kept. Errors are ignored: leftovers only waste space.
+  void RemoveOutputDir(const std::string& dir,
+                       const std::unordered_set<std::string>& keep) {
+    std::vector<std::string> children;
+    env_->GetChildren(dir, &children).PermitUncheckedError();
+    for (const auto& child : children) {
+      if (keep.count(child) == 0) {
+        env_->DeleteFile(dir + "/" + child).PermitUncheckedError();
+      }
+    }
+    if (keep.empty()) {
+      env_->DeleteDir(dir).PermitUncheckedError();
+    }
+  }
+
+  // Removes the directories of succeeded jobs whose output files were moved
+  // to the DB. A directory that still has files, e.g. because the DB failed
+  // to install them, is checked again by the next calls. After
+  // kMaxRemoveAttempts calls, or if `last` is set, it is left in place
+  // instead, since the files might still be about to be moved.
+  void RemoveFinishedDirs(bool last) {
+    std::vector<FinishedDir> dirs;
+    {
+      MutexLock l(&mu_);
+      dirs.swap(finished_dirs_);
+    }
+    std::vector<FinishedDir> remaining;
+    for (auto& dir : dirs) {
+      std::vector<std::string> children;
+      Status s = env_->GetChildren(dir.path, &children);
+      if (s.ok() && children.empty()) {
+        s = env_->DeleteDir(dir.path);
+      } else if (s.ok()) {
+        if (last || ++dir.remove_attempts >= kMaxRemoveAttempts) {
+          ROCKS_LOG_WARN(options_.info_log,
+                         "LocalCompactionService: leaving %" ROCKSDB_PRIszt
+                         " files in job directory %s",
+                         children.size(), dir.path.c_str());
+        } else {
+          remaining.push_back(std::move(dir));
+        }
+      }
+      s.PermitUncheckedError();
+    }
+    MutexLock l(&mu_);
+    finished_dirs_.insert(finished_dirs_.end(), remaining.begin(),
+                          remaining.end());
+  }
+
+  LocalCompactionServiceOptions options_;
+  Env* env_;
+
+  mutable port::Mutex mu_;
+  port::CondVar cv_;
+  // Scheduled jobs that nobody waited for yet. Guarded by `mu_`.
+  std::unordered_map<std::string, std::shared_ptr<Job>> jobs_;
+  // Jobs not picked up by a worker yet. Guarded by `mu_`.
+  std::deque<std::shared_ptr<Job>> queue_;
+  struct FinishedDir {
+    explicit FinishedDir(std::string _path) : path(std::move(_path)) {}
+    std::string path;
+    int remove_attempts = 0;
+  };
+  static constexpr int kMaxRemoveAttempts = 3;
+  // Output directories of succeeded jobs the DB got the result of. Guarded by
+  // `mu_`.
+  std::vector<FinishedDir> finished_dirs_;
+  // The directories the job directories were created in. Guarded by `mu_`.
+  std::unordered_set<std::string> output_roots_;
+  // Guarded by `mu_`.
+  LocalCompactionServiceStats stats_;
+  // Guarded by `mu_`.
+  bool shutting_down_ = false;
+  std::vector<port::Thread> workers_;
+};
+
+}  // namespace
+
+std::shared_ptr<LocalCompactionService> NewLocalCompactionService(
+    const LocalCompactionServiceOptions& options) {
+  return std::make_shared<LocalCompactionServiceImpl>(options);
+}
+
+}  // namespace ROCKSDB_NAMESPACE